@@ -0,0 +1,69 @@
+# Checks that the numexpr evaluation path of the Python Calculator produces
+# the same results as the default path, for simple and composite inputs.
+# The test is skipped when numexpr is not available.
+import sys
+from paraview.simple import *
+from paraview import servermanager
+from paraview.detail import calculator as calculatorModule
+from paraview.vtk.util.numpy_support import vtk_to_numpy
+import numpy
+
+try:
+    import numexpr
+except ImportError:
+    print("numexpr is not available, skipping the test.")
+    sys.exit(0)
+
+# counts the expressions evaluated with numexpr. The calculator executes in
+# this process with the builtin session.
+numExprEvaluations = []
+_compute_numexpr = calculatorModule.compute_numexpr
+def compute_numexpr(expression, ns):
+    result = _compute_numexpr(expression, ns)
+    if result is not None:
+        numExprEvaluations.append(expression)
+    return result
+calculatorModule.compute_numexpr = compute_numexpr
+
+wavelet = Wavelet()
+sphere = Sphere()
+elevation = Elevation(Input=sphere)
+grouped = GroupDatasets(Input=[wavelet, Elevation(Input=Wavelet())])
+
+def compare(source, expression, association=0):
+    if calculatorModule._get_numexpr_names(expression) is None:
+        print("ERROR: numexpr does not handle expression '%s'" % expression)
+        sys.exit(1)
+    results = []
+    for useNumExpr in (0, 1):
+        calculator = PythonCalculator(Input=source, Expression=expression,
+            ArrayAssociation=association, UseNumExpr=useNumExpr)
+        del numExprEvaluations[:]
+        calculator.UpdatePipeline()
+        if numExprEvaluations != ([expression] if useNumExpr else []):
+            print("ERROR: wrong evaluation path for expression '%s'" % expression)
+            sys.exit(1)
+        output = servermanager.Fetch(calculator)
+        if output.IsA("vtkCompositeDataSet"):
+            it = output.NewIterator()
+            it.InitTraversal()
+            arrays = []
+            while not it.IsDoneWithTraversal():
+                arrays.append(vtk_to_numpy(
+                    it.GetCurrentDataObject().GetPointData().GetArray("result")))
+                it.GoToNextItem()
+            results.append(numpy.concatenate(arrays))
+        else:
+            results.append(vtk_to_numpy(output.GetPointData().GetArray("result")))
+        Delete(calculator)
+    if results[0].shape != results[1].shape or not numpy.allclose(results[0], results[1]):
+        print("ERROR: numexpr result differs for expression '%s'" % expression)
+        sys.exit(1)
+
+compare(wavelet, "RTData * 2 + 1")
+compare(wavelet, "sqrt(abs(RTData)) - where(RTData > 100, 1.0, 0.0)")
+compare(elevation, "sin(Normals) * 3")
+compare(elevation, "Elevation * 2 - 1")
+compare(grouped, "RTData / 255 + 1")
+compare(grouped, "RTData ** 2 - 5")
+print("success")
@@ -0,0 +1,104 @@
+# Tests the asynchronous interactive rendering of two render views with a
+# remote server. The views share the connection to the server, each one must
+# display its own images whichever view renders next.
+from paraview import servermanager
+from paraview import simple as smp
+from vtkmodules.vtkRenderingCore import vtkWindowToImageFilter
+
+# Make sure the test driver know that process has properly started
+print ("Process started")
+
+def getHost(url):
+   return url.split(':')[1][2:]
+def getPort(url):
+   return int(url.split(':')[2])
+
+def expect(condition, message):
+    if not condition:
+        raise RuntimeError(message)
+
+options = servermanager.vtkRemotingCoreConfiguration.GetInstance()
+url = options.GetServerURL()
+smp.Connect(getHost(url), getPort(url))
+
+def createView(source, background):
+    view = smp.CreateRenderView()
+    view.ViewSize = [200, 200]
+    view.UseColorPaletteForBackground = 0
+    view.Background = background
+    # always render on the server.
+    view.RemoteRenderThreshold = 0
+    view.AsynchronousInteractiveRendering = 1
+    smp.Show(source, view)
+    smp.ResetCamera(view)
+    # keep the displayed image in the buffer read by checkBackground().
+    view.GetRenderWindow().SwapBuffersOff()
+    smp.Render(view)
+    return view
+
+# Checks that the image displayed by `view` has the background `channel`, i.e.
+# 0 for red, 1 for green and 2 for blue, and not another one.
+def checkBackground(view, channel, step):
+    w2i = vtkWindowToImageFilter()
+    w2i.SetInput(view.GetRenderWindow())
+    w2i.ReadFrontBufferOff()
+    w2i.ShouldRerenderOff()
+    w2i.Update()
+    # the lower left corner shows the background.
+    rgb = w2i.GetOutput().GetPointData().GetScalars().GetTuple(0)
+    expect(rgb[channel] > 200 and all(rgb[c] < 50 for c in range(3) if c != channel),
+           "Wrong image displayed after %s: %s" % (step, str(rgb)))
+
+redSphere = smp.Sphere()
+redView = createView(redSphere, [1, 0, 0])
+blueView = createView(smp.Cone(), [0, 0, 1])
+checkBackground(redView, 0, "the first still render")
+checkBackground(blueView, 2, "the first still render")
+
+# interleaved interactions, each view leaves its image pending for the other.
+for i in range(5):
+    redView.GetActiveCamera().Azimuth(10)
+    redView.InteractiveRender()
+    checkBackground(redView, 0, "an interactive render of the red view")
+    blueView.GetActiveCamera().Elevation(10)
+    blueView.InteractiveRender()
+    checkBackground(blueView, 2, "an interactive render of the blue view")
+
+# a still render of a view while the other one has a pending image.
+redView.InteractiveRender()
+smp.Render(blueView)
+checkBackground(blueView, 2, "a still render of the blue view")
+smp.Render(redView)
+checkBackground(redView, 0, "a still render of the red view")
+
+# a view deleted with a pending image.
+blueView.InteractiveRender()
+smp.Delete(blueView)
+del blueView
+redView.InteractiveRender()
+smp.Render(redView)
+checkBackground(redView, 0, "the deletion of the blue view")
+
+# a view rendering locally drops the images it rendered remotely before, the
+# next asynchronous render must not display them.
+redView.InteractiveRender()
+redView.Background = [0, 1, 0]
+redView.RemoteRenderThreshold = 1e6
+redSphere.ThetaResolution = 16
+redView.InteractiveRender()
+checkBackground(redView, 1, "a local interactive render")
+redView.RemoteRenderThreshold = 0
+redSphere.ThetaResolution = 8
+redView.InteractiveRender()
+checkBackground(redView, 1, "a local render followed by a remote one")
+smp.Render(redView)
+checkBackground(redView, 1, "a still render after a local render")
+
+# the connection is still in sync.
+sphere = smp.Sphere(ThetaResolution=12, PhiResolution=8)
+sphere.UpdatePipeline()
+expect(sphere.GetDataInformation().GetNumberOfPoints() == 12 * 6 + 2,
+       "Wrong data after the renders.")
+
+smp.Disconnect()
+print ("Test Passed")
@@ -0,0 +1,75 @@
+# Tests batched proxy updates (vtkSMSessionProxyManager::BeginBatchUpdate)
+# with a remote server, where the states are sent in PUSH_BATCH messages.
+from paraview import servermanager
+from paraview import simple as smp
+
+# Make sure the test driver know that process has properly started
+print ("Process started")
+
+def getHost(url):
+   return url.split(':')[1][2:]
+def getPort(url):
+   return int(url.split(':')[2])
+
+def expect(condition, message):
+    if not condition:
+        raise RuntimeError(message)
+
+def numberOfPoints(source):
+    source.UpdatePipeline()
+    return source.GetDataInformation().GetNumberOfPoints()
+
+options = servermanager.vtkRemotingCoreConfiguration.GetInstance()
+url = options.GetServerURL()
+smp.Connect(getHost(url), getPort(url))
+
+session = servermanager.ActiveConnection.Session
+pxm = servermanager.ProxyManager()
+
+sphere = smp.Sphere(PhiResolution=8, ThetaResolution=8)
+shrink = smp.Shrink(Input=sphere)
+view = smp.CreateRenderView()
+rep = smp.Show(shrink, view)
+smp.Render(view)
+expect(numberOfPoints(sphere) == 8 * 6 + 2, "Wrong initial sphere.")
+
+pxm.BeginBatchUpdate()
+expect(session.GetIsPushBatchOpen(), "Push batch was not opened.")
+
+# Several states for the same server-side object: the last one must win.
+sphere.ThetaResolution = 16
+shrink.ShrinkFactor = 0.3
+sphere.ThetaResolution = 12
+
+# A state with a client part: the client side object must be up to date
+# when it is accessed, even though the batch is still open.
+rep.Visibility = 0
+expect(rep.GetClientSideObject().GetVisibility() == 0,
+       "Client side object does not reflect the batched state.")
+
+# Requests needing a reply send the queued states first.
+expect(numberOfPoints(sphere) == 12 * 6 + 2, "Queued states were not sent before an update.")
+
+# Nested batches only send the states when the outermost batch ends.
+pxm.BeginBatchUpdate()
+sphere.ThetaResolution = 32
+sphere.PhiResolution = 10
+rep.Visibility = 1
+pxm.EndBatchUpdate()
+expect(session.GetIsPushBatchOpen(), "Nested batch closed the outer batch.")
+pxm.EndBatchUpdate()
+expect(not session.GetIsPushBatchOpen(), "Push batch was not closed.")
+
+expect(rep.GetClientSideObject().GetVisibility() == 1, "Wrong client side state.")
+expect(numberOfPoints(sphere) == 32 * 8 + 2, "Batched states were not applied in order.")
+expect(shrink.GetProperty("ShrinkFactor").GetElement(0) == 0.3, "Wrong shrink factor.")
+smp.Render(view)
+
+# The state of a proxy must be the same on the server.
+pxm.BeginBatchUpdate()
+sphere.ThetaResolution = 20
+pxm.EndBatchUpdate()
+expect(numberOfPoints(sphere) == 20 * 8 + 2, "Batch with a single state was not applied.")
+
+smp.Disconnect()
+print ("Test Passed")
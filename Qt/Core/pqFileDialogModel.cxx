@@ -19,6 +19,7 @@
 #include <vtkCollection.h>
 #include <vtkCollectionIterator.h>
 #include <vtkDirectory.h>
+#include <vtkNew.h>
 #include <vtkPVFileInformation.h>
 #include <vtkPVFileInformationHelper.h>
 #include <vtkPVSession.h>
@@ -240,6 +241,9 @@ Q_GLOBAL_STATIC(pqFileDialogModelIconProvider, Icons);
 namespace
 {
 
+// Number of entries of remote directory listings fetched per request.
+constexpr int ListingPageSize = 10000;
+
 ///////////////////////////////////////////////////////////////////////
 // CaseInsensitiveSort
 
@@ -365,11 +369,43 @@ public:
       pqSMAdaptor::setElementProperty(helper->GetProperty("Path"), path.toUtf8());
       pqSMAdaptor::setElementProperty(helper->GetProperty("SpecialDirectories"), specialDirs);
       pqSMAdaptor::setElementProperty(helper->GetProperty("GroupFileSequences"), this->GroupFiles);
+      pqSMAdaptor::setElementProperty(helper->GetProperty("ContentsOffset"), 0);
+      pqSMAdaptor::setElementProperty(
+        helper->GetProperty("MaximumNumberOfContents"), dirListing ? ListingPageSize : 0);
       helper->UpdateVTKObjects();
 
       // get data from server
       this->FileInformation->Initialize();
       this->FileInformationHelperProxy->GatherInformation(this->FileInformation);
+
+      // fetch the rest of large listings page by page. The server caches the
+      // listing so the directory is not listed again for each page.
+      const int total = this->FileInformation->GetTotalNumberOfContents();
+      vtkCollection* contents = this->FileInformation->GetContents();
+      vtkNew<vtkPVFileInformation> page;
+      while (dirListing && contents->GetNumberOfItems() < total)
+      {
+        pqSMAdaptor::setElementProperty(
+          helper->GetProperty("ContentsOffset"), contents->GetNumberOfItems());
+        helper->UpdateVTKObjects();
+        page->Initialize();
+        helper->GatherInformation(page);
+        if (page->GetTotalNumberOfContents() != total ||
+          page->GetContents()->GetNumberOfItems() == 0)
+        {
+          // the directory changed in between, get the whole listing at once.
+          pqSMAdaptor::setElementProperty(helper->GetProperty("ContentsOffset"), 0);
+          pqSMAdaptor::setElementProperty(helper->GetProperty("MaximumNumberOfContents"), 0);
+          helper->UpdateVTKObjects();
+          this->FileInformation->Initialize();
+          helper->GatherInformation(this->FileInformation);
+          break;
+        }
+        for (int cc = 0; cc < page->GetContents()->GetNumberOfItems(); ++cc)
+        {
+          contents->AddItem(page->GetContents()->GetItemAsObject(cc));
+        }
+      }
     }
     else
     {
@@ -13,6 +13,7 @@
 #include "vtkPVProgressHandler.h"
 #include "vtkPVServerInformation.h"
 #include "vtkPVXMLElement.h"
+#include "vtkProcessModule.h"
 #include "vtkRemoteWriterHelper.h"
 #include "vtkRenderWindow.h"
 #include "vtkSMAnimationScene.h"
@@ -26,8 +27,11 @@
 #include "vtkSMTrace.h"
 #include "vtkSMViewLayoutProxy.h"
 #include "vtkSMViewProxy.h"
+#include "vtkThreadedCallbackQueue.h"
 
+#include <algorithm>
 #include <sstream>
+#include <vector>
 #include <vtksys/SystemTools.hxx>
 
 namespace vtkSMSaveAnimationProxyNS
@@ -65,7 +69,7 @@ public:
    * Get the vtkRemoteWriterHelper proxy.
    */
   vtkSmartPointer<vtkSMSourceProxy> GetRemoteWriterHelper(
-    vtkSMProxy* formatProxy, vtkTypeUInt32 location)
+    vtkSMProxy* formatProxy, vtkTypeUInt32 location, bool background = false)
   {
     assert(formatProxy);
     const auto pxm = formatProxy->GetSessionProxyManager();
@@ -73,7 +77,7 @@ public:
       vtkSMSourceProxy::SafeDownCast(pxm->NewProxy("misc", "RemoteWriterHelper")));
     vtkSMPropertyHelper(remoteWriter, "Writer").Set(formatProxy);
     vtkSMPropertyHelper(remoteWriter, "OutputDestination").Set(static_cast<int>(location));
-    vtkSMPropertyHelper(remoteWriter, "TryWritingInBackground").Set(0);
+    vtkSMPropertyHelper(remoteWriter, "TryWritingInBackground").Set(background ? 1 : 0);
     remoteWriter->UpdateVTKObjects();
     return remoteWriter;
   }
@@ -235,7 +239,10 @@ vtkStandardNewMacro(SceneImageWriterMovie);
 
 class SceneImageWriterImageSeries : public SceneImageWriter
 {
-  vtkSmartPointer<vtkSMSourceProxy> RemoteWriterHelper = nullptr;
+  // Used in turn to write the frames. There is more than one when writing in
+  // the background.
+  std::vector<vtkSmartPointer<vtkSMSourceProxy>> RemoteWriterHelpers;
+  size_t NextRemoteWriterHelper = 0;
 
 public:
   static SceneImageWriterImageSeries* New();
@@ -248,11 +255,38 @@ public:
   vtkGetStringMacro(SuffixFormat);
 
   /**
-   * Set format proxy
+   * Set format proxy. When `background` is true, images are encoded and
+   * written by the threads of the process module's callback queue while the
+   * next frames are updated and rendered. A copy of the format is used for each
+   * image in flight, one more than the number of threads so that a frame can
+   * be captured while the threads are busy. Once all the copies are in use, the
+   * next frame waits for its copy to be available, which bounds the number of
+   * images kept in memory.
    */
-  void SetFormatProxy(vtkSMProxy* formatProxy, vtkTypeUInt32 location)
+  void SetFormatProxy(vtkSMProxy* formatProxy, vtkTypeUInt32 location, bool background)
   {
-    this->RemoteWriterHelper = this->GetRemoteWriterHelper(formatProxy, location);
+    this->RemoteWriterHelpers.clear();
+    this->NextRemoteWriterHelper = 0;
+    this->RemoteWriterHelpers.push_back(
+      this->GetRemoteWriterHelper(formatProxy, location, background));
+    if (!background)
+    {
+      return;
+    }
+
+    const int numberOfThreads =
+      vtkProcessModule::GetProcessModule()->GetCallbackQueue()->GetNumberOfThreads();
+    const auto pxm = formatProxy->GetSessionProxyManager();
+    for (int cc = 0; cc < std::max(numberOfThreads, 1); ++cc)
+    {
+      auto otherFormatProxy = vtkSmartPointer<vtkSMProxy>::Take(
+        pxm->NewProxy(formatProxy->GetXMLGroup(), formatProxy->GetXMLName()));
+      otherFormatProxy->SetLocation(formatProxy->GetLocation());
+      otherFormatProxy->Copy(formatProxy);
+      otherFormatProxy->UpdateVTKObjects();
+      this->RemoteWriterHelpers.push_back(
+        this->GetRemoteWriterHelper(otherFormatProxy, location, background));
+    }
   }
 
 protected:
@@ -277,13 +311,8 @@ protected:
     double vtkNotUsed(time), vtkImageData* dataLeft, vtkImageData* dataRight) override
   {
     bool success = true;
-
-    const auto remoteWriterHelper = this->RemoteWriterHelper;
-    auto remoteWriterAlgorithm =
-      vtkAlgorithm::SafeDownCast(remoteWriterHelper->GetClientSideObject());
     assert(dataLeft);
     assert(this->SuffixFormat);
-    assert(remoteWriterAlgorithm);
 
     char buffer[1024];
     snprintf(buffer, 1024, this->SuffixFormat, this->Counter);
@@ -295,46 +324,73 @@ protected:
     if (dataRight)
     {
       // write right image.
-      const auto rFormat = vtkSMPropertyHelper(remoteWriterHelper, "Writer").GetAsProxy();
-      vtkSMPropertyHelper(rFormat, "FileName")
-        .Set(this->GetStereoFileName(filename, /*left=*/false).c_str());
-      rFormat->UpdateVTKObjects();
-      remoteWriterAlgorithm->SetInputDataObject(dataRight);
-      vtkSMPropertyHelper(remoteWriterHelper, "State").Set(vtkRemoteWriterHelper::WRITE);
-      remoteWriterHelper->UpdateVTKObjects();
-      remoteWriterHelper->UpdatePipeline();
-      success &= (remoteWriterAlgorithm->GetErrorCode() == vtkErrorCode::NoError);
+      success &= this->WriteImage(this->GetStereoFileName(filename, /*left=*/false), dataRight);
 
       // write left image.
-      const auto lFormat = vtkSMPropertyHelper(remoteWriterHelper, "Writer").GetAsProxy();
-      vtkSMPropertyHelper(lFormat, "FileName")
-        .Set(this->GetStereoFileName(filename, /*left=*/true).c_str());
-      lFormat->UpdateVTKObjects();
-      remoteWriterAlgorithm->SetInputDataObject(dataLeft);
-      vtkSMPropertyHelper(remoteWriterHelper, "State").Set(vtkRemoteWriterHelper::WRITE);
-      remoteWriterHelper->UpdateVTKObjects();
-      remoteWriterHelper->UpdatePipeline();
-      success &= (remoteWriterAlgorithm->GetErrorCode() == vtkErrorCode::NoError);
+      success &= this->WriteImage(this->GetStereoFileName(filename, /*left=*/true), dataLeft);
     }
     else
     {
       // write left image.
-      const auto lFormat = vtkSMPropertyHelper(remoteWriterHelper, "Writer").GetAsProxy();
-      vtkSMPropertyHelper(lFormat, "FileName").Set(filename.c_str());
-      lFormat->UpdateVTKObjects();
-      remoteWriterAlgorithm->SetInputDataObject(dataLeft);
-      vtkSMPropertyHelper(remoteWriterHelper, "State").Set(vtkRemoteWriterHelper::WRITE);
-      remoteWriterHelper->UpdateVTKObjects();
-      remoteWriterHelper->UpdatePipeline();
-      success &= (remoteWriterAlgorithm->GetErrorCode() == vtkErrorCode::NoError);
+      success &= this->WriteImage(filename, dataLeft);
     }
-    remoteWriterAlgorithm->SetInputDataObject(nullptr);
 
-    success &= remoteWriterAlgorithm->GetErrorCode() == vtkErrorCode::NoError;
     this->Counter += success ? this->Stride : 0;
     return success;
   }
 
+  bool SaveFinalize() override
+  {
+    // make sure all the images have been written before returning.
+    bool success = true;
+    if (this->RemoteWriterHelpers.size() > 1)
+    {
+      for (const auto& remoteWriterHelper : this->RemoteWriterHelpers)
+      {
+        success &= this->WaitForPendingWrite(remoteWriterHelper);
+      }
+    }
+    return this->Superclass::SaveFinalize() && success;
+  }
+
+  /**
+   * Wait for the image given to `remoteWriterHelper` to be written in the
+   * background and return false if it could not be written.
+   */
+  bool WaitForPendingWrite(vtkSMSourceProxy* remoteWriterHelper)
+  {
+    remoteWriterHelper->InvokeCommand("WaitForPendingWrite");
+    auto remoteWriterAlgorithm =
+      vtkAlgorithm::SafeDownCast(remoteWriterHelper->GetClientSideObject());
+    return remoteWriterAlgorithm->GetErrorCode() == vtkErrorCode::NoError;
+  }
+
+  bool WriteImage(const std::string& filename, vtkImageData* data)
+  {
+    const auto remoteWriterHelper = this->RemoteWriterHelpers[this->NextRemoteWriterHelper];
+    this->NextRemoteWriterHelper =
+      (this->NextRemoteWriterHelper + 1) % this->RemoteWriterHelpers.size();
+    auto remoteWriterAlgorithm =
+      vtkAlgorithm::SafeDownCast(remoteWriterHelper->GetClientSideObject());
+    assert(remoteWriterAlgorithm);
+
+    // the format may still be writing the last image given to this helper,
+    // whose failure is only known once it is done.
+    const bool success =
+      this->RemoteWriterHelpers.size() <= 1 || this->WaitForPendingWrite(remoteWriterHelper);
+    const auto format = vtkSMPropertyHelper(remoteWriterHelper, "Writer").GetAsProxy();
+    vtkSMPropertyHelper(format, "FileName").Set(filename.c_str());
+    format->UpdateVTKObjects();
+    remoteWriterAlgorithm->SetInputDataObject(data);
+    vtkSMPropertyHelper(remoteWriterHelper, "State").Set(vtkRemoteWriterHelper::WRITE);
+    remoteWriterHelper->UpdateVTKObjects();
+    remoteWriterHelper->UpdatePipeline();
+    remoteWriterAlgorithm->SetInputDataObject(nullptr);
+    // an image written in the background reports its failure once the helper
+    // has waited for it, when the helper is reused or in SaveFinalize.
+    return success && remoteWriterAlgorithm->GetErrorCode() == vtkErrorCode::NoError;
+  }
+
 private:
   SceneImageWriterImageSeries(const SceneImageWriterImageSeries&) = delete;
   void operator=(const SceneImageWriterImageSeries&) = delete;
@@ -499,7 +555,8 @@ bool vtkSMSaveAnimationProxy::WriteAnimationInternal(const char* filename, vtkTy
     vtkNew<vtkSMSaveAnimationProxyNS::SceneImageWriterImageSeries> realWriter;
     realWriter->SetSuffixFormat(vtkSMPropertyHelper(formatProxy, "SuffixFormat").GetAsString());
     realWriter->SetHelper(this);
-    realWriter->SetFormatProxy(formatProxy, location);
+    realWriter->SetFormatProxy(
+      formatProxy, location, vtkSMPropertyHelper(this, "SaveInBackground", true).GetAsInt() != 0);
     writer = realWriter;
   }
   else if (vtkGenericMovieWriter::SafeDownCast(formatObj))
@@ -42,6 +42,10 @@ canex2Display = Show(reader, renderView1)
 # Save animation images
 SaveAnimation(tempdir + "/SaveAnimation.png", ImageResolution=[600, 600])
 
+# Save them again without writing them in the background
+SaveAnimation(tempdir + "/SaveAnimationSerial.png", ImageResolution=[600, 600],
+        SaveInBackground=0)
+
 # Lets save stereo animation images (two eyes at the same time)
 SaveAnimation(tempdir + "/SaveAnimationStereo.png",
         ImageResolution=[600, 600], StereoMode="Both Eyes")
@@ -52,14 +56,23 @@ SaveAnimation(tempdir + "/SaveAnimationStereo.ogv",
 
 pm = servermanager.vtkProcessModule.GetProcessModule()
 if pm.GetPartitionId() == 0:
+    import os.path
     if not RegressionTest("SaveAnimation.0002.png", "SaveAnimation.png"):
         raise RuntimeError("Test failed (non-stereo)")
+    if not RegressionTest("SaveAnimationSerial.0002.png", "SaveAnimation.png"):
+        raise RuntimeError("Test failed (non-stereo, serial)")
+
+    import glob
+    numBackground = len(glob.glob(os.path.join(tempdir, "SaveAnimation.*.png")))
+    numSerial = len(glob.glob(os.path.join(tempdir, "SaveAnimationSerial.*.png")))
+    if numBackground == 0 or numBackground != numSerial:
+        raise RuntimeError("Frames are missing (%d written in the background, %d serially)" %
+                (numBackground, numSerial))
     if not RegressionTest("SaveAnimationStereo.0002_left.png", "SaveAnimation.png"):
         raise RuntimeError("Test failed (stereo: left-eye)")
     if not RegressionTest("SaveAnimationStereo.0002_right.png", "SaveAnimation_right.png"):
         raise RuntimeError("Test failed (stereo: right-eye)")
 
-    import os.path
     if not os.path.exists(os.path.join(tempdir, "SaveAnimationStereo_right.ogv")):
         raise RuntimeError("Missing video file (stereo: right-eye)")
     if not os.path.exists(os.path.join(tempdir, "SaveAnimationStereo_left.ogv")):
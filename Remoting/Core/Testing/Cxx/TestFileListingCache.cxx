@@ -0,0 +1,186 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+#include "vtkCollection.h"
+#include "vtkLogger.h"
+#include "vtkNew.h"
+#include "vtkPVFileInformation.h"
+#include "vtkPVFileInformationHelper.h"
+#include "vtkPVFileListingCache.h"
+#include "vtkSmartPointer.h"
+
+#include <vtksys/Directory.hxx>
+#include <vtksys/SystemTools.hxx>
+
+#include <string>
+
+namespace
+{
+vtkPVFileInformation* FindEntry(vtkPVFileInformation* info, const std::string& name)
+{
+  for (int cc = 0; cc < info->GetContents()->GetNumberOfItems(); ++cc)
+  {
+    auto child = vtkPVFileInformation::SafeDownCast(info->GetContents()->GetItemAsObject(cc));
+    if (name == child->GetName())
+    {
+      return child;
+    }
+  }
+  return nullptr;
+}
+
+int TestListing(const std::string& root, const std::string& cacheDir)
+{
+  const std::string dir = root + "/listing";
+  vtksys::SystemTools::MakeDirectory(dir + "/subdir");
+  for (int cc = 1; cc <= 5; ++cc)
+  {
+    vtksys::SystemTools::Touch(dir + "/foo" + std::to_string(cc) + ".png", true);
+  }
+  vtksys::SystemTools::Touch(dir + "/bar.txt", true);
+
+  // Make sure the listing starts after the last modification of the directory,
+  // otherwise it cannot be reused.
+  vtksys::SystemTools::Delay(1100);
+
+  vtkPVFileListingCache* cache = vtkPVFileListingCache::GetInstance();
+  cache->SetCacheDirectory(cacheDir);
+
+  vtkNew<vtkPVFileInformationHelper> helper;
+  helper->SetPath(dir.c_str());
+  helper->SetDirectoryListing(1);
+
+  vtkNew<vtkPVFileInformation> info;
+  info->CopyFromObject(helper);
+  if (info->GetContents()->GetNumberOfItems() != 3)
+  {
+    vtkLogF(ERROR, "Expected a group, a file and a directory.");
+    return EXIT_FAILURE;
+  }
+  if (info->GetTotalNumberOfContents() != 3)
+  {
+    vtkLogF(ERROR, "Wrong total number of contents.");
+    return EXIT_FAILURE;
+  }
+  vtkPVFileInformation* group = FindEntry(info, "foo..png");
+  if (!(group && group->GetType() == vtkPVFileInformation::FILE_GROUP))
+  {
+    vtkLogF(ERROR, "Missing file group.");
+    return EXIT_FAILURE;
+  }
+  if (group->GetContents()->GetNumberOfItems() != 5)
+  {
+    vtkLogF(ERROR, "Wrong number of files in the group.");
+    return EXIT_FAILURE;
+  }
+  vtkPVFileInformation* file = FindEntry(info, "bar.txt");
+  if (!(file && file->GetType() == vtkPVFileInformation::SINGLE_FILE))
+  {
+    vtkLogF(ERROR, "Missing file.");
+    return EXIT_FAILURE;
+  }
+  vtkPVFileInformation* subdir = FindEntry(info, "subdir");
+  if (!(subdir && subdir->GetType() == vtkPVFileInformation::DIRECTORY))
+  {
+    vtkLogF(ERROR, "Missing directory.");
+    return EXIT_FAILURE;
+  }
+
+  // The directory did not change: the cached listing is reused.
+  vtkNew<vtkPVFileInformation> info2;
+  info2->CopyFromObject(helper);
+  if (FindEntry(info2, "foo..png") != group)
+  {
+    vtkLogF(ERROR, "Cached listing was not reused.");
+    return EXIT_FAILURE;
+  }
+
+  // Listings can be requested page by page.
+  helper->SetContentsOffset(1);
+  helper->SetMaximumNumberOfContents(1);
+  info2->CopyFromObject(helper);
+  if (info2->GetContents()->GetNumberOfItems() != 1)
+  {
+    vtkLogF(ERROR, "Wrong page size.");
+    return EXIT_FAILURE;
+  }
+  if (info2->GetTotalNumberOfContents() != 3)
+  {
+    vtkLogF(ERROR, "Wrong total number of contents of a page.");
+    return EXIT_FAILURE;
+  }
+  if (info2->GetContents()->GetItemAsObject(0) != info->GetContents()->GetItemAsObject(1))
+  {
+    vtkLogF(ERROR, "Wrong page contents.");
+    return EXIT_FAILURE;
+  }
+  helper->SetContentsOffset(0);
+  helper->SetMaximumNumberOfContents(0);
+
+  // The following pages of a listing that started in the same second as the
+  // last modification of the directory come from that same listing.
+  vtksys::SystemTools::Touch(dir + "/baz.txt", true);
+  helper->SetMaximumNumberOfContents(2);
+  info2->CopyFromObject(helper);
+  vtkSmartPointer<vtkObject> secondEntry = info2->GetContents()->GetItemAsObject(1);
+  helper->SetContentsOffset(1);
+  helper->SetMaximumNumberOfContents(1);
+  info2->CopyFromObject(helper);
+  if (info2->GetTotalNumberOfContents() != 4 ||
+    info2->GetContents()->GetItemAsObject(0) != secondEntry)
+  {
+    vtkLogF(ERROR, "Following page was not served from the same listing.");
+    return EXIT_FAILURE;
+  }
+  vtksys::SystemTools::RemoveFile(dir + "/baz.txt");
+  helper->SetContentsOffset(0);
+  helper->SetMaximumNumberOfContents(0);
+
+  // The directory changed: the listing is refreshed.
+  vtksys::SystemTools::Touch(dir + "/foo6.png", true);
+  info2->CopyFromObject(helper);
+  group = FindEntry(info2, "foo..png");
+  if (!(group && group->GetContents()->GetNumberOfItems() == 6))
+  {
+    vtkLogF(ERROR, "Listing was not refreshed.");
+    return EXIT_FAILURE;
+  }
+
+  // Listings are persisted in the cache directory and read back from there.
+  vtksys::Directory cacheContents;
+  if (!(cacheContents.Load(cacheDir) && cacheContents.GetNumberOfFiles() > 2))
+  {
+    vtkLogF(ERROR, "Listing was not written to the cache directory.");
+    return EXIT_FAILURE;
+  }
+  cache->SetMaximumNumberOfListings(0);
+  cache->SetMaximumNumberOfListings(32);
+  info2->CopyFromObject(helper);
+  group = FindEntry(info2, "foo..png");
+  if (!(group && group->GetContents()->GetNumberOfItems() == 6))
+  {
+    vtkLogF(ERROR, "Wrong persisted listing.");
+    return EXIT_FAILURE;
+  }
+
+  cache->Clear();
+  cacheContents.Load(cacheDir);
+  if (cacheContents.GetNumberOfFiles() != 2)
+  {
+    vtkLogF(ERROR, "Persisted listings were not removed.");
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
+}
+
+int TestFileListingCache(int, char*[])
+{
+  const std::string root =
+    vtksys::SystemTools::GetCurrentWorkingDirectory() + "/TestFileListingCache";
+  vtksys::SystemTools::RemoveADirectory(root);
+  const int result = TestListing(root, root + "/cache");
+
+  vtkPVFileListingCache::GetInstance()->SetCacheDirectory(std::string());
+  vtksys::SystemTools::RemoveADirectory(root);
+  return result;
+}
@@ -9,6 +9,7 @@
 #include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPVFileInformationHelper.h"
+#include "vtkPVFileListingCache.h"
 #include "vtkProcessModule.h"
 #include "vtkResourceFileLocator.h"
 #include "vtkSmartPointer.h"
@@ -41,6 +42,8 @@
 #include <ctime>
 #include <set>
 #include <string>
+#include <unordered_map>
+#include <vector>
 #include <vtksys/Encoding.hxx>
 #include <vtksys/RegularExpression.hxx>
 #include <vtksys/SystemTools.hxx>
@@ -356,6 +359,7 @@ vtkPVFileInformation::vtkPVFileInformation()
   this->Hidden = false;
   this->Extension = nullptr;
   this->Size = 0;
+  this->TotalNumberOfContents = 0;
   this->GroupFileSequences = true;
   this->IncludeExamples = true;
 #ifdef _WIN32
@@ -457,7 +461,43 @@ void vtkPVFileInformation::CopyFromObject(vtkObject* object)
 
   if (this->IsDirectory(this->Type) && helper->GetDirectoryListing())
   {
-    this->FetchDirectoryListing();
+    this->FetchDirectoryListing(
+      helper->GetMaximumNumberOfContents() > 0 && helper->GetContentsOffset() > 0);
+    this->TotalNumberOfContents = this->Contents->GetNumberOfItems();
+    if (helper->GetMaximumNumberOfContents() > 0)
+    {
+      this->TrimContents(helper->GetContentsOffset(), helper->GetMaximumNumberOfContents());
+    }
+  }
+}
+
+//-----------------------------------------------------------------------------
+void vtkPVFileInformation::TrimContents(int offset, int count)
+{
+  const int numItems = this->Contents->GetNumberOfItems();
+  if (offset == 0 && count >= numItems)
+  {
+    return;
+  }
+
+  std::vector<vtkSmartPointer<vtkObject>> items;
+  items.reserve(static_cast<size_t>(std::max(0, std::min(count, numItems - offset))));
+  vtkSmartPointer<vtkCollectionIterator> iter;
+  iter.TakeReference(this->Contents->NewIterator());
+  int index = 0;
+  for (iter->InitTraversal(); !iter->IsDoneWithTraversal() && index < offset + count;
+       iter->GoToNextItem(), ++index)
+  {
+    if (index >= offset)
+    {
+      items.emplace_back(iter->GetCurrentObject());
+    }
+  }
+
+  this->Contents->RemoveAllItems();
+  for (const auto& item : items)
+  {
+    this->Contents->AddItem(item);
   }
 }
 
@@ -664,11 +704,69 @@ void vtkPVFileInformation::GetSpecialDirectories()
 //-----------------------------------------------------------------------------
 void vtkPVFileInformation::FetchDirectoryListing()
 {
+  this->FetchDirectoryListing(false);
+}
+
+//-----------------------------------------------------------------------------
+void vtkPVFileInformation::FetchDirectoryListing(bool nextPage)
+{
+  // The sizes and modification times of the entries change without changing
+  // the modification time of the directory, so detailed listings are not
+  // cached.
+  vtksys::SystemTools::Stat_t status;
+  if (this->ReadDetailedFileInformation ||
+    (this->Type != DIRECTORY && this->Type != DIRECTORY_LINK) ||
+    vtksys::SystemTools::Stat(this->FullPath, &status) != 0)
+  {
+#if defined(_WIN32)
+    this->FetchWindowsDirectoryListing();
+#else
+    this->FetchUnixDirectoryListing();
+#endif
+    return;
+  }
+
+  std::string key = this->FullPath;
+  key += this->GroupFileSequences ? "\ng1" : "\ng0";
+  key += this->FastFileTypeDetection ? "f1" : "f0";
+
+  vtkPVFileListingCache* cache = vtkPVFileListingCache::GetInstance();
+  bool upToDate = false;
+  vtkSmartPointer<vtkPVFileInformation> previous =
+    cache->GetListing(key, status.st_mtime, upToDate, nextPage);
+  if (previous && upToDate)
+  {
+    vtkSmartPointer<vtkCollectionIterator> iter;
+    iter.TakeReference(previous->Contents->NewIterator());
+    for (iter->InitTraversal(); !iter->IsDoneWithTraversal(); iter->GoToNextItem())
+    {
+      this->Contents->AddItem(iter->GetCurrentObject());
+    }
+    return;
+  }
+
+  // Record the time before listing: changes made while listing may not
+  // change the modification time of the directory.
+  const time_t listingTime = time(nullptr);
 #if defined(_WIN32)
   this->FetchWindowsDirectoryListing();
 #else
-  this->FetchUnixDirectoryListing();
+  this->FetchUnixDirectoryListing(previous);
 #endif
+
+  vtkNew<vtkPVFileInformation> listing;
+  listing->SetName(this->Name);
+  listing->SetFullPath(this->FullPath);
+  listing->Type = this->Type;
+  listing->Hidden = this->Hidden;
+  vtkSmartPointer<vtkCollectionIterator> iter;
+  iter.TakeReference(this->Contents->NewIterator());
+  for (iter->InitTraversal(); !iter->IsDoneWithTraversal(); iter->GoToNextItem())
+  {
+    listing->Contents->AddItem(iter->GetCurrentObject());
+  }
+  listing->TotalNumberOfContents = listing->Contents->GetNumberOfItems();
+  cache->AddListing(key, status.st_mtime, listingTime, listing);
 }
 
 //-----------------------------------------------------------------------------
@@ -868,12 +966,39 @@ support and glibc/Linux system headers:
 #endif
 
 //-----------------------------------------------------------------------------
-void vtkPVFileInformation::FetchUnixDirectoryListing()
+void vtkPVFileInformation::FetchUnixDirectoryListing(vtkPVFileInformation* previous)
 {
 #if defined(_WIN32)
+  (void)previous;
   vtkErrorMacro("FetchUnixDirectoryListing() cannot be called on Windows systems.");
 #else
 
+  // Types of the entries of the previous listing, including the members of
+  // file groups.
+  std::unordered_map<std::string, int> previousTypes;
+  if (previous)
+  {
+    vtkSmartPointer<vtkCollectionIterator> iter;
+    iter.TakeReference(previous->Contents->NewIterator());
+    for (iter->InitTraversal(); !iter->IsDoneWithTraversal(); iter->GoToNextItem())
+    {
+      vtkPVFileInformation* obj = vtkPVFileInformation::SafeDownCast(iter->GetCurrentObject());
+      if (obj->IsGroup())
+      {
+        for (int cc = 0; cc < obj->Contents->GetNumberOfItems(); cc++)
+        {
+          vtkPVFileInformation* child =
+            vtkPVFileInformation::SafeDownCast(obj->Contents->GetItemAsObject(cc));
+          previousTypes[child->Name] = child->Type;
+        }
+      }
+      else
+      {
+        previousTypes[obj->Name] = obj->Type;
+      }
+    }
+  }
+
   vtkPVFileInformationSet info_set;
   std::string prefix = this->FullPath;
   vtkPVFileInformationAddTerminatingSlash(prefix);
@@ -937,8 +1062,22 @@ void vtkPVFileInformation::FetchUnixDirectoryListing()
     {
       info->Type = DIRECTORY;
     }
+    else if (d->d_type == DT_REG)
+    {
+      // No need to stat regular files to detect their type.
+      info->Type = SINGLE_FILE;
+    }
 #endif
 
+    if (info->Type == INVALID && !previousTypes.empty())
+    {
+      auto previousType = previousTypes.find(d->d_name);
+      if (previousType != previousTypes.end())
+      {
+        info->Type = previousType->second;
+      }
+    }
+
     info->FastFileTypeDetection = this->FastFileTypeDetection;
     info_set.insert(info);
     info->Delete();
@@ -1047,7 +1186,9 @@ struct vtkPVFileInformation::vtkInfo
 //-----------------------------------------------------------------------------
 void vtkPVFileInformation::OrganizeCollection(vtkPVFileInformationSet& info_set)
 {
-  typedef std::map<std::string, vtkInfo> MapOfStringToInfo;
+  // Groups are looked up once per entry, a hash map keeps the grouping linear
+  // in the number of entries.
+  typedef std::unordered_map<std::string, vtkInfo> MapOfStringToInfo;
   MapOfStringToInfo fileGroups;
 
   std::string prefix = this->FullPath;
@@ -1055,6 +1196,7 @@ void vtkPVFileInformation::OrganizeCollection(vtkPVFileInformationSet& info_set)
 
   if (this->GroupFileSequences)
   {
+    std::string key;
     for (vtkPVFileInformationSet::iterator iter = info_set.begin(); iter != info_set.end();)
     {
       vtkSmartPointer<vtkPVFileInformation> obj = *iter;
@@ -1067,22 +1209,21 @@ void vtkPVFileInformation::OrganizeCollection(vtkPVFileInformationSet& info_set)
       {
         if (this->SequenceParser->ParseFileSequence(obj->GetName()))
         {
-          const std::string groupName = this->SequenceParser->GetSequenceName();
-          std::string suffixString = this->SequenceParser->GetSequenceIndexString();
+          const char* groupName = this->SequenceParser->GetSequenceName();
           int sequenceIndex = this->SequenceParser->GetSequenceIndex();
 
           // since I want to keep file groups and directory groups separate, for
           // the key, I'm creating a new key by prefixing it with the group
           // type.
-          const std::string key_prefix(vtkPVFileInformation::IsDirectory(obj->Type) ? "d." : "f.");
-          const std::string key(key_prefix + groupName);
+          key.assign(vtkPVFileInformation::IsDirectory(obj->Type) ? "d." : "f.");
+          key.append(groupName);
 
           MapOfStringToInfo::iterator iter2 = fileGroups.find(key);
           if (iter2 == fileGroups.end())
           {
             vtkNew<vtkPVFileInformation> group;
             ;
-            group->SetName(groupName.c_str());
+            group->SetName(groupName);
             group->SetFullPath((prefix + groupName).c_str());
             group->Type =
               vtkPVFileInformation::IsDirectory(obj->Type) ? DIRECTORY_GROUP : FILE_GROUP;
@@ -1095,7 +1236,8 @@ void vtkPVFileInformation::OrganizeCollection(vtkPVFileInformationSet& info_set)
             iter2 = fileGroups.insert(std::pair<std::string, vtkInfo>(key, info)).first;
           }
 
-          iter2->second.Children[std::make_pair(sequenceIndex, suffixString)] = obj;
+          iter2->second.Children[std::make_pair(
+            sequenceIndex, this->SequenceParser->GetSequenceIndexString())] = obj;
 
           iter = info_set.erase(iter);
           continue; // needed to skip the ++iter, since we already incremented.
@@ -1138,7 +1280,7 @@ void vtkPVFileInformation::CopyToStream(vtkClientServerStream* stream)
 {
   *stream << vtkClientServerStream::Reply << this->Name << this->FullPath << this->Type
           << this->Hidden << this->Contents->GetNumberOfItems() << this->Extension << this->Size
-          << this->ModificationTime;
+          << this->ModificationTime << this->TotalNumberOfContents;
 
   vtkSmartPointer<vtkCollectionIterator> iter;
   iter.TakeReference(this->Contents->NewIterator());
@@ -1205,11 +1347,16 @@ void vtkPVFileInformation::CopyFromStream(const vtkClientServerStream* css)
     vtkErrorMacro("Error parsing File extension.");
     return;
   }
+  if (!css->GetArgument(0, 8, &this->TotalNumberOfContents))
+  {
+    vtkErrorMacro("Error parsing Total number of contents.");
+    return;
+  }
   for (int cc = 0; cc < num_of_children; cc++)
   {
     vtkPVFileInformation* child = vtkPVFileInformation::New();
     vtkClientServerStream childStream;
-    if (!css->GetArgument(0, 8 + cc, &childStream))
+    if (!css->GetArgument(0, 9 + cc, &childStream))
     {
       vtkErrorMacro("Error parsing child #" << cc);
       return;
@@ -1230,6 +1377,7 @@ void vtkPVFileInformation::Initialize()
   this->Contents->RemoveAllItems();
   this->SetExtension(nullptr);
   this->Size = 0;
+  this->TotalNumberOfContents = 0;
   this->GroupFileSequences = true;
 #ifdef _WIN32
   this->ModificationTime = _time64(nullptr);
@@ -1308,6 +1456,7 @@ void vtkPVFileInformation::PrintSelf(ostream& os, vtkIndent indent)
   }
   os << indent << "Hidden: " << this->Hidden << endl;
   os << indent << "FastFileTypeDetection: " << this->FastFileTypeDetection << endl;
+  os << indent << "TotalNumberOfContents: " << this->TotalNumberOfContents << endl;
 
   for (int cc = 0; cc < this->Contents->GetNumberOfItems(); cc++)
   {
@@ -8,8 +8,12 @@
  * vtkPVFileInformation can be used to collect information about file
  * or directory. vtkPVFileInformation can collect information
  * from a vtkPVFileInformationHelper object alone.
+ *
+ * Directory listings are cached in vtkPVFileListingCache and reused as long
+ * as the modification time of the directory does not change. When it does,
+ * only the types of the new entries are detected again.
  * @sa
- * vtkPVFileInformationHelper
+ * vtkPVFileInformationHelper vtkPVFileListingCache
  */
 
 #ifndef vtkPVFileInformation_h
@@ -151,6 +155,13 @@ public:
   vtkGetMacro(ModificationTime, time_t);
   ///@}
 
+  /**
+   * Returns the number of entries in the directory listing. This differs from
+   * the number of items in Contents when only a page of the listing was
+   * requested, see vtkPVFileInformationHelper::SetMaximumNumberOfContents().
+   */
+  vtkGetMacro(TotalNumberOfContents, int);
+
   /**
    * Fetch the directory listing to be able to use GetSize or GetContents with directories
    */
@@ -191,13 +202,25 @@ protected:
   char* Extension;         // File extension
   long long Size;          // File size
   time_t ModificationTime; // File modification time
+  int TotalNumberOfContents; // Number of entries in the directory listing
 
   vtkSetStringMacro(Extension);
   vtkSetStringMacro(Name);
   vtkSetStringMacro(FullPath);
 
   void FetchWindowsDirectoryListing();
-  void FetchUnixDirectoryListing();
+
+  // When `previous` is a former listing of the same directory, the types of
+  // the entries it contains are reused instead of being detected again.
+  void FetchUnixDirectoryListing(vtkPVFileInformation* previous = nullptr);
+
+  // Keeps only `count` items of Contents, starting at `offset`.
+  void TrimContents(int offset, int count);
+
+  // When `nextPage` is true, the cached listing is reused as long as the
+  // modification time of the directory did not change, even if the listing
+  // started in the same second, so that all pages come from the same listing.
+  void FetchDirectoryListing(bool nextPage);
 
   // Goes thru the collection of vtkPVFileInformation objects
   // are creates file groups, if possible.
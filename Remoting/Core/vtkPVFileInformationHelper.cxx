@@ -22,6 +22,8 @@ vtkPVFileInformationHelper::vtkPVFileInformationHelper()
   , FastFileTypeDetection(1)
   , GroupFileSequences(true)
   , ReadDetailedFileInformation(false)
+  , ContentsOffset(0)
+  , MaximumNumberOfContents(0)
   , PathSeparator(nullptr)
 {
   this->SetPath(".");
@@ -66,4 +68,6 @@ void vtkPVFileInformationHelper::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "PathSeparator: " << (this->PathSeparator ? this->PathSeparator : "(null)")
      << endl;
   os << indent << "FastFileTypeDetection: " << this->FastFileTypeDetection << endl;
+  os << indent << "ContentsOffset: " << this->ContentsOffset << endl;
+  os << indent << "MaximumNumberOfContents: " << this->MaximumNumberOfContents << endl;
 }
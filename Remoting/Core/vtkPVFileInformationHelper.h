@@ -137,6 +137,22 @@ public:
   vtkSetMacro(ReadDetailedFileInformation, bool);
   ///@}
 
+  ///@{
+  /**
+   * Get/Set the page of the directory listing to return. When
+   * MaximumNumberOfContents is greater than 0, only that many entries starting
+   * at ContentsOffset are returned, which avoids sending huge directories in a
+   * single message. Since listings are cached on the server, requesting the
+   * following pages does not list the directory again.
+   * vtkPVFileInformation::GetTotalNumberOfContents() gives the size of the
+   * whole listing. Defaults to 0 for both, i.e. the whole listing is returned.
+   */
+  vtkGetMacro(ContentsOffset, int);
+  vtkSetClampMacro(ContentsOffset, int, 0, VTK_INT_MAX);
+  vtkGetMacro(MaximumNumberOfContents, int);
+  vtkSetClampMacro(MaximumNumberOfContents, int, 0, VTK_INT_MAX);
+  ///@}
+
 protected:
   vtkPVFileInformationHelper();
   ~vtkPVFileInformationHelper() override;
@@ -150,6 +166,8 @@ protected:
   bool ExamplesInSpecialDirectories;
 
   bool ReadDetailedFileInformation;
+  int ContentsOffset;
+  int MaximumNumberOfContents;
   char* PathSeparator;
   vtkSetStringMacro(PathSeparator);
 
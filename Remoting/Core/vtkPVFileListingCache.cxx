@@ -0,0 +1,333 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+#include "vtkPVFileListingCache.h"
+
+#include "vtkClientServerStream.h"
+#include "vtkObjectFactory.h"
+#include "vtkPVFileInformation.h"
+#include "vtkType.h"
+
+#include <vtksys/Directory.hxx>
+#include <vtksys/FStream.hxx>
+#include <vtksys/SystemInformation.hxx>
+#include <vtksys/SystemTools.hxx>
+
+#include <atomic>
+#include <cstdio>
+#include <list>
+#include <unordered_map>
+#include <vector>
+
+namespace
+{
+const char vtkListingFileMagic[] = "vtkPVFileListingCache 1\n";
+const char vtkListingFileExtension[] = ".pvlisting";
+
+// FNV-1a, used to name the persisted listings. Unlike std::hash, it is stable
+// across runs and implementations.
+std::string vtkListingFileName(const std::string& key)
+{
+  vtkTypeUInt64 hash = 14695981039346656037ull;
+  for (unsigned char c : key)
+  {
+    hash = (hash ^ c) * 1099511628211ull;
+  }
+  char name[17];
+  snprintf(name, sizeof(name), "%016llx", static_cast<unsigned long long>(hash));
+  return std::string(name) + vtkListingFileExtension;
+}
+
+template <typename T>
+void vtkWriteValue(std::ostream& stream, T value)
+{
+  stream.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <typename T>
+bool vtkReadValue(std::istream& stream, T& value)
+{
+  return static_cast<bool>(stream.read(reinterpret_cast<char*>(&value), sizeof(T)));
+}
+}
+
+class vtkPVFileListingCache::vtkInternals
+{
+public:
+  struct Entry
+  {
+    std::string Key;
+    vtkTypeInt64 DirectoryMTime = 0;
+    vtkTypeInt64 ListingTime = 0;
+    vtkSmartPointer<vtkPVFileInformation> Listing;
+  };
+
+  // Most recently used first.
+  std::list<Entry> Entries;
+  std::unordered_map<std::string, std::list<Entry>::iterator> EntriesByKey;
+
+  void Touch(std::list<Entry>::iterator iter)
+  {
+    this->Entries.splice(this->Entries.begin(), this->Entries, iter);
+  }
+
+  void Trim(unsigned int maxEntries)
+  {
+    while (this->Entries.size() > maxEntries)
+    {
+      this->EntriesByKey.erase(this->Entries.back().Key);
+      this->Entries.pop_back();
+    }
+  }
+
+  static bool Write(const std::string& fname, const Entry& entry)
+  {
+    vtkClientServerStream stream;
+    entry.Listing->CopyToStream(&stream);
+    const unsigned char* data = nullptr;
+    size_t length = 0;
+    if (!stream.GetData(&data, &length))
+    {
+      return false;
+    }
+
+    // Write to a temporary file first so that concurrent readers never see a
+    // partially written listing. Its name is unique to this process and call
+    // so that concurrent writers do not write to the same file.
+    static std::atomic<unsigned int> counter(0);
+    const std::string tmpName = fname + "." +
+      std::to_string(vtksys::SystemInformation::GetProcessId()) + "." +
+      std::to_string(counter++) + ".tmp";
+    {
+      vtksys::ofstream file(tmpName.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+      if (!file)
+      {
+        return false;
+      }
+      file.write(vtkListingFileMagic, sizeof(vtkListingFileMagic) - 1);
+      vtkWriteValue<vtkTypeUInt64>(file, entry.Key.size());
+      file.write(entry.Key.data(), entry.Key.size());
+      vtkWriteValue(file, entry.DirectoryMTime);
+      vtkWriteValue(file, entry.ListingTime);
+      vtkWriteValue<vtkTypeUInt64>(file, length);
+      file.write(reinterpret_cast<const char*>(data), length);
+      if (!file)
+      {
+        file.close();
+        vtksys::SystemTools::RemoveFile(tmpName);
+        return false;
+      }
+    }
+    return vtksys::SystemTools::RenameFile(tmpName, fname).IsSuccess();
+  }
+
+  static bool Read(const std::string& fname, Entry& entry)
+  {
+    vtksys::ifstream file(fname.c_str(), std::ios::in | std::ios::binary);
+    if (!file)
+    {
+      return false;
+    }
+
+    char magic[sizeof(vtkListingFileMagic) - 1];
+    if (!file.read(magic, sizeof(magic)) ||
+      std::string(magic, sizeof(magic)) != std::string(vtkListingFileMagic, sizeof(magic)))
+    {
+      return false;
+    }
+
+    // The key is stored to detect collisions of the file names.
+    vtkTypeUInt64 keyLength = 0;
+    if (!vtkReadValue(file, keyLength) || keyLength != entry.Key.size())
+    {
+      return false;
+    }
+    std::string key(keyLength, '\0');
+    if (!file.read(&key[0], keyLength) || key != entry.Key)
+    {
+      return false;
+    }
+
+    vtkTypeUInt64 length = 0;
+    if (!vtkReadValue(file, entry.DirectoryMTime) || !vtkReadValue(file, entry.ListingTime) ||
+      !vtkReadValue(file, length))
+    {
+      return false;
+    }
+    std::vector<unsigned char> data(length);
+    if (!file.read(reinterpret_cast<char*>(data.data()), length))
+    {
+      return false;
+    }
+
+    vtkClientServerStream stream;
+    if (!stream.SetData(data.data(), data.size()))
+    {
+      return false;
+    }
+    entry.Listing = vtkSmartPointer<vtkPVFileInformation>::New();
+    entry.Listing->CopyFromStream(&stream);
+    return true;
+  }
+};
+
+vtkStandardNewMacro(vtkPVFileListingCache);
+//----------------------------------------------------------------------------
+vtkPVFileListingCache::vtkPVFileListingCache()
+  : MaximumNumberOfListings(32)
+  , Internals(new vtkPVFileListingCache::vtkInternals())
+{
+  if (const char* dir = vtksys::SystemTools::GetEnv("PARAVIEW_FILE_LISTING_CACHE_DIR"))
+  {
+    this->CacheDirectory = dir;
+  }
+}
+
+//----------------------------------------------------------------------------
+vtkPVFileListingCache::~vtkPVFileListingCache() = default;
+
+//----------------------------------------------------------------------------
+vtkPVFileListingCache* vtkPVFileListingCache::GetInstance()
+{
+  static vtkSmartPointer<vtkPVFileListingCache> Instance;
+  if (Instance.GetPointer() == nullptr)
+  {
+    vtkPVFileListingCache* cache = vtkPVFileListingCache::New();
+    Instance = cache;
+    cache->FastDelete();
+  }
+  return Instance;
+}
+
+//----------------------------------------------------------------------------
+void vtkPVFileListingCache::SetMaximumNumberOfListings(unsigned int count)
+{
+  if (this->MaximumNumberOfListings != count)
+  {
+    this->MaximumNumberOfListings = count;
+    this->Internals->Trim(count);
+    this->Modified();
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkPVFileListingCache::SetCacheDirectory(const std::string& directory)
+{
+  if (this->CacheDirectory != directory)
+  {
+    this->CacheDirectory = directory;
+    this->Modified();
+  }
+}
+
+//----------------------------------------------------------------------------
+vtkSmartPointer<vtkPVFileInformation> vtkPVFileListingCache::GetListing(
+  const std::string& key, time_t directoryMTime, bool& upToDate, bool sameListing)
+{
+  upToDate = false;
+  if (this->MaximumNumberOfListings == 0)
+  {
+    return nullptr;
+  }
+
+  auto& internals = *this->Internals;
+  auto iter = internals.EntriesByKey.find(key);
+  if (iter != internals.EntriesByKey.end())
+  {
+    internals.Touch(iter->second);
+  }
+  else if (!this->CacheDirectory.empty())
+  {
+    vtkInternals::Entry entry;
+    entry.Key = key;
+    if (!vtkInternals::Read(this->CacheDirectory + "/" + vtkListingFileName(key), entry))
+    {
+      return nullptr;
+    }
+    internals.Entries.push_front(std::move(entry));
+    iter = internals.EntriesByKey.emplace(key, internals.Entries.begin()).first;
+    internals.Trim(this->MaximumNumberOfListings);
+  }
+  else
+  {
+    return nullptr;
+  }
+
+  const auto& entry = *iter->second;
+  upToDate = entry.DirectoryMTime == static_cast<vtkTypeInt64>(directoryMTime) &&
+    (sameListing || entry.ListingTime > entry.DirectoryMTime);
+  return entry.Listing;
+}
+
+//----------------------------------------------------------------------------
+void vtkPVFileListingCache::AddListing(
+  const std::string& key, time_t directoryMTime, time_t listingTime, vtkPVFileInformation* listing)
+{
+  if (this->MaximumNumberOfListings == 0 || listing == nullptr)
+  {
+    return;
+  }
+
+  auto& internals = *this->Internals;
+  auto iter = internals.EntriesByKey.find(key);
+  if (iter == internals.EntriesByKey.end())
+  {
+    internals.Entries.emplace_front();
+    iter = internals.EntriesByKey.emplace(key, internals.Entries.begin()).first;
+  }
+  else
+  {
+    internals.Touch(iter->second);
+  }
+
+  auto& entry = *iter->second;
+  entry.Key = key;
+  entry.DirectoryMTime = static_cast<vtkTypeInt64>(directoryMTime);
+  entry.ListingTime = static_cast<vtkTypeInt64>(listingTime);
+  entry.Listing = listing;
+
+  if (!this->CacheDirectory.empty() &&
+    (vtksys::SystemTools::FileIsDirectory(this->CacheDirectory) ||
+      vtksys::SystemTools::MakeDirectory(this->CacheDirectory).IsSuccess()))
+  {
+    if (!vtkInternals::Write(this->CacheDirectory + "/" + vtkListingFileName(key), entry))
+    {
+      vtkWarningMacro(
+        "Failed to write the listing of '" << key << "' to '" << this->CacheDirectory << "'.");
+    }
+  }
+
+  internals.Trim(this->MaximumNumberOfListings);
+}
+
+//----------------------------------------------------------------------------
+void vtkPVFileListingCache::Clear()
+{
+  auto& internals = *this->Internals;
+  internals.Entries.clear();
+  internals.EntriesByKey.clear();
+
+  if (!this->CacheDirectory.empty() && vtksys::SystemTools::FileIsDirectory(this->CacheDirectory))
+  {
+    vtksys::Directory dir;
+    if (dir.Load(this->CacheDirectory))
+    {
+      for (unsigned long cc = 0; cc < dir.GetNumberOfFiles(); ++cc)
+      {
+        const std::string fname = dir.GetFile(cc);
+        if (vtksys::SystemTools::GetFilenameLastExtension(fname) == vtkListingFileExtension)
+        {
+          vtksys::SystemTools::RemoveFile(this->CacheDirectory + "/" + fname);
+        }
+      }
+    }
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkPVFileListingCache::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "MaximumNumberOfListings: " << this->MaximumNumberOfListings << endl;
+  os << indent << "CacheDirectory: " << this->CacheDirectory << endl;
+  os << indent << "NumberOfListings: " << this->Internals->Entries.size() << endl;
+}
@@ -0,0 +1,113 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+/**
+ * @class   vtkPVFileListingCache
+ * @brief   process-wide cache of directory listings.
+ *
+ * vtkPVFileListingCache is a singleton used by vtkPVFileInformation to avoid
+ * listing a directory, detecting the types of its entries and grouping file
+ * sequences again when the directory did not change. Listings are keyed on the
+ * path of the directory and the options used to build them, and are
+ * considered up to date as long as the modification time of the directory
+ * did not change.
+ *
+ * A directory whose modification time is not older than the time its listing
+ * started may be modified again within the same second without its
+ * modification time changing. Such listings are never reported as up to date
+ * but are still returned, so that vtkPVFileInformation can refresh them
+ * incrementally, i.e. only detect the types of entries it did not know about.
+ *
+ * The most recently used listings are kept in memory. When CacheDirectory is
+ * set, listings are also written to that directory and read back when they are
+ * not in memory, e.g. after the server is restarted. CacheDirectory is
+ * initialized from the `PARAVIEW_FILE_LISTING_CACHE_DIR` environment variable.
+ *
+ * @sa vtkPVFileInformation
+ */
+
+#ifndef vtkPVFileListingCache_h
+#define vtkPVFileListingCache_h
+
+#include "vtkObject.h"
+#include "vtkRemotingCoreModule.h" // needed for exports
+#include "vtkSmartPointer.h"       // needed for vtkSmartPointer
+
+#include <ctime>  // for time_t
+#include <memory> // for std::unique_ptr
+#include <string> // for std::string
+
+class vtkPVFileInformation;
+
+class VTKREMOTINGCORE_EXPORT vtkPVFileListingCache : public vtkObject
+{
+public:
+  static vtkPVFileListingCache* New();
+  vtkTypeMacro(vtkPVFileListingCache, vtkObject);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  /**
+   * Provides access to the singleton. This will create the
+   * vtkPVFileListingCache singleton the first time this method is called.
+   */
+  static vtkPVFileListingCache* GetInstance();
+
+  ///@{
+  /**
+   * Get/Set the maximum number of listings kept in memory. The least recently
+   * used listings are released first. 0 disables the cache. Default is 32.
+   */
+  void SetMaximumNumberOfListings(unsigned int count);
+  vtkGetMacro(MaximumNumberOfListings, unsigned int);
+  ///@}
+
+  ///@{
+  /**
+   * Get/Set the directory where listings are persisted. Empty (default unless
+   * `PARAVIEW_FILE_LISTING_CACHE_DIR` is set) keeps listings in memory only.
+   */
+  void SetCacheDirectory(const std::string& directory);
+  const std::string& GetCacheDirectory() const { return this->CacheDirectory; }
+  ///@}
+
+  /**
+   * Returns the last listing stored for `key`, or nullptr if none. `upToDate`
+   * is set to true if the listing can be used as is for a directory whose
+   * modification time is `directoryMTime`. When `sameListing` is true, the
+   * listing is reported as up to date whenever the modification time did not
+   * change, even if the listing started in the same second. This is used to
+   * return the following pages of a listing without listing the directory
+   * again.
+   */
+  vtkSmartPointer<vtkPVFileInformation> GetListing(
+    const std::string& key, time_t directoryMTime, bool& upToDate, bool sameListing = false);
+
+  /**
+   * Stores the listing of a directory. `directoryMTime` is the modification
+   * time of the directory and `listingTime` the time at which listing it
+   * started. The listing must not be modified afterwards.
+   */
+  void AddListing(const std::string& key, time_t directoryMTime, time_t listingTime,
+    vtkPVFileInformation* listing);
+
+  /**
+   * Releases all listings kept in memory and removes the listings persisted in
+   * CacheDirectory.
+   */
+  void Clear();
+
+protected:
+  vtkPVFileListingCache();
+  ~vtkPVFileListingCache() override;
+
+  unsigned int MaximumNumberOfListings;
+  std::string CacheDirectory;
+
+private:
+  vtkPVFileListingCache(const vtkPVFileListingCache&) = delete;
+  void operator=(const vtkPVFileListingCache&) = delete;
+
+  class vtkInternals;
+  std::unique_ptr<vtkInternals> Internals;
+};
+
+#endif
@@ -3,9 +3,10 @@
 #include "vtkPVPluginLoader.h"
 
 #include "vtkDynamicLoader.h"
+#include "vtkMultiProcessController.h"
+#include "vtkMultiProcessStream.h"
 #include "vtkNew.h"
 #include "vtkObjectFactory.h"
-#include "vtkPDirectory.h"
 #include "vtkPVLogger.h"
 #include "vtkPVPlugin.h"
 #include "vtkPVPluginTracker.h"
@@ -14,6 +15,7 @@
 #include "vtkPVXMLParser.h"
 #include "vtkProcessModule.h"
 
+#include "vtksys/Directory.hxx"
 #include "vtksys/FStream.hxx"
 #include "vtksys/SystemTools.hxx"
 
@@ -22,6 +24,7 @@
 #include <memory>
 #include <sstream>
 #include <string>
+#include <utility>
 #include <vector>
 
 #define vtkPVPluginLoaderErrorMacro(x)                                                             \
@@ -43,6 +46,88 @@ const char ENV_PATH_SEP = ':';
 
 namespace
 {
+// Reads the whole file in `contents`. Returns false if the file could not be read.
+bool vtkReadFile(const std::string& filename, std::string& contents)
+{
+  vtksys::ifstream is(filename.c_str(), ios::in | ios::binary);
+  if (!is)
+  {
+    return false;
+  }
+  contents.assign(std::istreambuf_iterator<char>(is), std::istreambuf_iterator<char>());
+  return !is.bad();
+}
+
+// A plugin found while scanning the search paths. `XML` holds the contents of
+// XML-only plugins so that they need not be read again on every rank.
+struct vtkPluginCandidate
+{
+  std::string FileName;
+  bool HasXML = false;
+  std::string XML;
+};
+
+// Lists the plugin candidates in a directory without any inter-process
+// communication.
+void vtkFindPluginCandidates(const std::string& path, std::vector<vtkPluginCandidate>& candidates)
+{
+  vtksys::Directory dir;
+  if (path.empty() || !dir.Load(path))
+  {
+    vtkVLogIfF(PARAVIEW_LOG_PLUGIN_VERBOSITY(), !path.empty(), "Invalid directory: %s",
+      path.c_str());
+    return;
+  }
+
+#ifdef _WIN32
+  const char* compiled_extension = ".dll";
+#else
+  const char* compiled_extension = ".so";
+#endif
+
+  for (unsigned long cc = 0; cc < dir.GetNumberOfFiles(); cc++)
+  {
+    const std::string file = dir.GetFile(cc);
+    if (file == "." || file == "..")
+    {
+      continue;
+    }
+
+    const std::string dir_file = std::string(dir.GetPath()) + '/' + file;
+    std::string full_file;
+
+    // If we have a directory, search it for a plugin of the same name.
+    if (vtksys::SystemTools::FileIsDirectory(dir_file))
+    {
+      full_file = dir_file + '/' + file + compiled_extension;
+      // Check if it exists and is a file.
+      if (!vtksys::SystemTools::FileExists(full_file, true))
+      {
+        continue;
+      }
+    }
+    else
+    {
+      // We have a file, check to see if its extension is acceptable.
+      std::string ext = vtksys::SystemTools::GetFilenameLastExtension(file);
+      if (ext != compiled_extension && ext != ".xml" && ext != ".sl" && ext != ".py")
+      {
+        // No extension, not a plugin.
+        continue;
+      }
+      full_file = dir_file;
+    }
+
+    vtkPluginCandidate candidate;
+    candidate.FileName = full_file;
+    if (vtksys::SystemTools::GetFilenameLastExtension(full_file) == ".xml")
+    {
+      candidate.HasXML = vtkReadFile(full_file, candidate.XML);
+    }
+    candidates.push_back(std::move(candidate));
+  }
+}
+
 // This is an helper class used for plugins constructed from XMLs.
 class vtkPVXMLOnlyPlugin
   : public vtkPVPlugin
@@ -55,34 +140,27 @@ class vtkPVXMLOnlyPlugin
   void operator=(const vtkPVXMLOnlyPlugin& other);
 
 public:
-  static vtkPVXMLOnlyPlugin* Create(const char* xmlfile)
+  static vtkPVXMLOnlyPlugin* Create(const char* xmlfile, const char* xmlcontents = nullptr)
   {
+    std::string xml;
+    if (xmlcontents)
+    {
+      xml = xmlcontents;
+    }
+    else if (!vtkReadFile(xmlfile, xml))
+    {
+      return nullptr;
+    }
+
     vtkNew<vtkPVXMLParser> parser;
-    parser->SetFileName(xmlfile);
-    if (!parser->Parse())
+    if (!parser->Parse(xml.c_str()))
     {
       return nullptr;
     }
 
     vtkPVXMLOnlyPlugin* instance = new vtkPVXMLOnlyPlugin();
     instance->PluginName = vtksys::SystemTools::GetFilenameWithoutExtension(xmlfile);
-
-    vtksys::ifstream is;
-    is.open(xmlfile, ios::binary);
-    // get length of file:
-    is.seekg(0, ios::end);
-    size_t length = is.tellg();
-    is.seekg(0, ios::beg);
-
-    // allocate memory:
-    char* buffer = new char[length + 1];
-
-    // read data as a block:
-    is.read(buffer, length);
-    is.close();
-    buffer[length] = 0;
-    instance->XML = buffer;
-    delete[] buffer;
+    instance->XML = std::move(xml);
     return instance;
   }
 
@@ -289,15 +367,14 @@ void vtkPVPluginLoader::LoadPluginsFromPluginSearchPath()
 
   std::vector<std::string> paths;
   vtksys::SystemTools::Split(this->SearchPaths, paths, ENV_PATH_SEP);
+  std::vector<std::string> directories;
   for (size_t cc = 0; cc < paths.size(); cc++)
   {
     std::vector<std::string> subpaths;
     vtksys::SystemTools::Split(paths[cc], subpaths, ';');
-    for (size_t scc = 0; scc < subpaths.size(); scc++)
-    {
-      this->LoadPluginsFromPath(subpaths[scc].c_str());
-    }
+    directories.insert(directories.end(), subpaths.begin(), subpaths.end());
   }
+  this->LoadPluginsFromPaths(directories);
 #else
   vtkVLogF(PARAVIEW_LOG_PLUGIN_VERBOSITY(), "Static build. Skipping PLUGIN_PATHS.");
 #endif
@@ -332,66 +409,66 @@ void vtkPVPluginLoader::LoadPluginsFromPluginConfigFile()
 void vtkPVPluginLoader::LoadPluginsFromPath(const char* path)
 {
   vtkVLogIfF(PARAVIEW_LOG_PLUGIN_VERBOSITY(), path != nullptr, "Loading plugins in Path: %s", path);
-
-  vtkNew<vtkPDirectory> dir;
-  if (dir->Load(path) == false)
+  if (path != nullptr)
   {
-    vtkVLogIfF(PARAVIEW_LOG_PLUGIN_VERBOSITY(), path != nullptr, "Invalid directory: %s", path);
-    return;
+    this->LoadPluginsFromPaths(std::vector<std::string>{ path });
   }
+}
 
-#ifdef _WIN32
-  const char* compiled_extension = ".dll";
-#else
-  const char* compiled_extension = ".so";
-#endif
-
-  for (vtkIdType cc = 0; cc < dir->GetNumberOfFiles(); cc++)
+//-----------------------------------------------------------------------------
+void vtkPVPluginLoader::LoadPluginsFromPaths(const std::vector<std::string>& paths)
+{
+  vtkMultiProcessController* controller = vtkMultiProcessController::GetGlobalController();
+  const bool parallel = (controller != nullptr && controller->GetNumberOfProcesses() > 1);
+  const int myRank = parallel ? controller->GetLocalProcessId() : 0;
+
+  // Only the root scans the directories and reads the XML-only plugins. With
+  // thousands of ranks, letting each rank do it floods the shared file system
+  // with metadata requests.
+  std::vector<vtkPluginCandidate> candidates;
+  if (myRank == 0)
   {
-    const char* file = dir->GetFile(cc);
-    std::string rel_path;
-    bool has_valid_extension;
-    bool assume_exists = false;
-
-    // If we have a directory, search it for a plugin of the same name.
-    if (dir->FileIsDirectory(file))
+    for (const auto& path : paths)
     {
-      rel_path = file;
-      rel_path += '/';
-      rel_path += file;
-      rel_path += compiled_extension;
-      has_valid_extension = true;
-    }
-    else
-    {
-      // We have a file, check to see if its extension is acceptable.
-      rel_path = file;
-      std::string ext = vtksys::SystemTools::GetFilenameLastExtension(rel_path);
-      has_valid_extension =
-        (ext == compiled_extension || ext == ".xml" || ext == ".sl" || ext == ".py");
-      assume_exists = true;
+      ::vtkFindPluginCandidates(path, candidates);
     }
+  }
 
-    // No extension, not a plugin.
-    if (!has_valid_extension)
+  if (parallel)
+  {
+    vtkMultiProcessStream stream;
+    if (myRank == 0)
     {
-      continue;
+      stream << static_cast<unsigned int>(candidates.size());
+      for (const auto& candidate : candidates)
+      {
+        stream << candidate.FileName << candidate.HasXML << candidate.XML;
+      }
     }
-
-    // Calculate the full path to the plugin.
-    std::string full_file = dir->GetPath();
-    full_file += '/';
-    full_file += rel_path;
-
-    // Check if it exists and is a file.
-    if (!assume_exists && !vtksys::SystemTools::FileExists(full_file, true))
+    controller->Broadcast(stream, 0);
+    if (myRank > 0)
     {
-      continue;
+      unsigned int count = 0;
+      stream >> count;
+      candidates.resize(count);
+      for (auto& candidate : candidates)
+      {
+        stream >> candidate.FileName >> candidate.HasXML >> candidate.XML;
+      }
+      vtkVLogF(PARAVIEW_LOG_PLUGIN_VERBOSITY(), "received %u plugin candidates from rank 0",
+        count);
     }
+  }
 
-    // Load the plugin.
-    this->LoadPluginSilently(full_file.c_str());
+  vtkPVPluginTracker* tracker = vtkPVPluginTracker::GetInstance();
+  tracker->BeginBatch();
+  for (const auto& candidate : candidates)
+  {
+    // Load the plugin. Shared libraries are still opened by each rank.
+    this->LoadPluginInternal(
+      candidate.FileName.c_str(), true, candidate.HasXML ? candidate.XML.c_str() : nullptr);
   }
+  tracker->EndBatch();
 }
 
 //-----------------------------------------------------------------------------
@@ -431,7 +508,8 @@ bool vtkPVPluginLoader::LoadPluginByName(const char* name)
 }
 
 //-----------------------------------------------------------------------------
-bool vtkPVPluginLoader::LoadPluginInternal(const char* file, bool no_errors)
+bool vtkPVPluginLoader::LoadPluginInternal(
+  const char* file, bool no_errors, const char* xmlcontents)
 {
   this->Loaded = false;
   if (!file || file[0] == '\0')
@@ -486,7 +564,7 @@ bool vtkPVPluginLoader::LoadPluginInternal(const char* file, bool no_errors)
   if (vtksys::SystemTools::GetFilenameLastExtension(file) == ".xml")
   {
     vtkVLogF(PARAVIEW_LOG_PLUGIN_VERBOSITY(), "Loading XML plugin.");
-    vtkPVXMLOnlyPlugin* plugin = vtkPVXMLOnlyPlugin::Create(file);
+    vtkPVXMLOnlyPlugin* plugin = vtkPVXMLOnlyPlugin::Create(file, xmlcontents);
     if (plugin)
     {
       vtkPVPluginLoaderCleaner::GetInstance()->Register(plugin);
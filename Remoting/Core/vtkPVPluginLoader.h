@@ -24,6 +24,8 @@
 #include "vtkRemotingCoreModule.h" //needed for exports
 
 #include <functional> // for std::function
+#include <string>     // for std::string
+#include <vector>     // for std::vector
 
 class vtkPVPlugin;
 
@@ -54,6 +56,7 @@ public:
 
   /**
    * Loads all plugins under the directories mentioned in the SearchPaths.
+   * This is a collective operation in parallel, see LoadPluginsFromPath.
    */
   void LoadPluginsFromPluginSearchPath();
 
@@ -76,6 +79,10 @@ public:
 
   /**
    * Loads all plugin libraries at a path.
+   *
+   * When running in parallel, this must be called on all ranks of the global
+   * controller: only the root rank scans the directory and reads XML plugins,
+   * the other ranks receive the list of plugins and merely load the libraries.
    */
   void LoadPluginsFromPath(const char* path);
 
@@ -146,7 +153,18 @@ protected:
   vtkPVPluginLoader();
   ~vtkPVPluginLoader() override;
 
-  bool LoadPluginInternal(const char* filename, bool no_errors);
+  /**
+   * Loads the plugin from `filename`. For XML-only plugins, `xmlcontents` may
+   * be used to provide the already read contents of the file.
+   */
+  bool LoadPluginInternal(
+    const char* filename, bool no_errors, const char* xmlcontents = nullptr);
+
+  /**
+   * Loads the plugins found in all the `paths` directories, scanning them on
+   * the root rank only.
+   */
+  void LoadPluginsFromPaths(const std::vector<std::string>& paths);
 
   /**
    * Called by LoadPluginInternal() to do the final steps in loading of a
@@ -4,6 +4,8 @@
 
 #include "vtkClientServerInterpreterInitializer.h"
 #include "vtkCommand.h"
+#include "vtkMultiProcessController.h"
+#include "vtkMultiProcessStream.h"
 #include "vtkObjectFactory.h"
 #include "vtkPResourceFileLocator.h"
 #include "vtkPSystemTools.h"
@@ -24,6 +26,7 @@
 #include "vtksys/SystemTools.hxx"
 
 #include <cassert>
+#include <iterator>
 #include <sstream>
 #include <string>
 #include <vector>
@@ -87,6 +90,46 @@ std::vector<std::string> tokenize(const std::string& input, char delimiter)
   return tokens;
 }
 
+/**
+ * Reads a file on the root rank and shares its contents with all other ranks,
+ * so that satellites never touch the file system. This is a collective
+ * operation when running in parallel. Returns false if the file is missing or
+ * could not be read.
+ */
+bool vtkReadFileOnRoot(const std::string& filename, std::string& contents)
+{
+  vtkMultiProcessController* controller = vtkMultiProcessController::GetGlobalController();
+  const bool parallel = (controller != nullptr && controller->GetNumberOfProcesses() > 1);
+  const int myRank = parallel ? controller->GetLocalProcessId() : 0;
+
+  bool success = false;
+  contents.clear();
+  if (myRank == 0 && vtksys::SystemTools::FileExists(filename, true))
+  {
+    vtksys::ifstream is(filename.c_str(), ios::in | ios::binary);
+    if (is)
+    {
+      contents.assign(std::istreambuf_iterator<char>(is), std::istreambuf_iterator<char>());
+      success = !is.bad();
+    }
+  }
+
+  if (parallel)
+  {
+    vtkMultiProcessStream stream;
+    if (myRank == 0)
+    {
+      stream << success << contents;
+    }
+    controller->Broadcast(stream, 0);
+    if (myRank > 0)
+    {
+      stream >> success >> contents;
+    }
+  }
+  return success;
+}
+
 /**
  * Locate a plugin library or a config file anchored at standard locations
  * for locating plugins.
@@ -287,9 +330,10 @@ void vtkPVPluginTracker::LoadPluginConfigurationXMLs(const char* appname)
     // Try it as a bundle.
     {
       auto conf = exe_dir + "/../Resources/" + appname + ".conf";
-      if (vtksys::SystemTools::FileExists(conf))
+      std::string contents;
+      if (::vtkReadFileOnRoot(conf, contents))
       {
-        this->LoadPluginConfigurationXMLConf(exe_dir, conf);
+        this->LoadPluginConfigurationXMLConf(exe_dir, contents);
         return;
       }
     }
@@ -297,9 +341,10 @@ void vtkPVPluginTracker::LoadPluginConfigurationXMLs(const char* appname)
     // Load it from beside the executable.
     {
       auto conf = exe_dir + "/" + appname + ".conf";
-      if (vtksys::SystemTools::FileExists(conf))
+      std::string contents;
+      if (::vtkReadFileOnRoot(conf, contents))
       {
-        this->LoadPluginConfigurationXMLConf(exe_dir, conf);
+        this->LoadPluginConfigurationXMLConf(exe_dir, contents);
         return;
       }
     }
@@ -329,9 +374,9 @@ void vtkPVPluginTracker::LoadPluginConfigurationXMLs(const char* appname)
 
 //----------------------------------------------------------------------------
 void vtkPVPluginTracker::LoadPluginConfigurationXMLConf(
-  std::string const& exe_dir, std::string const& conf)
+  std::string const& exe_dir, std::string const& contents)
 {
-  vtksys::ifstream fin(conf.c_str());
+  std::istringstream fin(contents);
   std::string line;
   // TODO: Replace with a JSON parser.
   while (std::getline(fin, line))
@@ -348,7 +393,9 @@ void vtkPVPluginTracker::LoadPluginConfigurationXMLConf(
 //----------------------------------------------------------------------------
 void vtkPVPluginTracker::LoadPluginConfigurationXML(const char* filename, bool forceLoad)
 {
-  if (!vtkPSystemTools::FileExists(filename, true))
+  // Only the root reads the file, the contents are broadcast to all ranks.
+  std::string contents;
+  if (!::vtkReadFileOnRoot(filename, contents))
   {
     vtkVLogF(PARAVIEW_LOG_PLUGIN_VERBOSITY(),
       "Loading plugin configuration xml `%s` -- failed, not found!", filename);
@@ -356,9 +403,8 @@ void vtkPVPluginTracker::LoadPluginConfigurationXML(const char* filename, bool f
   }
 
   vtkSmartPointer<vtkPVXMLParser> parser = vtkSmartPointer<vtkPVXMLParser>::New();
-  parser->SetFileName(filename);
   parser->SuppressErrorMessagesOn();
-  if (!parser->Parse())
+  if (!parser->Parse(contents.c_str()))
   {
     vtkVLogF(PARAVIEW_LOG_PLUGIN_VERBOSITY(),
       "Loading plugin configuration xml `%s` -- failed, invalid XML!", filename);
@@ -406,6 +452,7 @@ void vtkPVPluginTracker::LoadPluginConfigurationXMLHinted(
     return;
   }
 
+  this->BeginBatch();
   for (unsigned int cc = 0; cc < root->GetNumberOfNestedElements(); cc++)
   {
     vtkPVXMLElement* child = root->GetNestedElement(cc);
@@ -483,6 +530,23 @@ void vtkPVPluginTracker::LoadPluginConfigurationXMLHinted(
       (*this->PluginsList)[index].AutoLoad = (auto_load != 0);
     }
   }
+  this->EndBatch();
+}
+
+//----------------------------------------------------------------------------
+void vtkPVPluginTracker::BeginBatch()
+{
+  ++this->BatchDepth;
+}
+
+//----------------------------------------------------------------------------
+void vtkPVPluginTracker::EndBatch()
+{
+  assert(this->BatchDepth > 0);
+  if (--this->BatchDepth == 0)
+  {
+    this->InvokeEvent(vtkPVPluginTracker::RegisterBatchEndEvent);
+  }
 }
 
 //----------------------------------------------------------------------------
@@ -54,6 +54,21 @@ public:
    */
   void RegisterPlugin(vtkPVPlugin*);
 
+  ///@{
+  /**
+   * Plugins loaded together, such as the auto-loaded plugins of a
+   * configuration xml or the plugins found in the search paths, are loaded
+   * between BeginBatch() and EndBatch(). vtkCommand::RegisterEvent is still
+   * fired as each plugin is registered, and the outermost EndBatch() fires
+   * `vtkPVPluginTracker::RegisterBatchEndEvent`, so that handlers which
+   * process plugins faster together can defer processing them until then.
+   * Batches can be nested.
+   */
+  void BeginBatch();
+  void EndBatch();
+  bool GetInBatch() { return this->BatchDepth > 0; }
+  ///@}
+
   /**
    * This API is used to register available plugins without actually loading
    * them.
@@ -119,7 +134,8 @@ public:
 
   enum
   {
-    RegisterAvailablePluginEvent = vtkCommand::UserEvent + 91
+    RegisterAvailablePluginEvent = vtkCommand::UserEvent + 91,
+    RegisterBatchEndEvent = vtkCommand::UserEvent + 92
   };
 
 protected:
@@ -132,8 +148,9 @@ private:
 
   class vtkPluginsList;
   vtkPluginsList* PluginsList;
+  int BatchDepth = 0;
 
-  void LoadPluginConfigurationXMLConf(std::string const& exe_dir, std::string const& conf);
+  void LoadPluginConfigurationXMLConf(std::string const& exe_dir, std::string const& contents);
   void LoadPluginConfigurationXMLHinted(vtkPVXMLElement*, const char* hint, bool forceLoad);
 };
 
@@ -38,6 +38,17 @@ public:
     CLIENT_AND_SERVERS = DATA_SERVER | CLIENT | RENDER_SERVER
   };
 
+  enum
+  {
+    /**
+     * Tag of the messages delivering the images rendered remotely to the
+     * client. When images are delivered asynchronously, see
+     * vtkPVClientServerSynchronizedRenderers, the client may receive them
+     * while waiting for other messages, in which case they are buffered.
+     */
+    IMAGE_DELIVERY_TAG = 0x023430
+  };
+
   /**
    * Returns a ServerFlags indicate the nature of the current processes. e.g. if
    * the current processes acts as a data-server and a render-server, it returns
@@ -0,0 +1,157 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "vtkCommand.h"
+#include "vtkInitializationHelper.h"
+#include "vtkLogger.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkProcessModule.h"
+#include "vtkSMDomain.h"
+#include "vtkSMPropertyHelper.h"
+#include "vtkSMSession.h"
+#include "vtkSMSessionProxyManager.h"
+#include "vtkSMSourceProxy.h"
+#include "vtkSmartPointer.h"
+
+namespace
+{
+// Domain counting the calls to Update().
+class vtkCountingDomain : public vtkSMDomain
+{
+public:
+  static vtkCountingDomain* New();
+  vtkTypeMacro(vtkCountingDomain, vtkSMDomain);
+
+  void Update(vtkSMProperty*) override { ++this->NumberOfUpdates; }
+
+  void AddInput(vtkSMProperty* prop, const char* function)
+  {
+    this->AddRequiredProperty(prop, function);
+  }
+
+  void SetCacheUpdates(bool cache) { this->CacheUpdates = cache; }
+
+  int NumberOfUpdates = 0;
+};
+vtkStandardNewMacro(vtkCountingDomain);
+}
+
+int TestDomainUpdateCache(int, char* argv[])
+{
+  vtkInitializationHelper::Initialize(argv[0], vtkProcessModule::PROCESS_CLIENT);
+
+  vtkNew<vtkSMSession> session;
+  vtkSMSessionProxyManager* pxm = session->GetSessionProxyManager();
+
+  vtkSmartPointer<vtkSMSourceProxy> wavelet;
+  wavelet.TakeReference(
+    vtkSMSourceProxy::SafeDownCast(pxm->NewProxy("sources", "RTAnalyticSource")));
+  wavelet->UpdateVTKObjects();
+
+  vtkSmartPointer<vtkSMSourceProxy> shrink;
+  shrink.TakeReference(vtkSMSourceProxy::SafeDownCast(pxm->NewProxy("filters", "ShrinkFilter")));
+
+  vtkNew<vtkCountingDomain> cached;
+  cached->SetCacheUpdates(true);
+  cached->AddInput(shrink->GetProperty("Input"), "Input");
+  cached->AddInput(shrink->GetProperty("ShrinkFactor"), "ShrinkFactor");
+
+  vtkNew<vtkCountingDomain> uncached;
+  uncached->AddInput(shrink->GetProperty("Input"), "Input");
+
+  vtkSMPropertyHelper(shrink, "Input").Set(wavelet);
+  if (cached->NumberOfUpdates != 1)
+  {
+    vtkLogF(ERROR, "Domain was not updated when the input changed.");
+    return EXIT_FAILURE;
+  }
+  if (uncached->NumberOfUpdates != 1)
+  {
+    vtkLogF(ERROR, "Domain was not updated when the input changed.");
+    return EXIT_FAILURE;
+  }
+
+  // The data changes: the domains must be updated.
+  wavelet->UpdatePipeline();
+  if (cached->NumberOfUpdates != 2)
+  {
+    vtkLogF(ERROR, "Domain was not updated when the data changed.");
+    return EXIT_FAILURE;
+  }
+  if (uncached->NumberOfUpdates != 2)
+  {
+    vtkLogF(ERROR, "Domain was not updated when the data changed.");
+    return EXIT_FAILURE;
+  }
+
+  // Nothing changed: only the uncached domain is updated.
+  wavelet->InvokeEvent(vtkCommand::UpdateDataEvent);
+  if (cached->NumberOfUpdates != 2)
+  {
+    vtkLogF(ERROR, "Cached domain was updated although no input changed.");
+    return EXIT_FAILURE;
+  }
+  if (uncached->NumberOfUpdates != 3)
+  {
+    vtkLogF(ERROR, "Uncached domain was not updated.");
+    return EXIT_FAILURE;
+  }
+
+  // Changes within a batch update are coalesced.
+  pxm->BeginBatchUpdate();
+  vtkSMPropertyHelper(shrink, "ShrinkFactor").Set(0.25);
+  vtkSMPropertyHelper(shrink, "Input").Set(static_cast<vtkSMProxy*>(nullptr));
+  vtkSMPropertyHelper(shrink, "Input").Set(wavelet);
+  if (cached->NumberOfUpdates != 2)
+  {
+    vtkLogF(ERROR, "Domain update was not deferred during the batch.");
+    return EXIT_FAILURE;
+  }
+  pxm->EndBatchUpdate();
+  if (cached->NumberOfUpdates != 3)
+  {
+    vtkLogF(ERROR, "Deferred domain update should happen once.");
+    return EXIT_FAILURE;
+  }
+  if (uncached->NumberOfUpdates != 4)
+  {
+    vtkLogF(ERROR, "Deferred domain update should happen once.");
+    return EXIT_FAILURE;
+  }
+
+  // Same with nested batches: updates happen when the outermost one ends.
+  pxm->BeginBatchUpdate();
+  pxm->BeginBatchUpdate();
+  vtkSMPropertyHelper(shrink, "ShrinkFactor").Set(0.75);
+  pxm->EndBatchUpdate();
+  vtkSMPropertyHelper(shrink, "ShrinkFactor").Set(0.5);
+  if (cached->NumberOfUpdates != 3)
+  {
+    vtkLogF(ERROR, "Domain update was not deferred during the nested batch.");
+    return EXIT_FAILURE;
+  }
+  pxm->EndBatchUpdate();
+  if (cached->NumberOfUpdates != 4)
+  {
+    vtkLogF(ERROR, "Deferred domain update should happen once.");
+    return EXIT_FAILURE;
+  }
+
+  // A batch update on one session does not defer domain updates of another.
+  vtkNew<vtkSMSession> otherSession;
+  vtkSMSessionProxyManager* otherPxm = otherSession->GetSessionProxyManager();
+  otherPxm->BeginBatchUpdate();
+  vtkSMPropertyHelper(shrink, "ShrinkFactor").Set(0.25);
+  otherPxm->EndBatchUpdate();
+  if (cached->NumberOfUpdates != 5)
+  {
+    vtkLogF(ERROR, "Domain update was deferred by another session.");
+    return EXIT_FAILURE;
+  }
+
+  shrink = nullptr;
+  wavelet = nullptr;
+  vtkInitializationHelper::Finalize();
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,351 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "vtkCallbackCommand.h"
+#include "vtkLogger.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPVPlugin.h"
+#include "vtkPVPluginTracker.h"
+#include "vtkPVProxyDefinitionIterator.h"
+#include "vtkPVServerManagerPluginInterface.h"
+#include "vtkPVXMLElement.h"
+#include "vtkSIProxyDefinitionManager.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
+
+#include <array>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace
+{
+const char* Configuration = R"xml(<?xml version="1.0"?>
+<ServerManagerConfiguration>
+  <!-- <SourceProxy name="Commented" class="vtkObject" /> -->
+  <ProxyGroup name="test_sources">
+    <SourceProxy name="Base" class="vtkObject" label="a > b">
+      <IntVectorProperty name="BaseValue" command="SetBaseValue"
+                         number_of_elements="1" default_values="1" />
+      <Documentation><![CDATA[ <SourceProxy name="InCData" /> ]]></Documentation>
+    </SourceProxy>
+    <SourceProxy name="Derived" class="vtkObject"
+                 base_proxygroup="test_sources" base_proxyname="Base">
+      <IntVectorProperty name="DerivedValue" command="SetDerivedValue"
+                         number_of_elements="1" default_values="2" />
+    </SourceProxy>
+    <Proxy name="Empty" class="vtkObject" />
+  </ProxyGroup>
+</ServerManagerConfiguration>
+)xml";
+
+const char* ExtensionConfiguration = R"xml(<ServerManagerConfiguration>
+  <ProxyGroup name="test_sources">
+    <Extension name="Base">
+      <IntVectorProperty name="ExtensionValue" command="SetExtensionValue"
+                         number_of_elements="1" default_values="3" />
+    </Extension>
+  </ProxyGroup>
+</ServerManagerConfiguration>
+)xml";
+
+// Returns a configuration xml with a single source proxy.
+std::string SourceXML(const std::string& name)
+{
+  return "<ServerManagerConfiguration><ProxyGroup name=\"plugin_sources\">"
+         "<SourceProxy name=\"" +
+    name + "\" class=\"vtkObject\" /></ProxyGroup></ServerManagerConfiguration>";
+}
+
+class TestPluginBase
+  : public vtkPVPlugin
+  , public vtkPVServerManagerPluginInterface
+{
+public:
+  const char* GetPluginVersionString() override { return "1.0"; }
+  bool GetRequiredOnServer() override { return true; }
+  bool GetRequiredOnClient() override { return true; }
+  const char* GetRequiredPlugins() override { return ""; }
+  const char* GetDescription() override { return ""; }
+  const char* GetEULA() override { return nullptr; }
+  vtkClientServerInterpreterInitializer::InterpreterInitializationCallback
+  GetInitializeInterpreterCallback() override
+  {
+    return nullptr;
+  }
+};
+
+// A plugin whose xmls depend on each other: they must be registered in order
+// even though they are prepared concurrently.
+class TestPlugin : public TestPluginBase
+{
+public:
+  const char* GetPluginName() override { return "TestProxyDefinitionManagerPlugin"; }
+  void GetXMLs(std::vector<std::string>& xmls) override
+  {
+    for (int cc = 0; cc < 16; ++cc)
+    {
+      const std::string name = "Plugin" + std::to_string(cc);
+      xmls.push_back(SourceXML(name));
+      xmls.push_back("<ServerManagerConfiguration><ProxyGroup name=\"plugin_sources\">"
+                     "<Extension name=\"" +
+        name +
+        "\"><IntVectorProperty name=\"Value\" command=\"SetValue\" /></Extension>"
+        "</ProxyGroup></ServerManagerConfiguration>");
+    }
+    // Cannot be indexed, parsed as a whole.
+    xmls.emplace_back("<!DOCTYPE ServerManagerConfiguration>"
+                      "<ServerManagerConfiguration><ProxyGroup name=\"plugin_sources\">"
+                      "<SourceProxy name=\"NotIndexed\" class=\"vtkObject\" />"
+                      "</ProxyGroup></ServerManagerConfiguration>");
+  }
+};
+
+// A plugin that assigns its xmls to the vector instead of appending them, as
+// vtkPVPythonAlgorithmPlugin does.
+class AssigningTestPlugin : public TestPluginBase
+{
+public:
+  AssigningTestPlugin(const char* name)
+    : Name(name)
+  {
+  }
+  const char* GetPluginName() override { return this->Name.c_str(); }
+  void GetXMLs(std::vector<std::string>& xmls) override { xmls = { SourceXML(this->Name) }; }
+
+private:
+  std::string Name;
+};
+
+// Gives access to HandlePlugins() so that the test plugin does not have to be
+// registered with the global vtkPVPluginTracker.
+class vtkTestProxyDefinitionManager : public vtkSIProxyDefinitionManager
+{
+public:
+  static vtkTestProxyDefinitionManager* New();
+  vtkTypeMacro(vtkTestProxyDefinitionManager, vtkSIProxyDefinitionManager);
+  using vtkSIProxyDefinitionManager::HandlePlugins;
+};
+vtkStandardNewMacro(vtkTestProxyDefinitionManager);
+
+void CountUpdateEvents(vtkObject*, unsigned long, void* clientdata, void*)
+{
+  ++(*reinterpret_cast<int*>(clientdata));
+}
+
+// Looks definitions up from several threads before any of them is parsed:
+// each must be parsed once and every lookup must return the same element.
+int TestConcurrentLookups()
+{
+  vtkNew<vtkSIProxyDefinitionManager> pdm;
+  if (!pdm->LoadConfigurationXMLFromString(Configuration))
+  {
+    vtkLogF(ERROR, "Failed to load configuration.");
+    return EXIT_FAILURE;
+  }
+
+  const std::array<const char*, 3> names = { "Base", "Derived", "Empty" };
+  std::vector<vtkPVXMLElement*> found(64 * names.size(), nullptr);
+  const vtkIdType numberOfLookups = static_cast<vtkIdType>(found.size());
+  vtkSMPTools::For(0, numberOfLookups, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType cc = begin; cc < end; ++cc)
+    {
+      found[cc] = pdm->GetProxyDefinition("test_sources", names[cc % names.size()]);
+    }
+  });
+
+  for (size_t cc = 0; cc < found.size(); ++cc)
+  {
+    const char* name = names[cc % names.size()];
+    if (!found[cc] || found[cc] != pdm->GetProxyDefinition("test_sources", name))
+    {
+      vtkLogF(ERROR, "Concurrent lookups returned different definitions.");
+      return EXIT_FAILURE;
+    }
+  }
+  return EXIT_SUCCESS;
+}
+
+int TestPluginDefinitions()
+{
+  vtkNew<vtkTestProxyDefinitionManager> pdm;
+  int numberOfUpdates = 0;
+  vtkNew<vtkCallbackCommand> observer;
+  observer->SetCallback(&CountUpdateEvents);
+  observer->SetClientData(&numberOfUpdates);
+  pdm->AddObserver(vtkSIProxyDefinitionManager::ProxyDefinitionsUpdated, observer);
+
+  TestPlugin plugin;
+  AssigningTestPlugin assigningPlugin("AssigningPlugin");
+  pdm->HandlePlugins({ &plugin, &assigningPlugin });
+  if (numberOfUpdates != 2)
+  {
+    vtkLogF(ERROR, "Expected a single update per plugin.");
+    return EXIT_FAILURE;
+  }
+  if (!pdm->HasDefinition("plugin_sources", "AssigningPlugin"))
+  {
+    vtkLogF(ERROR, "Missing definition of the second plugin.");
+    return EXIT_FAILURE;
+  }
+
+  for (int cc = 0; cc < 16; ++cc)
+  {
+    const std::string name = "Plugin" + std::to_string(cc);
+    vtkPVXMLElement* proxy = pdm->GetProxyDefinition("plugin_sources", name.c_str());
+    if (!(proxy && proxy->FindNestedElementByName("IntVectorProperty")))
+    {
+      vtkLogF(ERROR, "Plugin definition or extension is missing.");
+      return EXIT_FAILURE;
+    }
+  }
+  if (!pdm->HasDefinition("plugin_sources", "NotIndexed"))
+  {
+    vtkLogF(ERROR, "Missing parsed definition.");
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
+
+// Plugins registered during a batch of the plugin tracker, as when plugins
+// are auto-loaded, must be handled together at the end of the batch.
+int TestBatchedPlugins()
+{
+  vtkNew<vtkSIProxyDefinitionManager> pdm;
+  int numberOfUpdates = 0;
+  vtkNew<vtkCallbackCommand> observer;
+  observer->SetCallback(&CountUpdateEvents);
+  observer->SetClientData(&numberOfUpdates);
+  pdm->AddObserver(vtkSIProxyDefinitionManager::ProxyDefinitionsUpdated, observer);
+
+  // the tracker keeps the plugins for the lifetime of the process.
+  static AssigningTestPlugin firstPlugin("BatchedPlugin0");
+  static AssigningTestPlugin secondPlugin("BatchedPlugin1");
+  vtkPVPluginTracker* tracker = vtkPVPluginTracker::GetInstance();
+  tracker->BeginBatch();
+  tracker->RegisterPlugin(&firstPlugin);
+  tracker->RegisterPlugin(&secondPlugin);
+  if (numberOfUpdates != 0 || pdm->HasDefinition("plugin_sources", "BatchedPlugin0"))
+  {
+    vtkLogF(ERROR, "Plugins were handled before the end of the batch.");
+    return EXIT_FAILURE;
+  }
+  tracker->EndBatch();
+
+  if (numberOfUpdates != 2 || !pdm->HasDefinition("plugin_sources", "BatchedPlugin0") ||
+    !pdm->HasDefinition("plugin_sources", "BatchedPlugin1"))
+  {
+    vtkLogF(ERROR, "Batched plugins were not handled at the end of the batch.");
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
+}
+
+int TestProxyDefinitionManager(int, char*[])
+{
+  vtkNew<vtkSIProxyDefinitionManager> pdm;
+  if (!pdm->LoadConfigurationXMLFromString(Configuration))
+  {
+    vtkLogF(ERROR, "Failed to load configuration.");
+    return EXIT_FAILURE;
+  }
+
+  if (!pdm->HasDefinition("test_sources", "Base"))
+  {
+    vtkLogF(ERROR, "Missing Base definition.");
+    return EXIT_FAILURE;
+  }
+  if (!pdm->HasDefinition("test_sources", "Derived"))
+  {
+    vtkLogF(ERROR, "Missing Derived definition.");
+    return EXIT_FAILURE;
+  }
+  if (!pdm->HasDefinition("test_sources", "Empty"))
+  {
+    vtkLogF(ERROR, "Missing Empty definition.");
+    return EXIT_FAILURE;
+  }
+  if (pdm->HasDefinition("test_sources", "Commented"))
+  {
+    vtkLogF(ERROR, "Commented definition was loaded.");
+    return EXIT_FAILURE;
+  }
+  if (pdm->HasDefinition("test_sources", "InCData"))
+  {
+    vtkLogF(ERROR, "CDATA content was loaded.");
+    return EXIT_FAILURE;
+  }
+
+  int count = 0;
+  vtkSmartPointer<vtkPVProxyDefinitionIterator> iter;
+  iter.TakeReference(pdm->NewSingleGroupIterator("test_sources"));
+  for (iter->InitTraversal(); !iter->IsDoneWithTraversal(); iter->GoToNextItem())
+  {
+    if (iter->GetProxyDefinition() == nullptr)
+    {
+      vtkLogF(ERROR, "Iterator returned no definition.");
+      return EXIT_FAILURE;
+    }
+    ++count;
+  }
+  if (count != 3)
+  {
+    vtkLogF(ERROR, "Unexpected number of definitions.");
+    return EXIT_FAILURE;
+  }
+
+  vtkPVXMLElement* base = pdm->GetProxyDefinition("test_sources", "Base");
+  if (!(base && strcmp(base->GetName(), "SourceProxy") == 0))
+  {
+    vtkLogF(ERROR, "Invalid Base definition.");
+    return EXIT_FAILURE;
+  }
+  if (strcmp(base->GetAttribute("label"), "a > b") != 0)
+  {
+    vtkLogF(ERROR, "Invalid Base attribute.");
+    return EXIT_FAILURE;
+  }
+  if (!base->FindNestedElementByName("IntVectorProperty"))
+  {
+    vtkLogF(ERROR, "Missing Base property.");
+    return EXIT_FAILURE;
+  }
+  if (!(base->GetParent() && strcmp(base->GetParent()->GetAttribute("name"), "test_sources") == 0))
+  {
+    vtkLogF(ERROR, "Invalid Base parent.");
+    return EXIT_FAILURE;
+  }
+
+  if (!pdm->LoadConfigurationXMLFromString(ExtensionConfiguration))
+  {
+    vtkLogF(ERROR, "Failed to load extension.");
+    return EXIT_FAILURE;
+  }
+  base = pdm->GetProxyDefinition("test_sources", "Base");
+  if (base->GetNumberOfNestedElements() != 3)
+  {
+    vtkLogF(ERROR, "Extension was not applied.");
+    return EXIT_FAILURE;
+  }
+
+  vtkPVXMLElement* derived = pdm->GetCollapsedProxyDefinition("test_sources", "Derived", nullptr);
+  int numProperties = 0;
+  for (unsigned int cc = 0; derived && cc < derived->GetNumberOfNestedElements(); ++cc)
+  {
+    numProperties +=
+      strcmp(derived->GetNestedElement(cc)->GetName(), "IntVectorProperty") == 0 ? 1 : 0;
+  }
+  if (numProperties != 3)
+  {
+    vtkLogF(ERROR, "Invalid collapsed Derived definition.");
+    return EXIT_FAILURE;
+  }
+
+  if (TestConcurrentLookups() != EXIT_SUCCESS || TestPluginDefinitions() != EXIT_SUCCESS)
+  {
+    return EXIT_FAILURE;
+  }
+  return TestBatchedPlugins();
+}
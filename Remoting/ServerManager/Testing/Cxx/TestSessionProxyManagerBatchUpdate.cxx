@@ -0,0 +1,101 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "vtkCallbackCommand.h"
+#include "vtkCommand.h"
+#include "vtkInitializationHelper.h"
+#include "vtkLogger.h"
+#include "vtkNew.h"
+#include "vtkProcessModule.h"
+#include "vtkSMPropertyHelper.h"
+#include "vtkSMProxy.h"
+#include "vtkSMSession.h"
+#include "vtkSMSessionProxyManager.h"
+#include "vtkSmartPointer.h"
+
+namespace
+{
+void CountUpdateEvents(vtkObject*, unsigned long, void* clientdata, void*)
+{
+  ++(*reinterpret_cast<int*>(clientdata));
+}
+}
+
+int TestSessionProxyManagerBatchUpdate(int, char* argv[])
+{
+  vtkInitializationHelper::Initialize(argv[0], vtkProcessModule::PROCESS_CLIENT);
+
+  vtkNew<vtkSMSession> session;
+  vtkSMSessionProxyManager* pxm = session->GetSessionProxyManager();
+
+  vtkSmartPointer<vtkSMProxy> sphere;
+  sphere.TakeReference(pxm->NewProxy("sources", "SphereSource"));
+  sphere->UpdateVTKObjects();
+
+  int updateEvents = 0;
+  vtkNew<vtkCallbackCommand> observer;
+  observer->SetCallback(&CountUpdateEvents);
+  observer->SetClientData(&updateEvents);
+  sphere->AddObserver(vtkCommand::UpdateEvent, observer);
+
+  pxm->BeginBatchUpdate();
+  if (!pxm->IsInBatchUpdate())
+  {
+    vtkLogF(ERROR, "Batch update was not started.");
+    return EXIT_FAILURE;
+  }
+  if (!session->GetIsPushBatchOpen())
+  {
+    vtkLogF(ERROR, "Push batch was not opened on the session.");
+    return EXIT_FAILURE;
+  }
+
+  vtkSMPropertyHelper(sphere, "Radius").Set(2.0);
+  sphere->UpdateVTKObjects();
+
+  // Nested batches must not end the outer one.
+  pxm->BeginBatchUpdate();
+  vtkSMPropertyHelper(sphere, "ThetaResolution").Set(16);
+  sphere->UpdateVTKObjects();
+  pxm->EndBatchUpdate();
+  if (!pxm->IsInBatchUpdate())
+  {
+    vtkLogF(ERROR, "Nested batch ended the outer batch.");
+    return EXIT_FAILURE;
+  }
+  if (updateEvents != 0)
+  {
+    vtkLogF(ERROR, "UpdateEvent was not deferred during the batch.");
+    return EXIT_FAILURE;
+  }
+
+  pxm->EndBatchUpdate();
+  if (pxm->IsInBatchUpdate())
+  {
+    vtkLogF(ERROR, "Batch update was not ended.");
+    return EXIT_FAILURE;
+  }
+  if (session->GetIsPushBatchOpen())
+  {
+    vtkLogF(ERROR, "Push batch was not closed on the session.");
+    return EXIT_FAILURE;
+  }
+  if (updateEvents != 1)
+  {
+    vtkLogF(ERROR, "Deferred UpdateEvent should be fired once at the end of the batch.");
+    return EXIT_FAILURE;
+  }
+
+  // Outside of a batch, events are fired immediately.
+  vtkSMPropertyHelper(sphere, "Radius").Set(3.0);
+  sphere->UpdateVTKObjects();
+  if (updateEvents != 2)
+  {
+    vtkLogF(ERROR, "UpdateEvent was not fired outside of a batch.");
+    return EXIT_FAILURE;
+  }
+
+  sphere = nullptr;
+  vtkInitializationHelper::Finalize();
+  return EXIT_SUCCESS;
+}
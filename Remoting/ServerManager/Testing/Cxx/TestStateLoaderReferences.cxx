@@ -0,0 +1,184 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "vtkInitializationHelper.h"
+#include "vtkLogger.h"
+#include "vtkNew.h"
+#include "vtkPVXMLElement.h"
+#include "vtkProcessModule.h"
+#include "vtkSMIntRangeDomain.h"
+#include "vtkSMPropertyHelper.h"
+#include "vtkSMSession.h"
+#include "vtkSMSessionProxyManager.h"
+#include "vtkSMSourceProxy.h"
+#include "vtkSmartPointer.h"
+
+#include <cstring>
+#include <vector>
+
+namespace
+{
+struct ExpectedState
+{
+  unsigned int NumberOfTimeSteps;
+  int MaximumTimeStepIndex;
+};
+
+//----------------------------------------------------------------------------
+int GetMaximumTimeStepIndex(vtkSMProxy* extract)
+{
+  auto domain = vtkSMIntRangeDomain::SafeDownCast(
+    extract->GetProperty("TimeStepIndices")->FindDomain("vtkSMTimeStepIndexDomain"));
+  int exists = 0;
+  return domain ? domain->GetMaximum(0, exists) : -1;
+}
+
+//----------------------------------------------------------------------------
+// Returns a copy of the state where the <Proxy/> elements are in reverse
+// order, so that proxies are defined before the proxies they reference.
+vtkSmartPointer<vtkPVXMLElement> ReverseProxyElements(vtkPVXMLElement* state)
+{
+  vtkNew<vtkPVXMLElement> copy;
+  state->CopyTo(copy);
+
+  vtkPVXMLElement* smState = copy;
+  if (!smState->GetName() || strcmp(smState->GetName(), "ServerManagerState") != 0)
+  {
+    smState = copy->FindNestedElementByName("ServerManagerState");
+  }
+  if (!smState)
+  {
+    return nullptr;
+  }
+
+  std::vector<vtkSmartPointer<vtkPVXMLElement>> proxies;
+  std::vector<vtkSmartPointer<vtkPVXMLElement>> others;
+  for (unsigned int cc = 0; cc < smState->GetNumberOfNestedElements(); ++cc)
+  {
+    vtkPVXMLElement* child = smState->GetNestedElement(cc);
+    if (child->GetName() && strcmp(child->GetName(), "Proxy") == 0)
+    {
+      proxies.insert(proxies.begin(), child);
+    }
+    else
+    {
+      others.emplace_back(child);
+    }
+  }
+  smState->RemoveAllNestedElements();
+  for (const auto& child : proxies)
+  {
+    smState->AddNestedElement(child);
+  }
+  for (const auto& child : others)
+  {
+    smState->AddNestedElement(child);
+  }
+  return copy.Get();
+}
+
+//----------------------------------------------------------------------------
+bool CheckLoadedState(
+  vtkSMSessionProxyManager* pxm, vtkPVXMLElement* state, const ExpectedState& expected)
+{
+  pxm->LoadXMLState(state);
+
+  vtkSMSourceProxy* time = vtkSMSourceProxy::SafeDownCast(pxm->GetProxy("sources", "time"));
+  vtkSMSourceProxy* extract =
+    vtkSMSourceProxy::SafeDownCast(pxm->GetProxy("sources", "extract"));
+  if (!time || !extract)
+  {
+    vtkLogF(ERROR, "Proxies were not registered.");
+    return false;
+  }
+  if (vtkSMPropertyHelper(extract, "Input").GetAsProxy() != time)
+  {
+    vtkLogF(ERROR, "Input reference was not restored.");
+    return false;
+  }
+  if (vtkSMPropertyHelper(time, "TimestepValues").GetNumberOfElements() !=
+    expected.NumberOfTimeSteps)
+  {
+    vtkLogF(ERROR, "Pipeline information of the source was not updated.");
+    return false;
+  }
+  if (GetMaximumTimeStepIndex(extract) != expected.MaximumTimeStepIndex)
+  {
+    vtkLogF(ERROR, "Domain depending on the input was not updated (%d != %d).",
+      GetMaximumTimeStepIndex(extract), expected.MaximumTimeStepIndex);
+    return false;
+  }
+  vtkSMPropertyHelper indices(extract, "TimeStepIndices");
+  if (indices.GetNumberOfElements() != 2 || indices.GetAsInt(0) != 0 || indices.GetAsInt(1) != 2)
+  {
+    vtkLogF(ERROR, "Property values were not restored.");
+    return false;
+  }
+
+  pxm->UnRegisterProxies();
+  return true;
+}
+}
+
+//----------------------------------------------------------------------------
+// Loads a state where a filter references its input, with the input defined
+// before and after the filter, and checks the domains depending on the input.
+int TestStateLoaderReferences(int, char* argv[])
+{
+  vtkInitializationHelper::Initialize(argv[0], vtkProcessModule::PROCESS_CLIENT);
+
+  int result = EXIT_SUCCESS;
+  {
+    vtkNew<vtkSMSession> session;
+    vtkSMSessionProxyManager* pxm = session->GetSessionProxyManager();
+
+    vtkSmartPointer<vtkPVXMLElement> state;
+    ExpectedState expected;
+    {
+      vtkSmartPointer<vtkSMSourceProxy> time;
+      time.TakeReference(vtkSMSourceProxy::SafeDownCast(pxm->NewProxy("sources", "TimeSource")));
+      time->UpdateVTKObjects();
+      time->UpdatePipelineInformation();
+
+      vtkSmartPointer<vtkSMSourceProxy> extract;
+      extract.TakeReference(
+        vtkSMSourceProxy::SafeDownCast(pxm->NewProxy("filters", "ExtractTimeSteps")));
+      vtkSMPropertyHelper(extract, "Input").Set(time);
+      const int indices[2] = { 0, 2 };
+      vtkSMPropertyHelper(extract, "TimeStepIndices").Set(indices, 2);
+      extract->UpdateVTKObjects();
+
+      pxm->RegisterProxy("sources", "time", time);
+      pxm->RegisterProxy("sources", "extract", extract);
+
+      expected.NumberOfTimeSteps =
+        vtkSMPropertyHelper(time, "TimestepValues").GetNumberOfElements();
+      expected.MaximumTimeStepIndex = GetMaximumTimeStepIndex(extract);
+      if (expected.NumberOfTimeSteps == 0 ||
+        expected.MaximumTimeStepIndex != static_cast<int>(expected.NumberOfTimeSteps) - 1)
+      {
+        vtkLogF(ERROR, "Unexpected time steps of the source.");
+        result = EXIT_FAILURE;
+      }
+
+      state.TakeReference(pxm->SaveXMLState());
+      pxm->UnRegisterProxies();
+    }
+
+    if (result == EXIT_SUCCESS && !CheckLoadedState(pxm, state, expected))
+    {
+      vtkLogF(ERROR, "Failed to load the state with the filter after its input.");
+      result = EXIT_FAILURE;
+    }
+
+    vtkSmartPointer<vtkPVXMLElement> reversed = ReverseProxyElements(state);
+    if (result == EXIT_SUCCESS && (!reversed || !CheckLoadedState(pxm, reversed, expected)))
+    {
+      vtkLogF(ERROR, "Failed to load the state with the filter before its input.");
+      result = EXIT_FAILURE;
+    }
+  }
+
+  vtkInitializationHelper::Finalize();
+  return result;
+}
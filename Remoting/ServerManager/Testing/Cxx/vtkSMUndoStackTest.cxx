@@ -63,5 +63,112 @@ void vtkSMUndoStackTest::StackDepth()
 {
   vtkSMUndoStack* stack = vtkSMUndoStack::New();
   QCOMPARE(stack->GetStackDepth(), 10);
+  QCOMPARE(stack->GetMaximumMemorySize(), static_cast<vtkTypeUInt64>(256 * 1024 * 1024));
   stack->Delete();
 }
+
+void vtkSMUndoStackTest::MergeUpdates()
+{
+  vtkSMSession* session = vtkSMSession::New();
+  vtkSMSessionProxyManager* pxm = session->GetSessionProxyManager();
+
+  vtkSMProxy* sphere = pxm->NewProxy("sources", "SphereSource");
+  sphere->UpdateVTKObjects();
+  QVERIFY(sphere != nullptr);
+
+  // Record a few consecutive updates of the same proxy, as an interactive
+  // change would.
+  vtkUndoSet* undoSet = vtkUndoSet::New();
+  for (double radius : { 1.0, 2.0, 3.0 })
+  {
+    vtkSMMessage before;
+    before.CopyFrom(*sphere->GetFullState());
+    vtkSMPropertyHelper(sphere, "Radius").Set(radius);
+    sphere->UpdateVTKObjects();
+    vtkSMMessage after;
+    after.CopyFrom(*sphere->GetFullState());
+
+    vtkSMRemoteObjectUpdateUndoElement* undoElement = vtkSMRemoteObjectUpdateUndoElement::New();
+    undoElement->SetSession(session);
+    undoElement->SetUndoRedoState(&before, &after);
+    undoSet->AddElement(undoElement);
+    undoElement->Delete();
+  }
+  QCOMPARE(undoSet->GetNumberOfElements(), 1);
+
+  // The after state only stores the changed property but decodes to the full
+  // state.
+  vtkSMRemoteObjectUpdateUndoElement* merged =
+    vtkSMRemoteObjectUpdateUndoElement::SafeDownCast(undoSet->GetElement(0));
+  vtkSMMessage after;
+  QVERIFY(merged->GetAfterState(&after));
+  QCOMPARE(after.SerializeAsString(), sphere->GetFullState()->SerializeAsString());
+  QVERIFY(merged->GetMemorySize() < sizeof(*merged) + 3 * after.ByteSizeLong() / 2);
+
+  vtkSMUndoStack* undoStack = vtkSMUndoStack::New();
+  undoStack->Push("ChangeRadius", undoSet);
+  undoSet->Delete();
+
+  undoStack->Undo();
+  sphere->UpdateVTKObjects();
+  QCOMPARE(vtkSMPropertyHelper(sphere, "Radius").GetAsDouble(), 0.5);
+  undoStack->Redo();
+  sphere->UpdateVTKObjects();
+  QCOMPARE(vtkSMPropertyHelper(sphere, "Radius").GetAsDouble(), 3.0);
+
+  undoStack->Delete();
+  sphere->Delete();
+  session->Delete();
+}
+
+void vtkSMUndoStackTest::MemoryBudget()
+{
+  vtkSMSession* session = vtkSMSession::New();
+  vtkSMSessionProxyManager* pxm = session->GetSessionProxyManager();
+
+  vtkSMProxy* sphere = pxm->NewProxy("sources", "SphereSource");
+  sphere->UpdateVTKObjects();
+
+  vtkSMUndoStack* undoStack = vtkSMUndoStack::New();
+  for (int cc = 0; cc < 5; ++cc)
+  {
+    vtkSMMessage before;
+    before.CopyFrom(*sphere->GetFullState());
+    vtkSMPropertyHelper(sphere, "Radius").Set(1.0 + cc);
+    sphere->UpdateVTKObjects();
+    vtkSMMessage after;
+    after.CopyFrom(*sphere->GetFullState());
+
+    vtkUndoSet* undoSet = vtkUndoSet::New();
+    vtkSMRemoteObjectUpdateUndoElement* undoElement = vtkSMRemoteObjectUpdateUndoElement::New();
+    undoElement->SetSession(session);
+    undoElement->SetUndoRedoState(&before, &after);
+    undoSet->AddElement(undoElement);
+    undoElement->Delete();
+    if (cc == 0)
+    {
+      // Leave room for two sets.
+      undoStack->SetMaximumMemorySize(2 * undoSet->GetMemorySize() + 1);
+    }
+    undoStack->Push("ChangeRadius", undoSet);
+    undoSet->Delete();
+  }
+  QCOMPARE(undoStack->GetNumberOfUndoSets(), 2u);
+  QVERIFY(undoStack->GetMemorySize() <= undoStack->GetMaximumMemorySize());
+
+  // A set larger than the budget is still kept.
+  undoStack->SetMaximumMemorySize(1);
+  vtkUndoSet* undoSet = vtkUndoSet::New();
+  vtkSMRemoteObjectUpdateUndoElement* undoElement = vtkSMRemoteObjectUpdateUndoElement::New();
+  undoElement->SetSession(session);
+  undoElement->SetUndoRedoState(sphere->GetFullState(), sphere->GetFullState());
+  undoSet->AddElement(undoElement);
+  undoElement->Delete();
+  undoStack->Push("Unchanged", undoSet);
+  undoSet->Delete();
+  QCOMPARE(undoStack->GetNumberOfUndoSets(), 1u);
+
+  undoStack->Delete();
+  sphere->Delete();
+  session->Delete();
+}
@@ -13,6 +13,8 @@ class vtkSMUndoStackTest : public QObject
 private Q_SLOTS:
   void UndoRedo();
   void StackDepth();
+  void MergeUpdates();
+  void MemoryBudget();
 };
 
 #endif
@@ -532,6 +532,26 @@ void vtkPVSessionServer::OnClientServerMessageRMI(void* message, int message_len
     }
     break;
 
+    case vtkPVSessionServer::PUSH_BATCH:
+    {
+      // Several states pushed in a single message, handled as PUSH in order.
+      int count = 0;
+      stream >> count;
+      for (int cc = 0; cc < count; ++cc)
+      {
+        std::string string;
+        stream >> string;
+        vtkSMMessage msg;
+        msg.ParseFromString(string);
+        if (!this->Internal->StoreShareOnly(&msg))
+        {
+          this->PushState(&msg);
+        }
+        this->NotifyOtherClients(&msg);
+      }
+    }
+    break;
+
     case vtkPVSessionServer::PULL:
     {
       std::string string;
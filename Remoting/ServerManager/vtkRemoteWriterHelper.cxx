@@ -8,6 +8,7 @@
 #include "vtkClientServerInterpreterInitializer.h"
 #include "vtkClientServerStream.h"
 #include "vtkDataObject.h"
+#include "vtkErrorCode.h"
 #include "vtkImageWriter.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
@@ -81,6 +82,7 @@ vtkRemoteWriterHelper::vtkRemoteWriterHelper()
 //----------------------------------------------------------------------------
 vtkRemoteWriterHelper::~vtkRemoteWriterHelper()
 {
+  this->WaitForPendingWrite();
   this->SetWriter(nullptr);
   this->SetInterpreter(nullptr);
 }
@@ -120,6 +122,8 @@ int vtkRemoteWriterHelper::RequestData(
     else if (auto imageWriter =
                vtkSmartPointer<vtkImageWriter>(vtkImageWriter::SafeDownCast(this->Writer)))
     {
+      // The writer may still be writing the previous file.
+      this->WaitForPendingWrite();
       this->Writer->SetInputDataObject(std::move(input));
       {
         if (this->GetState() != vtkRemoteWriterHelper::WRITE)
@@ -134,6 +138,7 @@ int vtkRemoteWriterHelper::RequestData(
         worker.FileName = imageWriter->GetFileName();
         ::SharedFutures.emplace(vtksys::SystemTools::CollapseFullPath(imageWriter->GetFileName()),
           std::make_pair(worker.TimeStamp, future));
+        this->PendingWrite = future;
       }
     }
     else
@@ -222,6 +227,18 @@ void vtkRemoteWriterHelper::Wait()
   vtkProcessModule::GetProcessModule()->GetCallbackQueue()->Wait(filenames);
 }
 
+//----------------------------------------------------------------------------
+void vtkRemoteWriterHelper::WaitForPendingWrite()
+{
+  if (this->PendingWrite)
+  {
+    this->PendingWrite->Wait();
+    this->PendingWrite = nullptr;
+    // The writer reports failures, e.g. a full disk, through its error code.
+    this->SetErrorCode(this->Writer ? this->Writer->GetErrorCode() : vtkErrorCode::NoError);
+  }
+}
+
 //----------------------------------------------------------------------------
 void vtkRemoteWriterHelper::WriteLocally(vtkDataObject* input)
 {
@@ -249,10 +266,12 @@ void vtkRemoteWriterHelper::WriteLocally(vtkDataObject* input)
            << vtkClientServerStream::End;
     this->Interpreter->ProcessStream(stream);
     this->Writer->SetInputDataObject(nullptr);
+    this->SetErrorCode(this->Writer->GetErrorCode());
   }
   else
   {
     vtkErrorMacro("No writer specified! Failed to write.");
+    this->SetErrorCode(vtkErrorCode::UnknownError);
   }
 }
 
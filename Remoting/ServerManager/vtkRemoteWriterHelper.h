@@ -25,6 +25,7 @@
 #include "vtkDataObjectAlgorithm.h"
 #include "vtkPVSession.h"                   // for vtkPVSession::ServerFlags
 #include "vtkRemotingServerManagerModule.h" // for exports
+#include "vtkThreadedCallbackQueue.h"       // for vtkThreadedCallbackQueue::SharedFutureBasePointer
 
 class vtkAlgorithm;
 class vtkClientServerInterpreter;
@@ -122,6 +123,19 @@ public:
    */
   static void Wait();
 
+  /**
+   * Wait until the last file written in the background by this instance has
+   * been written. The writer is used by the background job until then, hence
+   * this must be called before changing its properties, e.g. its file name,
+   * when writing several files with the same instance.
+   *
+   * Once the file has been written, the error code of this instance is set to
+   * the one of the writer, so that `GetErrorCode()` tells whether the file
+   * written in the background could be written. Files written in the
+   * foreground set it when `Write()` returns.
+   */
+  void WaitForPendingWrite();
+
   /**
    * Write the data.
    */
@@ -145,6 +159,7 @@ protected:
   vtkAlgorithm* Writer = nullptr;
   vtkClientServerInterpreter* Interpreter = nullptr;
   bool TryWritingInBackground = false;
+  vtkThreadedCallbackQueue::SharedFutureBasePointer PendingWrite;
 };
 
 #endif /* end of include guard: vtkRemoteWriterHelper_h */
@@ -17,12 +17,17 @@
 #include "vtkProcessModule.h"
 #include "vtkReservedRemoteObjectIds.h"
 #include "vtkSMMessage.h"
+#include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
 #include "vtkStringList.h"
 #include "vtkTimerLog.h"
 
 #include <cassert>
+#include <functional>
+#include <iterator>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <set>
 #include <sstream>
 #include <string>
@@ -37,6 +42,189 @@ typedef vtkSmartPointer<vtkPVXMLElement> XMLElement;
 typedef std::map<std::string, XMLElement> StrToXmlMap;
 typedef std::map<std::string, StrToXmlMap> StrToStrToXmlMap;
 
+namespace
+{
+//----------------------------------------------------------------------------
+// Location of a proxy definition within a ServerManagerConfiguration document.
+struct vtkDefinitionLocation
+{
+  std::string GroupName;
+  std::string ProxyName;
+  std::string TagName;
+  size_t Begin;
+  size_t End;
+};
+
+//----------------------------------------------------------------------------
+// Extracts the value of `attrName` from the content of a start tag. Returns
+// false if the tag is malformed or the value uses entity references, in which
+// case it needs a real XML parser.
+bool vtkGetTagAttribute(const std::string& tag, const char* attrName, std::string& value)
+{
+  static const char* whitespace = " \t\r\n";
+  value.clear();
+  size_t cc = tag.find_first_of(whitespace);
+  while (cc != std::string::npos && cc < tag.size())
+  {
+    cc = tag.find_first_not_of(whitespace, cc);
+    if (cc == std::string::npos)
+    {
+      break;
+    }
+    const size_t equal = tag.find('=', cc);
+    const size_t open = equal == std::string::npos ? equal : tag.find_first_of("\"'", equal);
+    const size_t close = open == std::string::npos ? open : tag.find(tag[open], open + 1);
+    if (close == std::string::npos || equal == cc)
+    {
+      return false;
+    }
+    const size_t nameEnd = tag.find_last_not_of(whitespace, equal - 1);
+    if (tag.compare(cc, nameEnd + 1 - cc, attrName) == 0)
+    {
+      value = tag.substr(open + 1, close - open - 1);
+      return value.find('&') == std::string::npos;
+    }
+    cc = close + 1;
+  }
+  return true;
+}
+
+//----------------------------------------------------------------------------
+// Lightweight scan of a ServerManagerConfiguration document that locates the
+// proxy definitions, i.e. the named elements nested in the top-level groups,
+// without building the XML tree. Returns false on any construct it does not
+// handle so that the caller falls back to parsing the whole document.
+bool vtkIndexConfigurationXML(const std::string& xml, std::vector<vtkDefinitionLocation>& locations)
+{
+  std::vector<std::string> openElements;
+  std::string groupName;
+  vtkDefinitionLocation current;
+  bool foundRoot = false;
+  size_t pos = 0;
+  while ((pos = xml.find('<', pos)) != std::string::npos)
+  {
+    const char* skipTo = nullptr;
+    size_t skipFrom = pos;
+    if (xml.compare(pos, 4, "<!--") == 0)
+    {
+      skipTo = "-->";
+    }
+    else if (xml.compare(pos, 9, "<![CDATA[") == 0)
+    {
+      skipTo = "]]>";
+    }
+    else if (xml.compare(pos, 2, "<?") == 0)
+    {
+      skipTo = "?>";
+    }
+    else if (xml.compare(pos, 2, "<!") == 0)
+    {
+      // A DOCTYPE may declare entities used in the definitions.
+      return false;
+    }
+    if (skipTo)
+    {
+      pos = xml.find(skipTo, skipFrom + 2);
+      if (pos == std::string::npos)
+      {
+        return false;
+      }
+      pos += strlen(skipTo);
+      continue;
+    }
+
+    // Find the end of the tag, ignoring '>' in attribute values.
+    size_t end = pos + 1;
+    char quote = 0;
+    for (; end < xml.size(); ++end)
+    {
+      const char c = xml[end];
+      if (quote)
+      {
+        quote = (c == quote) ? 0 : quote;
+      }
+      else if (c == '"' || c == '\'')
+      {
+        quote = c;
+      }
+      else if (c == '>')
+      {
+        break;
+      }
+    }
+    if (end >= xml.size())
+    {
+      return false;
+    }
+
+    if (xml[pos + 1] == '/')
+    {
+      const size_t nameBegin = pos + 2;
+      const size_t nameEnd = xml.find_last_not_of(" \t\r\n", end - 1);
+      if (openElements.empty() || nameEnd < nameBegin ||
+        xml.compare(nameBegin, nameEnd + 1 - nameBegin, openElements.back()) != 0)
+      {
+        return false;
+      }
+      openElements.pop_back();
+      if (openElements.size() == 2 && !current.ProxyName.empty())
+      {
+        current.End = end + 1;
+        locations.push_back(current);
+      }
+    }
+    else
+    {
+      const bool selfClosing = xml[end - 1] == '/';
+      const std::string tag = xml.substr(pos + 1, end - pos - 1 - (selfClosing ? 1 : 0));
+      const std::string tagName = tag.substr(0, tag.find_first_of(" \t\r\n"));
+      if (tagName.empty())
+      {
+        return false;
+      }
+      switch (openElements.size())
+      {
+        case 0:
+          if (foundRoot || tagName != "ServerManagerConfiguration")
+          {
+            return false;
+          }
+          foundRoot = true;
+          break;
+        case 1:
+          if (!vtkGetTagAttribute(tag, "name", groupName))
+          {
+            return false;
+          }
+          break;
+        case 2:
+          if (!vtkGetTagAttribute(tag, "name", current.ProxyName))
+          {
+            return false;
+          }
+          current.GroupName = groupName;
+          current.TagName = tagName;
+          current.Begin = pos;
+          if (selfClosing && !current.ProxyName.empty())
+          {
+            current.End = end + 1;
+            locations.push_back(current);
+          }
+          break;
+        default:
+          break;
+      }
+      if (!selfClosing)
+      {
+        openElements.push_back(tagName);
+      }
+    }
+    pos = end + 1;
+  }
+  return foundRoot && openElements.empty();
+}
+}
+
 class vtkSIProxyDefinitionManager::vtkInternals
 {
 public:
@@ -48,6 +236,28 @@ public:
   StrToStrToXmlMap CoreDefinitions;
   // Keep track of custom definition
   StrToStrToXmlMap CustomsDefinitions;
+
+  // Core definitions that have only been located in their configuration XML.
+  // They have a nullptr entry in CoreDefinitions until they are first
+  // requested, at which point only that definition is parsed.
+  struct DeferredDefinition
+  {
+    std::shared_ptr<const std::string> Source;
+    size_t Begin;
+    size_t End;
+    bool AttachShowInMenuHints;
+  };
+  std::map<std::string, std::map<std::string, DeferredDefinition>> DeferredDefinitions;
+  // Parents of the parsed deferred definitions, as in the original document.
+  StrToXmlMap DeferredGroups;
+  // Guards the deferred definitions and the core definitions they are parsed
+  // into, since a lookup may parse and register a definition. Recursive
+  // because registering a parsed definition can look up other definitions.
+  std::recursive_mutex DeferredMutex;
+  vtkSIProxyDefinitionManager* Owner = nullptr;
+  // Plugins registered during a batch of the plugin tracker, handled together
+  // at the end of the batch.
+  std::vector<vtkPVPlugin*> PendingPlugins;
   //-------------------------------------------------------------------------
   vtkInternals()
     : EnableXMLProxyDefinitionUpdate(true)
@@ -57,13 +267,127 @@ public:
   //-------------------------------------------------------------------------
   void Clear()
   {
+    std::lock_guard<std::recursive_mutex> lock(this->DeferredMutex);
     this->CoreDefinitions.clear();
     this->CustomsDefinitions.clear();
+    this->DeferredDefinitions.clear();
+    this->DeferredGroups.clear();
   }
   //-------------------------------------------------------------------------
   bool HasCoreDefinition(const char* groupName, const char* proxyName)
   {
-    return this->GetProxyElement(this->CoreDefinitions, groupName, proxyName) != nullptr;
+    std::lock_guard<std::recursive_mutex> lock(this->DeferredMutex);
+    return this->GetDeferredDefinition(groupName, proxyName) != nullptr ||
+      this->GetProxyElement(this->CoreDefinitions, groupName, proxyName) != nullptr;
+  }
+  //-------------------------------------------------------------------------
+  void AddDeferredDefinition(const std::string& groupName, const std::string& proxyName,
+    const DeferredDefinition& definition)
+  {
+    std::lock_guard<std::recursive_mutex> lock(this->DeferredMutex);
+    this->CoreDefinitions[groupName][proxyName] = nullptr;
+    this->DeferredDefinitions[groupName][proxyName] = definition;
+  }
+  //-------------------------------------------------------------------------
+  void RemoveDeferredDefinition(const std::string& groupName, const std::string& proxyName)
+  {
+    auto iter = this->DeferredDefinitions.find(groupName);
+    if (iter != this->DeferredDefinitions.end())
+    {
+      iter->second.erase(proxyName);
+    }
+  }
+  //-------------------------------------------------------------------------
+  const DeferredDefinition* GetDeferredDefinition(const char* groupName, const char* proxyName)
+  {
+    if (groupName && proxyName)
+    {
+      auto iter = this->DeferredDefinitions.find(groupName);
+      if (iter != this->DeferredDefinitions.end())
+      {
+        auto iter2 = iter->second.find(proxyName);
+        if (iter2 != iter->second.end())
+        {
+          return &iter2->second;
+        }
+      }
+    }
+    return nullptr;
+  }
+  //-------------------------------------------------------------------------
+  // Returns the XML of a definition that has not been parsed yet, if it can be
+  // used as is.
+  bool GetDeferredXML(const char* groupName, const char* proxyName, std::string& xml)
+  {
+    std::lock_guard<std::recursive_mutex> lock(this->DeferredMutex);
+    const DeferredDefinition* deferred = this->GetDeferredDefinition(groupName, proxyName);
+    if (!deferred || deferred->AttachShowInMenuHints)
+    {
+      return false;
+    }
+    xml = deferred->Source->substr(deferred->Begin, deferred->End - deferred->Begin);
+    return true;
+  }
+  //-------------------------------------------------------------------------
+  // Parses a deferred definition and registers the resulting element. The
+  // definition is removed from the deferred ones while the lock is held, so it
+  // is parsed exactly once even if requested concurrently.
+  vtkPVXMLElement* ParseDeferredDefinition(
+    const std::string& groupName, const std::string& proxyName)
+  {
+    std::lock_guard<std::recursive_mutex> lock(this->DeferredMutex);
+    const DeferredDefinition* found =
+      this->GetDeferredDefinition(groupName.c_str(), proxyName.c_str());
+    if (!found)
+    {
+      return nullptr;
+    }
+    const DeferredDefinition deferred = *found;
+    this->RemoveDeferredDefinition(groupName, proxyName);
+
+    vtkNew<vtkPVXMLParser> parser;
+    if (!parser->Parse(deferred.Source->c_str() + deferred.Begin,
+          static_cast<unsigned int>(deferred.End - deferred.Begin)))
+    {
+      vtkErrorWithObjectMacro(this->Owner,
+        "Failed to parse definition for (" << groupName << ", " << proxyName << ").");
+      return nullptr;
+    }
+    vtkPVXMLElement* element = parser->GetRootElement();
+
+    XMLElement& group = this->DeferredGroups[groupName];
+    if (!group)
+    {
+      group = vtkSmartPointer<vtkPVXMLElement>::New();
+      group->SetName("ProxyGroup");
+      group->AddAttribute("name", groupName.c_str());
+    }
+    group->AddNestedElement(element);
+
+    if (deferred.AttachShowInMenuHints && (groupName == "sources" || groupName == "filters"))
+    {
+      this->Owner->AttachShowInMenuHintsToProxy(element);
+    }
+    this->CoreDefinitions[groupName][proxyName] = element;
+    return element;
+  }
+  //-------------------------------------------------------------------------
+  void ParseDeferredDefinitions(const std::string& groupName)
+  {
+    std::lock_guard<std::recursive_mutex> lock(this->DeferredMutex);
+    auto iter = this->DeferredDefinitions.find(groupName);
+    if (iter != this->DeferredDefinitions.end())
+    {
+      std::vector<std::string> proxyNames;
+      for (const auto& item : iter->second)
+      {
+        proxyNames.push_back(item.first);
+      }
+      for (const auto& proxyName : proxyNames)
+      {
+        this->ParseDeferredDefinition(groupName, proxyName);
+      }
+    }
   }
   //-------------------------------------------------------------------------
   bool HasCustomDefinition(const char* groupName, const char* proxyName)
@@ -103,6 +427,13 @@ public:
   {
     vtkPVXMLElement* elementToReturn = nullptr;
 
+    // Core definitions may be parsed and registered by a concurrent lookup
+    std::unique_lock<std::recursive_mutex> lock(this->DeferredMutex, std::defer_lock);
+    if (&map == &this->CoreDefinitions)
+    {
+      lock.lock();
+    }
+
     // Test if parameters are valid
     if (firstStr && secondStr)
     {
@@ -120,6 +451,12 @@ public:
       }
     }
 
+    // Parse the definition on first access if it was deferred
+    if (!elementToReturn && firstStr && secondStr && &map == &this->CoreDefinitions)
+    {
+      elementToReturn = this->ParseDeferredDefinition(firstStr, secondStr);
+    }
+
     // The result might be nullptr if the value was not found
     return elementToReturn;
   }
@@ -254,6 +591,11 @@ public:
     {
       return this->CustomProxyIterator->second.GetPointer();
     }
+    else if (!this->CoreProxyIterator->second && this->CoreDefinitionParser)
+    {
+      // Definition not parsed yet
+      return this->CoreDefinitionParser(this->CurrentGroupName, this->CoreProxyIterator->first);
+    }
     else
     {
       return this->CoreProxyIterator->second.GetPointer();
@@ -286,6 +628,12 @@ public:
     this->CustomDefinitionMap = map;
     this->InvalidCustomIterator = true;
   }
+  //-------------------------------------------------------------------------
+  void SetCoreDefinitionParser(
+    std::function<vtkPVXMLElement*(const std::string&, const std::string&)> parser)
+  {
+    this->CoreDefinitionParser = std::move(parser);
+  }
 
   //-------------------------------------------------------------------------
   void GoToNextGroup() override { this->NextGroup(); }
@@ -402,6 +750,7 @@ private:
   std::set<std::string>::iterator GroupNameIterator;
   bool InvalidCoreIterator;
   bool InvalidCustomIterator;
+  std::function<vtkPVXMLElement*(const std::string&, const std::string&)> CoreDefinitionParser;
 };
 
 //****************************************************************************
@@ -412,6 +761,7 @@ vtkStandardNewMacro(vtkInternalDefinitionIterator);
 vtkSIProxyDefinitionManager::vtkSIProxyDefinitionManager()
 {
   this->Internals = new vtkInternals;
+  this->Internals->Owner = this;
   this->InternalsFlatten = new vtkInternals;
 
   vtkPVPluginTracker* tracker = vtkPVPluginTracker::GetInstance();
@@ -430,22 +780,24 @@ vtkSIProxyDefinitionManager::vtkSIProxyDefinitionManager()
 
   // Now, process any other loaded plugins. This has to happen after loading the
   // core xmls (BUG #13488).
+  std::vector<vtkPVPlugin*> plugins;
   for (unsigned int cc = 0; cc < tracker->GetNumberOfPlugins(); cc++)
   {
     vtkPVPlugin* plugin = tracker->GetPlugin(cc);
-    if (plugin && strcmp(plugin->GetPluginName(), "vtkPVInitializerPlugin") == 0)
+    if (plugin && strcmp(plugin->GetPluginName(), "vtkPVInitializerPlugin") != 0)
     {
-      continue;
+      plugins.push_back(plugin);
     }
-
-    this->HandlePlugin(plugin);
   }
+  this->HandlePlugins(plugins);
 
   // Register with the plugin tracker, so that when new plugins are loaded,
   // we parse the XML if provided and automatically add it to the proxy
   // definitions.
   tracker->AddObserver(
     vtkCommand::RegisterEvent, this, &vtkSIProxyDefinitionManager::OnPluginLoaded);
+  tracker->AddObserver(vtkPVPluginTracker::RegisterBatchEndEvent, this,
+    &vtkSIProxyDefinitionManager::OnPluginBatchLoaded);
 }
 
 //---------------------------------------------------------------------------
@@ -491,6 +843,7 @@ void vtkSIProxyDefinitionManager::AddElement(
   {
     // Just referenced it
     this->Internals->CoreDefinitions[groupName][proxyName] = element;
+    this->Internals->RemoveDeferredDefinition(groupName, proxyName);
     updated = true;
   }
 
@@ -753,13 +1106,102 @@ bool vtkSIProxyDefinitionManager::LoadConfigurationXMLFromString(const char* xml
 {
   return this->LoadConfigurationXMLFromString(xmlContent, false);
 }
+//---------------------------------------------------------------------------
+// Result of locating the proxy definitions of a configuration xml. Only the
+// extensions, which modify existing definitions, are parsed. Documents that
+// cannot be indexed are parsed as a whole. Preparing a document does not
+// touch the manager, so that documents can be prepared concurrently.
+class vtkSIProxyDefinitionManager::vtkPreparedConfiguration
+{
+public:
+  std::shared_ptr<const std::string> Source;
+  std::vector<vtkDefinitionLocation> Locations;
+  // Parsed extensions, indexed like Locations.
+  std::vector<XMLElement> Extensions;
+  // Set when the document could not be indexed.
+  XMLElement Root;
+  bool Indexed = false;
+
+  void Prepare(const char* xmlContent)
+  {
+    this->Source = std::make_shared<const std::string>(xmlContent ? xmlContent : "");
+    vtkNew<vtkPVXMLParser> parser;
+    if (!vtkIndexConfigurationXML(*this->Source, this->Locations))
+    {
+      this->Locations.clear();
+      if (parser->Parse(this->Source->c_str()))
+      {
+        this->Root = parser->GetRootElement();
+      }
+      return;
+    }
+
+    this->Indexed = true;
+    this->Extensions.resize(this->Locations.size());
+    for (size_t cc = 0; cc < this->Locations.size(); ++cc)
+    {
+      const vtkDefinitionLocation& location = this->Locations[cc];
+      if (location.TagName == "Extension" &&
+        parser->Parse(this->Source->c_str() + location.Begin,
+          static_cast<unsigned int>(location.End - location.Begin)))
+      {
+        this->Extensions[cc] = parser->GetRootElement();
+      }
+    }
+  }
+};
+
 //---------------------------------------------------------------------------
 bool vtkSIProxyDefinitionManager::LoadConfigurationXMLFromString(
   const char* xmlContent, bool attachHints)
 {
-  vtkNew<vtkPVXMLParser> parser;
-  return (parser->Parse(xmlContent) != 0) &&
-    this->LoadConfigurationXML(parser->GetRootElement(), attachHints);
+  vtkPreparedConfiguration prepared;
+  prepared.Prepare(xmlContent);
+  if (!this->RegisterConfigurationXML(prepared, attachHints))
+  {
+    return false;
+  }
+  this->InvokeEvent(vtkSIProxyDefinitionManager::ProxyDefinitionsUpdated);
+  return true;
+}
+
+//---------------------------------------------------------------------------
+bool vtkSIProxyDefinitionManager::RegisterConfigurationXML(
+  const vtkPreparedConfiguration& prepared, bool attachHints)
+{
+  if (!prepared.Indexed)
+  {
+    return this->RegisterConfigurationXML(prepared.Root, attachHints);
+  }
+
+  // Only locate the proxy definitions for now, each one is parsed when first
+  // requested. Most processes only ever use a small fraction of them.
+  for (size_t cc = 0; cc < prepared.Locations.size(); ++cc)
+  {
+    const vtkDefinitionLocation& location = prepared.Locations[cc];
+    if (location.TagName == "Extension")
+    {
+      // Extensions modify an existing definition, apply them right away.
+      if (vtkPVXMLElement* extension = prepared.Extensions[cc])
+      {
+        if (attachHints && (location.GroupName == "sources" || location.GroupName == "filters"))
+        {
+          this->AttachShowInMenuHintsToProxy(extension);
+        }
+        this->AddElement(location.GroupName.c_str(), location.ProxyName.c_str(), extension);
+      }
+      continue;
+    }
+
+    this->Internals->AddDeferredDefinition(location.GroupName, location.ProxyName,
+      { prepared.Source, location.Begin, location.End, attachHints });
+
+    // Let the world know that a core-definition was registered.
+    RegisteredDefinitionInformation info(
+      location.GroupName.c_str(), location.ProxyName.c_str(), false);
+    this->InvokeEvent(vtkCommand::RegisterEvent, &info);
+  }
+  return true;
 }
 
 //---------------------------------------------------------------------------
@@ -770,6 +1212,17 @@ bool vtkSIProxyDefinitionManager::LoadConfigurationXML(vtkPVXMLElement* root)
 
 //---------------------------------------------------------------------------
 bool vtkSIProxyDefinitionManager::LoadConfigurationXML(vtkPVXMLElement* root, bool attachHints)
+{
+  if (!this->RegisterConfigurationXML(root, attachHints))
+  {
+    return false;
+  }
+  this->InvokeEvent(vtkSIProxyDefinitionManager::ProxyDefinitionsUpdated);
+  return true;
+}
+
+//---------------------------------------------------------------------------
+bool vtkSIProxyDefinitionManager::RegisterConfigurationXML(vtkPVXMLElement* root, bool attachHints)
 {
   if (!root)
   {
@@ -779,7 +1232,7 @@ bool vtkSIProxyDefinitionManager::LoadConfigurationXML(vtkPVXMLElement* root, bo
   if (!root->GetName() || strcmp(root->GetName(), "ServerManagerConfiguration") != 0)
   {
     // find nested ServerManagerConfiguration element and process that.
-    return this->LoadConfigurationXML(
+    return this->RegisterConfigurationXML(
       root->FindNestedElementByName("ServerManagerConfiguration"), attachHints);
   }
 
@@ -807,7 +1260,6 @@ bool vtkSIProxyDefinitionManager::LoadConfigurationXML(vtkPVXMLElement* root, bo
       }
     }
   }
-  this->InvokeEvent(vtkSIProxyDefinitionManager::ProxyDefinitionsUpdated);
   return true;
 }
 
@@ -847,6 +1299,11 @@ vtkPVProxyDefinitionIterator* vtkSIProxyDefinitionManager::NewIterator(int scope
       iterator->RegisterCustomDefinitionMap(&this->Internals->CustomsDefinitions);
       break;
   }
+  vtkInternals* internals = this->Internals;
+  iterator->SetCoreDefinitionParser(
+    [internals](const std::string& groupName, const std::string& proxyName) {
+      return internals->ParseDeferredDefinition(groupName, proxyName);
+    });
   return iterator;
 }
 //---------------------------------------------------------------------------
@@ -1076,13 +1533,25 @@ void vtkSIProxyDefinitionManager::Pull(vtkSMMessage* msg)
   iter->GoToFirstItem();
   while (!iter->IsDoneWithTraversal())
   {
-    std::ostringstream xmlContent;
-    iter->GetProxyDefinition()->PrintXML(xmlContent, vtkIndent());
+    // Definitions that were not parsed yet are sent as is.
+    std::string xml;
+    if (!this->Internals->GetDeferredXML(iter->GetGroupName(), iter->GetProxyName(), xml))
+    {
+      vtkPVXMLElement* definition = iter->GetProxyDefinition();
+      if (!definition)
+      {
+        iter->GoToNextItem();
+        continue;
+      }
+      std::ostringstream xmlContent;
+      definition->PrintXML(xmlContent, vtkIndent());
+      xml = xmlContent.str();
+    }
 
     xmlDef = msg->AddExtension(ProxyDefinitionState::xml_definition_proxy);
     xmlDef->set_group(iter->GetGroupName());
     xmlDef->set_name(iter->GetProxyName());
-    xmlDef->set_xml(xmlContent.str());
+    xmlDef->set_xml(xml);
 
     iter->GoToNextItem();
   }
@@ -1113,6 +1582,8 @@ void vtkSIProxyDefinitionManager::Push(vtkSMMessage* msg)
   // proxy definitions on the client side when a server's definitions are
   // loaded. Ideally, we save all proxies that are "client" only. We will do
   // that when we convert this class to use pugixml.
+  this->Internals->ParseDeferredDefinitions("animation_writers");
+  this->Internals->ParseDeferredDefinitions("screenshot_writers");
   const auto animationWriters = this->Internals->CoreDefinitions["animation_writers"];
   const auto screenshotWriters = this->Internals->CoreDefinitions["screenshot_writers"];
 
@@ -1167,40 +1638,104 @@ void vtkSIProxyDefinitionManager::Push(vtkSMMessage* msg)
 }
 
 //---------------------------------------------------------------------------
-void vtkSIProxyDefinitionManager::OnPluginLoaded(vtkObject*, unsigned long, void* calldata)
+void vtkSIProxyDefinitionManager::OnPluginLoaded(vtkObject* caller, unsigned long, void* calldata)
+{
+  vtkPVPlugin* plugin = reinterpret_cast<vtkPVPlugin*>(calldata);
+  vtkPVPluginTracker* tracker = vtkPVPluginTracker::SafeDownCast(caller);
+  if (tracker && tracker->GetInBatch())
+  {
+    // the xmls of all the plugins of the batch are prepared together.
+    this->Internals->PendingPlugins.push_back(plugin);
+    return;
+  }
+  this->HandlePlugin(plugin);
+}
+
+//---------------------------------------------------------------------------
+void vtkSIProxyDefinitionManager::OnPluginBatchLoaded(vtkObject*, unsigned long, void*)
 {
-  this->HandlePlugin(reinterpret_cast<vtkPVPlugin*>(calldata));
+  std::vector<vtkPVPlugin*> plugins;
+  plugins.swap(this->Internals->PendingPlugins);
+  this->HandlePlugins(plugins);
 }
 
 //---------------------------------------------------------------------------
 void vtkSIProxyDefinitionManager::HandlePlugin(vtkPVPlugin* plugin)
 {
-  vtkPVServerManagerPluginInterface* smplugin =
-    dynamic_cast<vtkPVServerManagerPluginInterface*>(plugin);
-  if (smplugin)
+  this->HandlePlugins(std::vector<vtkPVPlugin*>(1, plugin));
+}
+
+//---------------------------------------------------------------------------
+void vtkSIProxyDefinitionManager::HandlePlugins(const std::vector<vtkPVPlugin*>& plugins)
+{
+  // Make sure only the SERVER is processing the XML proxy definition
+  if (!this->Internals->EnableXMLProxyDefinitionUpdate)
   {
-    std::vector<std::string> xmls;
-    smplugin->GetXMLs(xmls);
+    return;
+  }
 
-    // Make sure only the SERVER is processing the XML proxy definition
-    if (this->Internals->EnableXMLProxyDefinitionUpdate)
+  std::vector<std::string> xmls;
+  std::vector<size_t> pluginOffsets(1, 0);
+  for (vtkPVPlugin* plugin : plugins)
+  {
+    if (auto smplugin = dynamic_cast<vtkPVServerManagerPluginInterface*>(plugin))
     {
-      bool tmpReplaceOverrideInParent = this->Internals->ReplaceOverrideInParent;
-      this->Internals->ReplaceOverrideInParent = false;
-      for (size_t cc = 0; cc < xmls.size(); cc++)
-      {
-        this->LoadConfigurationXMLFromString(xmls[cc].c_str(),
-          // if GetPluginName() == vtkPVInitializerPlugin, it implies that it's
-          // the ParaView core and should not be treated as plugin.
-          strcmp(plugin->GetPluginName(), "vtkPVInitializerPlugin") != 0);
-      }
+      // plugins may assign to the vector rather than append to it.
+      std::vector<std::string> pluginXMLs;
+      smplugin->GetXMLs(pluginXMLs);
+      xmls.insert(xmls.end(), std::make_move_iterator(pluginXMLs.begin()),
+        std::make_move_iterator(pluginXMLs.end()));
+    }
+    pluginOffsets.push_back(xmls.size());
+  }
+  if (xmls.empty())
+  {
+    return;
+  }
+
+  // Indexing or parsing a document does not depend on the others, nor on the
+  // definitions already registered, so only that part is done concurrently.
+  // Registering must happen in order, and stays on the calling thread since
+  // callers expect the definitions to be available once the plugin is loaded.
+  vtkTimerLog::MarkStartEvent("vtkSIProxyDefinitionManager Prepare Plugin XMLs");
+  const vtkIdType numberOfXMLs = static_cast<vtkIdType>(xmls.size());
+  std::vector<vtkPreparedConfiguration> prepared(xmls.size());
+  vtkSMPTools::For(0, numberOfXMLs, 1, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType cc = begin; cc < end; ++cc)
+    {
+      prepared[cc].Prepare(xmls[cc].c_str());
+    }
+  });
+  vtkTimerLog::MarkEndEvent("vtkSIProxyDefinitionManager Prepare Plugin XMLs");
 
-      // Make sure we invalidate any cached flatten version of our proxy definition
-      this->InternalsFlatten->Clear();
-      this->Internals->ReplaceOverrideInParent = tmpReplaceOverrideInParent;
+  bool tmpReplaceOverrideInParent = this->Internals->ReplaceOverrideInParent;
+  this->Internals->ReplaceOverrideInParent = false;
+  for (size_t pluginIdx = 0; pluginIdx < plugins.size(); ++pluginIdx)
+  {
+    if (pluginOffsets[pluginIdx] == pluginOffsets[pluginIdx + 1])
+    {
+      continue;
+    }
+    // if GetPluginName() == vtkPVInitializerPlugin, it implies that it's
+    // the ParaView core and should not be treated as plugin.
+    const bool attachHints =
+      strcmp(plugins[pluginIdx]->GetPluginName(), "vtkPVInitializerPlugin") != 0;
+    bool updated = false;
+    for (size_t cc = pluginOffsets[pluginIdx]; cc < pluginOffsets[pluginIdx + 1]; ++cc)
+    {
+      updated = this->RegisterConfigurationXML(prepared[cc], attachHints) || updated;
+    }
+    if (updated)
+    {
+      this->InvokeEvent(vtkSIProxyDefinitionManager::ProxyDefinitionsUpdated);
     }
   }
+
+  // Make sure we invalidate any cached flatten version of our proxy definition
+  this->InternalsFlatten->Clear();
+  this->Internals->ReplaceOverrideInParent = tmpReplaceOverrideInParent;
 }
+
 //---------------------------------------------------------------------------
 bool vtkSIProxyDefinitionManager::HasDefinition(const char* groupName, const char* proxyName)
 {
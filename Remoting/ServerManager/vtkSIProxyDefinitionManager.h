@@ -9,6 +9,17 @@
  * It maintains a map of vtkPVXMLElement (populated by the XML parser) from
  * which it can extract Hint, Documentation, Properties, Domains definition.
  *
+ * Configuration XML loaded from strings, such as the ones embedded in ParaView
+ * and in plugins, is only scanned to locate the proxy definitions it contains.
+ * The vtkPVXMLElement for a definition is built the first time it is requested,
+ * so that processes which only use a few proxies, e.g. Catalyst ranks, do not
+ * pay for parsing all of them.
+ *
+ * Since a lookup may parse and register a definition, lookups such as
+ * GetProxyDefinition() and HasDefinition() are serialized by an internal
+ * mutex and can be called concurrently. Loading or removing definitions is
+ * not thread-safe and must not happen concurrently with lookups.
+ *
  * This class fires the following events:
  * \li \c vtkSIProxyDefinitionManager::ProxyDefinitionsUpdated - Fired any time
  * any definitions are updated. If a group of definitions are being updated (i.e.
@@ -33,6 +44,8 @@
 #include "vtkRemotingServerManagerModule.h" //needed for exports
 #include "vtkSIObject.h"
 
+#include <vector> // for std::vector
+
 class vtkPVPlugin;
 class vtkPVProxyDefinitionIterator;
 class vtkPVXMLElement;
@@ -62,6 +75,8 @@ public:
    * Returns a registered proxy definition or return a nullptr otherwise.
    * Moreover, error can be throw if the definition was not found if the
    * flag throwError is true.
+   * A definition that has not been parsed yet is parsed on this call, exactly
+   * once even when it is requested from several threads.
    */
   vtkPVXMLElement* GetProxyDefinition(const char* group, const char* name, bool throwError);
   vtkPVXMLElement* GetProxyDefinition(const char* group, const char* name)
@@ -260,12 +275,24 @@ protected:
 
   ///@{
   /**
-   * Callback called when a plugin is loaded.
+   * Callbacks called when a plugin is loaded, and at the end of a batch of
+   * plugins loaded together (see vtkPVPluginTracker::BeginBatch()), whose
+   * xmls are then handled together by a single HandlePlugins() call.
    */
   void OnPluginLoaded(vtkObject* caller, unsigned long event, void* calldata);
+  void OnPluginBatchLoaded(vtkObject* caller, unsigned long event, void* calldata);
   void HandlePlugin(vtkPVPlugin*);
   ///@}
 
+  /**
+   * Loads the configuration xmls of several plugins. Only the preparation of
+   * the xmls is concurrent: they are indexed, or parsed when they cannot be
+   * indexed, using vtkSMPTools. The definitions are then registered
+   * synchronously on the calling thread, in the order of the plugins, and
+   * ProxyDefinitionsUpdated is fired once per plugin.
+   */
+  void HandlePlugins(const std::vector<vtkPVPlugin*>& plugins);
+
   /**
    * Called by the XML parser to add an element from which a proxy
    * can be created. Called during parsing.
@@ -316,6 +343,20 @@ private:
   class vtkInternals;
   vtkInternals* Internals;
   vtkInternals* InternalsFlatten;
+
+  ///@{
+  /**
+   * Registers the definitions of a configuration xml, or of a
+   * ServerManagerConfiguration element, without firing
+   * ProxyDefinitionsUpdated. vtkPreparedConfiguration is the result of
+   * indexing or parsing a configuration xml, which does not touch the manager
+   * and may happen on any thread.
+   */
+  class vtkPreparedConfiguration;
+  bool RegisterConfigurationXML(
+    const vtkPreparedConfiguration& prepared, bool attachShowInMenuHints);
+  bool RegisterConfigurationXML(vtkPVXMLElement* root, bool attachShowInMenuHints);
+  ///@}
 };
 
 #endif
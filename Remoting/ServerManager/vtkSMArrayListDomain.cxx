@@ -326,6 +326,7 @@ vtkSMArrayListDomain::vtkSMArrayListDomain()
   this->NoneString = nullptr;
   this->ALDInternals = new vtkSMArrayListDomainInternals;
   this->PickFirstAvailableArrayByDefault = true;
+  this->CacheUpdates = true;
 }
 
 //---------------------------------------------------------------------------
@@ -13,7 +13,10 @@
 vtkStandardNewMacro(vtkSMArrayRangeDomain);
 
 //---------------------------------------------------------------------------
-vtkSMArrayRangeDomain::vtkSMArrayRangeDomain() = default;
+vtkSMArrayRangeDomain::vtkSMArrayRangeDomain()
+{
+  this->CacheUpdates = true;
+}
 
 //---------------------------------------------------------------------------
 vtkSMArrayRangeDomain::~vtkSMArrayRangeDomain() = default;
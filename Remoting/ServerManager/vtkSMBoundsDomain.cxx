@@ -23,6 +23,7 @@ vtkSMBoundsDomain::vtkSMBoundsDomain()
   this->ScaleFactor = 0.1;
   this->AxisFlags = X_Y_AND_Z_AXES;
   this->ArrayRangeDomain = nullptr;
+  this->CacheUpdates = true;
 }
 
 //---------------------------------------------------------------------------
@@ -20,6 +20,7 @@ vtkSMCompositeTreeDomain::vtkSMCompositeTreeDomain()
   , DefaultMode(vtkSMCompositeTreeDomain::DEFAULT)
   , DataInformationTimeStamp(0)
 {
+  this->CacheUpdates = true;
 }
 
 //----------------------------------------------------------------------------
@@ -18,7 +18,10 @@
 
 vtkStandardNewMacro(vtkSMDataAssemblyDomain);
 //----------------------------------------------------------------------------
-vtkSMDataAssemblyDomain::vtkSMDataAssemblyDomain() = default;
+vtkSMDataAssemblyDomain::vtkSMDataAssemblyDomain()
+{
+  this->CacheUpdates = true;
+}
 
 //----------------------------------------------------------------------------
 vtkSMDataAssemblyDomain::~vtkSMDataAssemblyDomain() = default;
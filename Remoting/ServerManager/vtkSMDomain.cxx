@@ -6,13 +6,17 @@
 #include "vtkObjectFactory.h"
 #include "vtkPVXMLElement.h"
 #include "vtkSMProperty.h"
+#include "vtkSMProxyProperty.h"
 #include "vtkSMSession.h"
+#include "vtkSMSessionProxyManager.h"
 #include "vtkSMSourceProxy.h"
 #include "vtkSMUncheckedPropertyHelper.h"
 #include "vtkWeakPointer.h"
 
+#include <algorithm>
 #include <cassert>
 #include <map>
+#include <set>
 
 struct vtkSMDomainInternals
 {
@@ -27,6 +31,27 @@ struct vtkSMDomainInternals
   vtkWeakPointer<vtkSMProperty> DomainProperty;
 };
 
+namespace
+{
+vtkMTimeType vtkGetDataInformationMTime(vtkSMProxy* proxy, std::set<vtkSMProxy*>& visited)
+{
+  if (proxy == nullptr || !visited.insert(proxy).second)
+  {
+    return 0;
+  }
+  vtkMTimeType mtime = 0;
+  if (auto source = vtkSMSourceProxy::SafeDownCast(proxy))
+  {
+    mtime = source->GetDataInformationMTime();
+  }
+  for (unsigned int cc = 0, max = proxy->GetNumberOfProducers(); cc < max; ++cc)
+  {
+    mtime = std::max(mtime, vtkGetDataInformationMTime(proxy->GetProducerProxy(cc), visited));
+  }
+  return mtime;
+}
+}
+
 //---------------------------------------------------------------------------
 vtkSMDomain::DeferDomainModifiedEvents::DeferDomainModifiedEvents(vtkSMDomain* domain)
   : Self(domain)
@@ -59,6 +84,7 @@ vtkSMDomain::vtkSMDomain()
 
   this->DeferDomainModifiedEventsCount = 0;
   this->PendingDomainModifiedEvents = false;
+  this->CacheUpdates = false;
 }
 
 //---------------------------------------------------------------------------
@@ -74,6 +100,50 @@ void vtkSMDomain::Update(vtkSMProperty* vtkNotUsed(requestingProperty))
   this->DomainModified();
 }
 
+//---------------------------------------------------------------------------
+void vtkSMDomain::RequestUpdate(vtkSMProperty* requestingProperty)
+{
+  vtkSMProxy* proxy = requestingProperty ? requestingProperty->GetParent() : nullptr;
+  vtkSMSession* session = proxy ? proxy->GetSession() : nullptr;
+  vtkSMSessionProxyManager* pxm = session ? session->GetSessionProxyManager() : nullptr;
+  if (pxm && pxm->DeferDomainUpdate(this, requestingProperty))
+  {
+    return;
+  }
+
+  if (this->CacheUpdates && this->UpdateTime.GetMTime() > 0 &&
+    this->GetInputsMTime() <= this->UpdateTime.GetMTime())
+  {
+    return;
+  }
+  this->Update(requestingProperty);
+  this->UpdateTime.Modified();
+}
+
+//---------------------------------------------------------------------------
+vtkMTimeType vtkSMDomain::GetInputsMTime()
+{
+  vtkMTimeType mtime = 0;
+  std::set<vtkSMProxy*> visited;
+  for (const auto& item : this->Internals->RequiredProperties)
+  {
+    vtkSMProperty* prop = item.second;
+    if (!prop)
+    {
+      continue;
+    }
+    mtime = std::max({ mtime, prop->GetMTime(), prop->GetUncheckedMTime() });
+    if (auto pp = vtkSMProxyProperty::SafeDownCast(prop))
+    {
+      for (unsigned int cc = 0, max = pp->GetNumberOfUncheckedProxies(); cc < max; ++cc)
+      {
+        mtime = std::max(mtime, vtkGetDataInformationMTime(pp->GetUncheckedProxy(cc), visited));
+      }
+    }
+  }
+  return mtime;
+}
+
 //---------------------------------------------------------------------------
 vtkSMProperty* vtkSMDomain::GetRequiredProperty(const char* function)
 {
@@ -231,6 +301,7 @@ void vtkSMDomain::AddRequiredProperty(vtkSMProperty* prop, const char* function)
 
   prop->AddDependent(this);
   this->Internals->RequiredProperties[function] = prop;
+  this->UpdateTime = vtkTimeStamp();
 }
 
 //---------------------------------------------------------------------------
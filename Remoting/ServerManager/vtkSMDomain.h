@@ -26,6 +26,7 @@
 #include "vtkClientServerID.h"              // needed for saving animation in batch script
 #include "vtkRemotingServerManagerModule.h" //needed for exports
 #include "vtkSMSessionObject.h"
+#include "vtkTimeStamp.h" // for vtkTimeStamp
 
 class vtkPVDataInformation;
 class vtkPVXMLElement;
@@ -196,6 +197,30 @@ protected:
    */
   void AddRequiredProperty(vtkSMProperty* prop, const char* function);
 
+  /**
+   * Called by vtkSMProperty when a required property changes. Calls Update()
+   * unless the session proxy manager of the requesting property is in a batch
+   * update (see vtkSMSessionProxyManager::BeginBatchUpdate()), in which case
+   * the update is performed once when the batch ends, or CacheUpdates is set
+   * and none of the inputs changed since the last update.
+   */
+  void RequestUpdate(vtkSMProperty* requestingProperty);
+
+  /**
+   * Returns the latest modification time of the inputs of this domain: the
+   * required properties, including their unchecked values, and the data
+   * information of the proxies they refer to and of their producers.
+   */
+  vtkMTimeType GetInputsMTime();
+
+  /**
+   * Subclasses whose Update() only depends on the required properties and on
+   * the data information of the proxies they refer to set this to true. Update
+   * requests are then skipped when GetInputsMTime() did not change since the
+   * last update. Default is false.
+   */
+  bool CacheUpdates;
+
   ///@{
   /**
    * When the IsOptional flag is set, IsInDomain() always returns true.
@@ -279,6 +304,9 @@ private:
   friend class DeferDomainModifiedEvents;
   unsigned int DeferDomainModifiedEventsCount;
   bool PendingDomainModifiedEvents;
+
+  // Last time RequestUpdate() called Update().
+  vtkTimeStamp UpdateTime;
 };
 
 #endif
@@ -18,6 +18,7 @@ vtkStandardNewMacro(vtkSMNumberOfComponentsDomain);
 vtkSMNumberOfComponentsDomain::vtkSMNumberOfComponentsDomain()
 {
   this->EnableMagnitude = false;
+  this->CacheUpdates = true;
 }
 
 //----------------------------------------------------------------------------
@@ -64,7 +64,7 @@ vtkSMProperty::vtkSMProperty()
   // Whenever the property fires UncheckedPropertyModifiedEvent, we update any
   // dependent domains.
   this->AddObserver(
-    vtkCommand::UncheckedPropertyModifiedEvent, this, &vtkSMProperty::UpdateDomains);
+    vtkCommand::UncheckedPropertyModifiedEvent, this, &vtkSMProperty::OnUncheckedPropertyModified);
 }
 
 //---------------------------------------------------------------------------
@@ -265,6 +265,13 @@ void vtkSMProperty::RemoveAllDependents()
     this->PInternals->Dependents.begin(), this->PInternals->Dependents.end());
 }
 
+//---------------------------------------------------------------------------
+void vtkSMProperty::OnUncheckedPropertyModified()
+{
+  this->UncheckedMTime.Modified();
+  this->UpdateDomains();
+}
+
 //---------------------------------------------------------------------------
 void vtkSMProperty::UpdateDomains()
 {
@@ -293,7 +300,7 @@ void vtkSMProperty::UpdateDomains()
   vtkSMPropertyInternals::DependentsVector::iterator iter = this->PInternals->Dependents.begin();
   for (; iter != this->PInternals->Dependents.end(); iter++)
   {
-    iter->GetPointer()->Update(this);
+    iter->GetPointer()->RequestUpdate(this);
   }
 }
 
@@ -127,6 +127,7 @@
 #include "vtkSMMessageMinimal.h"            // needed for vtkSMMessage
 #include "vtkSMObject.h"
 #include "vtkSmartPointer.h" // needed for vtkSmartPointer
+#include "vtkTimeStamp.h"    // needed for vtkTimeStamp
 #include "vtkWeakPointer.h"  // needed for vtkWeakPointer
 
 class vtkClientServerStream;
@@ -516,6 +517,14 @@ public:
    */
   bool HasDomainsWithRequiredProperties();
 
+  /**
+   * Returns the last time vtkCommand::UncheckedPropertyModifiedEvent was
+   * fired. Unchecked values can change without modifying the property, so
+   * vtkSMDomain uses this together with GetMTime() to tell whether the
+   * property changed since a domain was last updated.
+   */
+  vtkMTimeType GetUncheckedMTime() { return this->UncheckedMTime.GetMTime(); }
+
   /**
    * Use this method to clear unchecked values set of this property.
    */
@@ -712,8 +721,12 @@ private:
   // domains change.
   void InvokeDomainModifiedEvent();
 
+  // Callback for vtkCommand::UncheckedPropertyModifiedEvent.
+  void OnUncheckedPropertyModified();
+
   bool PendingModifiedEvents;
   bool BlockModifiedEvents;
+  vtkTimeStamp UncheckedMTime;
 };
 
 #define vtkSMPropertyTemplateMacroCase(typeSMProperty, type, prop, call)                           \
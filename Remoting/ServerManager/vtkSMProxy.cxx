@@ -193,6 +193,9 @@ vtkObjectBase* vtkSMProxy::GetClientSideObject()
   {
     this->CreateVTKObjects();
 
+    // The client side object must reflect the states pushed in a batch.
+    this->Session->FlushPushBatch();
+
     vtkTypeUInt32 gid = this->GetGlobalID();
     vtkSIProxy* siProxy = vtkSIProxy::SafeDownCast(this->Session->GetSIObject(gid));
     if (siProxy)
@@ -711,7 +714,18 @@ void vtkSMProxy::UpdateVTKObjects()
   }
 
   this->MarkModified(this);
-  this->InvokeEvent(vtkCommand::UpdateEvent, nullptr);
+
+  vtkSMSessionProxyManager* pxm =
+    this->Session ? this->Session->GetSessionProxyManager() : nullptr;
+  if (pxm && pxm->IsInBatchUpdate())
+  {
+    // Fired when the batch ends, see vtkSMSessionProxyManager::EndBatchUpdate.
+    pxm->DeferUpdateEvent(this);
+  }
+  else
+  {
+    this->InvokeEvent(vtkCommand::UpdateEvent, nullptr);
+  }
 }
 
 //---------------------------------------------------------------------------
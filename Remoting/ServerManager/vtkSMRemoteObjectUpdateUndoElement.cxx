@@ -14,6 +14,87 @@
 
 #include <vtkNew.h>
 
+#include <map>
+#include <string>
+#include <vector>
+
+namespace
+{
+// Removes from `after` the properties that are identical in `before`. Returns
+// false, leaving `after` untouched, if `after` is missing some properties of
+// `before` since those could not be told apart from unchanged ones.
+bool vtkEncodePropertyDelta(const vtkSMMessage& before, vtkSMMessage& after)
+{
+  std::map<std::string, std::string> beforeProperties;
+  for (int cc = 0, max = before.ExtensionSize(ProxyState::property); cc < max; ++cc)
+  {
+    const ProxyState_Property& prop = before.GetExtension(ProxyState::property, cc);
+    beforeProperties[prop.name()] = prop.SerializeAsString();
+  }
+
+  std::vector<ProxyState_Property> changed;
+  size_t numFound = 0;
+  for (int cc = 0, max = after.ExtensionSize(ProxyState::property); cc < max; ++cc)
+  {
+    const ProxyState_Property& prop = after.GetExtension(ProxyState::property, cc);
+    auto iter = beforeProperties.find(prop.name());
+    if (iter == beforeProperties.end())
+    {
+      changed.push_back(prop);
+      continue;
+    }
+    ++numFound;
+    if (iter->second != prop.SerializeAsString())
+    {
+      changed.push_back(prop);
+    }
+  }
+  if (numFound != beforeProperties.size())
+  {
+    return false;
+  }
+
+  after.ClearExtension(ProxyState::property);
+  for (const auto& prop : changed)
+  {
+    after.AddExtension(ProxyState::property)->CopyFrom(prop);
+  }
+  return true;
+}
+
+// Reverts vtkEncodePropertyDelta(): adds to `delta` the properties of
+// `before` it does not have, keeping the order of `before`.
+void vtkDecodePropertyDelta(const vtkSMMessage& before, vtkSMMessage& delta)
+{
+  std::map<std::string, ProxyState_Property> changed;
+  for (int cc = 0, max = delta.ExtensionSize(ProxyState::property); cc < max; ++cc)
+  {
+    const ProxyState_Property& prop = delta.GetExtension(ProxyState::property, cc);
+    changed[prop.name()] = prop;
+  }
+
+  delta.ClearExtension(ProxyState::property);
+  for (int cc = 0, max = before.ExtensionSize(ProxyState::property); cc < max; ++cc)
+  {
+    const ProxyState_Property& prop = before.GetExtension(ProxyState::property, cc);
+    auto iter = changed.find(prop.name());
+    if (iter != changed.end())
+    {
+      delta.AddExtension(ProxyState::property)->CopyFrom(iter->second);
+      changed.erase(iter);
+    }
+    else
+    {
+      delta.AddExtension(ProxyState::property)->CopyFrom(prop);
+    }
+  }
+  for (const auto& item : changed)
+  {
+    delta.AddExtension(ProxyState::property)->CopyFrom(item.second);
+  }
+}
+}
+
 vtkStandardNewMacro(vtkSMRemoteObjectUpdateUndoElement);
 vtkSetObjectImplementationMacro(
   vtkSMRemoteObjectUpdateUndoElement, ProxyLocator, vtkSMProxyLocator);
@@ -21,18 +102,14 @@ vtkSetObjectImplementationMacro(
 vtkSMRemoteObjectUpdateUndoElement::vtkSMRemoteObjectUpdateUndoElement()
 {
   this->ProxyLocator = nullptr;
-  this->AfterState = new vtkSMMessage();
-  this->BeforeState = new vtkSMMessage();
+  this->GlobalId = 0;
+  this->AfterStateIsDelta = false;
+  this->SetMergeable(true);
 }
 
 //-----------------------------------------------------------------------------
 vtkSMRemoteObjectUpdateUndoElement::~vtkSMRemoteObjectUpdateUndoElement()
 {
-  delete this->AfterState;
-  delete this->BeforeState;
-  this->AfterState = nullptr;
-  this->BeforeState = nullptr;
-
   this->SetProxyLocator(nullptr);
 }
 
@@ -41,23 +118,26 @@ void vtkSMRemoteObjectUpdateUndoElement::PrintSelf(ostream& os, vtkIndent indent
 {
   this->Superclass::PrintSelf(os, indent);
   os << indent << "GlobalId: " << this->GetGlobalId() << endl;
+  vtkSMMessage state;
   os << indent << "Before state: " << endl;
-  if (this->BeforeState)
-    this->BeforeState->PrintDebugString();
+  if (this->GetBeforeState(&state))
+    state.PrintDebugString();
   os << indent << "After state: " << endl;
-  if (this->AfterState)
-    this->AfterState->PrintDebugString();
+  if (this->GetAfterState(&state))
+    state.PrintDebugString();
 }
 //-----------------------------------------------------------------------------
 int vtkSMRemoteObjectUpdateUndoElement::Undo()
 {
-  return this->UpdateState(this->BeforeState);
+  vtkSMMessage state;
+  return this->GetBeforeState(&state) ? this->UpdateState(&state) : 1;
 }
 
 //-----------------------------------------------------------------------------
 int vtkSMRemoteObjectUpdateUndoElement::Redo()
 {
-  return this->UpdateState(this->AfterState);
+  vtkSMMessage state;
+  return this->GetAfterState(&state) ? this->UpdateState(&state) : 1;
 }
 
 //-----------------------------------------------------------------------------
@@ -93,12 +173,23 @@ int vtkSMRemoteObjectUpdateUndoElement::UpdateState(const vtkSMMessage* state)
 void vtkSMRemoteObjectUpdateUndoElement::SetUndoRedoState(
   const vtkSMMessage* before, const vtkSMMessage* after)
 {
-  this->BeforeState->Clear();
-  this->AfterState->Clear();
+  this->GlobalId = 0;
+  this->BeforeStateData.clear();
+  this->AfterStateData.clear();
+  this->AfterStateIsDelta = false;
   if (before && after)
   {
-    this->BeforeState->CopyFrom(*before);
-    this->AfterState->CopyFrom(*after);
+    this->GlobalId = before->global_id();
+    before->SerializeToString(&this->BeforeStateData);
+
+    vtkSMMessage delta;
+    delta.CopyFrom(*after);
+    this->AfterStateIsDelta = vtkEncodePropertyDelta(*before, delta);
+    delta.SerializeToString(&this->AfterStateData);
+
+    // The states are kept for the lifetime of the undo stack.
+    this->BeforeStateData.shrink_to_fit();
+    this->AfterStateData.shrink_to_fit();
   }
   else
   {
@@ -106,8 +197,59 @@ void vtkSMRemoteObjectUpdateUndoElement::SetUndoRedoState(
       << "At least one of the provided states is NULL.");
   }
 }
+
+//-----------------------------------------------------------------------------
+bool vtkSMRemoteObjectUpdateUndoElement::GetBeforeState(vtkSMMessage* state)
+{
+  state->Clear();
+  return !this->BeforeStateData.empty() && state->ParseFromString(this->BeforeStateData);
+}
+
+//-----------------------------------------------------------------------------
+bool vtkSMRemoteObjectUpdateUndoElement::GetAfterState(vtkSMMessage* state)
+{
+  state->Clear();
+  if (this->AfterStateData.empty() || !state->ParseFromString(this->AfterStateData))
+  {
+    return false;
+  }
+  if (this->AfterStateIsDelta)
+  {
+    vtkSMMessage before;
+    this->GetBeforeState(&before);
+    vtkDecodePropertyDelta(before, *state);
+  }
+  return true;
+}
+
+//-----------------------------------------------------------------------------
+bool vtkSMRemoteObjectUpdateUndoElement::Merge(vtkUndoElement* new_element)
+{
+  auto other = vtkSMRemoteObjectUpdateUndoElement::SafeDownCast(new_element);
+  if (!other || other->GetSession() != this->GetSession() || other->GlobalId != this->GlobalId ||
+    this->BeforeStateData.empty())
+  {
+    return false;
+  }
+
+  vtkSMMessage before;
+  vtkSMMessage after;
+  if (!this->GetBeforeState(&before) || !other->GetAfterState(&after))
+  {
+    return false;
+  }
+  this->SetUndoRedoState(&before, &after);
+  return true;
+}
+
+//-----------------------------------------------------------------------------
+vtkTypeUInt64 vtkSMRemoteObjectUpdateUndoElement::GetMemorySize()
+{
+  return sizeof(*this) + this->BeforeStateData.capacity() + this->AfterStateData.capacity();
+}
+
 //-----------------------------------------------------------------------------
 vtkTypeUInt32 vtkSMRemoteObjectUpdateUndoElement::GetGlobalId()
 {
-  return this->BeforeState->global_id();
+  return this->GlobalId;
 }
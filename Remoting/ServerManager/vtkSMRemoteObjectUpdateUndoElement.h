@@ -7,6 +7,10 @@
  * This class keeps the before and after state of the RemoteObject in the
  * vtkSMMessage form. It works with any proxy and RemoteObject. It is a very
  * generic undoElement.
+ *
+ * The states are kept serialized. The after state only stores the properties
+ * that differ from the before state. Consecutive elements updating the same
+ * remote object are merged together when added to a vtkUndoSet.
  */
 
 #ifndef vtkSMRemoteObjectUpdateUndoElement_h
@@ -17,6 +21,8 @@
 #include "vtkSMUndoElement.h"
 #include "vtkWeakPointer.h" //  needed for vtkWeakPointer.
 
+#include <string> // for std::string
+
 class vtkSMProxyLocator;
 
 class VTKREMOTINGSERVERMANAGER_EXPORT vtkSMRemoteObjectUpdateUndoElement : public vtkSMUndoElement
@@ -48,12 +54,29 @@ public:
    */
   virtual void SetUndoRedoState(const vtkSMMessage* before, const vtkSMMessage* after);
 
-  // Current full state of the UndoElement
-  vtkSMMessage* BeforeState;
-  vtkSMMessage* AfterState;
+  ///@{
+  /**
+   * Decode the full state of the remote object before/after the change into
+   * \c state. Returns false if no state was set.
+   */
+  bool GetBeforeState(vtkSMMessage* state);
+  bool GetAfterState(vtkSMMessage* state);
+  ///@}
 
   virtual vtkTypeUInt32 GetGlobalId();
 
+  /**
+   * Merges \c new_element into this one when both update the same remote
+   * object: this element then goes from its before state to the after state
+   * of \c new_element.
+   */
+  bool Merge(vtkUndoElement* new_element) override;
+
+  /**
+   * Returns the size of the serialized states, in bytes.
+   */
+  vtkTypeUInt64 GetMemorySize() override;
+
 protected:
   vtkSMRemoteObjectUpdateUndoElement();
   ~vtkSMRemoteObjectUpdateUndoElement() override;
@@ -63,6 +86,16 @@ protected:
 
   vtkSMProxyLocator* ProxyLocator;
 
+  vtkTypeUInt32 GlobalId;
+
+  // Serialized before state.
+  std::string BeforeStateData;
+
+  // Serialized after state. When AfterStateIsDelta is true, the properties
+  // whose value is the same in the before state are not part of it.
+  std::string AfterStateData;
+  bool AfterStateIsDelta;
+
 private:
   vtkSMRemoteObjectUpdateUndoElement(const vtkSMRemoteObjectUpdateUndoElement&) = delete;
   void operator=(const vtkSMRemoteObjectUpdateUndoElement&) = delete;
@@ -55,6 +55,7 @@ vtkSMSession::vtkSMSession(bool initialize_during_constructor /*=true*/,
 
   this->SessionProxyManager = nullptr;
   this->StateLocator = vtkSMStateLocator::New();
+  this->PushBatchDepth = 0;
 
   // Create and setup deserializer for the local ProxyLocator
   vtkNew<vtkSMDeserializerProtobuf> deserializer;
@@ -114,6 +115,26 @@ void vtkSMSession::PushState(vtkSMMessage* msg)
   this->Superclass::PushState(msg);
 }
 
+//----------------------------------------------------------------------------
+void vtkSMSession::BeginPushBatch()
+{
+  ++this->PushBatchDepth;
+}
+
+//----------------------------------------------------------------------------
+void vtkSMSession::EndPushBatch()
+{
+  if (this->PushBatchDepth <= 0)
+  {
+    vtkWarningMacro("EndPushBatch called without a matching BeginPushBatch.");
+    return;
+  }
+  if (--this->PushBatchDepth == 0)
+  {
+    this->FlushPushBatch();
+  }
+}
+
 //----------------------------------------------------------------------------
 void vtkSMSession::UpdateStateHistory(vtkSMMessage* msg)
 {
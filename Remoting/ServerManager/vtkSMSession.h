@@ -132,6 +132,29 @@ public:
    */
   void PushState(vtkSMMessage* msg) override;
 
+  ///@{
+  /**
+   * Open/close a batch of state pushes. While a batch is open, sessions
+   * connected to remote servers queue the states sent with PushState() and
+   * send them to the servers as a single message when the outermost batch is
+   * closed, or earlier if any other request has to be sent to the servers.
+   * Batches can be nested. Applications generally use
+   * vtkSMSessionProxyManager::BeginBatchUpdate() instead.
+   */
+  void BeginPushBatch();
+  void EndPushBatch();
+  bool GetIsPushBatchOpen() const { return this->PushBatchDepth > 0; }
+  ///@}
+
+  /**
+   * Sends the states queued while a push batch is open, without closing it.
+   * Called when the outermost batch is closed, and before anything that
+   * depends on the pushed states, e.g. accessing client side objects. The
+   * default implementation does nothing since the states are pushed
+   * immediately.
+   */
+  virtual void FlushPushBatch() {}
+
   /**
    * Sends the message to all clients.
    */
@@ -303,6 +326,7 @@ protected:
   vtkSMSessionProxyManager* SessionProxyManager;
   vtkSMStateLocator* StateLocator;
   vtkSMProxyLocator* ProxyLocator;
+  int PushBatchDepth;
 
 private:
   vtkSMSession(const vtkSMSession&) = delete;
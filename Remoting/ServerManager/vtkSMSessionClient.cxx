@@ -522,6 +522,7 @@ bool vtkSMSessionClient::IsMPIInitialized(vtkTypeUInt32 servers)
 //----------------------------------------------------------------------------
 void vtkSMSessionClient::CloseSession()
 {
+  this->FlushPushBatch();
   if (this->DataServerController)
   {
     this->DataServerController->TriggerRMIOnAllChildren(vtkPVSessionServer::CLOSE_SESSION);
@@ -574,6 +575,16 @@ void vtkSMSessionClient::PushState(vtkSMMessage* message)
 
   vtkTypeUInt32 location = this->GetRealLocation(message->location());
   message->set_location(location);
+
+  if (this->GetIsPushBatchOpen())
+  {
+    // Both the remote and the local parts of the state are applied in
+    // FlushPushBatch(), so that states are applied in the order they were
+    // pushed on every process.
+    this->PendingPushes.emplace_back(location, message->SerializeAsString());
+    return;
+  }
+
   int num_controllers = 0;
   vtkMultiProcessController* controllers[2] = { nullptr, nullptr };
 
@@ -605,46 +616,16 @@ void vtkSMSessionClient::PushState(vtkSMMessage* message)
 
     // For collaboration purpose we might need to share the proxy state with
     // other clients
-    if (num_controllers == 0 && this->IsMultiClients())
+    vtkSMMessage msg;
+    if (num_controllers == 0 && this->GetStateToShare(message, msg))
     {
-      vtkSMRemoteObject* remoteObject =
-        vtkSMRemoteObject::SafeDownCast(this->GetRemoteObject(message->global_id()));
-      vtkSMMessage msg;
-      if (remoteObject && remoteObject->GetFullState() == nullptr)
-      {
-        vtkWarningMacro("The following vtkRemoteObject ("
-          << remoteObject->GetClassName() << "-" << remoteObject->GetGlobalIDAsString()
-          << ") does not support properly GetFullState() so no "
-          << "collaboration mechanisme could be applied to it.");
-      }
-      else if (remoteObject && !remoteObject->IsLocalPushOnly())
-      {
-        msg.CopyFrom(remoteObject ? *remoteObject->GetFullState() : *message);
-        msg.set_global_id(message->global_id());
-        msg.set_location(message->location());
-
-        // Add extra-information
-        msg.set_share_only(true);
-        msg.set_client_id(this->ServerInformation->GetClientId());
-
-        vtkMultiProcessStream stream;
-        stream << static_cast<int>(vtkPVSessionServer::PUSH);
-        stream << msg.SerializeAsString();
-        std::vector<unsigned char> raw_message;
-        stream.GetRawData(raw_message);
-        this->DataServerController->TriggerRMIOnAllChildren(&raw_message[0],
-          static_cast<int>(raw_message.size()), vtkPVSessionServer::CLIENT_SERVER_MESSAGE_RMI);
-      }
-      else if (!remoteObject)
-      {
-        // This issue seems to happen only sometime on amber12 in collaboration
-        // and are hard to reproduce
-        // If we get time to figure out how this situation happen and why that
-        // would be nice but for now, we'll just keep a warning around as
-        // this case is harmless.
-        vtkWarningMacro("No remote object found for corresponding state: " << message->global_id());
-        message->PrintDebugString();
-      }
+      vtkMultiProcessStream stream;
+      stream << static_cast<int>(vtkPVSessionServer::PUSH);
+      stream << msg.SerializeAsString();
+      std::vector<unsigned char> raw_message;
+      stream.GetRawData(raw_message);
+      this->DataServerController->TriggerRMIOnAllChildren(&raw_message[0],
+        static_cast<int>(raw_message.size()), vtkPVSessionServer::CLIENT_SERVER_MESSAGE_RMI);
     }
   }
   else
@@ -655,9 +636,137 @@ void vtkSMSessionClient::PushState(vtkSMMessage* message)
   }
 }
 
+//----------------------------------------------------------------------------
+bool vtkSMSessionClient::GetStateToShare(vtkSMMessage* message, vtkSMMessage& shared)
+{
+  if (!this->IsMultiClients())
+  {
+    return false;
+  }
+
+  vtkSMRemoteObject* remoteObject =
+    vtkSMRemoteObject::SafeDownCast(this->GetRemoteObject(message->global_id()));
+  if (remoteObject && remoteObject->GetFullState() == nullptr)
+  {
+    vtkWarningMacro("The following vtkRemoteObject ("
+      << remoteObject->GetClassName() << "-" << remoteObject->GetGlobalIDAsString()
+      << ") does not support properly GetFullState() so no "
+      << "collaboration mechanisme could be applied to it.");
+  }
+  else if (remoteObject && !remoteObject->IsLocalPushOnly())
+  {
+    shared.CopyFrom(*remoteObject->GetFullState());
+    shared.set_global_id(message->global_id());
+    shared.set_location(message->location());
+
+    // Add extra-information
+    shared.set_share_only(true);
+    shared.set_client_id(this->ServerInformation->GetClientId());
+    return true;
+  }
+  else if (!remoteObject)
+  {
+    // This issue seems to happen only sometime on amber12 in collaboration
+    // and are hard to reproduce
+    // If we get time to figure out how this situation happen and why that
+    // would be nice but for now, we'll just keep a warning around as
+    // this case is harmless.
+    vtkWarningMacro("No remote object found for corresponding state: " << message->global_id());
+    message->PrintDebugString();
+  }
+  return false;
+}
+
+//----------------------------------------------------------------------------
+void vtkSMSessionClient::FlushPushBatch()
+{
+  if (this->PendingPushes.empty())
+  {
+    return;
+  }
+
+  std::vector<std::pair<vtkTypeUInt32, std::string>> pending;
+  pending.swap(this->PendingPushes);
+
+  std::vector<vtkSMMessage> states(pending.size());
+  for (size_t idx = 0; idx < pending.size(); ++idx)
+  {
+    states[idx].ParseFromString(pending[idx].second);
+  }
+
+  // Collect the states to send to each server, in order. States that are only
+  // applied on the client are shared with the other clients through the data
+  // server, along with the other states of the batch.
+  vtkMultiProcessController* controllers[2] = { this->DataServerController,
+    this->RenderServerController };
+  const vtkTypeUInt32 masks[2] = { vtkPVSession::DATA_SERVER | vtkPVSession::DATA_SERVER_ROOT,
+    vtkPVSession::RENDER_SERVER | vtkPVSession::RENDER_SERVER_ROOT };
+  std::vector<std::string> messages[2];
+  for (size_t idx = 0; idx < pending.size(); ++idx)
+  {
+    const vtkTypeUInt32 location = pending[idx].first;
+    for (int cc = 0; cc < 2; cc++)
+    {
+      if ((location & masks[cc]) != 0)
+      {
+        messages[cc].push_back(pending[idx].second);
+      }
+    }
+
+    vtkSMMessage shared;
+    if ((location & vtkPVSession::CLIENT) != 0 && (location & (masks[0] | masks[1])) == 0 &&
+      this->GetStateToShare(&states[idx], shared))
+    {
+      messages[0].push_back(shared.SerializeAsString());
+    }
+  }
+
+  for (int cc = 0; cc < 2; cc++)
+  {
+    if (controllers[cc] == nullptr || messages[cc].empty())
+    {
+      continue;
+    }
+
+    vtkMultiProcessStream stream;
+    if (messages[cc].size() == 1)
+    {
+      stream << static_cast<int>(vtkPVSessionServer::PUSH) << messages[cc][0];
+    }
+    else
+    {
+      stream << static_cast<int>(vtkPVSessionServer::PUSH_BATCH)
+             << static_cast<int>(messages[cc].size());
+      for (const std::string& message : messages[cc])
+      {
+        stream << message;
+      }
+    }
+    std::vector<unsigned char> raw_message;
+    stream.GetRawData(raw_message);
+    controllers[cc]->TriggerRMIOnAllChildren(&raw_message[0],
+      static_cast<int>(raw_message.size()), vtkPVSessionServer::CLIENT_SERVER_MESSAGE_RMI);
+  }
+
+  // Apply the local parts once the servers have received the states, as it is
+  // done for states pushed outside of a batch.
+  for (auto& state : states)
+  {
+    if ((state.location() & vtkPVSession::CLIENT) != 0)
+    {
+      this->Superclass::PushState(&state);
+    }
+    else
+    {
+      this->UpdateStateHistory(&state);
+    }
+  }
+}
+
 //----------------------------------------------------------------------------
 void vtkSMSessionClient::PullState(vtkSMMessage* message)
 {
+  this->FlushPushBatch();
   this->StartBusyWork();
   vtkTypeUInt32 location = this->GetRealLocation(message->location());
   message->set_location(location);
@@ -714,6 +823,9 @@ void vtkSMSessionClient::ExecuteStream(
     return;
   }
 
+  // Even client-only streams may trigger communication with the servers, e.g.
+  // rendering, so queued states must be sent first.
+  this->FlushPushBatch();
   location = this->GetRealLocation(location);
 
   vtkMultiProcessController* controllers[2] = { nullptr, nullptr };
@@ -757,6 +869,7 @@ void vtkSMSessionClient::ExecuteStream(
 //----------------------------------------------------------------------------
 const vtkClientServerStream& vtkSMSessionClient::GetLastResult(vtkTypeUInt32 location)
 {
+  this->FlushPushBatch();
   this->StartBusyWork();
   location = this->GetRealLocation(location);
 
@@ -805,6 +918,7 @@ const vtkClientServerStream& vtkSMSessionClient::GetLastResult(vtkTypeUInt32 loc
 bool vtkSMSessionClient::GatherInformation(
   vtkTypeUInt32 location, vtkPVInformation* information, vtkTypeUInt32 globalid)
 {
+  this->FlushPushBatch();
   this->StartBusyWork();
   if (this->RenderServerController == nullptr)
   {
@@ -904,6 +1018,8 @@ void vtkSMSessionClient::UnRegisterSIObject(vtkSMMessage* message)
     return;
   }
 
+  this->FlushPushBatch();
+
   vtkTypeUInt32 location = this->GetRealLocation(message->location());
   message->set_location(location);
   message->set_client_id(this->GetServerInformation()->GetClientId());
@@ -945,6 +1061,8 @@ void vtkSMSessionClient::RegisterSIObject(vtkSMMessage* message)
     return;
   }
 
+  this->FlushPushBatch();
+
   vtkTypeUInt32 location = this->GetRealLocation(message->location());
   message->set_location(location);
   message->set_client_id(this->GetServerInformation()->GetClientId());
@@ -1036,7 +1154,7 @@ void vtkSMSessionClient::OnServerNotificationMessageRMI(void* message, int messa
 }
 //-----------------------------------------------------------------------------
 bool vtkSMSessionClient::OnWrongTagEvent(
-  vtkObject* vtkNotUsed(obj), unsigned long vtkNotUsed(event), void* calldata)
+  vtkObject* obj, unsigned long vtkNotUsed(event), void* calldata)
 {
   int tag = -1;
   const char* data = reinterpret_cast<const char*>(calldata);
@@ -1049,6 +1167,13 @@ bool vtkSMSessionClient::OnWrongTagEvent(
     vtkSocketCommunicator::SafeDownCast(this->DataServerController->GetCommunicator())
       ->BufferCurrentMessage();
   }
+  else if (tag == vtkPVSession::IMAGE_DELIVERY_TAG &&
+    vtkSocketCommunicator::SafeDownCast(obj) != nullptr)
+  {
+    // images rendered asynchronously may be received before the reply we are
+    // waiting for, buffer them until the view processes them.
+    vtkSocketCommunicator::SafeDownCast(obj)->BufferCurrentMessage();
+  }
   else
   {
     cout << "Wrong tag but don't know how to handle it... " << tag << endl;
@@ -14,6 +14,10 @@
 #include "vtkRemotingServerManagerModule.h" //needed for exports
 #include "vtkSMSession.h"
 
+#include <string>  // for std::string
+#include <utility> // for std::pair
+#include <vector>  // for std::vector
+
 class vtkMultiProcessController;
 class vtkPVServerInformation;
 class vtkSMCollaborationManager;
@@ -97,6 +101,13 @@ public:
    */
   void Initialize() override;
 
+  /**
+   * Sends the states queued while a push batch was open, using a single
+   * message per server, then applies their local parts in the order they
+   * were pushed.
+   */
+  void FlushPushBatch() override;
+
   ///@{
   /**
    * Push the state.
@@ -239,6 +250,13 @@ protected:
    */
   vtkTypeUInt32 GetRealLocation(vtkTypeUInt32);
 
+  /**
+   * Fills `shared` with the full state of the object the state was pushed for,
+   * when it has to be shared with the other clients of a collaborative
+   * session. Returns false if the state must not be shared.
+   */
+  bool GetStateToShare(vtkSMMessage* message, vtkSMMessage& shared);
+
   // Both maybe the same when connected to pvserver.
   vtkMultiProcessController* RenderServerController;
   vtkMultiProcessController* DataServerController;
@@ -278,6 +296,8 @@ private:
   void operator=(const vtkSMSessionClient&) = delete;
 
   int NotBusy;
+  // States pushed while a push batch is open, with their real location.
+  std::vector<std::pair<vtkTypeUInt32, std::string>> PendingPushes;
   vtkTypeUInt32 LastGlobalID;
   vtkTypeUInt32 LastGlobalIDAvailable;
 };
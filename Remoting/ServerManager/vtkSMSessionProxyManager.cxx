@@ -902,6 +902,7 @@ void vtkSMSessionProxyManager::RegisterProxy(
 void vtkSMSessionProxyManager::UpdateRegisteredProxies(
   const char* groupname, int modified_only /*=1*/)
 {
+  std::vector<vtkSmartPointer<vtkSMProxy>> proxies;
   vtkSMSessionProxyManagerInternals::ProxyGroupType::iterator it =
     this->Internals->RegisteredProxyMap.find(groupname);
   if (it != this->Internals->RegisteredProxyMap.end())
@@ -917,12 +918,12 @@ void vtkSMSessionProxyManager::UpdateRegisteredProxies(
           this->Internals->ModifiedProxies.find(it3->GetPointer()->Proxy.GetPointer()) !=
             this->Internals->ModifiedProxies.end())
         {
-          it3->GetPointer()->Proxy.GetPointer()->UpdateVTKObjects();
-          it3->GetPointer()->Proxy.GetPointer()->UpdatePipelineInformation();
+          proxies.emplace_back(it3->GetPointer()->Proxy.GetPointer());
         }
       }
     }
   }
+  this->UpdateProxies(proxies);
 }
 
 //---------------------------------------------------------------------------
@@ -930,6 +931,7 @@ void vtkSMSessionProxyManager::UpdateRegisteredProxies(int modified_only /*=1*/)
 {
   vtksys::RegularExpression prototypesRe("_prototypes$");
 
+  std::vector<vtkSmartPointer<vtkSMProxy>> proxies;
   vtkSMSessionProxyManagerInternals::ProxyGroupType::iterator it =
     this->Internals->RegisteredProxyMap.begin();
   for (; it != this->Internals->RegisteredProxyMap.end(); it++)
@@ -952,12 +954,125 @@ void vtkSMSessionProxyManager::UpdateRegisteredProxies(int modified_only /*=1*/)
           this->Internals->ModifiedProxies.find(it3->GetPointer()->Proxy.GetPointer()) !=
             this->Internals->ModifiedProxies.end())
         {
-          it3->GetPointer()->Proxy.GetPointer()->UpdateVTKObjects();
-          it3->GetPointer()->Proxy.GetPointer()->UpdatePipelineInformation();
+          proxies.emplace_back(it3->GetPointer()->Proxy.GetPointer());
         }
       }
     }
   }
+  this->UpdateProxies(proxies);
+}
+
+//---------------------------------------------------------------------------
+void vtkSMSessionProxyManager::UpdateProxies(
+  const std::vector<vtkSmartPointer<vtkSMProxy>>& proxies)
+{
+  // Push the properties of all proxies in one batch first: updating the
+  // pipeline information requires a round trip to the server which would
+  // flush the batch after each proxy otherwise.
+  this->BeginBatchUpdate();
+  for (const auto& proxy : proxies)
+  {
+    proxy->UpdateVTKObjects();
+  }
+  this->EndBatchUpdate();
+
+  for (const auto& proxy : proxies)
+  {
+    proxy->UpdatePipelineInformation();
+  }
+}
+
+//---------------------------------------------------------------------------
+void vtkSMSessionProxyManager::BeginBatchUpdate()
+{
+  ++this->Internals->BatchUpdateDepth;
+  if (this->Session)
+  {
+    this->Session->BeginPushBatch();
+  }
+}
+
+//---------------------------------------------------------------------------
+void vtkSMSessionProxyManager::EndBatchUpdate()
+{
+  auto& internals = *this->Internals;
+  if (internals.BatchUpdateDepth <= 0)
+  {
+    vtkWarningMacro("EndBatchUpdate called without a matching BeginBatchUpdate.");
+    return;
+  }
+
+  if (internals.BatchUpdateDepth == 1)
+  {
+    // Update the domains first so that observers see up-to-date domains.
+    // Updates requested meanwhile are performed immediately.
+    internals.PerformingDeferredDomainUpdates = true;
+    std::vector<vtkSMSessionProxyManagerInternals::DomainUpdateType> updates;
+    updates.swap(internals.DeferredDomainUpdates);
+    internals.DeferredDomainUpdateSet.clear();
+    for (const auto& update : updates)
+    {
+      if (update.first && update.second)
+      {
+        update.first->RequestUpdate(update.second);
+      }
+    }
+    internals.PerformingDeferredDomainUpdates = false;
+
+    // Fire the deferred events while the batch is still open so that the
+    // updates triggered by observers (e.g. links) are sent with the batch.
+    while (!internals.DeferredUpdateEventProxies.empty())
+    {
+      std::vector<vtkWeakPointer<vtkSMProxy>> proxies;
+      proxies.swap(internals.DeferredUpdateEventProxies);
+      internals.DeferredUpdateEventProxySet.clear();
+      for (const auto& proxy : proxies)
+      {
+        if (proxy)
+        {
+          proxy->InvokeEvent(vtkCommand::UpdateEvent, nullptr);
+        }
+      }
+    }
+  }
+
+  --internals.BatchUpdateDepth;
+  if (this->Session)
+  {
+    this->Session->EndPushBatch();
+  }
+}
+
+//---------------------------------------------------------------------------
+bool vtkSMSessionProxyManager::IsInBatchUpdate()
+{
+  return this->Internals->BatchUpdateDepth > 0;
+}
+
+//---------------------------------------------------------------------------
+void vtkSMSessionProxyManager::DeferUpdateEvent(vtkSMProxy* proxy)
+{
+  auto& internals = *this->Internals;
+  if (internals.DeferredUpdateEventProxySet.insert(proxy).second)
+  {
+    internals.DeferredUpdateEventProxies.emplace_back(proxy);
+  }
+}
+
+//---------------------------------------------------------------------------
+bool vtkSMSessionProxyManager::DeferDomainUpdate(
+  vtkSMDomain* domain, vtkSMProperty* requestingProperty)
+{
+  auto& internals = *this->Internals;
+  if (internals.BatchUpdateDepth <= 0 || internals.PerformingDeferredDomainUpdates)
+  {
+    return false;
+  }
+  if (internals.DeferredDomainUpdateSet.emplace(domain, requestingProperty).second)
+  {
+    internals.DeferredDomainUpdates.emplace_back(domain, requestingProperty);
+  }
+  return true;
 }
 
 //---------------------------------------------------------------------------
@@ -1220,6 +1335,7 @@ void vtkSMSessionProxyManager::LoadXMLState(vtkPVXMLElement* rootElement,
 
   bool prev = this->InLoadXMLState;
   this->InLoadXMLState = true;
+  this->BeginBatchUpdate();
   vtkSmartPointer<vtkSMStateLoader> spLoader;
   if (!loader)
   {
@@ -1230,7 +1346,9 @@ void vtkSMSessionProxyManager::LoadXMLState(vtkPVXMLElement* rootElement,
   {
     spLoader = loader;
   }
-  if (spLoader->LoadState(rootElement, keepOriginalIds))
+  const bool loaded = spLoader->LoadState(rootElement, keepOriginalIds);
+  this->EndBatchUpdate();
+  if (loaded)
   {
     vtkSMProxyManager::LoadStateInformation info;
     info.RootElement = rootElement;
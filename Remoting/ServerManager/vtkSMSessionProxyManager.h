@@ -108,12 +108,14 @@
 
 #include <set>    // needed for std::set
 #include <string> // needed for std::string
+#include <vector> // needed for std::vector
 
 class vtkCollection;
 class vtkEventForwarderCommand;
 class vtkPVXMLElement;
 class vtkSMCompoundSourceProxy;
 class vtkSMDocumentation;
+class vtkSMDomain;
 class vtkSMLink;
 class vtkSMProperty;
 class vtkSMProxy;
@@ -304,6 +306,25 @@ public:
   void UpdateRegisteredProxies(int modified_only = 1);
   ///@}
 
+  ///@{
+  /**
+   * Batch the updates of many proxies. Between BeginBatchUpdate() and
+   * EndBatchUpdate(), the states pushed by vtkSMProxy::UpdateVTKObjects() on
+   * any proxy are queued and sent to the server as a single message, and the
+   * vtkCommand::UpdateEvent fired by the updated proxies is deferred until the
+   * batch ends. The queued states are sent earlier if any request needing a
+   * reply is made to the server, so the order of the operations is preserved.
+   * Batches can be nested; only the outermost EndBatchUpdate() sends the
+   * states and fires the events. This greatly reduces the cost of applying
+   * changes to many proxies on high-latency connections.
+   *
+   * UpdateRegisteredProxies() and LoadXMLState() use a batch internally.
+   */
+  void BeginBatchUpdate();
+  void EndBatchUpdate();
+  bool IsInBatchUpdate();
+  ///@}
+
   ///@{
   /**
    * Updates all registered proxies in order, respecting dependencies
@@ -600,6 +621,7 @@ protected:
   vtkSMSessionProxyManager(vtkSMSession*);
   ~vtkSMSessionProxyManager() override;
 
+  friend class vtkSMDomain;
   friend class vtkSMProxy;
   friend class vtkPVProxyDefinitionIterator;
   friend class vtkSMProxyIterator;
@@ -637,6 +659,26 @@ protected:
   void UnMarkProxyAsModified(vtkSMProxy*);
   ///@}
 
+  /**
+   * Calls UpdateVTKObjects() on all `proxies` in a single batch, then updates
+   * their pipeline information.
+   */
+  void UpdateProxies(const std::vector<vtkSmartPointer<vtkSMProxy>>& proxies);
+
+  /**
+   * Called by vtkSMProxy::UpdateVTKObjects() during a batch update to have the
+   * vtkCommand::UpdateEvent fired on `proxy` when the batch ends.
+   */
+  void DeferUpdateEvent(vtkSMProxy* proxy);
+
+  /**
+   * Called by vtkSMDomain::RequestUpdate(). During a batch update, records the
+   * update of `domain` requested by `requestingProperty` so that it is
+   * performed once when the batch ends, and returns true. Returns false if the
+   * update must be performed immediately.
+   */
+  bool DeferDomainUpdate(vtkSMDomain* domain, vtkSMProperty* requestingProperty);
+
   /**
    * Recursively collects all proxies referred by the proxy in the set.
    */
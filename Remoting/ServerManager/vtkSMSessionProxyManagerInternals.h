@@ -5,11 +5,13 @@
 #define vtkSMSessionProxyManagerInternals_h
 
 #include "vtkObjectBase.h"
+#include "vtkSMDomain.h"              // for vtkSMDomain
 #include "vtkSMLink.h"                // for vtkSMLink
 #include "vtkSMMessage.h"             // for vtkSMMessage
 #include "vtkSMProxyLocator.h"        // for vtkSMProxyLocator
 #include "vtkSMProxySelectionModel.h" // for vtkSMProxySelectionModel
 #include "vtkSmartPointer.h"          // for vtkSmartPointer
+#include "vtkWeakPointer.h"           // for vtkWeakPointer
 
 #include <map>                          // for std::map
 #include <set>                          // for std::set
@@ -188,6 +190,18 @@ struct vtkSMSessionProxyManagerInternals
   typedef std::set<vtkSMProxy*> SetOfProxies;
   SetOfProxies ModifiedProxies;
 
+  // Nesting level of BeginBatchUpdate() calls and proxies updated during the
+  // batch, whose UpdateEvent is fired when the batch ends, in order. The set
+  // only deduplicates them. Domain updates are coalesced for the duration of
+  // the batch as well, and performed once when it ends.
+  int BatchUpdateDepth = 0;
+  std::vector<vtkWeakPointer<vtkSMProxy>> DeferredUpdateEventProxies;
+  SetOfProxies DeferredUpdateEventProxySet;
+  typedef std::pair<vtkWeakPointer<vtkSMDomain>, vtkWeakPointer<vtkSMProperty>> DomainUpdateType;
+  std::vector<DomainUpdateType> DeferredDomainUpdates;
+  std::set<std::pair<vtkSMDomain*, vtkSMProperty*>> DeferredDomainUpdateSet;
+  bool PerformingDeferredDomainUpdates = false;
+
   // Data structure to save registered links.
   typedef std::map<std::string, vtkSmartPointer<vtkSMLink>> LinkType;
   LinkType RegisteredLinkMap;
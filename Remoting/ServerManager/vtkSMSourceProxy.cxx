@@ -577,6 +577,7 @@ vtkPVDataInformation* vtkSMSourceProxy::GetSubsetDataInformation(
 //----------------------------------------------------------------------------
 void vtkSMSourceProxy::InvalidateDataInformation()
 {
+  this->DataInformationTime.Modified();
   if (this->OutputPortsCreated)
   {
     vtkSMSourceProxyInternals::VectorOfPorts::iterator it = this->PInternals->OutputPorts.begin();
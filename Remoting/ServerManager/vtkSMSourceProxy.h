@@ -23,6 +23,7 @@
 
 #include "vtkRemotingServerManagerModule.h" //needed for exports
 #include "vtkSMProxy.h"
+#include "vtkTimeStamp.h" // for vtkTimeStamp
 
 class vtkPVArrayInformation;
 class vtkPVDataInformation;
@@ -130,6 +131,13 @@ public:
   vtkPVDataInformation* GetDataInformation(unsigned int outputIdx);
   ///@}
 
+  /**
+   * Returns the last time the data information of the output ports was
+   * invalidated, e.g. after the pipeline updated. Domains depending on the
+   * data produced by this proxy use it to skip needless updates.
+   */
+  vtkMTimeType GetDataInformationMTime() { return this->DataInformationTime.GetMTime(); }
+
   ///@{
   /**
    * For composite datasets, `GetDataInformation` returns summary data information for
@@ -256,6 +264,7 @@ protected:
   friend class vtkSMOutputPort;
 
   int OutputPortsCreated;
+  vtkTimeStamp DataInformationTime;
 
   int ProcessSupport;
   bool MPIRequired;
@@ -4,6 +4,7 @@
 
 #include "vtkClientServerStreamInstantiator.h"
 #include "vtkObjectFactory.h"
+#include "vtkPVLogger.h"
 #include "vtkPVXMLElement.h"
 #include "vtkSMProperty.h"
 #include "vtkSMPropertyLink.h"
@@ -17,9 +18,11 @@
 #include "vtkSMSourceProxy.h"
 #include "vtkSMStateVersionController.h"
 #include "vtkSmartPointer.h"
+#include "vtkWeakPointer.h"
 
 #include <cassert>
 #include <cstdlib>
+#include <unordered_map>
 #include <vector>
 
 vtkObjectFactoryNewMacro(vtkSMStateLoader);
@@ -47,6 +50,43 @@ struct vtkSMStateLoaderInternals
   ProxyCreationOrderType ProxyCreationOrder;
   bool DeferProxyRegistration;
 
+  /// Source proxies created while DeferProxyRegistration is set. Their
+  /// pipeline information is updated once all of them have been created so
+  /// that the property pushes are not interleaved with round trips.
+  std::vector<vtkWeakPointer<vtkSMSourceProxy>> PendingPipelineInformation;
+
+  /// <Proxy/> elements indexed by id, built on first use by
+  /// LocateProxyElement() for `IndexedRoot`.
+  std::unordered_map<vtkIdType, vtkPVXMLElement*> ProxyElements;
+  vtkPVXMLElement* IndexedRoot = nullptr;
+
+  // Fills ProxyElements, keeping the first element found for each id in the
+  // same order as vtkSMStateLoader::LocateProxyElementInternal() searches.
+  void IndexProxyElements(vtkPVXMLElement* root)
+  {
+    const unsigned int numElems = root->GetNumberOfNestedElements();
+    for (unsigned int i = 0; i < numElems; i++)
+    {
+      vtkPVXMLElement* currentElement = root->GetNestedElement(i);
+      vtkIdType currentId;
+      if (currentElement->GetName() && strcmp(currentElement->GetName(), "Proxy") == 0 &&
+        currentElement->GetScalarAttribute("id", &currentId))
+      {
+        this->ProxyElements.emplace(currentId, currentElement);
+      }
+    }
+    for (unsigned int i = 0; i < numElems; i++)
+    {
+      this->IndexProxyElements(root->GetNestedElement(i));
+    }
+  }
+
+  void ClearProxyElements()
+  {
+    this->ProxyElements.clear();
+    this->IndexedRoot = nullptr;
+  }
+
   vtkSMStateLoaderInternals()
     : KeepOriginalId(false)
     , DeferProxyRegistration(false)
@@ -210,17 +250,23 @@ void vtkSMStateLoader::CreatedNewProxy(vtkTypeUInt32 id, vtkSMProxy* proxy)
 
   // Calling UpdateVTKObjects() will assign the proxy a GlobalId, if needed.
   proxy->UpdateVTKObjects();
-  if (proxy->IsA("vtkSMSourceProxy"))
-  {
-    vtkSMSourceProxy::SafeDownCast(proxy)->UpdatePipelineInformation();
-  }
+  vtkSMSourceProxy* source = vtkSMSourceProxy::SafeDownCast(proxy);
   if (this->Internal->DeferProxyRegistration)
   {
+    if (source)
+    {
+      // Updated in LoadStateInternal() before the proxies are registered.
+      this->Internal->PendingPipelineInformation.emplace_back(source);
+    }
     this->Internal->ProxyCreationOrder.push_back(
       vtkSMStateLoaderInternals::ProxyCreationOrderItem(id, proxy));
   }
   else
   {
+    if (source)
+    {
+      source->UpdatePipelineInformation();
+    }
     this->RegisterProxy(id, proxy);
   }
 }
@@ -303,7 +349,23 @@ bool vtkSMStateLoader::UpdateRegistrationInfo(
 //---------------------------------------------------------------------------
 vtkPVXMLElement* vtkSMStateLoader::LocateProxyElement(vtkTypeUInt32 id)
 {
-  return this->LocateProxyElementInternal(this->ServerManagerStateElement, id);
+  vtkPVXMLElement* root = this->ServerManagerStateElement;
+  if (!root)
+  {
+    return this->LocateProxyElementInternal(root, id);
+  }
+
+  // Searching the whole state for every referenced proxy is quadratic in the
+  // number of proxies, so index the <Proxy/> elements once.
+  auto& internals = *this->Internal;
+  if (internals.IndexedRoot != root)
+  {
+    internals.ClearProxyElements();
+    internals.IndexProxyElements(root);
+    internals.IndexedRoot = root;
+  }
+  auto iter = internals.ProxyElements.find(static_cast<vtkIdType>(id));
+  return iter != internals.ProxyElements.end() ? iter->second : nullptr;
 }
 
 //---------------------------------------------------------------------------
@@ -560,13 +622,16 @@ int vtkSMStateLoader::LoadStateInternal(vtkPVXMLElement* parent)
     }
   }
 
-  vtkSMStateVersionController* converter = vtkSMStateVersionController::New();
-  if (!converter->Process(parent, this->GetSession()))
   {
-    vtkWarningMacro("State converter was not able to convert the state to current "
-                    "version successfully");
+    vtkVLogScopeF(PARAVIEW_LOG_APPLICATION_VERBOSITY(), "load state: convert version");
+    vtkSMStateVersionController* converter = vtkSMStateVersionController::New();
+    if (!converter->Process(parent, this->GetSession()))
+    {
+      vtkWarningMacro("State converter was not able to convert the state to current "
+                      "version successfully");
+    }
+    converter->Delete();
   }
-  converter->Delete();
 
   if (!this->VerifyXMLVersion(rootElement))
   {
@@ -574,6 +639,7 @@ int vtkSMStateLoader::LoadStateInternal(vtkPVXMLElement* parent)
   }
 
   this->ServerManagerStateElement = rootElement;
+  this->Internal->ClearProxyElements();
 
   unsigned int numElems = rootElement->GetNumberOfNestedElements();
   unsigned int i;
@@ -618,47 +684,85 @@ int vtkSMStateLoader::LoadStateInternal(vtkPVXMLElement* parent)
   // present and registered.
   std::vector<vtkSmartPointer<vtkPVXMLElement>> deferredCollections;
   this->Internal->DeferProxyRegistration = true;
-  for (i = 0; i < numElems; i++)
   {
-    vtkPVXMLElement* currentElement = rootElement->GetNestedElement(i);
-    const char* name = currentElement->GetName();
-    if (name != nullptr && strcmp(name, "ProxyCollection") == 0)
+    vtkVLogScopeF(PARAVIEW_LOG_APPLICATION_VERBOSITY(), "load state: create proxies");
+    for (i = 0; i < numElems; i++)
     {
-      const char* group_name = currentElement->GetAttributeOrEmpty("name");
-      if (strcmp(group_name, "animation") == 0 || strcmp(group_name, "timekeeper") == 0)
+      vtkPVXMLElement* currentElement = rootElement->GetNestedElement(i);
+      const char* name = currentElement->GetName();
+      if (name != nullptr && strcmp(name, "ProxyCollection") == 0)
       {
-        deferredCollections.push_back(currentElement);
+        const char* group_name = currentElement->GetAttributeOrEmpty("name");
+        if (strcmp(group_name, "animation") == 0 || strcmp(group_name, "timekeeper") == 0)
+        {
+          deferredCollections.push_back(currentElement);
+        }
+        else if (!this->HandleProxyCollection(currentElement))
+        {
+          this->Internal->PendingPipelineInformation.clear();
+          return 0;
+        }
       }
-      else if (!this->HandleProxyCollection(currentElement))
+    }
+  }
+
+  // Now that all the properties have been pushed, update the pipeline
+  // information of the sources before registering them.
+  {
+    vtkVLogScopeF(PARAVIEW_LOG_APPLICATION_VERBOSITY(),
+      "load state: update pipeline information (%d sources)",
+      static_cast<int>(this->Internal->PendingPipelineInformation.size()));
+    std::vector<vtkWeakPointer<vtkSMSourceProxy>> sources;
+    sources.swap(this->Internal->PendingPipelineInformation);
+    for (const auto& source : sources)
+    {
+      if (source)
       {
-        return 0;
+        source->UpdatePipelineInformation();
       }
     }
   }
 
   // Register proxies in order they were created (as that's a good dependency
-  // order).
-  for (vtkSMStateLoaderInternals::ProxyCreationOrderType::const_iterator iter =
-         this->Internal->ProxyCreationOrder.begin();
-       iter != this->Internal->ProxyCreationOrder.end(); ++iter)
+  // order). The pipeline state is only validated once all proxies are
+  // registered instead of after each registration.
   {
-    this->RegisterProxy(iter->first, iter->second);
+    vtkVLogScopeF(PARAVIEW_LOG_APPLICATION_VERBOSITY(), "load state: register %d proxies",
+      static_cast<int>(this->Internal->ProxyCreationOrder.size()));
+    vtkSMSessionProxyManager* pxm = this->GetSessionProxyManager();
+    const bool stateUpdateNotification = pxm->IsStateUpdateNotificationEnabled();
+    pxm->DisableStateUpdateNotification();
+    for (vtkSMStateLoaderInternals::ProxyCreationOrderType::const_iterator iter =
+           this->Internal->ProxyCreationOrder.begin();
+         iter != this->Internal->ProxyCreationOrder.end(); ++iter)
+    {
+      this->RegisterProxy(iter->first, iter->second);
+    }
+    this->Internal->ProxyCreationOrder.clear();
+    if (stateUpdateNotification)
+    {
+      pxm->EnableStateUpdateNotification();
+      pxm->TriggerStateUpdate();
+    }
   }
-  this->Internal->ProxyCreationOrder.clear();
 
   // Now handle animation and timekeeper collections. This time, we let the
   // proxies be registered as needed.
   this->Internal->DeferProxyRegistration = false;
-  for (size_t cc = 0; cc < deferredCollections.size(); ++cc)
   {
-    if (!this->HandleProxyCollection(deferredCollections[cc]))
+    vtkVLogScopeF(PARAVIEW_LOG_APPLICATION_VERBOSITY(), "load state: animation and time");
+    for (size_t cc = 0; cc < deferredCollections.size(); ++cc)
     {
-      return 0;
+      if (!this->HandleProxyCollection(deferredCollections[cc]))
+      {
+        return 0;
+      }
     }
   }
   assert(this->Internal->ProxyCreationOrder.size() == 0);
 
   // Process link elements.
+  vtkVLogScopeF(PARAVIEW_LOG_APPLICATION_VERBOSITY(), "load state: links and settings");
   for (i = 0; i < numElems; i++)
   {
     vtkPVXMLElement* currentElement = rootElement->GetNestedElement(i);
@@ -715,6 +819,7 @@ int vtkSMStateLoader::LoadStateInternal(vtkPVXMLElement* parent)
   // Clear internal data structures.
   this->Internal->ProxyCreationOrder.clear();
   this->Internal->RegistrationInformation.clear();
+  this->Internal->ClearProxyElements();
   this->ServerManagerStateElement = nullptr;
   return 1;
 }
@@ -51,13 +51,10 @@ public:
       if (elem)
       {
         elem->SetProxyLocator(this->UndoSetProxyLocator.GetPointer());
-        if (useBeforeState)
+        vtkSMMessage state;
+        if (useBeforeState ? elem->GetBeforeState(&state) : elem->GetAfterState(&state))
         {
-          this->UndoSetStateLocator->RegisterState(elem->BeforeState);
-        }
-        else
-        {
-          this->UndoSetStateLocator->RegisterState(elem->AfterState);
+          this->UndoSetStateLocator->RegisterState(&state);
         }
       }
     }
@@ -117,6 +114,7 @@ vtkStandardNewMacro(vtkSMUndoStack);
 vtkSMUndoStack::vtkSMUndoStack()
 {
   this->Internal = new vtkInternal();
+  this->MaximumMemorySize = 256 * 1024 * 1024;
 }
 
 //-----------------------------------------------------------------------------
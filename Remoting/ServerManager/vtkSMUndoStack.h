@@ -17,6 +17,8 @@
  * server. GUI can use this to push its own changes that is undoable across
  * connections.
  *
+ * Unlike vtkUndoStack, the MaximumMemorySize defaults to 256 MiB.
+ *
  * @sa
  * vtkSMUndoStackBuilder
  */
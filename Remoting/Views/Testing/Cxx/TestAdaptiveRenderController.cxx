@@ -0,0 +1,172 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+#include "vtkLogger.h"
+#include "vtkNew.h"
+#include "vtkPVAdaptiveRenderController.h"
+
+#include <string>
+
+// Tests the decisions made by vtkPVAdaptiveRenderController from synthetic
+// frame times.
+int TestAdaptiveRenderController(int, char*[])
+{
+  const std::string lz4 = "vtkLZ4Compressor 0 3";
+  vtkNew<vtkPVAdaptiveRenderController> controller;
+  controller->SetTargetFrameRate(10);
+  controller->StartInteraction(2, 0.5, lz4, true);
+  if (controller->GetImageReductionFactor() != 2)
+  {
+    vtkLogF(ERROR, "Wrong initial image reduction factor.");
+    return EXIT_FAILURE;
+  }
+  if (controller->GetLODResolution() != 0.5)
+  {
+    vtkLogF(ERROR, "Wrong initial LOD resolution.");
+    return EXIT_FAILURE;
+  }
+  if (controller->GetCompressorConfiguration() != lz4)
+  {
+    vtkLogF(ERROR, "Wrong initial compressor.");
+    return EXIT_FAILURE;
+  }
+
+  // Slow renders: the image reduction factor goes up after a few frames.
+  if (controller->AddFrame(0.3, 0.01))
+  {
+    vtkLogF(ERROR, "Changed settings after a single frame.");
+    return EXIT_FAILURE;
+  }
+  if (controller->AddFrame(0.3, 0.01))
+  {
+    vtkLogF(ERROR, "Changed settings after two frames.");
+    return EXIT_FAILURE;
+  }
+  if (!controller->AddFrame(0.3, 0.01))
+  {
+    vtkLogF(ERROR, "Settings not changed for slow frames.");
+    return EXIT_FAILURE;
+  }
+  if (controller->GetImageReductionFactor() != 4)
+  {
+    vtkLogF(ERROR, "Wrong image reduction factor.");
+    return EXIT_FAILURE;
+  }
+  if (controller->GetCompressorConfiguration() != lz4)
+  {
+    vtkLogF(ERROR, "Compressor changed unexpectedly.");
+    return EXIT_FAILURE;
+  }
+
+  // Image delivery dominates: the compressor gets more lossy first, then the
+  // image reduction factor reaches its maximum.
+  for (int cc = 0; cc < 12; ++cc)
+  {
+    controller->AddFrame(0.3, 0.25);
+  }
+  if (controller->GetCompressorConfiguration() != "vtkLZ4Compressor 0 5")
+  {
+    vtkLogF(ERROR, "Compressor was not made more lossy.");
+    return EXIT_FAILURE;
+  }
+  if (controller->GetImageReductionFactor() != 8)
+  {
+    vtkLogF(ERROR, "Image reduction factor is not maximum.");
+    return EXIT_FAILURE;
+  }
+  if (controller->GetLODResolution() != 0.5)
+  {
+    vtkLogF(ERROR, "LOD resolution changed too early.");
+    return EXIT_FAILURE;
+  }
+
+  // Still too slow with the lowest image quality: the LOD resolution goes down.
+  for (int cc = 0; cc < 3; ++cc)
+  {
+    controller->AddFrame(0.3, 0.25);
+  }
+  if (controller->GetLODResolution() != 0.375)
+  {
+    vtkLogF(ERROR, "LOD resolution was not lowered.");
+    return EXIT_FAILURE;
+  }
+
+  // The next interaction starts with the quality reached by the previous one.
+  controller->StartInteraction(2, 0.5, lz4, true);
+  if (controller->GetLODResolution() != 0.375)
+  {
+    vtkLogF(ERROR, "LOD resolution was not kept.");
+    return EXIT_FAILURE;
+  }
+  if (controller->GetImageReductionFactor() != 8)
+  {
+    vtkLogF(ERROR, "Image quality was not kept.");
+    return EXIT_FAILURE;
+  }
+
+  // Fast renders: the quality is restored, but not beyond the user's settings.
+  for (int cc = 0; cc < 60; ++cc)
+  {
+    controller->AddFrame(0.01, 0.001);
+  }
+  if (controller->GetLODResolution() != 0.5)
+  {
+    vtkLogF(ERROR, "LOD resolution was not restored.");
+    return EXIT_FAILURE;
+  }
+  if (controller->GetImageReductionFactor() != 1)
+  {
+    vtkLogF(ERROR, "Image reduction factor was not lowered.");
+    return EXIT_FAILURE;
+  }
+  if (controller->GetCompressorConfiguration() != lz4)
+  {
+    vtkLogF(ERROR, "Compressor was not restored.");
+    return EXIT_FAILURE;
+  }
+
+  // Only the LOD resolution is adjusted when rendering locally.
+  controller->StartInteraction(2, 0.5, lz4, false);
+  for (int cc = 0; cc < 3; ++cc)
+  {
+    controller->AddFrame(0.3, 0.0);
+  }
+  if (controller->GetImageReductionFactor() != 2)
+  {
+    vtkLogF(ERROR, "Wrong image reduction factor.");
+    return EXIT_FAILURE;
+  }
+  if (controller->GetCompressorConfiguration() != lz4)
+  {
+    vtkLogF(ERROR, "Compressor changed unexpectedly.");
+    return EXIT_FAILURE;
+  }
+  if (controller->GetLODResolution() != 0.375)
+  {
+    vtkLogF(ERROR, "LOD resolution was not lowered.");
+    return EXIT_FAILURE;
+  }
+
+  int applied = 0;
+  if (vtkPVAdaptiveRenderController::GetLossyCompressorConfiguration(
+        "vtkZlibImageCompressor 0 5 2 0", 2, applied) != "vtkZlibImageCompressor 0 5 4 0" ||
+    applied != 2)
+  {
+    vtkLogF(ERROR, "Wrong lossy zlib configuration.");
+    return EXIT_FAILURE;
+  }
+  if (vtkPVAdaptiveRenderController::GetLossyCompressorConfiguration(
+        "vtkSquirtCompressor 0 4", 3, applied) != "vtkSquirtCompressor 0 5" ||
+    applied != 1)
+  {
+    vtkLogF(ERROR, "Wrong lossy squirt configuration.");
+    return EXIT_FAILURE;
+  }
+  if (vtkPVAdaptiveRenderController::GetLossyCompressorConfiguration(
+        "vtkNvPipeCompressor 0 1", 1, applied) != "vtkNvPipeCompressor 0 1" ||
+    applied != 0)
+  {
+    vtkLogF(ERROR, "Unknown compressor configuration was changed.");
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
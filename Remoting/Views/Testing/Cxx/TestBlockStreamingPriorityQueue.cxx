@@ -0,0 +1,141 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+#include "vtkBlockStreamingPriorityQueue.h"
+#include "vtkInformation.h"
+#include "vtkLogger.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkNew.h"
+#include "vtkStreamingDemandDrivenPipeline.h"
+
+#include <vector>
+
+// Tests the order in which vtkBlockStreamingPriorityQueue requests and releases
+// the blocks described by synthetic meta-data.
+int TestBlockStreamingPriorityQueue(int, char*[])
+{
+  // Blocks 1 and 2 are small and large blocks in the middle of the view, block
+  // 3 is outside of the view and block 4 is the closest to the camera.
+  const double bounds[4][6] = { { -1, 1, -1, 1, -1, 1 }, { 5, 9, 5, 9, -1, 1 },
+    { 50, 60, 50, 60, 50, 60 }, { -2, 2, -2, 2, 5, 9 } };
+  const double ranges[4][2] = { { 0, 1 }, { 0, 1 }, { 0, 1 }, { 100, 200 } };
+  vtkNew<vtkMultiBlockDataSet> metadata;
+  metadata->SetNumberOfBlocks(4);
+  for (unsigned int cc = 0; cc < 4; ++cc)
+  {
+    vtkInformation* info = metadata->GetMetaData(cc);
+    info->Set(vtkStreamingDemandDrivenPipeline::BOUNDS(), bounds[cc], 6);
+    info->Set(vtkDataObject::PIECE_FIELD_RANGE(), ranges[cc], 2);
+  }
+
+  // A box shaped frustum looking down the Z axis, planes are left, right,
+  // bottom, top, near and far with inward normals.
+  double planes[24] = { 1, 0, 0, 10, -1, 0, 0, 10, 0, 1, 0, 10, 0, -1, 0, 10, 0, 0, -1, 10, 0, 0,
+    1, 10 };
+
+  vtkNew<vtkBlockStreamingPriorityQueue> queue;
+  queue->Initialize(metadata);
+  if (queue->GetNumberOfBlocks() != 4)
+  {
+    vtkLogF(ERROR, "Wrong number of blocks.");
+    return EXIT_FAILURE;
+  }
+  double allBounds[6];
+  queue->GetBounds(allBounds);
+  if (!(allBounds[0] == -2 && allBounds[5] == 60))
+  {
+    vtkLogF(ERROR, "Wrong bounds.");
+    return EXIT_FAILURE;
+  }
+
+  queue->Update(planes);
+  if (queue->GetNextBlocks(10) != std::vector<unsigned int>{ 4, 2, 1 })
+  {
+    vtkLogF(ERROR, "Wrong order for screen coverage.");
+    return EXIT_FAILURE;
+  }
+
+  queue->SetPriorityMetric(vtkBlockStreamingPriorityQueue::VIEW_DISTANCE);
+  queue->Initialize(metadata);
+  queue->Update(planes);
+  if (queue->GetNextBlocks(10) != std::vector<unsigned int>{ 4, 1, 2 })
+  {
+    vtkLogF(ERROR, "Wrong order for view distance.");
+    return EXIT_FAILURE;
+  }
+
+  queue->SetPriorityMetric(vtkBlockStreamingPriorityQueue::DATA_RANGE);
+  queue->SetDataRange(0, 1);
+  queue->Initialize(metadata);
+  queue->Update(planes);
+  if (queue->GetNextBlocks(2) != std::vector<unsigned int>{ 2, 1 })
+  {
+    vtkLogF(ERROR, "Wrong order for data range.");
+    return EXIT_FAILURE;
+  }
+  if (queue->GetNextBlocks(2) != std::vector<unsigned int>{ 4 })
+  {
+    vtkLogF(ERROR, "Block out of the data range not requested last.");
+    return EXIT_FAILURE;
+  }
+
+  // With a memory budget, the lowest priority blocks are released once loaded
+  // and not requested again unless they become more important.
+  queue->SetPriorityMetric(vtkBlockStreamingPriorityQueue::SCREEN_COVERAGE);
+  queue->SetMemoryBudget(100);
+  queue->Initialize(metadata);
+  queue->Update(planes);
+  if (queue->GetNextBlocks(1) != std::vector<unsigned int>{ 4 })
+  {
+    vtkLogF(ERROR, "Wrong first request.");
+    return EXIT_FAILURE;
+  }
+  queue->SetBlockMemorySize(4, 80);
+  if (!queue->GetBlocksToRelease().empty())
+  {
+    vtkLogF(ERROR, "Released blocks within the budget.");
+    return EXIT_FAILURE;
+  }
+  if (queue->GetNextBlocks(2) != std::vector<unsigned int>{ 2, 1 })
+  {
+    vtkLogF(ERROR, "Wrong second request.");
+    return EXIT_FAILURE;
+  }
+  queue->SetBlockMemorySize(2, 60);
+  queue->SetBlockMemorySize(1, 10);
+  if (queue->GetResidentMemorySize() != 150)
+  {
+    vtkLogF(ERROR, "Wrong resident memory size.");
+    return EXIT_FAILURE;
+  }
+  if (queue->GetBlocksToRelease() != std::vector<unsigned int>{ 1, 2 })
+  {
+    vtkLogF(ERROR, "Wrong blocks released.");
+    return EXIT_FAILURE;
+  }
+  if (queue->GetResidentMemorySize() != 80)
+  {
+    vtkLogF(ERROR, "Wrong resident memory size after release.");
+    return EXIT_FAILURE;
+  }
+  if (!queue->GetNextBlocks(4).empty())
+  {
+    vtkLogF(ERROR, "Requested blocks that do not fit.");
+    return EXIT_FAILURE;
+  }
+
+  // Moving the near plane hides block 4, which is replaced by block 2.
+  planes[19] = 0;
+  queue->Update(planes);
+  if (queue->GetNextBlocks(1) != std::vector<unsigned int>{ 2 })
+  {
+    vtkLogF(ERROR, "Wrong request after move.");
+    return EXIT_FAILURE;
+  }
+  queue->SetBlockMemorySize(2, 60);
+  if (queue->GetBlocksToRelease() != std::vector<unsigned int>{ 4 })
+  {
+    vtkLogF(ERROR, "Hidden block not released.");
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,231 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+#include "vtkBlockStreamingPriorityQueue.h"
+#include "vtkBlockStreamingRepresentation.h"
+#include "vtkCamera.h"
+#include "vtkCompositeDataPipeline.h"
+#include "vtkFieldData.h"
+#include "vtkInformation.h"
+#include "vtkInformationVector.h"
+#include "vtkInitializationHelper.h"
+#include "vtkLogger.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkMultiBlockDataSetAlgorithm.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPVView.h"
+#include "vtkPlaneSource.h"
+#include "vtkProcessModule.h"
+#include "vtkStreamingDemandDrivenPipeline.h"
+#include "vtkUnsignedIntArray.h"
+
+#include <cstdlib>
+#include <set>
+#include <vector>
+
+namespace
+{
+constexpr unsigned int NumberOfBlocks = 8;
+
+// Source producing a row of NumberOfBlocks planes along X, loading only the
+// blocks requested with vtkCompositeDataPipeline::LOAD_REQUESTED_BLOCKS().
+class vtkTestBlockSource : public vtkMultiBlockDataSetAlgorithm
+{
+public:
+  static vtkTestBlockSource* New();
+  vtkTypeMacro(vtkTestBlockSource, vtkMultiBlockDataSetAlgorithm);
+
+  // flat indices of the blocks loaded by the last execution.
+  std::vector<unsigned int> LoadedBlocks;
+
+protected:
+  vtkTestBlockSource() { this->SetNumberOfInputPorts(0); }
+
+  int RequestInformation(
+    vtkInformation*, vtkInformationVector**, vtkInformationVector* outputVector) override
+  {
+    vtkNew<vtkMultiBlockDataSet> metadata;
+    metadata->SetNumberOfBlocks(NumberOfBlocks);
+    for (unsigned int cc = 0; cc < NumberOfBlocks; ++cc)
+    {
+      const double bounds[6] = { static_cast<double>(cc), cc + 1.0, 0.0, 1.0, 0.0, 0.0 };
+      metadata->GetMetaData(cc)->Set(vtkStreamingDemandDrivenPipeline::BOUNDS(), bounds, 6);
+    }
+    outputVector->GetInformationObject(0)->Set(
+      vtkCompositeDataPipeline::COMPOSITE_DATA_META_DATA(), metadata);
+    return 1;
+  }
+
+  int RequestData(
+    vtkInformation*, vtkInformationVector**, vtkInformationVector* outputVector) override
+  {
+    vtkInformation* outInfo = outputVector->GetInformationObject(0);
+    const bool loadRequested = outInfo->Has(vtkCompositeDataPipeline::LOAD_REQUESTED_BLOCKS());
+    std::set<unsigned int> requested;
+    if (loadRequested && outInfo->Length(vtkCompositeDataPipeline::UPDATE_COMPOSITE_INDICES()) > 0)
+    {
+      const int* indices = outInfo->Get(vtkCompositeDataPipeline::UPDATE_COMPOSITE_INDICES());
+      requested.insert(
+        indices, indices + outInfo->Length(vtkCompositeDataPipeline::UPDATE_COMPOSITE_INDICES()));
+    }
+
+    auto output = vtkMultiBlockDataSet::GetData(outInfo);
+    output->SetNumberOfBlocks(NumberOfBlocks);
+    this->LoadedBlocks.clear();
+    for (unsigned int cc = 0; cc < NumberOfBlocks; ++cc)
+    {
+      // the children of the root are leaves, their flat index is cc + 1.
+      if (loadRequested && requested.find(cc + 1) == requested.end())
+      {
+        continue;
+      }
+      vtkNew<vtkPlaneSource> plane;
+      plane->SetOrigin(cc, 0.0, 0.0);
+      plane->SetPoint1(cc + 1.0, 0.0, 0.0);
+      plane->SetPoint2(cc, 1.0, 0.0);
+      plane->SetResolution(256, 256);
+      plane->Update();
+      output->SetBlock(cc, plane->GetOutput());
+      this->LoadedBlocks.push_back(cc + 1);
+    }
+    return 1;
+  }
+};
+vtkStandardNewMacro(vtkTestBlockSource);
+
+class vtkTestBlockStreamingRepresentation : public vtkBlockStreamingRepresentation
+{
+public:
+  static vtkTestBlockStreamingRepresentation* New();
+  vtkTypeMacro(vtkTestBlockStreamingRepresentation, vtkBlockStreamingRepresentation);
+  using vtkBlockStreamingRepresentation::MergeStreamedPiece;
+  using vtkBlockStreamingRepresentation::StreamingUpdate;
+
+  // what the representation does with the delivered data on the first render.
+  void Deliver()
+  {
+    this->RenderedData.TakeReference(this->ProcessedData->NewInstance());
+    this->RenderedData->ShallowCopy(this->ProcessedData);
+  }
+  vtkDataObject* GetProcessedPiece() { return this->ProcessedPiece; }
+  vtkMultiBlockDataSet* GetRenderedData()
+  {
+    return vtkMultiBlockDataSet::SafeDownCast(this->RenderedData);
+  }
+  vtkTypeUInt64 GetResidentMemorySize() { return this->PriorityQueue->GetResidentMemorySize(); }
+};
+vtkStandardNewMacro(vtkTestBlockStreamingRepresentation);
+
+// Streams the blocks visible from `camera` the way vtkPVRenderView does,
+// keeping track of the blocks loaded by the source and released by the
+// representation. Returns false if a block was loaded while resident.
+bool Stream(vtkTestBlockStreamingRepresentation* repr, vtkTestBlockSource* source,
+  vtkCamera* camera, std::set<unsigned int>& resident)
+{
+  double planes[24];
+  camera->GetFrustumPlanes(1.0, planes);
+  source->LoadedBlocks.clear();
+  for (int pass = 0; pass < 100 && repr->StreamingUpdate(planes); ++pass)
+  {
+    for (unsigned int block : source->LoadedBlocks)
+    {
+      if (!resident.insert(block).second)
+      {
+        vtkLogF(ERROR, "Block %u loaded again while resident.", block);
+        return false;
+      }
+    }
+    source->LoadedBlocks.clear();
+
+    vtkDataObject* piece = repr->GetProcessedPiece();
+    if (auto array = vtkUnsignedIntArray::SafeDownCast(
+          piece->GetFieldData()->GetArray("__blocks_to_release")))
+    {
+      for (vtkIdType cc = 0; cc < array->GetNumberOfValues(); ++cc)
+      {
+        resident.erase(array->GetValue(cc));
+      }
+    }
+    repr->MergeStreamedPiece(piece);
+  }
+  return true;
+}
+
+// Checks that the rendered blocks are the resident ones and that they fit in
+// the memory budget.
+bool CheckResidentBlocks(
+  vtkTestBlockStreamingRepresentation* repr, const std::set<unsigned int>& resident)
+{
+  vtkMultiBlockDataSet* rendered = repr->GetRenderedData();
+  for (unsigned int cc = 0; cc < NumberOfBlocks; ++cc)
+  {
+    const bool isResident = resident.find(cc + 1) != resident.end();
+    if ((rendered->GetBlock(cc) != nullptr) != isResident)
+    {
+      vtkLogF(ERROR, "Block %u is %s but %s.", cc + 1, isResident ? "resident" : "released",
+        isResident ? "not rendered" : "rendered");
+      return false;
+    }
+  }
+  if (repr->GetResidentMemorySize() > static_cast<vtkTypeUInt64>(repr->GetMemoryBudget()) * 1024)
+  {
+    vtkLogF(ERROR, "Resident blocks exceed the memory budget.");
+    return false;
+  }
+  return true;
+}
+}
+
+int TestBlockStreamingRepresentation(int, char* argv[])
+{
+  vtkInitializationHelper::Initialize(argv[0], vtkProcessModule::PROCESS_CLIENT);
+  vtkPVView::SetEnableStreaming(true);
+
+  int result = EXIT_SUCCESS;
+  {
+    vtkNew<vtkTestBlockSource> source;
+    vtkNew<vtkTestBlockStreamingRepresentation> repr;
+    // each block uses a few MiB, only some of them fit in the budget.
+    repr->SetMemoryBudget(12);
+    repr->SetInputConnection(source->GetOutputPort());
+    repr->Update();
+    if (!source->LoadedBlocks.empty())
+    {
+      vtkLogF(ERROR, "Blocks were loaded before streaming.");
+      result = EXIT_FAILURE;
+    }
+    repr->Deliver();
+
+    // all blocks are visible, only the ones that fit in the budget are loaded.
+    std::set<unsigned int> resident;
+    vtkNew<vtkCamera> camera;
+    camera->SetPosition(4.0, 0.5, 10.0);
+    camera->SetFocalPoint(4.0, 0.5, 0.0);
+    camera->SetViewAngle(60.0);
+    camera->SetClippingRange(1.0, 100.0);
+    if (result == EXIT_SUCCESS &&
+      (!Stream(repr, source, camera, resident) || !CheckResidentBlocks(repr, resident) ||
+        resident.empty() || resident.size() == NumberOfBlocks))
+    {
+      vtkLogF(ERROR, "Wrong blocks streamed with all blocks visible (%d resident).",
+        static_cast<int>(resident.size()));
+      result = EXIT_FAILURE;
+    }
+
+    // only the last block is visible, it replaces the others.
+    camera->SetPosition(NumberOfBlocks - 0.5, 0.5, 2.0);
+    camera->SetFocalPoint(NumberOfBlocks - 0.5, 0.5, 0.0);
+    camera->SetViewAngle(20.0);
+    if (result == EXIT_SUCCESS &&
+      (!Stream(repr, source, camera, resident) || !CheckResidentBlocks(repr, resident) ||
+        resident.find(NumberOfBlocks) == resident.end()))
+    {
+      vtkLogF(ERROR, "Visible block was not streamed.");
+      result = EXIT_FAILURE;
+    }
+  }
+
+  vtkPVView::SetEnableStreaming(false);
+  vtkInitializationHelper::Finalize();
+  return result;
+}
@@ -0,0 +1,158 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+#include "vtkBoundingBox.h"
+#include "vtkCamera.h"
+#include "vtkGeometryRepresentation.h"
+#include "vtkImageData.h"
+#include "vtkLogger.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPVView.h"
+#include "vtkPlaneSource.h"
+#include "vtkPointData.h"
+#include "vtkPolyData.h"
+#include "vtkSphereSource.h"
+
+#include <cstdlib>
+
+namespace
+{
+class vtkTestGeometryRepresentation : public vtkGeometryRepresentation
+{
+public:
+  static vtkTestGeometryRepresentation* New();
+  vtkTypeMacro(vtkTestGeometryRepresentation, vtkGeometryRepresentation);
+  using vtkGeometryRepresentation::AddStreamedBricks;
+  using vtkGeometryRepresentation::GetRenderedBricks;
+  using vtkGeometryRepresentation::StreamBricks;
+  using vtkGeometryRepresentation::UpdateBricks;
+  vtkMultiBlockDataSet* GetCoarseBricks() { return this->CoarseBricks; }
+  vtkMultiBlockDataSet* GetStreamedBricks() { return this->StreamedBricks; }
+};
+vtkStandardNewMacro(vtkTestGeometryRepresentation);
+
+vtkIdType GetNumberOfCells(vtkDataObject* data, unsigned int block)
+{
+  auto mb = vtkMultiBlockDataSet::SafeDownCast(data);
+  auto leaf = mb ? vtkPolyData::SafeDownCast(mb->GetBlock(block)) : nullptr;
+  return leaf ? leaf->GetNumberOfCells() : 0;
+}
+
+// Streams the bricks visible from `camera` until none remains, the way
+// vtkPVRenderView does, and returns the number of streaming updates.
+int StreamVisibleBricks(vtkTestGeometryRepresentation* repr, vtkCamera* camera)
+{
+  double planes[24];
+  camera->GetFrustumPlanes(1.0, planes);
+  int updates = 0;
+  for (; repr->StreamBricks(planes) && updates < 1000; ++updates)
+  {
+    repr->AddStreamedBricks(repr->GetStreamedBricks());
+  }
+  return updates;
+}
+}
+
+int TestGeometryRepresentationBricks(int, char*[])
+{
+  vtkPVView::SetEnableStreaming(true);
+
+  vtkNew<vtkSphereSource> sphere;
+  sphere->SetThetaResolution(64);
+  sphere->SetPhiResolution(64);
+  sphere->Update();
+  vtkNew<vtkPlaneSource> plane;
+  plane->SetResolution(32, 32);
+  plane->Update();
+
+  // the last block is left empty to check that the structure is preserved.
+  vtkNew<vtkMultiBlockDataSet> input;
+  input->SetNumberOfBlocks(3);
+  input->SetBlock(0, sphere->GetOutput());
+  input->SetBlock(1, plane->GetOutput());
+
+  vtkNew<vtkTestGeometryRepresentation> repr;
+  repr->SetUseFrustumCulledDelivery(true);
+  repr->SetBrickResolution(2);
+  repr->UpdateBricks(input);
+  if (repr->GetCoarseBricks()->GetNumberOfBlocks() != 8)
+  {
+    vtkLogF(ERROR, "Expected 8 bricks, got %u.", repr->GetCoarseBricks()->GetNumberOfBlocks());
+    return EXIT_FAILURE;
+  }
+
+  // the coarse bricks are combined back into the structure of the input.
+  auto rendered =
+    vtkMultiBlockDataSet::SafeDownCast(repr->GetRenderedBricks(repr->GetCoarseBricks()));
+  if (!rendered || rendered->GetNumberOfBlocks() != 3 || rendered->GetBlock(2) != nullptr)
+  {
+    vtkLogF(ERROR, "Bricks were not combined into the structure of the input.");
+    return EXIT_FAILURE;
+  }
+  const vtkIdType coarseCells = GetNumberOfCells(rendered, 0);
+  if (coarseCells <= 0 || coarseCells >= sphere->GetOutput()->GetNumberOfCells())
+  {
+    vtkLogF(ERROR, "Coarse bricks are not decimated (%lld cells).",
+      static_cast<long long>(coarseCells));
+    return EXIT_FAILURE;
+  }
+
+  // a narrow view of the x > 0, y > 0 quarter only streams some bricks.
+  vtkNew<vtkCamera> camera;
+  camera->SetPosition(0.25, 0.25, 3.0);
+  camera->SetFocalPoint(0.25, 0.25, 0.0);
+  camera->SetViewAngle(5.0);
+  camera->SetClippingRange(0.1, 10.0);
+  const int partialUpdates = StreamVisibleBricks(repr, camera);
+  rendered = vtkMultiBlockDataSet::SafeDownCast(repr->GetRenderedBricks(repr->GetCoarseBricks()));
+  const vtkIdType partialCells = GetNumberOfCells(rendered, 0);
+  if (partialUpdates == 0 || partialCells <= coarseCells ||
+    partialCells >= sphere->GetOutput()->GetNumberOfCells())
+  {
+    vtkLogF(ERROR, "Wrong bricks streamed for a partial view (%lld cells).",
+      static_cast<long long>(partialCells));
+    return EXIT_FAILURE;
+  }
+
+  // once the whole geometry is visible, all the full resolution bricks are
+  // streamed and the input is rendered.
+  camera->SetPosition(0.0, 0.0, 5.0);
+  camera->SetFocalPoint(0.0, 0.0, 0.0);
+  camera->SetViewAngle(30.0);
+  StreamVisibleBricks(repr, camera);
+  rendered = vtkMultiBlockDataSet::SafeDownCast(repr->GetRenderedBricks(repr->GetCoarseBricks()));
+  for (unsigned int block = 0; block < 2; ++block)
+  {
+    auto expected = vtkPolyData::SafeDownCast(input->GetBlock(block));
+    auto result = vtkPolyData::SafeDownCast(rendered->GetBlock(block));
+    if (!result || result->GetNumberOfCells() != expected->GetNumberOfCells() ||
+      vtkBoundingBox(result->GetBounds()) != vtkBoundingBox(expected->GetBounds()) ||
+      !result->GetPointData()->GetNormals())
+    {
+      vtkLogF(ERROR, "Streamed bricks do not match block %u of the input.", block);
+      return EXIT_FAILURE;
+    }
+  }
+  double planes[24];
+  camera->GetFrustumPlanes(1.0, planes);
+  if (repr->StreamBricks(planes))
+  {
+    vtkLogF(ERROR, "Bricks streamed twice.");
+    return EXIT_FAILURE;
+  }
+
+  // geometry that is not only polydata is not split.
+  vtkNew<vtkImageData> image;
+  image->SetDimensions(2, 2, 2);
+  input->SetBlock(2, image);
+  repr->UpdateBricks(input);
+  if (repr->GetCoarseBricks()->GetNumberOfBlocks() != 0)
+  {
+    vtkLogF(ERROR, "Geometry with non-polydata leaves was split into bricks.");
+    return EXIT_FAILURE;
+  }
+
+  vtkPVView::SetEnableStreaming(false);
+  return EXIT_SUCCESS;
+}
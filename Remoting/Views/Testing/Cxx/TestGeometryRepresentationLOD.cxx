@@ -0,0 +1,132 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+#include "vtkDataObject.h"
+#include "vtkGeometryRepresentation.h"
+#include "vtkInitializationHelper.h"
+#include "vtkLogger.h"
+#include "vtkMapper.h"
+#include "vtkNew.h"
+#include "vtkPVDataDeliveryManager.h"
+#include "vtkPVLODActor.h"
+#include "vtkPVRenderView.h"
+#include "vtkProcessModule.h"
+#include "vtkSMParaViewPipelineControllerWithRendering.h"
+#include "vtkSMPropertyHelper.h"
+#include "vtkSMRenderViewProxy.h"
+#include "vtkSMSession.h"
+#include "vtkSMSessionProxyManager.h"
+#include "vtkSMSourceProxy.h"
+#include "vtkSmartPointer.h"
+
+namespace
+{
+// Returns the LOD geometry used by the surface representation of `repr` for
+// the last render.
+vtkDataObject* GetRenderedLOD(vtkSMProxy* repr)
+{
+  auto geometry = vtkGeometryRepresentation::SafeDownCast(
+    repr->GetSubProxy("SurfaceRepresentation")->GetClientSideObject());
+  return geometry->GetActor()->GetLODMapper()->GetInputDataObject(0, 0);
+}
+
+vtkIdType GetNumberOfCells(vtkDataObject* data)
+{
+  return data ? data->GetNumberOfElements(vtkDataObject::CELL) : 0;
+}
+
+vtkIdType RenderLOD(vtkSMRenderViewProxy* view, vtkSMProxy* repr, double resolution)
+{
+  vtkSMPropertyHelper(view, "LODResolution").Set(resolution);
+  view->UpdateVTKObjects();
+  view->InteractiveRender();
+  return GetNumberOfCells(GetRenderedLOD(repr));
+}
+
+int TestLODLevels(vtkSMSession* session, vtkSMParaViewPipelineControllerWithRendering* controller)
+{
+  vtkSMSessionProxyManager* pxm = session->GetSessionProxyManager();
+
+  vtkSmartPointer<vtkSMRenderViewProxy> view;
+  view.TakeReference(vtkSMRenderViewProxy::SafeDownCast(pxm->NewProxy("views", "RenderView")));
+  controller->InitializeProxy(view);
+  // always use the LOD geometry for interactive renders.
+  vtkSMPropertyHelper(view, "LODThreshold").Set(0.0);
+  view->UpdateVTKObjects();
+
+  vtkSmartPointer<vtkSMSourceProxy> sphere;
+  sphere.TakeReference(vtkSMSourceProxy::SafeDownCast(pxm->NewProxy("sources", "SphereSource")));
+  controller->InitializeProxy(sphere);
+  vtkSMPropertyHelper(sphere, "ThetaResolution").Set(256);
+  vtkSMPropertyHelper(sphere, "PhiResolution").Set(256);
+  sphere->UpdateVTKObjects();
+
+  vtkSMProxy* repr = controller->Show(sphere, 0, view);
+  view->ResetCamera();
+  view->StillRender();
+
+  // The rendered level is the one built with the LOD resolution set by the
+  // user, which rebuilds the hierarchy when it changes.
+  const vtkIdType cells50 = RenderLOD(view, repr, 0.5);
+  const vtkIdType cells25 = RenderLOD(view, repr, 0.25);
+  const vtkIdType cells40 = RenderLOD(view, repr, 0.4);
+  if (!(cells25 > 0 && cells25 < cells40 && cells40 < cells50))
+  {
+    vtkLogF(ERROR, "Wrong LOD levels rendered: %lld (0.25), %lld (0.4), %lld (0.5).",
+      static_cast<long long>(cells25), static_cast<long long>(cells40),
+      static_cast<long long>(cells50));
+    return EXIT_FAILURE;
+  }
+  if (RenderLOD(view, repr, 0.25) != cells25)
+  {
+    vtkLogF(ERROR, "LOD hierarchy was not rebuilt for a coarser resolution.");
+    return EXIT_FAILURE;
+  }
+  RenderLOD(view, repr, 0.4);
+
+  // All the levels are delivered, so they all count toward the LOD size.
+  vtkSmartPointer<vtkDataObject> finest = GetRenderedLOD(repr);
+  auto rv = vtkPVRenderView::SafeDownCast(view->GetClientSideObject());
+  if (rv->GetDeliveryManager()->GetVisibleDataSize(true) <= finest->GetActualMemorySize())
+  {
+    vtkLogF(ERROR, "Only the finest LOD level is accounted for.");
+    return EXIT_FAILURE;
+  }
+
+  // The adaptive controller snaps to a coarser level without rebuilding.
+  vtkSMPropertyHelper(view, "AdaptiveLODResolution").Set(0.2);
+  view->UpdateVTKObjects();
+  view->InteractiveRender();
+  if (GetNumberOfCells(GetRenderedLOD(repr)) >= cells25)
+  {
+    vtkLogF(ERROR, "Adaptive LOD resolution did not select a coarser level.");
+    return EXIT_FAILURE;
+  }
+  vtkSMPropertyHelper(view, "AdaptiveLODResolution").Set(-1.0);
+  view->UpdateVTKObjects();
+  view->InteractiveRender();
+  if (GetRenderedLOD(repr) != finest)
+  {
+    vtkLogF(ERROR, "LOD hierarchy was rebuilt for an adaptive LOD resolution.");
+    return EXIT_FAILURE;
+  }
+
+  controller->UnRegisterProxy(repr);
+  return EXIT_SUCCESS;
+}
+}
+
+int TestGeometryRepresentationLOD(int, char* argv[])
+{
+  vtkInitializationHelper::Initialize(argv[0], vtkProcessModule::PROCESS_CLIENT);
+
+  vtkNew<vtkSMParaViewPipelineControllerWithRendering> controller;
+  vtkNew<vtkSMSession> session;
+  vtkProcessModule::GetProcessModule()->RegisterSession(session);
+  controller->InitializeSession(session);
+
+  const int result = TestLODLevels(session, controller);
+
+  vtkProcessModule::GetProcessModule()->UnRegisterSession(session);
+  vtkInitializationHelper::Finalize();
+  return result;
+}
@@ -0,0 +1,64 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+#include "vtkBoundingBox.h"
+#include "vtkMinimalStandardRandomSequence.h"
+#include "vtkNew.h"
+#include "vtkOrderedCompositingHelper.h"
+
+#include <iostream>
+#include <vector>
+
+// Tests that the sort orders reused by vtkOrderedCompositingHelper while the
+// camera moves match the ones computed from scratch.
+int TestOrderedCompositingHelper(int, char*[])
+{
+  // cuts of a kd-tree with 8 ranks of unequal sizes.
+  const double splits[3][3] = { { 0, 3, 10 }, { 0, 6, 10 }, { 0, 4, 10 } };
+  std::vector<vtkBoundingBox> boxes;
+  for (int k = 0; k < 2; ++k)
+  {
+    for (int j = 0; j < 2; ++j)
+    {
+      for (int i = 0; i < 2; ++i)
+      {
+        boxes.emplace_back(splits[0][i], splits[0][i + 1], splits[1][j], splits[1][j + 1],
+          splits[2][k], splits[2][k + 1]);
+      }
+    }
+  }
+
+  vtkNew<vtkOrderedCompositingHelper> helper;
+  helper->SetBoundingBoxes(boxes);
+
+  vtkNew<vtkMinimalStandardRandomSequence> random;
+  random->SetSeed(1);
+  for (int cc = 0; cc < 1000; ++cc)
+  {
+    double vector[3];
+    for (int axis = 0; axis < 3; ++axis)
+    {
+      // snap some coordinates on the planes of the boxes.
+      random->Next();
+      vector[axis] = random->GetRangeValue(-5, 15);
+      if (cc % 4 == 0)
+      {
+        vector[axis] = splits[axis][cc % 3];
+      }
+    }
+
+    const bool parallel = cc >= 500;
+    vtkNew<vtkOrderedCompositingHelper> reference;
+    reference->SetBoundingBoxes(boxes);
+    const auto expected = parallel ? reference->ComputeSortOrderInViewDirection(vector)
+                                   : reference->ComputeSortOrderFromPosition(vector);
+    const auto result = parallel ? helper->ComputeSortOrderInViewDirection(vector)
+                                 : helper->ComputeSortOrderFromPosition(vector);
+    if (result != expected)
+    {
+      std::cerr << "Wrong sort order for " << (parallel ? "direction " : "position ") << vector[0]
+                << ", " << vector[1] << ", " << vector[2] << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+  return EXIT_SUCCESS;
+}
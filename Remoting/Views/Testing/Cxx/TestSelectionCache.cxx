@@ -0,0 +1,205 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+#include "vtkAbstractArray.h"
+#include "vtkCallbackCommand.h"
+#include "vtkCamera.h"
+#include "vtkCommand.h"
+#include "vtkInitializationHelper.h"
+#include "vtkLogger.h"
+#include "vtkNew.h"
+#include "vtkPVRenderView.h"
+#include "vtkProcessModule.h"
+#include "vtkRenderWindow.h"
+#include "vtkSMParaViewPipelineControllerWithRendering.h"
+#include "vtkSMPropertyHelper.h"
+#include "vtkSMRenderViewProxy.h"
+#include "vtkSMSession.h"
+#include "vtkSMSessionProxyManager.h"
+#include "vtkSMSourceProxy.h"
+#include "vtkSelection.h"
+#include "vtkSelectionNode.h"
+#include "vtkSmartPointer.h"
+
+#include <cstdlib>
+
+namespace
+{
+constexpr int ViewSize = 300;
+
+void CountRender(vtkObject*, unsigned long, void* clientData, void*)
+{
+  ++*static_cast<int*>(clientData);
+}
+
+// Selects the cells of the whole view, invalidating the cached buffers first
+// when `fresh` is true. `renders` is set to the number of renders done to
+// make the selection.
+vtkSmartPointer<vtkSelection> SelectCells(vtkPVRenderView* rv, bool fresh, int& renders)
+{
+  if (fresh)
+  {
+    rv->InvalidateCachedSelection();
+  }
+  renders = 0;
+  vtkNew<vtkCallbackCommand> observer;
+  observer->SetCallback(CountRender);
+  observer->SetClientData(&renders);
+  const unsigned long tag = rv->GetRenderWindow()->AddObserver(vtkCommand::StartEvent, observer);
+  int region[4] = { 0, 0, ViewSize - 1, ViewSize - 1 };
+  rv->SelectCells(region);
+  rv->GetRenderWindow()->RemoveObserver(tag);
+
+  auto selection = vtkSmartPointer<vtkSelection>::New();
+  if (rv->GetLastSelection())
+  {
+    selection->DeepCopy(rv->GetLastSelection());
+  }
+  return selection;
+}
+
+bool SameSelection(vtkSelection* a, vtkSelection* b)
+{
+  if (a->GetNumberOfNodes() != b->GetNumberOfNodes())
+  {
+    return false;
+  }
+  for (unsigned int cc = 0; cc < a->GetNumberOfNodes(); ++cc)
+  {
+    vtkSelectionNode* nodeA = a->GetNode(cc);
+    vtkSelectionNode* nodeB = b->GetNode(cc);
+    if (!nodeA->EqualProperties(nodeB))
+    {
+      return false;
+    }
+    vtkAbstractArray* idsA = nodeA->GetSelectionList();
+    vtkAbstractArray* idsB = nodeB->GetSelectionList();
+    if (!idsA || !idsB || idsA->GetNumberOfValues() != idsB->GetNumberOfValues())
+    {
+      return false;
+    }
+    for (vtkIdType id = 0; id < idsA->GetNumberOfValues(); ++id)
+    {
+      if (idsA->GetVariantValue(id) != idsB->GetVariantValue(id))
+      {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+// Selects twice: once reusing the cached buffers if possible and once after
+// invalidating them. Both selections must match and, when `changed` is true,
+// the first one must have captured the buffers again.
+bool CheckSelection(vtkPVRenderView* rv, bool changed, const char* step)
+{
+  int renders = 0;
+  vtkSmartPointer<vtkSelection> cached = SelectCells(rv, false, renders);
+  if (changed && renders == 0)
+  {
+    vtkLogF(ERROR, "Cached buffers reused after %s.", step);
+    return false;
+  }
+  if (!changed && renders != 0)
+  {
+    vtkLogF(ERROR, "%d renders to select %s.", renders, step);
+    return false;
+  }
+
+  int freshRenders = 0;
+  vtkSmartPointer<vtkSelection> fresh = SelectCells(rv, true, freshRenders);
+  if (!SameSelection(cached, fresh))
+  {
+    vtkLogF(ERROR, "Selection differs from a freshly rendered one after %s.", step);
+    return false;
+  }
+  return true;
+}
+
+int TestCache(vtkSMSession* session, vtkSMParaViewPipelineControllerWithRendering* controller)
+{
+  vtkSMSessionProxyManager* pxm = session->GetSessionProxyManager();
+
+  vtkSmartPointer<vtkSMRenderViewProxy> view;
+  view.TakeReference(vtkSMRenderViewProxy::SafeDownCast(pxm->NewProxy("views", "RenderView")));
+  controller->InitializeProxy(view);
+  const int size[2] = { ViewSize, ViewSize };
+  vtkSMPropertyHelper(view, "ViewSize").Set(size, 2);
+  view->UpdateVTKObjects();
+
+  vtkSmartPointer<vtkSMSourceProxy> sphere;
+  sphere.TakeReference(vtkSMSourceProxy::SafeDownCast(pxm->NewProxy("sources", "SphereSource")));
+  controller->InitializeProxy(sphere);
+  vtkSMPropertyHelper(sphere, "ThetaResolution").Set(16);
+  sphere->UpdateVTKObjects();
+
+  vtkSMProxy* repr = controller->Show(sphere, 0, view);
+  view->ResetCamera();
+  view->StillRender();
+
+  auto rv = vtkPVRenderView::SafeDownCast(view->GetClientSideObject());
+  int renders = 0;
+  vtkSmartPointer<vtkSelection> first = SelectCells(rv, false, renders);
+  if (first->GetNumberOfNodes() == 0)
+  {
+    vtkLogF(ERROR, "Nothing selected.");
+    return EXIT_FAILURE;
+  }
+  if (!CheckSelection(rv, false, "again without changes"))
+  {
+    return EXIT_FAILURE;
+  }
+
+  // the changes are made on the VTK objects, as interacting with the view does,
+  // so that the selector notices them by itself.
+  vtkCamera* camera = rv->GetActiveCamera();
+  camera->Azimuth(40);
+  view->StillRender();
+  if (!CheckSelection(rv, true, "a camera move"))
+  {
+    return EXIT_FAILURE;
+  }
+
+  camera->SetWindowCenter(0.5, 0.0);
+  view->StillRender();
+  if (!CheckSelection(rv, true, "a window center change"))
+  {
+    return EXIT_FAILURE;
+  }
+
+  vtkSMPropertyHelper(sphere, "ThetaResolution").Set(24);
+  sphere->UpdateVTKObjects();
+  view->StillRender();
+  if (!CheckSelection(rv, true, "a data change"))
+  {
+    return EXIT_FAILURE;
+  }
+
+  vtkSMPropertyHelper(repr, "Visibility").Set(0);
+  repr->UpdateVTKObjects();
+  view->StillRender();
+  if (!CheckSelection(rv, true, "a visibility toggle"))
+  {
+    return EXIT_FAILURE;
+  }
+
+  controller->UnRegisterProxy(repr);
+  return EXIT_SUCCESS;
+}
+}
+
+int TestSelectionCache(int, char* argv[])
+{
+  vtkInitializationHelper::Initialize(argv[0], vtkProcessModule::PROCESS_CLIENT);
+
+  vtkNew<vtkSMParaViewPipelineControllerWithRendering> controller;
+  vtkNew<vtkSMSession> session;
+  vtkProcessModule::GetProcessModule()->RegisterSession(session);
+  controller->InitializeSession(session);
+
+  const int result = TestCache(session, controller);
+
+  vtkProcessModule::GetProcessModule()->UnRegisterSession(session);
+  vtkInitializationHelper::Finalize();
+  return result;
+}
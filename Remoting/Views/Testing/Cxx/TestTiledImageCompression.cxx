@@ -0,0 +1,118 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+#include "vtkLogger.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPVClientServerSynchronizedRenderers.h"
+#include "vtkSmartPointer.h"
+#include "vtkUnsignedCharArray.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+namespace
+{
+class vtkTestTiledRenderers : public vtkPVClientServerSynchronizedRenderers
+{
+public:
+  static vtkTestTiledRenderers* New();
+  vtkTypeMacro(vtkTestTiledRenderers, vtkPVClientServerSynchronizedRenderers);
+  using vtkPVClientServerSynchronizedRenderers::CompressTiles;
+  using vtkPVClientServerSynchronizedRenderers::DecompressTiles;
+  using vtkPVClientServerSynchronizedRenderers::GetTileRows;
+
+  vtkUnsignedCharArray* GetCompressedTile(int tile)
+  {
+    return this->TileCompressors[tile]->GetOutput();
+  }
+
+  // tiles returned by ReceiveTile(), in order.
+  std::vector<vtkSmartPointer<vtkUnsignedCharArray>> Tiles;
+  size_t NumberOfReceivedTiles = 0;
+
+protected:
+  void ReceiveTile(vtkUnsignedCharArray* tile) override
+  {
+    tile->DeepCopy(this->Tiles[this->NumberOfReceivedTiles++]);
+  }
+};
+vtkStandardNewMacro(vtkTestTiledRenderers);
+
+constexpr int Width = 100;
+constexpr int Height = 37;
+
+// Compresses an image by tiles with the compressor configured by
+// `configuration`, decompresses the tiles and checks the image is unchanged.
+bool RoundTrip(const char* configuration)
+{
+  vtkNew<vtkUnsignedCharArray> image;
+  image->SetNumberOfComponents(4);
+  image->SetNumberOfTuples(Width * Height);
+  for (int y = 0; y < Height; ++y)
+  {
+    for (int x = 0; x < Width; ++x)
+    {
+      const unsigned char rgba[4] = { static_cast<unsigned char>(x / 8 * 20),
+        static_cast<unsigned char>(y * 7), static_cast<unsigned char>((x + y) % 3 * 100), 255 };
+      image->SetTypedTuple(y * Width + x, rgba);
+    }
+  }
+
+  vtkNew<vtkTestTiledRenderers> server;
+  server->ConfigureCompressor(configuration);
+  server->SetTileSize(1000);
+  const int rows = server->GetTileRows(Width, Height);
+  if (rows <= 0 || Height % rows == 0)
+  {
+    vtkLogF(ERROR, "The last tile of the image has %d rows like the others.", rows);
+    return false;
+  }
+  if (!server->CompressTiles(image, Width, Height, rows))
+  {
+    vtkLogF(ERROR, "%s failed to compress the tiles.", configuration);
+    return false;
+  }
+
+  vtkNew<vtkTestTiledRenderers> client;
+  client->ConfigureCompressor(configuration);
+  const int numTiles = (Height + rows - 1) / rows;
+  for (int cc = 0; cc < numTiles; ++cc)
+  {
+    auto tile = vtkSmartPointer<vtkUnsignedCharArray>::New();
+    tile->DeepCopy(server->GetCompressedTile(cc));
+    client->Tiles.push_back(tile);
+  }
+
+  vtkNew<vtkUnsignedCharArray> result;
+  result->SetNumberOfComponents(4);
+  result->SetNumberOfTuples(Width * Height);
+  result->Fill(0);
+  if (!client->DecompressTiles(result, Width, Height, rows) ||
+    client->NumberOfReceivedTiles != client->Tiles.size())
+  {
+    vtkLogF(ERROR, "%s failed to decompress the tiles.", configuration);
+    return false;
+  }
+  if (std::memcmp(image->GetPointer(0), result->GetPointer(0), image->GetDataSize()) != 0)
+  {
+    vtkLogF(ERROR, "%s changed the image.", configuration);
+    return false;
+  }
+  return true;
+}
+}
+
+int TestTiledImageCompression(int, char*[])
+{
+  // the compressors are lossless since the renderers use LossLessCompression.
+  for (const char* configuration :
+    { "vtkLZ4Compressor 0 3", "vtkSquirtCompressor 0 3", "vtkZlibImageCompressor 0 1 0 0" })
+  {
+    if (!RoundTrip(configuration))
+    {
+      return EXIT_FAILURE;
+    }
+  }
+  return EXIT_SUCCESS;
+}
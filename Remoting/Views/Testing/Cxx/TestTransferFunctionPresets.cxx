@@ -10,6 +10,9 @@
 #include "vtkTestUtilities.h"
 
 #include "vtk_jsoncpp.h"
+#include "vtksys/SystemTools.hxx"
+
+#include <algorithm>
 #include <cassert>
 #include <sstream>
 
@@ -40,6 +43,35 @@ int TestTransferFunctionPresets(int argc, char* argv[])
   myassert(presets->GetPresetAsString(testPreset).empty() == false, "Has test preset");
   cout << "Preset: " << endl << presets->GetPresetAsString(testPreset);
 
+  // Names and flags come from the index of builtin presets: check them against
+  // the decoded presets.
+  bool indexMatches = true;
+  for (unsigned int cc = 0; cc < presets->GetNumberOfPresets(); ++cc)
+  {
+    const Json::Value& decoded = presets->GetPreset(cc);
+    indexMatches = indexMatches && presets->GetPresetName(cc) == decoded["Name"].asString() &&
+      presets->GetPresetHasOpacities(cc) == presets->GetPresetHasOpacities(decoded) &&
+      presets->GetPresetHasIndexedColors(cc) == presets->GetPresetHasIndexedColors(decoded) &&
+      presets->GetPresetHasAnnotations(cc) == presets->GetPresetHasAnnotations(decoded);
+  }
+  myassert(indexMatches, "Indexed names and members match decoded presets");
+
+  int coolToWarm = -1;
+  presets->GetFirstPresetWithName("Cool to Warm", coolToWarm);
+  myassert(coolToWarm >= 0, "Find preset by name");
+  std::vector<unsigned int> found = presets->FindPresets("cool to");
+  myassert(std::find(found.begin(), found.end(), static_cast<unsigned int>(coolToWarm)) !=
+      found.end(),
+    "Find presets by substring");
+  bool allMatch = !found.empty();
+  for (unsigned int index : found)
+  {
+    allMatch = allMatch &&
+      vtksys::SystemTools::LowerCase(presets->GetPresetName(index)).find("cool to") !=
+        std::string::npos;
+  }
+  myassert(allMatch, "Found presets contain the substring");
+
   unsigned int old_size = presets->GetNumberOfPresets();
 
   // Test that "builtin" preset cannot be removed.
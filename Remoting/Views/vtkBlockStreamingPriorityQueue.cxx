@@ -0,0 +1,271 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+#include "vtkBlockStreamingPriorityQueue.h"
+
+#include "vtkBoundingBox.h"
+#include "vtkDataObject.h"
+#include "vtkDataObjectTree.h"
+#include "vtkDataObjectTreeIterator.h"
+#include "vtkInformation.h"
+#include "vtkObjectFactory.h"
+#include "vtkSmartPointer.h"
+#include "vtkStreamingDemandDrivenPipeline.h"
+#include "vtkStreamingPriorityQueue.h"
+
+#include <algorithm>
+#include <numeric>
+
+class vtkBlockStreamingPriorityQueue::vtkInternals
+{
+public:
+  struct vtkBlock
+  {
+    unsigned int FlatIndex = 0;
+    double Bounds[6];
+    vtkSmartPointer<vtkInformation> MetaData;
+    double Priority = 0.0;
+    // Memory size of the block, in kibibytes, known once it was loaded.
+    vtkTypeUInt64 Size = 0;
+    bool SizeKnown = false;
+    bool Requested = false;
+  };
+
+  std::vector<vtkBlock> Blocks;
+  vtkBoundingBox Bounds;
+
+  vtkBlock* Find(unsigned int flatIndex)
+  {
+    auto iter = std::lower_bound(this->Blocks.begin(), this->Blocks.end(), flatIndex,
+      [](const vtkBlock& block, unsigned int index) { return block.FlatIndex < index; });
+    return (iter != this->Blocks.end() && iter->FlatIndex == flatIndex) ? &(*iter) : nullptr;
+  }
+
+  // Requested blocks with a known size are resident.
+  vtkTypeUInt64 GetResidentMemorySize() const
+  {
+    vtkTypeUInt64 size = 0;
+    for (const auto& block : this->Blocks)
+    {
+      size += (block.Requested && block.SizeKnown) ? block.Size : 0;
+    }
+    return size;
+  }
+
+  // Indices of the blocks sorted by decreasing priority. Ties are broken by the
+  // flat index so that all processes get the same order.
+  std::vector<size_t> GetSortedBlocks() const
+  {
+    std::vector<size_t> order(this->Blocks.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [this](size_t a, size_t b) {
+      return this->Blocks[a].Priority > this->Blocks[b].Priority;
+    });
+    return order;
+  }
+};
+
+vtkStandardNewMacro(vtkBlockStreamingPriorityQueue);
+//----------------------------------------------------------------------------
+vtkBlockStreamingPriorityQueue::vtkBlockStreamingPriorityQueue()
+  : Internals(new vtkBlockStreamingPriorityQueue::vtkInternals())
+{
+}
+
+//----------------------------------------------------------------------------
+vtkBlockStreamingPriorityQueue::~vtkBlockStreamingPriorityQueue()
+{
+  delete this->Internals;
+  this->Internals = nullptr;
+}
+
+//----------------------------------------------------------------------------
+void vtkBlockStreamingPriorityQueue::Initialize(vtkDataObjectTree* metadata)
+{
+  auto& internals = *this->Internals;
+  internals.Blocks.clear();
+  internals.Bounds.Reset();
+  if (!metadata)
+  {
+    return;
+  }
+
+  vtkSmartPointer<vtkDataObjectTreeIterator> iter;
+  iter.TakeReference(metadata->NewTreeIterator());
+  iter->VisitOnlyLeavesOn();
+  iter->SkipEmptyNodesOff();
+  for (iter->InitTraversal(); !iter->IsDoneWithTraversal(); iter->GoToNextItem())
+  {
+    if (!iter->HasCurrentMetaData())
+    {
+      continue;
+    }
+    vtkInformation* info = iter->GetCurrentMetaData();
+    if (!info->Has(vtkStreamingDemandDrivenPipeline::BOUNDS()))
+    {
+      continue;
+    }
+
+    vtkInternals::vtkBlock block;
+    block.FlatIndex = iter->GetCurrentFlatIndex();
+    info->Get(vtkStreamingDemandDrivenPipeline::BOUNDS(), block.Bounds);
+    block.MetaData = info;
+    internals.Bounds.AddBounds(block.Bounds);
+    internals.Blocks.push_back(block);
+  }
+}
+
+//----------------------------------------------------------------------------
+int vtkBlockStreamingPriorityQueue::GetNumberOfBlocks() const
+{
+  return static_cast<int>(this->Internals->Blocks.size());
+}
+
+//----------------------------------------------------------------------------
+void vtkBlockStreamingPriorityQueue::GetBounds(double bounds[6]) const
+{
+  this->Internals->Bounds.GetBounds(bounds);
+}
+
+//----------------------------------------------------------------------------
+void vtkBlockStreamingPriorityQueue::Update(const double view_planes[24])
+{
+  for (auto& block : this->Internals->Blocks)
+  {
+    double distance, centeredness, itemCoverage;
+    const double coverage =
+      vtkComputeScreenCoverage(view_planes, block.Bounds, distance, centeredness, itemCoverage);
+    block.Priority =
+      coverage > 0.0 ? this->ComputePriority(coverage, distance, block.MetaData) : 0.0;
+  }
+}
+
+//----------------------------------------------------------------------------
+double vtkBlockStreamingPriorityQueue::ComputePriority(
+  double coverage, double distance, vtkInformation* metadata)
+{
+  switch (this->PriorityMetric)
+  {
+    case VIEW_DISTANCE:
+      // blocks behind the near plane but still visible are the closest ones.
+      return 1.0 / (1.0 + std::max(distance, 0.0));
+
+    case DATA_RANGE:
+      if (metadata && metadata->Has(vtkDataObject::PIECE_FIELD_RANGE()) &&
+        metadata->Length(vtkDataObject::PIECE_FIELD_RANGE()) >= 2)
+      {
+        const double* range = metadata->Get(vtkDataObject::PIECE_FIELD_RANGE());
+        if (range[1] < this->DataRange[0] || range[0] > this->DataRange[1])
+        {
+          // keep blocks outside the range of interest after all the others,
+          // but still stream them.
+          return 0.01 * coverage;
+        }
+      }
+      return coverage;
+
+    case SCREEN_COVERAGE:
+    default:
+      return coverage;
+  }
+}
+
+//----------------------------------------------------------------------------
+std::vector<unsigned int> vtkBlockStreamingPriorityQueue::GetNextBlocks(int count)
+{
+  auto& internals = *this->Internals;
+  const vtkTypeUInt64 budget = this->MemoryBudget;
+  vtkTypeUInt64 resident = internals.GetResidentMemorySize();
+
+  // once the budget is reached, a block is only worth loading if it has a
+  // higher priority than a resident block it will replace.
+  double minResidentPriority = VTK_DOUBLE_MAX;
+  for (const auto& block : internals.Blocks)
+  {
+    if (block.Requested)
+    {
+      minResidentPriority = std::min(minResidentPriority, block.Priority);
+    }
+  }
+
+  std::vector<unsigned int> result;
+  for (size_t index : internals.GetSortedBlocks())
+  {
+    auto& block = internals.Blocks[index];
+    if (static_cast<int>(result.size()) >= count || block.Priority <= 0.0)
+    {
+      break;
+    }
+    if (block.Requested)
+    {
+      continue;
+    }
+
+    if (budget > 0)
+    {
+      // the size of blocks that were loaded and released before is known,
+      // which avoids loading again blocks that cannot fit.
+      const vtkTypeUInt64 size = block.SizeKnown ? block.Size : 0;
+      const bool fits = block.SizeKnown ? resident + size <= budget : resident < budget;
+      if (!fits && block.Priority <= minResidentPriority)
+      {
+        break;
+      }
+      resident += size;
+    }
+
+    block.Requested = true;
+    result.push_back(block.FlatIndex);
+  }
+  return result;
+}
+
+//----------------------------------------------------------------------------
+void vtkBlockStreamingPriorityQueue::SetBlockMemorySize(unsigned int flatIndex, vtkTypeUInt64 size)
+{
+  if (auto block = this->Internals->Find(flatIndex))
+  {
+    block->Size = size;
+    block->SizeKnown = true;
+  }
+}
+
+//----------------------------------------------------------------------------
+std::vector<unsigned int> vtkBlockStreamingPriorityQueue::GetBlocksToRelease()
+{
+  std::vector<unsigned int> result;
+  auto& internals = *this->Internals;
+  if (this->MemoryBudget == 0)
+  {
+    return result;
+  }
+
+  vtkTypeUInt64 resident = internals.GetResidentMemorySize();
+  const auto order = internals.GetSortedBlocks();
+  for (auto iter = order.rbegin(); iter != order.rend() && resident > this->MemoryBudget; ++iter)
+  {
+    auto& block = internals.Blocks[*iter];
+    if (block.Requested && block.SizeKnown)
+    {
+      block.Requested = false;
+      resident -= block.Size;
+      result.push_back(block.FlatIndex);
+    }
+  }
+  return result;
+}
+
+//----------------------------------------------------------------------------
+vtkTypeUInt64 vtkBlockStreamingPriorityQueue::GetResidentMemorySize() const
+{
+  return this->Internals->GetResidentMemorySize();
+}
+
+//----------------------------------------------------------------------------
+void vtkBlockStreamingPriorityQueue::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "PriorityMetric: " << this->PriorityMetric << endl;
+  os << indent << "DataRange: " << this->DataRange[0] << ", " << this->DataRange[1] << endl;
+  os << indent << "MemoryBudget: " << this->MemoryBudget << endl;
+  os << indent << "NumberOfBlocks: " << this->GetNumberOfBlocks() << endl;
+}
@@ -0,0 +1,165 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+/**
+ * @class   vtkBlockStreamingPriorityQueue
+ * @brief   view-based priority queue for streaming blocks of composite datasets.
+ *
+ * vtkBlockStreamingPriorityQueue is used by vtkBlockStreamingRepresentation to
+ * decide which blocks of a composite dataset to request next from a pipeline
+ * that supports loading requested blocks, and which ones to release to stay
+ * within a memory budget. Blocks are the leaves of the composite data meta-data
+ * provided by the pipeline (vtkCompositeDataPipeline::COMPOSITE_DATA_META_DATA())
+ * and are identified by their flat index. Only leaves with bounds
+ * (vtkStreamingDemandDrivenPipeline::BOUNDS()) in their meta-data are streamed.
+ *
+ * The priority of each block is computed from the view planes (returned by
+ * vtkCamera::GetFrustumPlanes()) using the metric selected with
+ * SetPriorityMetric(). Blocks outside of the view frustum have a priority of 0
+ * and are never requested. Subclasses can implement other metrics by
+ * overriding ComputePriority().
+ *
+ * All processes must call Initialize(), Update(), GetNextBlocks(),
+ * SetBlockMemorySize() and GetBlocksToRelease() with the same arguments, in
+ * which case they all make the same decisions. It is up to the caller to
+ * distribute the blocks to load among the processes.
+ *
+ * @sa
+ * vtkBlockStreamingRepresentation, vtkAMRStreamingPriorityQueue
+ */
+
+#ifndef vtkBlockStreamingPriorityQueue_h
+#define vtkBlockStreamingPriorityQueue_h
+
+#include "vtkObject.h"
+#include "vtkRemotingViewsModule.h" // for export macros
+
+#include <vector> // for std::vector
+
+class vtkDataObjectTree;
+class vtkInformation;
+
+class VTKREMOTINGVIEWS_EXPORT vtkBlockStreamingPriorityQueue : public vtkObject
+{
+public:
+  static vtkBlockStreamingPriorityQueue* New();
+  vtkTypeMacro(vtkBlockStreamingPriorityQueue, vtkObject);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  enum PriorityMetrics
+  {
+    /**
+     * Blocks covering a larger part of the screen first.
+     */
+    SCREEN_COVERAGE = 0,
+
+    /**
+     * Blocks closer to the camera first.
+     */
+    VIEW_DISTANCE = 1,
+
+    /**
+     * Blocks whose range for the data array (see
+     * vtkDataObject::PIECE_FIELD_RANGE()) overlaps DataRange first, by screen
+     * coverage. Blocks without range are treated as overlapping.
+     */
+    DATA_RANGE = 2
+  };
+
+  ///@{
+  /**
+   * Get/Set the metric used to prioritize the visible blocks. Default is
+   * SCREEN_COVERAGE.
+   */
+  vtkSetClampMacro(PriorityMetric, int, SCREEN_COVERAGE, DATA_RANGE);
+  vtkGetMacro(PriorityMetric, int);
+  ///@}
+
+  ///@{
+  /**
+   * Get/Set the range of interest used by the DATA_RANGE metric.
+   */
+  vtkSetVector2Macro(DataRange, double);
+  vtkGetVector2Macro(DataRange, double);
+  ///@}
+
+  ///@{
+  /**
+   * Get/Set the memory, in kibibytes, that the resident blocks may use. Lower
+   * priority blocks are released when it is exceeded, and blocks are no
+   * longer requested once it is reached unless they have a higher priority
+   * than a resident block. 0 means no limit, which is the default.
+   */
+  vtkSetMacro(MemoryBudget, vtkTypeUInt64);
+  vtkGetMacro(MemoryBudget, vtkTypeUInt64);
+  ///@}
+
+  /**
+   * Initializes the queue from the composite data meta-data. All information
+   * about requested and resident blocks is lost.
+   */
+  void Initialize(vtkDataObjectTree* metadata);
+
+  /**
+   * Returns the number of blocks that can be streamed.
+   */
+  int GetNumberOfBlocks() const;
+
+  /**
+   * Returns the bounds of all the blocks.
+   */
+  void GetBounds(double bounds[6]) const;
+
+  /**
+   * Updates the priorities of the blocks for the view planes.
+   */
+  void Update(const double view_planes[24]);
+
+  /**
+   * Returns the flat indices of the next blocks to request, at most `count`,
+   * highest priority first. The blocks are considered as requested.
+   */
+  std::vector<unsigned int> GetNextBlocks(int count);
+
+  /**
+   * Records the memory size, in kibibytes, of a requested block once loaded.
+   */
+  void SetBlockMemorySize(unsigned int flatIndex, vtkTypeUInt64 size);
+
+  /**
+   * Returns the flat indices of the resident blocks to release to stay within
+   * the memory budget, lowest priority first. The blocks are no longer
+   * considered as requested and may be requested again.
+   */
+  std::vector<unsigned int> GetBlocksToRelease();
+
+  /**
+   * Returns the memory size of the resident blocks, in kibibytes.
+   */
+  vtkTypeUInt64 GetResidentMemorySize() const;
+
+protected:
+  vtkBlockStreamingPriorityQueue();
+  ~vtkBlockStreamingPriorityQueue() override;
+
+  /**
+   * Computes the priority of a visible block. `coverage` is the fraction of
+   * the screen covered by the block, `distance` is the distance of the block
+   * center to the near plane and `metadata` is the block meta-data. Higher
+   * priority blocks are requested first. Blocks with a priority of 0 or less
+   * are not requested.
+   */
+  virtual double ComputePriority(double coverage, double distance, vtkInformation* metadata);
+
+  int PriorityMetric = SCREEN_COVERAGE;
+  double DataRange[2] = { 0.0, 1.0 };
+  vtkTypeUInt64 MemoryBudget = 0;
+
+private:
+  vtkBlockStreamingPriorityQueue(const vtkBlockStreamingPriorityQueue&) = delete;
+  void operator=(const vtkBlockStreamingPriorityQueue&) = delete;
+
+  class vtkInternals;
+  vtkInternals* Internals;
+};
+
+#endif
@@ -0,0 +1,543 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+#include "vtkBlockStreamingRepresentation.h"
+
+#include "vtkAlgorithmOutput.h"
+#include "vtkBlockStreamingPriorityQueue.h"
+#include "vtkCommunicator.h"
+#include "vtkCompositeDataPipeline.h"
+#include "vtkCompositePolyDataMapper.h"
+#include "vtkDataObjectTreeIterator.h"
+#include "vtkDataSet.h"
+#include "vtkFieldData.h"
+#include "vtkInformation.h"
+#include "vtkInformationVector.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkMultiProcessController.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPVGeometryFilter.h"
+#include "vtkPVLODActor.h"
+#include "vtkPVRenderView.h"
+#include "vtkPVStreamingMacros.h"
+#include "vtkProperty.h"
+#include "vtkRenderer.h"
+#include "vtkUnsignedIntArray.h"
+
+#include <algorithm>
+#include <cassert>
+#include <set>
+
+namespace
+{
+// Field data array listing the flat indices of the blocks to release, sent
+// along with the streamed pieces.
+constexpr const char* BlocksToReleaseArrayName = "__blocks_to_release";
+}
+
+vtkStandardNewMacro(vtkBlockStreamingRepresentation);
+//----------------------------------------------------------------------------
+vtkBlockStreamingRepresentation::vtkBlockStreamingRepresentation()
+{
+  this->PriorityQueue = vtkSmartPointer<vtkBlockStreamingPriorityQueue>::New();
+  this->Mapper = vtkSmartPointer<vtkCompositePolyDataMapper>::New();
+  this->Actor = vtkSmartPointer<vtkPVLODActor>::New();
+  this->Actor->SetMapper(this->Mapper);
+}
+
+//----------------------------------------------------------------------------
+vtkBlockStreamingRepresentation::~vtkBlockStreamingRepresentation() = default;
+
+//----------------------------------------------------------------------------
+void vtkBlockStreamingRepresentation::SetVisibility(bool val)
+{
+  this->Actor->SetVisibility(val);
+  this->Superclass::SetVisibility(val);
+}
+
+//----------------------------------------------------------------------------
+void vtkBlockStreamingRepresentation::SetPriorityMetric(int metric)
+{
+  // the metric only affects the order of the next requests, there is no need
+  // to re-execute.
+  this->PriorityQueue->SetPriorityMetric(metric);
+}
+
+//----------------------------------------------------------------------------
+int vtkBlockStreamingRepresentation::GetPriorityMetric() const
+{
+  return this->PriorityQueue->GetPriorityMetric();
+}
+
+//----------------------------------------------------------------------------
+void vtkBlockStreamingRepresentation::SetPriorityDataRange(double min, double max)
+{
+  this->PriorityQueue->SetDataRange(min, max);
+}
+
+//----------------------------------------------------------------------------
+void vtkBlockStreamingRepresentation::GetPriorityDataRange(double range[2]) const
+{
+  this->PriorityQueue->GetDataRange(range);
+}
+
+//----------------------------------------------------------------------------
+int vtkBlockStreamingRepresentation::ProcessViewRequest(
+  vtkInformationRequestKey* request_type, vtkInformation* inInfo, vtkInformation* outInfo)
+{
+  if (!this->Superclass::ProcessViewRequest(request_type, inInfo, outInfo))
+  {
+    return 0;
+  }
+
+  if (request_type == vtkPVView::REQUEST_UPDATE())
+  {
+    vtkPVRenderView::SetPiece(inInfo, this, this->ProcessedData);
+    double bounds[6];
+    this->DataBounds.GetBounds(bounds);
+    vtkPVRenderView::SetGeometryBounds(inInfo, this, bounds);
+    vtkPVRenderView::SetStreamable(inInfo, this, this->GetStreamingCapablePipeline());
+  }
+  else if (request_type == vtkPVView::REQUEST_RENDER())
+  {
+    if (this->RenderedData == nullptr)
+    {
+      vtkStreamingStatusMacro(<< this << ": cloning delivered data.");
+      vtkAlgorithmOutput* producerPort = vtkPVRenderView::GetPieceProducer(inInfo, this);
+      vtkAlgorithm* producer = producerPort->GetProducer();
+      auto data =
+        vtkDataObjectTree::SafeDownCast(producer->GetOutputDataObject(producerPort->GetIndex()));
+      if (data)
+      {
+        // streamed pieces are merged into a shallow copy to leave the delivered
+        // data untouched.
+        this->RenderedData.TakeReference(data->NewInstance());
+        this->RenderedData->ShallowCopy(data);
+        this->Mapper->SetInputDataObject(this->RenderedData);
+      }
+    }
+  }
+  else if (request_type == vtkPVRenderView::REQUEST_STREAMING_UPDATE())
+  {
+    if (this->GetStreamingCapablePipeline())
+    {
+      double view_planes[24];
+      inInfo->Get(vtkPVRenderView::VIEW_PLANES(), view_planes);
+      if (this->StreamingUpdate(view_planes))
+      {
+        vtkPVRenderView::SetNextStreamedPiece(inInfo, this, this->ProcessedPiece);
+      }
+    }
+  }
+  else if (request_type == vtkPVRenderView::REQUEST_PROCESS_STREAMED_PIECE())
+  {
+    if (vtkDataObject* piece = vtkPVRenderView::GetCurrentStreamedPiece(inInfo, this))
+    {
+      vtkStreamingStatusMacro(<< this << ": received new piece.");
+      this->MergeStreamedPiece(piece);
+    }
+  }
+
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+void vtkBlockStreamingRepresentation::MergeStreamedPiece(vtkDataObject* piece)
+{
+  auto tree = vtkDataObjectTree::SafeDownCast(piece);
+  if (!tree || !this->RenderedData)
+  {
+    return;
+  }
+
+  // pieces have the same structure as the rendered data, blocks are simply
+  // replaced.
+  vtkSmartPointer<vtkDataObjectTreeIterator> iter;
+  iter.TakeReference(tree->NewTreeIterator());
+  iter->VisitOnlyLeavesOn();
+  for (iter->InitTraversal(); !iter->IsDoneWithTraversal(); iter->GoToNextItem())
+  {
+    this->RenderedData->SetDataSet(iter, iter->GetCurrentDataObject());
+  }
+
+  // release blocks after merging since a block loaded in this pass may already
+  // have been released.
+  auto array =
+    vtkUnsignedIntArray::SafeDownCast(tree->GetFieldData()->GetArray(BlocksToReleaseArrayName));
+  if (array)
+  {
+    const std::set<unsigned int> blocksToRelease(
+      array->GetPointer(0), array->GetPointer(0) + array->GetNumberOfValues());
+    iter.TakeReference(this->RenderedData->NewTreeIterator());
+    iter->VisitOnlyLeavesOn();
+    for (iter->InitTraversal(); !iter->IsDoneWithTraversal(); iter->GoToNextItem())
+    {
+      if (blocksToRelease.find(iter->GetCurrentFlatIndex()) != blocksToRelease.end())
+      {
+        this->RenderedData->SetDataSet(iter, nullptr);
+      }
+    }
+  }
+  this->RenderedData->Modified();
+}
+
+//----------------------------------------------------------------------------
+int vtkBlockStreamingRepresentation::RequestInformation(
+  vtkInformation* rqst, vtkInformationVector** inputVector, vtkInformationVector* outputVector)
+{
+  this->StreamingCapablePipeline = false;
+  if (inputVector[0]->GetNumberOfInformationObjects() == 1)
+  {
+    vtkInformation* inInfo = inputVector[0]->GetInformationObject(0);
+    if (inInfo->Has(vtkCompositeDataPipeline::COMPOSITE_DATA_META_DATA()) &&
+      vtkPVView::GetEnableStreaming())
+    {
+      this->StreamingCapablePipeline = true;
+    }
+  }
+
+  vtkStreamingStatusMacro(<< this << ": streaming capable input pipeline? "
+                          << (this->StreamingCapablePipeline ? "yes" : "no"));
+  return this->Superclass::RequestInformation(rqst, inputVector, outputVector);
+}
+
+//----------------------------------------------------------------------------
+int vtkBlockStreamingRepresentation::RequestUpdateExtent(
+  vtkInformation* request, vtkInformationVector** inputVector, vtkInformationVector* outputVector)
+{
+  if (!this->Superclass::RequestUpdateExtent(request, inputVector, outputVector))
+  {
+    return 0;
+  }
+
+  for (int cc = 0; cc < this->GetNumberOfInputPorts(); cc++)
+  {
+    for (int kk = 0; kk < inputVector[cc]->GetNumberOfInformationObjects(); kk++)
+    {
+      vtkInformation* info = inputVector[cc]->GetInformationObject(kk);
+      if (this->InStreamingUpdate && !this->StreamingRequest.empty())
+      {
+        info->Set(vtkCompositeDataPipeline::LOAD_REQUESTED_BLOCKS(), 1);
+        info->Set(vtkCompositeDataPipeline::UPDATE_COMPOSITE_INDICES(),
+          this->StreamingRequest.data(), static_cast<int>(this->StreamingRequest.size()));
+      }
+      else if (this->StreamingCapablePipeline)
+      {
+        // blocks are only loaded by streaming passes, visible ones first and
+        // within the memory budget, hence none is requested here: only the
+        // structure of the data is delivered. This is also the request of
+        // processes with no block to load during a streaming pass.
+        const int noBlocks = 0;
+        info->Set(vtkCompositeDataPipeline::LOAD_REQUESTED_BLOCKS(), 1);
+        info->Set(vtkCompositeDataPipeline::UPDATE_COMPOSITE_INDICES(), &noBlocks, 0);
+      }
+      else
+      {
+        info->Remove(vtkCompositeDataPipeline::LOAD_REQUESTED_BLOCKS());
+        info->Remove(vtkCompositeDataPipeline::UPDATE_COMPOSITE_INDICES());
+      }
+    }
+  }
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+vtkSmartPointer<vtkDataObject> vtkBlockStreamingRepresentation::ProcessBlocks(vtkDataObject* input)
+{
+  vtkNew<vtkPVGeometryFilter> geomFilter;
+  geomFilter->SetController(nullptr);
+  geomFilter->SetInputData(input);
+  geomFilter->Update();
+  return geomFilter->GetOutputDataObject(0);
+}
+
+//----------------------------------------------------------------------------
+int vtkBlockStreamingRepresentation::RequestData(
+  vtkInformation* rqst, vtkInformationVector** inputVector, vtkInformationVector* outputVector)
+{
+  this->ProcessedPiece = nullptr;
+  if (inputVector[0]->GetNumberOfInformationObjects() == 1)
+  {
+    vtkInformation* inInfo = inputVector[0]->GetInformationObject(0);
+    if (this->GetStreamingCapablePipeline() && !this->GetInStreamingUpdate())
+    {
+      // the input changed, restart streaming from scratch.
+      this->PriorityQueue->Initialize(vtkDataObjectTree::SafeDownCast(
+        inInfo->Get(vtkCompositeDataPipeline::COMPOSITE_DATA_META_DATA())));
+    }
+
+    vtkSmartPointer<vtkDataObject> output =
+      this->ProcessBlocks(vtkDataObject::GetData(inputVector[0], 0));
+    if (this->GetInStreamingUpdate())
+    {
+      this->ProcessedPiece = output;
+    }
+    else
+    {
+      this->ProcessedData = vtkDataObjectTree::SafeDownCast(output);
+      if (!this->ProcessedData)
+      {
+        vtkNew<vtkMultiBlockDataSet> mb;
+        mb->SetBlock(0, output);
+        this->ProcessedData = mb;
+      }
+
+      this->DataBounds.Reset();
+      vtkSmartPointer<vtkDataObjectTreeIterator> iter;
+      iter.TakeReference(this->ProcessedData->NewTreeIterator());
+      for (iter->InitTraversal(); !iter->IsDoneWithTraversal(); iter->GoToNextItem())
+      {
+        if (auto ds = vtkDataSet::SafeDownCast(iter->GetCurrentDataObject()))
+        {
+          this->DataBounds.AddBounds(ds->GetBounds());
+        }
+      }
+      if (this->GetStreamingCapablePipeline() && this->PriorityQueue->GetNumberOfBlocks() > 0)
+      {
+        // include the blocks that are yet to be streamed.
+        double bounds[6];
+        this->PriorityQueue->GetBounds(bounds);
+        this->DataBounds.AddBounds(bounds);
+      }
+    }
+  }
+  else
+  {
+    // create an empty dataset. This is needed so that view knows what dataset
+    // to expect from the other processes on this node.
+    this->ProcessedData = vtkSmartPointer<vtkMultiBlockDataSet>::New();
+    this->DataBounds.Reset();
+  }
+
+  if (!this->GetInStreamingUpdate())
+  {
+    this->RenderedData = nullptr;
+
+    // provide the mapper with an empty input. This is needed only because
+    // mappers die when input is nullptr, currently.
+    vtkNew<vtkMultiBlockDataSet> tmp;
+    this->Mapper->SetInputDataObject(tmp);
+  }
+
+  return this->Superclass::RequestData(rqst, inputVector, outputVector);
+}
+
+//----------------------------------------------------------------------------
+bool vtkBlockStreamingRepresentation::StreamingUpdate(const double view_planes[24])
+{
+  assert(this->InStreamingUpdate == false);
+
+  vtkMultiProcessController* controller = vtkMultiProcessController::GetGlobalController();
+  const int numProcs = controller ? controller->GetNumberOfProcesses() : 1;
+  const int rank = controller ? controller->GetLocalProcessId() : 0;
+
+  // All processes share the same meta-data, hence make the same decisions.
+  this->PriorityQueue->SetMemoryBudget(static_cast<vtkTypeUInt64>(this->MemoryBudget) * 1024);
+  this->PriorityQueue->Update(view_planes);
+  const std::vector<unsigned int> blocks =
+    this->PriorityQueue->GetNextBlocks(this->StreamingRequestSize * numProcs);
+  std::vector<unsigned int> blocksToRelease;
+  if (blocks.empty())
+  {
+    // the budget may have been lowered.
+    blocksToRelease = this->PriorityQueue->GetBlocksToRelease();
+    if (blocksToRelease.empty())
+    {
+      return false;
+    }
+  }
+
+  this->StreamingRequest.clear();
+  for (size_t cc = rank; cc < blocks.size(); cc += numProcs)
+  {
+    vtkStreamingStatusMacro(<< this << ": requesting block: " << blocks[cc]);
+    this->StreamingRequest.push_back(static_cast<int>(blocks[cc]));
+  }
+
+  if (!blocks.empty())
+  {
+    // every process updates, even those with no block to load which request
+    // none, since the reader may use collective operations while loading.
+    this->InStreamingUpdate = true;
+    vtkStreamingStatusMacro(<< this << ": doing streaming-update.");
+
+    // This ensure that the representation re-executes.
+    this->MarkModified();
+    this->Update();
+    this->InStreamingUpdate = false;
+  }
+  else
+  {
+    // only blocks to release, no process needs to update. An empty piece is
+    // still delivered since the view delivers pieces from all processes.
+    vtkSmartPointer<vtkDataObjectTree> clone;
+    clone.TakeReference(this->ProcessedData->NewInstance());
+    clone->CopyStructure(this->ProcessedData);
+    this->ProcessedPiece = clone;
+  }
+
+  if (!blocks.empty())
+  {
+    // record the memory used by the loaded blocks on all processes.
+    std::vector<vtkTypeUInt64> localSizes(blocks.size(), 0);
+    if (auto piece = vtkDataObjectTree::SafeDownCast(this->ProcessedPiece))
+    {
+      vtkSmartPointer<vtkDataObjectTreeIterator> iter;
+      iter.TakeReference(piece->NewTreeIterator());
+      iter->VisitOnlyLeavesOn();
+      for (iter->InitTraversal(); !iter->IsDoneWithTraversal(); iter->GoToNextItem())
+      {
+        auto pos = std::find(blocks.begin(), blocks.end(), iter->GetCurrentFlatIndex());
+        if (pos != blocks.end())
+        {
+          localSizes[pos - blocks.begin()] += iter->GetCurrentDataObject()->GetActualMemorySize();
+        }
+      }
+    }
+    std::vector<vtkTypeUInt64> sizes(localSizes);
+    if (numProcs > 1)
+    {
+      controller->AllReduce(localSizes.data(), sizes.data(),
+        static_cast<vtkIdType>(sizes.size()), vtkCommunicator::SUM_OP);
+    }
+    for (size_t cc = 0; cc < blocks.size(); ++cc)
+    {
+      this->PriorityQueue->SetBlockMemorySize(blocks[cc], sizes[cc]);
+    }
+    blocksToRelease = this->PriorityQueue->GetBlocksToRelease();
+  }
+
+  if (!blocksToRelease.empty())
+  {
+    vtkStreamingStatusMacro(<< this << ": releasing " << blocksToRelease.size() << " blocks.");
+    vtkNew<vtkUnsignedIntArray> array;
+    array->SetName(BlocksToReleaseArrayName);
+    array->SetNumberOfValues(static_cast<vtkIdType>(blocksToRelease.size()));
+    std::copy(blocksToRelease.begin(), blocksToRelease.end(), array->GetPointer(0));
+    this->ProcessedPiece->GetFieldData()->AddArray(array);
+  }
+  return true;
+}
+
+//----------------------------------------------------------------------------
+int vtkBlockStreamingRepresentation::FillInputPortInformation(
+  int vtkNotUsed(port), vtkInformation* info)
+{
+  info->Set(vtkAlgorithm::INPUT_REQUIRED_DATA_TYPE(), "vtkCompositeDataSet");
+  info->Append(vtkAlgorithm::INPUT_REQUIRED_DATA_TYPE(), "vtkDataSet");
+
+  // Saying INPUT_IS_OPTIONAL() is essential, since representations don't have
+  // any inputs on client-side (in client-server, client-render-server mode) and
+  // render-server-side (in client-render-server mode).
+  info->Set(vtkAlgorithm::INPUT_IS_OPTIONAL(), 1);
+
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+bool vtkBlockStreamingRepresentation::AddToView(vtkView* view)
+{
+  vtkPVRenderView* rview = vtkPVRenderView::SafeDownCast(view);
+  if (rview)
+  {
+    rview->GetRenderer()->AddActor(this->Actor);
+    return this->Superclass::AddToView(view);
+  }
+  return false;
+}
+
+//----------------------------------------------------------------------------
+bool vtkBlockStreamingRepresentation::RemoveFromView(vtkView* view)
+{
+  vtkPVRenderView* rview = vtkPVRenderView::SafeDownCast(view);
+  if (rview)
+  {
+    rview->GetRenderer()->RemoveActor(this->Actor);
+    return this->Superclass::RemoveFromView(view);
+  }
+  return false;
+}
+
+//----------------------------------------------------------------------------
+void vtkBlockStreamingRepresentation::SetInputArrayToProcess(
+  int idx, int port, int connection, int fieldAssociation, const char* name)
+{
+  this->Superclass::SetInputArrayToProcess(idx, port, connection, fieldAssociation, name);
+
+  if (name && name[0])
+  {
+    this->Mapper->SetScalarVisibility(1);
+    this->Mapper->SelectColorArray(name);
+    this->Mapper->SetUseLookupTableScalarRange(1);
+  }
+  else
+  {
+    this->Mapper->SetScalarVisibility(0);
+    this->Mapper->SelectColorArray(static_cast<const char*>(nullptr));
+  }
+
+  switch (fieldAssociation)
+  {
+    case vtkDataObject::FIELD_ASSOCIATION_CELLS:
+      this->Mapper->SetScalarMode(VTK_SCALAR_MODE_USE_CELL_FIELD_DATA);
+      break;
+
+    case vtkDataObject::FIELD_ASSOCIATION_POINTS:
+    default:
+      this->Mapper->SetScalarMode(VTK_SCALAR_MODE_USE_POINT_FIELD_DATA);
+      break;
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkBlockStreamingRepresentation::SetLookupTable(vtkScalarsToColors* lut)
+{
+  this->Mapper->SetLookupTable(lut);
+}
+
+//----------------------------------------------------------------------------
+void vtkBlockStreamingRepresentation::SetOpacity(double val)
+{
+  this->Actor->GetProperty()->SetOpacity(val);
+}
+
+//----------------------------------------------------------------------------
+void vtkBlockStreamingRepresentation::SetPointSize(double val)
+{
+  this->Actor->GetProperty()->SetPointSize(val);
+}
+
+//----------------------------------------------------------------------------
+void vtkBlockStreamingRepresentation::SetLineWidth(double val)
+{
+  this->Actor->GetProperty()->SetLineWidth(val);
+}
+
+//----------------------------------------------------------------------------
+void vtkBlockStreamingRepresentation::SetDiffuseColor(double r, double g, double b)
+{
+  this->Actor->GetProperty()->SetDiffuseColor(r, g, b);
+}
+
+//----------------------------------------------------------------------------
+void vtkBlockStreamingRepresentation::SetAmbientColor(double r, double g, double b)
+{
+  this->Actor->GetProperty()->SetAmbientColor(r, g, b);
+}
+
+//----------------------------------------------------------------------------
+void vtkBlockStreamingRepresentation::SetPickable(int val)
+{
+  this->Actor->SetPickable(val);
+}
+
+//----------------------------------------------------------------------------
+void vtkBlockStreamingRepresentation::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "StreamingCapablePipeline: " << this->StreamingCapablePipeline << endl;
+  os << indent << "StreamingRequestSize: " << this->StreamingRequestSize << endl;
+  os << indent << "MemoryBudget: " << this->MemoryBudget << endl;
+  os << indent << "PriorityQueue: " << endl;
+  this->PriorityQueue->PrintSelf(os, indent.GetNextIndent());
+}
@@ -0,0 +1,292 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+/**
+ * @class   vtkBlockStreamingRepresentation
+ * @brief   surface representation that streams the blocks of composite datasets.
+ *
+ * vtkBlockStreamingRepresentation renders the surface of multiblock or
+ * partitioned dataset collections produced by pipelines that can load
+ * requested blocks, i.e. that provide
+ * vtkCompositeDataPipeline::COMPOSITE_DATA_META_DATA() with the bounds of the
+ * blocks and honor vtkCompositeDataPipeline::LOAD_REQUESTED_BLOCKS(). Unlike
+ * vtkAMROutlineRepresentation and the streaming particles plugin, it makes no
+ * assumption about the organization of the blocks.
+ *
+ * When streaming is enabled (see vtkPVView::GetEnableStreaming()), no block is
+ * requested when the pipeline updates, so only the structure of the data is
+ * delivered. Then, for each streaming pass of the view, the visible blocks are
+ * requested by order of priority, as computed by a
+ * vtkBlockStreamingPriorityQueue with the metric selected with
+ * SetPriorityMetric(), StreamingRequestSize blocks per process at a time.
+ * Blocks are requested on all the data-server processes in a round-robin
+ * fashion. Resident blocks are released, lowest priority first, when their
+ * memory exceeds the MemoryBudget.
+ *
+ * Subclasses can change how blocks are converted to renderable geometry by
+ * overriding ProcessBlocks() and how they are prioritized by setting a
+ * vtkBlockStreamingPriorityQueue subclass as the PriorityQueue in their
+ * constructor.
+ *
+ * When streaming is disabled or the pipeline cannot load requested blocks,
+ * the whole pipeline output is rendered.
+ *
+ * @sa
+ * vtkBlockStreamingPriorityQueue
+ */
+
+#ifndef vtkBlockStreamingRepresentation_h
+#define vtkBlockStreamingRepresentation_h
+
+#include "vtkBoundingBox.h" // needed for vtkBoundingBox.
+#include "vtkPVDataRepresentation.h"
+#include "vtkRemotingViewsModule.h" // for export macros
+#include "vtkSmartPointer.h"        // for smart pointer.
+
+#include <vector> // for std::vector
+
+class vtkBlockStreamingPriorityQueue;
+class vtkCompositePolyDataMapper;
+class vtkDataObjectTree;
+class vtkPVLODActor;
+class vtkScalarsToColors;
+
+class VTKREMOTINGVIEWS_EXPORT vtkBlockStreamingRepresentation : public vtkPVDataRepresentation
+{
+public:
+  static vtkBlockStreamingRepresentation* New();
+  vtkTypeMacro(vtkBlockStreamingRepresentation, vtkPVDataRepresentation);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  /**
+   * Overridden to handle various view passes.
+   */
+  int ProcessViewRequest(vtkInformationRequestKey* request_type, vtkInformation* inInfo,
+    vtkInformation* outInfo) override;
+
+  /**
+   * Get/Set the visibility for this representation. When the visibility of
+   * representation of false, all view passes are ignored.
+   */
+  void SetVisibility(bool val) override;
+
+  ///@{
+  /**
+   * Set the input data arrays that this algorithm will process. Overridden to
+   * pass the array selection to the mapper.
+   */
+  void SetInputArrayToProcess(
+    int idx, int port, int connection, int fieldAssociation, const char* name) override;
+  void SetInputArrayToProcess(
+    int idx, int port, int connection, int fieldAssociation, int fieldAttributeType) override
+  {
+    this->Superclass::SetInputArrayToProcess(
+      idx, port, connection, fieldAssociation, fieldAttributeType);
+  }
+  void SetInputArrayToProcess(int idx, vtkInformation* info) override
+  {
+    this->Superclass::SetInputArrayToProcess(idx, info);
+  }
+  void SetInputArrayToProcess(int idx, int port, int connection, const char* fieldAssociation,
+    const char* attributeTypeorName) override
+  {
+    this->Superclass::SetInputArrayToProcess(
+      idx, port, connection, fieldAssociation, attributeTypeorName);
+  }
+  ///@}
+
+  ///@{
+  /**
+   * Get/Set the number of blocks to request at a time on each process when
+   * streaming. Default is 1.
+   */
+  vtkSetClampMacro(StreamingRequestSize, int, 1, 10000);
+  vtkGetMacro(StreamingRequestSize, int);
+  ///@}
+
+  ///@{
+  /**
+   * Get/Set the metric used to prioritize the blocks, see
+   * vtkBlockStreamingPriorityQueue::PriorityMetrics. Default is
+   * vtkBlockStreamingPriorityQueue::SCREEN_COVERAGE.
+   */
+  void SetPriorityMetric(int metric);
+  int GetPriorityMetric() const;
+  ///@}
+
+  ///@{
+  /**
+   * Get/Set the range of interest for the
+   * vtkBlockStreamingPriorityQueue::DATA_RANGE metric.
+   */
+  void SetPriorityDataRange(double min, double max);
+  void GetPriorityDataRange(double range[2]) const;
+  ///@}
+
+  ///@{
+  /**
+   * Get/Set the memory, in megabytes, that the blocks streamed on each process
+   * may use. 0 means no limit. Default is 1024.
+   */
+  vtkSetMacro(MemoryBudget, int);
+  vtkGetMacro(MemoryBudget, int);
+  ///@}
+
+  //---------------------------------------------------------------------------
+  // The following API is to simply provide the functionality similar to
+  // vtkGeometryRepresentation.
+  //---------------------------------------------------------------------------
+  void SetLookupTable(vtkScalarsToColors*);
+  void SetOpacity(double val);
+  void SetPointSize(double val);
+  void SetLineWidth(double val);
+  void SetDiffuseColor(double r, double g, double b);
+  void SetAmbientColor(double r, double g, double b);
+  void SetPickable(int val);
+
+protected:
+  vtkBlockStreamingRepresentation();
+  ~vtkBlockStreamingRepresentation() override;
+
+  /**
+   * Adds the representation to the view.  This is called from
+   * vtkView::AddRepresentation().  Subclasses should override this method.
+   * Returns true if the addition succeeds.
+   */
+  bool AddToView(vtkView* view) override;
+
+  /**
+   * Removes the representation to the view.  This is called from
+   * vtkView::RemoveRepresentation().  Subclasses should override this method.
+   * Returns true if the removal succeeds.
+   */
+  bool RemoveFromView(vtkView* view) override;
+
+  /**
+   * Fill input port information.
+   */
+  int FillInputPortInformation(int port, vtkInformation* info) override;
+
+  /**
+   * Overridden to check if the input pipeline is streaming capable, i.e. if
+   * streaming is enabled and the input pipeline provides composite data
+   * meta-data.
+   */
+  int RequestInformation(vtkInformation* rqst, vtkInformationVector** inputVector,
+    vtkInformationVector* outputVector) override;
+
+  /**
+   * Setup the block request. During StreamingUpdate(), this requests the
+   * blocks assigned to this process, otherwise it requests no block at all
+   * from a streaming capable pipeline.
+   */
+  int RequestUpdateExtent(vtkInformation* request, vtkInformationVector** inputVector,
+    vtkInformationVector* outputVector) override;
+
+  /**
+   * Generates the geometry for the current input using ProcessBlocks().
+   * When not in StreamingUpdate(), this also initializes the priority queue
+   * since the input may have totally changed, including its structure.
+   */
+  int RequestData(vtkInformation* rqst, vtkInformationVector** inputVector,
+    vtkInformationVector* outputVector) override;
+
+  /**
+   * Converts the blocks produced by the input pipeline to the geometry to
+   * render. The result must have the same structure as `input`. The default
+   * implementation extracts the surface using vtkPVGeometryFilter.
+   */
+  virtual vtkSmartPointer<vtkDataObject> ProcessBlocks(vtkDataObject* input);
+
+  ///@{
+  /**
+   * Returns true when the input pipeline supports streaming. It is set in
+   * RequestInformation().
+   */
+  vtkGetMacro(StreamingCapablePipeline, bool);
+  ///@}
+
+  ///@{
+  /**
+   * Returns true when StreamingUpdate() is being processed.
+   */
+  vtkGetMacro(InStreamingUpdate, bool);
+  ///@}
+
+  /**
+   * Returns true if this representation has a "next piece" that it streamed.
+   * This method updates the PriorityQueue using the view planes specified,
+   * then calls Update() on the representation to load the next blocks and
+   * releases the blocks that exceed the memory budget.
+   */
+  bool StreamingUpdate(const double view_planes[24]);
+
+  /**
+   * Merges a streamed piece with the data being rendered.
+   */
+  void MergeStreamedPiece(vtkDataObject* piece);
+
+  /**
+   * The geometry generated by the most recent call to RequestData() while not
+   * streaming. This is non-empty only on the data-server nodes.
+   */
+  vtkSmartPointer<vtkDataObjectTree> ProcessedData;
+
+  /**
+   * The geometry generated by the most recent call to RequestData() while
+   * streaming. This is non-empty only on the data-server nodes.
+   */
+  vtkSmartPointer<vtkDataObject> ProcessedPiece;
+
+  /**
+   * Shallow copy of the delivered data to which the streamed pieces are
+   * merged.
+   */
+  vtkSmartPointer<vtkDataObjectTree> RenderedData;
+
+  /**
+   * Computes the order in which to request blocks from the input pipeline.
+   */
+  vtkSmartPointer<vtkBlockStreamingPriorityQueue> PriorityQueue;
+
+  ///@{
+  /**
+   * Actor used to render the geometry in the view.
+   */
+  vtkSmartPointer<vtkCompositePolyDataMapper> Mapper;
+  vtkSmartPointer<vtkPVLODActor> Actor;
+  ///@}
+
+  /**
+   * Used to keep track of data bounds.
+   */
+  vtkBoundingBox DataBounds;
+
+  /**
+   * Flat indices of the blocks requested from the input pipeline during
+   * StreamingUpdate().
+   */
+  std::vector<int> StreamingRequest;
+
+  int StreamingRequestSize = 1;
+  int MemoryBudget = 1024;
+
+private:
+  vtkBlockStreamingRepresentation(const vtkBlockStreamingRepresentation&) = delete;
+  void operator=(const vtkBlockStreamingRepresentation&) = delete;
+
+  /**
+   * This flag is set to true if the input pipeline is streaming capable in
+   * RequestInformation(). Note that in client-server mode, this is valid only
+   * on the data-server nodes since all other nodes don't have input pipelines
+   * connected, they cannot indicate if the pipeline supports streaming.
+   */
+  bool StreamingCapablePipeline = false;
+
+  /**
+   * This flag is used to indicate that the representation is being updated
+   * during the streaming pass.
+   */
+  bool InStreamingUpdate = false;
+};
+
+#endif
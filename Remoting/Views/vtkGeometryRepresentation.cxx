@@ -4,11 +4,16 @@
 #include "vtkGeometryRepresentationInternal.h"
 
 #include "vtkAlgorithmOutput.h"
+#include "vtkAppendPolyData.h"
 #include "vtkBoundingBox.h"
 #include "vtkCallbackCommand.h"
+#include "vtkCellData.h"
 #include "vtkCommand.h"
+#include "vtkCommunicator.h"
+#include "vtkCompositeDataIterator.h"
 #include "vtkCompositeCellGridMapper.h"
 #include "vtkCompositeDataDisplayAttributes.h"
+#include "vtkCompositeDataSet.h"
 #include "vtkCompositePolyDataMapper.h"
 #include "vtkConvertToPartitionedDataSetCollection.h"
 #include "vtkDataAssembly.h"
@@ -33,15 +38,19 @@
 #include "vtkPVTrivialProducer.h"
 #include "vtkPartitionedDataSetCollection.h"
 #include "vtkPointData.h"
+#include "vtkPoints.h"
 #include "vtkProcessModule.h"
 #include "vtkProperty.h"
 #include "vtkRenderer.h"
+#include "vtkSMPTools.h"
 #include "vtkScalarsToColors.h"
 #include "vtkSelection.h"
 #include "vtkSelectionNode.h"
 #include "vtkShader.h"
 #include "vtkShaderProperty.h"
+#include "vtkSmartPointer.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
+#include "vtkStreamingPriorityQueue.h"
 #include "vtkStringToken.h"
 #include "vtkTexture.h"
 #include "vtkTransform.h"
@@ -54,11 +63,247 @@
 #include <vtk_jsoncpp.h>
 #include <vtksys/SystemTools.hxx>
 
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <iterator>
 #include <memory>
 #include <numeric>
 #include <tuple>
 #include <vector>
 
+namespace
+{
+// Difference between the LOD factors of successive levels of the LOD
+// hierarchy, the coarsest level always uses 0.
+constexpr double LODLevelStep = 0.25;
+
+// Blocks of the LOD hierarchy are named using this prefix followed by the LOD
+// factor of the level. Names are preserved when the hierarchy is delivered to
+// the rendering processes, which then pick the level to render.
+constexpr const char* LODLevelPrefix = "vtkGeometryRepresentation LOD ";
+
+std::vector<double> GetLODLevelFactors(double resolution)
+{
+  std::vector<double> factors;
+  for (double factor = resolution; factor > 1e-6; factor -= LODLevelStep)
+  {
+    factors.push_back(factor);
+  }
+  factors.push_back(0.0);
+  return factors;
+}
+
+// Decimates `finest` using `factors`, finest first. Leaves are processed in
+// parallel, each one progressively: a level is decimated from the previous
+// one, which is already much smaller than the full resolution geometry.
+std::vector<vtkSmartPointer<vtkDataObject>> BuildCoarserLODLevels(
+  vtkDataObject* finest, const std::vector<double>& factors)
+{
+  auto composite = vtkCompositeDataSet::SafeDownCast(finest);
+  vtkSmartPointer<vtkCompositeDataIterator> iter;
+  std::vector<vtkPolyData*> leaves;
+  if (composite)
+  {
+    iter.TakeReference(composite->NewIterator());
+    iter->SkipEmptyNodesOn();
+    for (iter->InitTraversal(); !iter->IsDoneWithTraversal(); iter->GoToNextItem())
+    {
+      leaves.push_back(vtkPolyData::SafeDownCast(iter->GetCurrentDataObject()));
+    }
+  }
+  else
+  {
+    leaves.push_back(vtkPolyData::SafeDownCast(finest));
+  }
+
+  // decimated[leaf][level]
+  std::vector<std::vector<vtkSmartPointer<vtkPolyData>>> decimated(leaves.size());
+  const auto numberOfLeaves = static_cast<vtkIdType>(leaves.size());
+  vtkSMPTools::For(0, numberOfLeaves, 1, [&](vtkIdType begin, vtkIdType end) {
+    vtkNew<vtkGeometryRepresentation_detail::DecimationFilterType> decimator;
+    for (vtkIdType cc = begin; cc < end; ++cc)
+    {
+      vtkSmartPointer<vtkPolyData> input = leaves[cc];
+      for (double factor : factors)
+      {
+        if (input && input->GetNumberOfCells() > 0)
+        {
+          decimator->SetLODFactor(factor);
+          decimator->SetInputData(input);
+          decimator->Update();
+          input = vtkSmartPointer<vtkPolyData>::New();
+          input->ShallowCopy(decimator->GetOutput());
+        }
+        decimated[cc].push_back(input);
+      }
+      decimator->SetInputData(nullptr);
+    }
+  });
+
+  std::vector<vtkSmartPointer<vtkDataObject>> levels;
+  for (size_t level = 0; level < factors.size(); ++level)
+  {
+    if (!composite)
+    {
+      levels.emplace_back(decimated[0][level]);
+      continue;
+    }
+    auto output = vtk::TakeSmartPointer(composite->NewInstance());
+    output->CopyStructure(composite);
+    size_t leaf = 0;
+    for (iter->InitTraversal(); !iter->IsDoneWithTraversal(); iter->GoToNextItem(), ++leaf)
+    {
+      output->SetDataSet(iter, decimated[leaf][level]);
+    }
+    levels.emplace_back(output);
+  }
+  return levels;
+}
+
+// Name of the field data array marking the geometry delivered when using
+// frustum-culled delivery, i.e. a vtkMultiBlockDataSet with one block per brick.
+constexpr const char* BricksArrayName = "vtkGeometryRepresentationBricks";
+
+// Maximum number of bricks streamed on each streaming update.
+constexpr size_t BricksPerStreamingUpdate = 4;
+
+int GetBrickIndex(const vtkBoundingBox& bounds, int resolution, const double point[3])
+{
+  int ijk[3];
+  for (int axis = 0; axis < 3; ++axis)
+  {
+    const double length = bounds.GetLength(axis);
+    const double t = length > 0 ? (point[axis] - bounds.GetMinPoint()[axis]) / length : 0.0;
+    ijk[axis] = vtkMath::ClampValue(static_cast<int>(t * resolution), 0, resolution - 1);
+  }
+  return ijk[0] + resolution * (ijk[1] + resolution * ijk[2]);
+}
+
+vtkBoundingBox GetBrickBounds(const vtkBoundingBox& bounds, int resolution, int index)
+{
+  const int ijk[3] = { index % resolution, (index / resolution) % resolution,
+    index / (resolution * resolution) };
+  double brick[6];
+  for (int axis = 0; axis < 3; ++axis)
+  {
+    const double step = bounds.GetLength(axis) / resolution;
+    brick[2 * axis] = bounds.GetMinPoint()[axis] + ijk[axis] * step;
+    brick[2 * axis + 1] = brick[2 * axis] + step;
+  }
+  return vtkBoundingBox(brick);
+}
+
+// Sorts the cells of `input` by brick of `bounds`, split into `resolution`^3
+// bricks, using the center of the cells. The cells of a brick are stored from
+// `offsets[brick]` to `offsets[brick + 1]` in `cells`, in increasing order so
+// that cell ids stay ordered by cell type.
+void SortCellsIntoBricks(vtkPolyData* input, const vtkBoundingBox& bounds, int resolution,
+  std::vector<vtkIdType>& offsets, std::vector<vtkIdType>& cells)
+{
+  const int numberOfBricks = resolution * resolution * resolution;
+  const vtkIdType numberOfCells = input ? input->GetNumberOfCells() : 0;
+  offsets.assign(numberOfBricks + 1, 0);
+  cells.resize(numberOfCells);
+  if (numberOfCells == 0)
+  {
+    return;
+  }
+
+  vtkPoints* inPoints = input->GetPoints();
+  std::vector<int> cellBricks(numberOfCells);
+  vtkIdType npts;
+  const vtkIdType* pts;
+  for (vtkIdType cellId = 0; cellId < numberOfCells; ++cellId)
+  {
+    input->GetCellPoints(cellId, npts, pts);
+    double center[3] = { 0.0, 0.0, 0.0 };
+    for (vtkIdType cc = 0; cc < npts; ++cc)
+    {
+      double x[3];
+      inPoints->GetPoint(pts[cc], x);
+      vtkMath::Add(center, x, center);
+    }
+    vtkMath::MultiplyScalar(center, 1.0 / std::max<vtkIdType>(npts, 1));
+    cellBricks[cellId] = ::GetBrickIndex(bounds, resolution, center);
+    ++offsets[cellBricks[cellId] + 1];
+  }
+  std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+  std::vector<vtkIdType> next(offsets.begin(), std::prev(offsets.end()));
+  for (vtkIdType cellId = 0; cellId < numberOfCells; ++cellId)
+  {
+    cells[next[cellBricks[cellId]]++] = cellId;
+  }
+}
+
+// Extracts the `count` cells `cells` of `input`, with the points they use.
+vtkSmartPointer<vtkPolyData> ExtractBrick(
+  vtkPolyData* input, const vtkIdType* cells, vtkIdType count)
+{
+  vtkPoints* inPoints = input->GetPoints();
+  vtkPointData* inPD = input->GetPointData();
+  vtkCellData* inCD = input->GetCellData();
+
+  auto output = vtkSmartPointer<vtkPolyData>::New();
+  vtkNew<vtkPoints> points;
+  points->SetDataType(inPoints->GetDataType());
+  output->AllocateProportional(input, static_cast<double>(count) / input->GetNumberOfCells());
+  output->GetPointData()->CopyAllocate(inPD);
+  output->GetCellData()->CopyAllocate(inCD, count);
+
+  std::unordered_map<vtkIdType, vtkIdType> pointMap;
+  std::vector<vtkIdType> cellPointIds;
+  vtkIdType npts;
+  const vtkIdType* pts;
+  for (vtkIdType cc = 0; cc < count; ++cc)
+  {
+    const vtkIdType cellId = cells[cc];
+    input->GetCellPoints(cellId, npts, pts);
+    cellPointIds.resize(npts);
+    for (vtkIdType pt = 0; pt < npts; ++pt)
+    {
+      auto inserted = pointMap.emplace(pts[pt], points->GetNumberOfPoints());
+      if (inserted.second)
+      {
+        double x[3];
+        inPoints->GetPoint(pts[pt], x);
+        points->InsertNextPoint(x);
+        output->GetPointData()->CopyData(inPD, pts[pt], inserted.first->second);
+      }
+      cellPointIds[pt] = inserted.first->second;
+    }
+    const vtkIdType newCellId = output->InsertNextCell(
+      input->GetCellType(cellId), static_cast<int>(npts), cellPointIds.data());
+    output->GetCellData()->CopyData(inCD, cellId, newCellId);
+  }
+
+  output->SetPoints(points);
+  output->GetFieldData()->ShallowCopy(input->GetFieldData());
+  output->Squeeze();
+  return output;
+}
+
+// Splits the cells of `input` into `resolution`^3 bricks of `bounds`. Bricks
+// without cells are null.
+std::vector<vtkSmartPointer<vtkPolyData>> SplitIntoBricks(
+  vtkPolyData* input, const vtkBoundingBox& bounds, int resolution)
+{
+  std::vector<vtkIdType> offsets;
+  std::vector<vtkIdType> cells;
+  ::SortCellsIntoBricks(input, bounds, resolution, offsets, cells);
+  std::vector<vtkSmartPointer<vtkPolyData>> bricks(offsets.size() - 1);
+  for (size_t brick = 0; brick < bricks.size(); ++brick)
+  {
+    const vtkIdType count = offsets[brick + 1] - offsets[brick];
+    if (count > 0)
+    {
+      bricks[brick] = ::ExtractBrick(input, cells.data() + offsets[brick], count);
+    }
+  }
+  return bricks;
+}
+}
+
 //*****************************************************************************
 // This is used to convert a vtkPolyData to a vtkMultiBlockDataSet. If input is
 // vtkMultiBlockDataSet, then this is simply a pass-through filter. This makes
@@ -209,6 +454,12 @@ vtkGeometryRepresentation::vtkGeometryRepresentation()
   this->MultiBlockMaker = vtkGeometryRepresentationMultiBlockMaker::New();
   this->Decimator = vtkGeometryRepresentation_detail::DecimationFilterType::New();
   this->LODOutlineFilter = vtkPVGeometryFilter::New();
+  this->LODHierarchy = vtkMultiBlockDataSet::New();
+  this->BrickedInput = vtkMultiBlockDataSet::New();
+  this->CoarseBricks = vtkMultiBlockDataSet::New();
+  this->StreamedBricks = vtkMultiBlockDataSet::New();
+  this->RenderedBricks = vtkMultiBlockDataSet::New();
+  this->BrickedData = vtkMultiBlockDataSet::New();
 
   // connect progress bar
   this->GeometryFilter->AddObserver(vtkCommand::ProgressEvent, this,
@@ -271,6 +522,12 @@ vtkGeometryRepresentation::~vtkGeometryRepresentation()
     this->Decimator->Delete();
   }
   this->LODOutlineFilter->Delete();
+  this->LODHierarchy->Delete();
+  this->BrickedInput->Delete();
+  this->CoarseBricks->Delete();
+  this->StreamedBricks->Delete();
+  this->RenderedBricks->Delete();
+  this->BrickedData->Delete();
   this->Mapper->Delete();
   this->LODMapper->Delete();
   this->Actor->Delete();
@@ -374,8 +631,22 @@ int vtkGeometryRepresentation::ProcessViewRequest(
   if (request_type == vtkPVView::REQUEST_UPDATE())
   {
     // provide the "geometry" to the view so the view can delivery it to the
-    // rendering nodes as and when needed.
-    vtkPVView::SetPiece(inInfo, this, this->MultiBlockMaker->GetOutputDataObject(0));
+    // rendering nodes as and when needed. When using frustum-culled delivery,
+    // that's the coarse bricks, the full resolution bricks are streamed.
+    // Bricks are not redistributed since the full resolution ones are streamed
+    // to the ranks that have their coarse version, hence the whole geometry is
+    // delivered when this representation needs ordered compositing.
+    const bool bricked =
+      this->CoarseBricks->GetNumberOfBlocks() > 0 && !this->NeedsOrderedCompositing();
+    if (bricked != this->DeliveringBricks)
+    {
+      // the coarse bricks are delivered again, so will be the full resolution ones.
+      this->BrickStreamed.assign(this->BrickStreamed.size(), false);
+      this->DeliveringBricks = bricked;
+    }
+    vtkPVView::SetPiece(inInfo, this,
+      bricked ? this->CoarseBricks : this->MultiBlockMaker->GetOutputDataObject(0));
+    vtkPVRenderView::SetStreamable(inInfo, this, bricked);
 
     if (this->UseDataPartitions == true)
     {
@@ -384,7 +655,7 @@ int vtkGeometryRepresentation::ProcessViewRequest(
       vtkPVRenderView::SetOrderedCompositingConfiguration(
         inInfo, this, vtkPVRenderView::USE_BOUNDS_FOR_REDISTRIBUTION);
     }
-    else
+    else if (!bricked)
     {
       // We want to let vtkPVRenderView do redistribution of data as necessary,
       // and use this representations data for determining a load balanced distribution
@@ -411,7 +682,10 @@ int vtkGeometryRepresentation::ProcessViewRequest(
     // Called to generate and provide the LOD data to the view.
     // If SuppressLOD is true, we tell the view we have no LOD data to provide,
     // otherwise we provide the decimated data.
-    auto data = vtkPVView::GetPiece(inInfo, this);
+    // The LOD geometry is built from the full geometry, not from the bricks.
+    auto data = this->DeliveringBricks
+      ? this->MultiBlockMaker->GetOutputDataObject(0)
+      : vtkPVView::GetPiece(inInfo, this);
     if (data != nullptr && !this->SuppressLOD)
     {
       if (inInfo->Has(vtkPVRenderView::USE_OUTLINE_FOR_LOD()))
@@ -424,28 +698,51 @@ int vtkGeometryRepresentation::ProcessViewRequest(
       }
       else
       {
-        if (inInfo->Has(vtkPVRenderView::LOD_RESOLUTION()))
-        {
-          // We handle this number differently depending on decimator
-          // implementation.
-          const double factor = inInfo->Get(vtkPVRenderView::LOD_RESOLUTION());
-          this->Decimator->SetLODFactor(factor);
-        }
-
-        this->Decimator->SetInputDataObject(data);
-        this->Decimator->Update();
-
-        // Pass along the LOD geometry to the view so that it can deliver it to
-        // the rendering node as and when needed.
-        vtkPVView::SetPieceLOD(inInfo, this, this->Decimator->GetOutputDataObject(0));
+        // We handle this number differently depending on decimator
+        // implementation.
+        const double factor = inInfo->Has(vtkPVRenderView::LOD_RESOLUTION())
+          ? inInfo->Get(vtkPVRenderView::LOD_RESOLUTION())
+          : 0.5;
+        this->UpdateLODHierarchy(data, factor);
+
+        // Pass along the LOD hierarchy to the view so that it can deliver it to
+        // the rendering node as and when needed. All the levels are delivered,
+        // so all of them count when deciding whether to render remotely.
+        vtkPVView::SetPieceLOD(inInfo, this, this->LODHierarchy);
       }
     }
   }
+  else if (request_type == vtkPVRenderView::REQUEST_STREAMING_UPDATE())
+  {
+    double view_planes[24];
+    inInfo->Get(vtkPVRenderView::VIEW_PLANES(), view_planes);
+    if (this->DeliveringBricks && this->StreamBricks(view_planes))
+    {
+      vtkPVRenderView::SetNextStreamedPiece(inInfo, this, this->StreamedBricks);
+    }
+  }
+  else if (request_type == vtkPVRenderView::REQUEST_PROCESS_STREAMED_PIECE())
+  {
+    this->AddStreamedBricks(vtkPVRenderView::GetCurrentStreamedPiece(inInfo, this));
+  }
   else if (request_type == vtkPVView::REQUEST_RENDER())
   {
-    auto outputData = vtkPVView::GetDeliveredPiece(inInfo, this);
+    auto outputData = this->GetRenderedBricks(vtkPVView::GetDeliveredPiece(inInfo, this));
     // vtkLogF(INFO, "%p: %s", (void*)data, this->GetLogName().c_str());
-    auto dataLOD = vtkPVView::GetDeliveredPieceLOD(inInfo, this);
+    // The finest level of the LOD hierarchy is rendered, unless the view asks
+    // for a coarser one, which it may change on every frame.
+    unsigned int level = 0;
+    const double resolution = inInfo->Has(vtkPVRenderView::LOD_RESOLUTION())
+      ? inInfo->Get(vtkPVRenderView::LOD_RESOLUTION())
+      : 1.0;
+    auto dataLOD = vtkGeometryRepresentation::GetLODLevel(
+      vtkPVView::GetDeliveredPieceLOD(inInfo, this), resolution, level);
+    if (level != this->LODLevel)
+    {
+      // block attributes are associated with the blocks of the level.
+      this->LODLevel = level;
+      this->UpdateBlockAttrLOD = true;
+    }
     this->Mapper->SetInputDataObject(outputData);
     this->LODMapper->SetInputDataObject(dataLOD);
 
@@ -482,6 +779,414 @@ int vtkGeometryRepresentation::ProcessViewRequest(
   return 1;
 }
 
+//----------------------------------------------------------------------------
+void vtkGeometryRepresentation::UpdateLODHierarchy(vtkDataObject* data, double resolution)
+{
+  resolution = vtkMath::ClampValue(resolution, 0., 1.);
+  if (data == this->LODHierarchyInput && data->GetMTime() == this->LODHierarchyInputTime &&
+    resolution == this->LODHierarchyResolution)
+  {
+    return;
+  }
+
+  vtkVLogScopeF(PARAVIEW_LOG_RENDERING_VERBOSITY(), "%s: build LOD hierarchy (resolution=%g)",
+    this->GetLogName().c_str(), resolution);
+
+  // the finest level goes through the decimator to report progress.
+  this->Decimator->SetLODFactor(resolution);
+  this->Decimator->SetInputDataObject(data);
+  this->Decimator->Update();
+  vtkDataObject* decimated = this->Decimator->GetOutputDataObject(0);
+  auto finest = vtk::TakeSmartPointer(decimated->NewInstance());
+  finest->ShallowCopy(decimated);
+
+  std::vector<double> factors = ::GetLODLevelFactors(resolution);
+  const auto coarser = ::BuildCoarserLODLevels(
+    finest, std::vector<double>(std::next(factors.begin()), factors.end()));
+
+  this->LODHierarchy->Initialize();
+  this->LODHierarchy->SetNumberOfBlocks(static_cast<unsigned int>(factors.size()));
+  for (unsigned int cc = 0; cc < factors.size(); ++cc)
+  {
+    this->LODHierarchy->SetBlock(cc, cc == 0 ? finest.GetPointer() : coarser[cc - 1].GetPointer());
+    const std::string name = LODLevelPrefix + std::to_string(factors[cc]);
+    this->LODHierarchy->GetMetaData(cc)->Set(vtkCompositeDataSet::NAME(), name.c_str());
+  }
+
+  this->LODHierarchyInput = data;
+  this->LODHierarchyInputTime = data->GetMTime();
+  this->LODHierarchyResolution = resolution;
+}
+
+//----------------------------------------------------------------------------
+vtkDataObject* vtkGeometryRepresentation::GetLODLevel(
+  vtkDataObject* lod, double resolution, unsigned int& level)
+{
+  level = 0;
+  auto hierarchy = vtkMultiBlockDataSet::SafeDownCast(lod);
+  if (!hierarchy)
+  {
+    return lod;
+  }
+
+  const size_t prefixLength = strlen(LODLevelPrefix);
+  for (unsigned int cc = 0; cc < hierarchy->GetNumberOfBlocks(); ++cc)
+  {
+    const char* name = hierarchy->HasMetaData(cc)
+      ? hierarchy->GetMetaData(cc)->Get(vtkCompositeDataSet::NAME())
+      : nullptr;
+    if (!name || strncmp(name, LODLevelPrefix, prefixLength) != 0)
+    {
+      // not a LOD hierarchy.
+      level = 0;
+      return lod;
+    }
+    // levels go from the finest to the coarsest.
+    level = cc;
+    if (std::atof(name + prefixLength) <= resolution + 1e-6)
+    {
+      break;
+    }
+  }
+  return hierarchy->GetNumberOfBlocks() > 0 ? hierarchy->GetBlock(level) : lod;
+}
+
+//----------------------------------------------------------------------------
+void vtkGeometryRepresentation::SetUseFrustumCulledDelivery(bool val)
+{
+  if (this->UseFrustumCulledDelivery != val)
+  {
+    this->UseFrustumCulledDelivery = val;
+    this->MarkModified();
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkGeometryRepresentation::SetBrickResolution(int val)
+{
+  val = vtkMath::ClampValue(val, 1, 8);
+  if (this->BrickResolution != val)
+  {
+    this->BrickResolution = val;
+    this->MarkModified();
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkGeometryRepresentation::UpdateBricks(vtkDataObject* data)
+{
+  this->BrickedInput->Initialize();
+  this->CoarseBricks->Initialize();
+  this->StreamedBricks->Initialize();
+  this->BrickCells.clear();
+  this->BrickCellOffsets.clear();
+  this->BrickStreamed.clear();
+  auto input = vtkMultiBlockDataSet::SafeDownCast(data);
+  if (!this->UseFrustumCulledDelivery || !vtkPVView::GetEnableStreaming() || !input)
+  {
+    return;
+  }
+
+  vtkSmartPointer<vtkCompositeDataIterator> iter;
+  iter.TakeReference(input->NewIterator());
+  iter->SkipEmptyNodesOn();
+  std::vector<vtkPolyData*> leaves;
+  vtkBoundingBox bbox;
+  double notPolyData = 0.0;
+  for (iter->InitTraversal(); !iter->IsDoneWithTraversal(); iter->GoToNextItem())
+  {
+    auto polyData = vtkPolyData::SafeDownCast(iter->GetCurrentDataObject());
+    if (!polyData)
+    {
+      notPolyData = 1.0;
+      continue;
+    }
+    leaves.push_back(polyData);
+    double bounds[6];
+    polyData->GetBounds(bounds);
+    if (vtkMath::AreBoundsInitialized(bounds))
+    {
+      bbox.AddBounds(bounds);
+    }
+  }
+
+  // bricks must split the same space on all ranks so that the bricks streamed
+  // by each rank can be combined.
+  auto controller = vtkMultiProcessController::GetGlobalController();
+  if (controller && controller->GetNumberOfProcesses() > 1)
+  {
+    // negate the minima to use a MAX reduction. Invalid bounds are ignored.
+    const double* minPoint = bbox.GetMinPoint();
+    const double* maxPoint = bbox.GetMaxPoint();
+    const double local[7] = { -minPoint[0], -minPoint[1], -minPoint[2], maxPoint[0], maxPoint[1],
+      maxPoint[2], notPolyData };
+    double global[7];
+    controller->AllReduce(local, global, 7, vtkCommunicator::MAX_OP);
+    bbox.SetBounds(-global[0], global[3], -global[1], global[4], -global[2], global[5]);
+    notPolyData = global[6];
+  }
+  if (!bbox.IsValid() || notPolyData > 0.0)
+  {
+    // only polydata is split, other datasets cannot be combined back.
+    vtkVLogIfF(PARAVIEW_LOG_RENDERING_VERBOSITY(), notPolyData > 0.0,
+      "%s: not splitting into bricks, geometry is not only polydata", this->GetLogName().c_str());
+    return;
+  }
+
+  vtkVLogScopeF(PARAVIEW_LOG_RENDERING_VERBOSITY(), "%s: split geometry into %d^3 bricks",
+    this->GetLogName().c_str(), this->BrickResolution);
+
+  // The full resolution bricks are extracted from the input when streamed,
+  // only the cells of each brick are kept. The coarse bricks are split from
+  // the decimated leaf, decimating each brick would result in much finer
+  // geometry overall.
+  const int resolution = this->BrickResolution;
+  const int numberOfBricks = resolution * resolution * resolution;
+  this->BrickCells.resize(leaves.size());
+  this->BrickCellOffsets.resize(leaves.size());
+  std::vector<std::vector<vtkSmartPointer<vtkPolyData>>> coarse(leaves.size());
+  const auto numberOfLeaves = static_cast<vtkIdType>(leaves.size());
+  vtkSMPTools::For(0, numberOfLeaves, 1, [&](vtkIdType begin, vtkIdType end) {
+    vtkNew<vtkGeometryRepresentation_detail::DecimationFilterType> decimator;
+    decimator->SetLODFactor(0.0);
+    for (vtkIdType cc = begin; cc < end; ++cc)
+    {
+      ::SortCellsIntoBricks(
+        leaves[cc], bbox, resolution, this->BrickCellOffsets[cc], this->BrickCells[cc]);
+      coarse[cc].resize(numberOfBricks);
+      if (leaves[cc]->GetNumberOfCells() > 0)
+      {
+        decimator->SetInputData(leaves[cc]);
+        decimator->Update();
+        coarse[cc] = ::SplitIntoBricks(decimator->GetOutput(), bbox, resolution);
+        decimator->SetInputData(nullptr);
+      }
+    }
+  });
+
+  // each brick has the structure of the input so that the bricks can be
+  // combined back into it on the rendering processes.
+  this->BrickedInput->ShallowCopy(input);
+  this->CoarseBricks->SetNumberOfBlocks(numberOfBricks);
+  for (int cc = 0; cc < numberOfBricks; ++cc)
+  {
+    vtkNew<vtkMultiBlockDataSet> brick;
+    brick->CopyStructure(input);
+    brick->GetFieldData()->ShallowCopy(input->GetFieldData());
+    size_t leaf = 0;
+    for (iter->InitTraversal(); !iter->IsDoneWithTraversal(); iter->GoToNextItem(), ++leaf)
+    {
+      brick->SetDataSet(iter, coarse[leaf][cc]);
+    }
+    this->CoarseBricks->SetBlock(cc, brick);
+  }
+
+  vtkNew<vtkIntArray> marker;
+  marker->SetName(BricksArrayName);
+  marker->InsertNextValue(resolution);
+  this->CoarseBricks->GetFieldData()->AddArray(marker);
+  this->BrickBounds = bbox;
+  this->BrickStreamed.assign(numberOfBricks, false);
+}
+
+//----------------------------------------------------------------------------
+bool vtkGeometryRepresentation::StreamBricks(const double view_planes[24])
+{
+  const int numberOfBricks = static_cast<int>(this->BrickStreamed.size());
+  vtkStreamingPriorityQueue<> queue;
+  for (int cc = 0; cc < numberOfBricks; ++cc)
+  {
+    if (!this->BrickStreamed[cc])
+    {
+      vtkStreamingPriorityQueueItem item;
+      item.Identifier = static_cast<unsigned int>(cc);
+      item.Bounds = ::GetBrickBounds(this->BrickBounds, this->BrickResolution, cc);
+      queue.push(item);
+    }
+  }
+  if (queue.empty())
+  {
+    return false;
+  }
+
+  // All ranks pick the same bricks: the bricks and the view planes are the same
+  // everywhere.
+  double clamp_bounds[6];
+  vtkMath::UninitializeBounds(clamp_bounds);
+  queue.UpdatePriorities(view_planes, clamp_bounds);
+
+  std::vector<unsigned int> bricks;
+  for (; !queue.empty() && bricks.size() < BricksPerStreamingUpdate; queue.pop())
+  {
+    const auto& item = queue.top();
+    if (item.Priority <= 0)
+    {
+      // not visible.
+      break;
+    }
+    bricks.push_back(item.Identifier);
+    this->BrickStreamed[item.Identifier] = true;
+  }
+  vtkVLogIfF(PARAVIEW_LOG_RENDERING_VERBOSITY(), !bricks.empty(), "%s: streaming %d bricks",
+    this->GetLogName().c_str(), static_cast<int>(bricks.size()));
+  if (bricks.empty())
+  {
+    return false;
+  }
+
+  // the leaves of BrickedInput are the polydata sorted by UpdateBricks().
+  vtkSmartPointer<vtkCompositeDataIterator> iter;
+  iter.TakeReference(this->BrickedInput->NewIterator());
+  iter->SkipEmptyNodesOn();
+  std::vector<vtkPolyData*> leaves;
+  for (iter->InitTraversal(); !iter->IsDoneWithTraversal(); iter->GoToNextItem())
+  {
+    leaves.push_back(vtkPolyData::SafeDownCast(iter->GetCurrentDataObject()));
+  }
+
+  this->StreamedBricks->Initialize();
+  this->StreamedBricks->SetNumberOfBlocks(static_cast<unsigned int>(numberOfBricks));
+  const auto numberOfLeaves = static_cast<vtkIdType>(leaves.size());
+  for (const unsigned int brick : bricks)
+  {
+    std::vector<vtkSmartPointer<vtkPolyData>> fine(leaves.size());
+    vtkSMPTools::For(0, numberOfLeaves, 1, [&](vtkIdType begin, vtkIdType end) {
+      for (vtkIdType leaf = begin; leaf < end; ++leaf)
+      {
+        const auto& offsets = this->BrickCellOffsets[leaf];
+        const vtkIdType count = offsets[brick + 1] - offsets[brick];
+        if (count > 0)
+        {
+          fine[leaf] =
+            ::ExtractBrick(leaves[leaf], this->BrickCells[leaf].data() + offsets[brick], count);
+        }
+      }
+    });
+
+    vtkNew<vtkMultiBlockDataSet> output;
+    output->CopyStructure(this->BrickedInput);
+    output->GetFieldData()->ShallowCopy(this->BrickedInput->GetFieldData());
+    size_t leaf = 0;
+    for (iter->InitTraversal(); !iter->IsDoneWithTraversal(); iter->GoToNextItem(), ++leaf)
+    {
+      output->SetDataSet(iter, fine[leaf]);
+    }
+    this->StreamedBricks->SetBlock(brick, output);
+  }
+  return true;
+}
+
+//----------------------------------------------------------------------------
+void vtkGeometryRepresentation::AddStreamedBricks(vtkDataObject* piece)
+{
+  auto bricks = vtkMultiBlockDataSet::SafeDownCast(piece);
+  if (!bricks || bricks->GetNumberOfBlocks() != this->RenderedBricks->GetNumberOfBlocks())
+  {
+    return;
+  }
+
+  // replace the coarse bricks with the full resolution ones.
+  for (unsigned int cc = 0; cc < bricks->GetNumberOfBlocks(); ++cc)
+  {
+    if (auto brick = bricks->GetBlock(cc))
+    {
+      this->RenderedBricks->SetBlock(cc, brick);
+    }
+  }
+  this->AssembleBricks();
+}
+
+//----------------------------------------------------------------------------
+vtkDataObject* vtkGeometryRepresentation::GetRenderedBricks(vtkDataObject* delivered)
+{
+  auto bricks = vtkMultiBlockDataSet::SafeDownCast(delivered);
+  if (!bricks || !bricks->GetFieldData()->GetAbstractArray(BricksArrayName))
+  {
+    return delivered;
+  }
+
+  if (bricks != this->DeliveredBricks || bricks->GetMTime() != this->DeliveredBricksTime)
+  {
+    // new coarse bricks, full resolution ones will be streamed again.
+    this->RenderedBricks->Initialize();
+    this->RenderedBricks->SetNumberOfBlocks(bricks->GetNumberOfBlocks());
+    for (unsigned int cc = 0; cc < bricks->GetNumberOfBlocks(); ++cc)
+    {
+      this->RenderedBricks->SetBlock(cc, bricks->GetBlock(cc));
+    }
+    this->DeliveredBricks = bricks;
+    this->DeliveredBricksTime = bricks->GetMTime();
+    this->AssembleBricks();
+  }
+  return this->BrickedData;
+}
+
+//----------------------------------------------------------------------------
+void vtkGeometryRepresentation::AssembleBricks()
+{
+  this->BrickedData->Initialize();
+  auto first = vtkMultiBlockDataSet::SafeDownCast(this->RenderedBricks->GetBlock(0));
+  if (!first)
+  {
+    return;
+  }
+
+  // leaves[brick][leaf], all bricks have the structure of the input and only
+  // polydata leaves.
+  const unsigned int numberOfBricks = this->RenderedBricks->GetNumberOfBlocks();
+  std::vector<std::vector<vtkPolyData*>> leaves(numberOfBricks);
+  vtkNew<vtkDataObjectTreeIterator> iter;
+  iter->SkipEmptyNodesOff();
+  iter->VisitOnlyLeavesOn();
+  for (unsigned int cc = 0; cc < numberOfBricks; ++cc)
+  {
+    auto brick = vtkMultiBlockDataSet::SafeDownCast(this->RenderedBricks->GetBlock(cc));
+    if (!brick)
+    {
+      continue;
+    }
+    iter->SetDataSet(brick);
+    for (iter->InitTraversal(); !iter->IsDoneWithTraversal(); iter->GoToNextItem())
+    {
+      leaves[cc].push_back(vtkPolyData::SafeDownCast(iter->GetCurrentDataObject()));
+    }
+  }
+
+  const auto numberOfLeaves = static_cast<vtkIdType>(leaves[0].size());
+  std::vector<vtkSmartPointer<vtkDataObject>> combined(numberOfLeaves);
+  vtkSMPTools::For(0, numberOfLeaves, 1, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType leaf = begin; leaf < end; ++leaf)
+    {
+      vtkNew<vtkAppendPolyData> appender;
+      for (unsigned int cc = 0; cc < numberOfBricks; ++cc)
+      {
+        if (leaf < static_cast<vtkIdType>(leaves[cc].size()) && leaves[cc][leaf])
+        {
+          appender->AddInputDataObject(leaves[cc][leaf]);
+        }
+      }
+      if (appender->GetNumberOfInputConnections(0) == 1)
+      {
+        combined[leaf] = appender->GetInputDataObject(0, 0);
+      }
+      else if (appender->GetNumberOfInputConnections(0) > 1)
+      {
+        appender->Update();
+        combined[leaf] = appender->GetOutputDataObject(0);
+      }
+    }
+  });
+
+  this->BrickedData->CopyStructure(first);
+  this->BrickedData->GetFieldData()->ShallowCopy(first->GetFieldData());
+  iter->SetDataSet(this->BrickedData);
+  vtkIdType leaf = 0;
+  for (iter->InitTraversal(); !iter->IsDoneWithTraversal(); iter->GoToNextItem(), ++leaf)
+  {
+    this->BrickedData->SetDataSet(iter, combined[leaf]);
+  }
+}
+
 //----------------------------------------------------------------------------
 int vtkGeometryRepresentation::RequestUpdateExtent(
   vtkInformation* request, vtkInformationVector** inputVector, vtkInformationVector* outputVector)
@@ -537,6 +1242,7 @@ int vtkGeometryRepresentation::RequestData(
   // does use parallel communication (see #19963).
   this->GeometryFilter->Modified();
   this->MultiBlockMaker->Update();
+  this->UpdateBricks(this->MultiBlockMaker->GetOutputDataObject(0));
   return this->Superclass::RequestData(request, inputVector, outputVector);
 }
 
@@ -1377,6 +2083,19 @@ void vtkGeometryRepresentation::SetGenerateFeatureEdges(bool val)
   this->MarkModified();
 }
 
+//----------------------------------------------------------------------------
+void vtkGeometryRepresentation::SetUseStaticMeshCache(bool val)
+{
+  if (vtkPVGeometryFilter::SafeDownCast(this->GeometryFilter))
+  {
+    vtkPVGeometryFilter::SafeDownCast(this->GeometryFilter)->SetUseStaticMeshCache(val);
+  }
+
+  // since geometry filter needs to execute, we need to mark the representation
+  // modified.
+  this->MarkModified();
+}
+
 //----------------------------------------------------------------------------
 void vtkGeometryRepresentation::AddBlockSelector(const char* selector)
 {
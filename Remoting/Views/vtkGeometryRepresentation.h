@@ -16,6 +16,7 @@
 #ifndef vtkGeometryRepresentation_h
 #define vtkGeometryRepresentation_h
 
+#include "vtkBoundingBox.h"         // needed for vtkBoundingBox
 #include "vtkPVDataRepresentation.h"
 #include "vtkProperty.h"            // needed for VTK_POINTS etc.
 #include "vtkRemotingViewsModule.h" // needed for exports
@@ -24,9 +25,11 @@
 #include <set>           // needed for std::set
 #include <string>        // needed for std::string
 #include <unordered_map> // needed for std::unordered_map
+#include <vector>        // needed for std::vector
 
 class vtkCompositeDataDisplayAttributes;
 class vtkMapper;
+class vtkMultiBlockDataSet;
 class vtkPiecewiseFunction;
 class vtkPVGeometryFilter;
 class vtkPVLODActor;
@@ -166,6 +169,7 @@ public:
   void SetNonlinearSubdivisionLevel(int);
   void SetMatchBoundariesIgnoringCellOrder(int);
   virtual void SetGenerateFeatureEdges(bool);
+  void SetUseStaticMeshCache(bool);
 
   //***************************************************************************
   // Forwarded to vtkProperty.
@@ -331,6 +335,36 @@ public:
   vtkGetMacro(UseDataPartitions, bool);
   ///@}
 
+  ///@{
+  /**
+   * When enabled, and streaming is enabled (see
+   * vtkPVView::SetEnableStreaming()), the geometry is split into
+   * BrickResolution^3 spatial bricks. Only a decimated version of the bricks
+   * is delivered with the data, then the full resolution bricks that intersect
+   * the view frustum are streamed, the most visible first. Bricks are streamed
+   * as the camera moves and are not delivered again until the data changes.
+   * This avoids delivering the whole geometry when inspecting a small region
+   * of large surfaces in client rendering mode. Only geometry made of
+   * polydata is split into bricks.
+   *
+   * Bricks are not redistributed for ordered compositing: the whole geometry
+   * is delivered instead while this representation is translucent. When
+   * another representation needs ordered compositing, the bricks are only
+   * sorted correctly if UseDataPartitions is enabled. Default is false.
+   */
+  virtual void SetUseFrustumCulledDelivery(bool);
+  vtkGetMacro(UseFrustumCulledDelivery, bool);
+  ///@}
+
+  ///@{
+  /**
+   * Get/Set the number of bricks along each axis when using frustum-culled
+   * delivery. Clamped to [1, 8]. Default is 4.
+   */
+  virtual void SetBrickResolution(int);
+  vtkGetMacro(BrickResolution, int);
+  ///@}
+
   ///@{
   /**
    * Specify whether or not to shader replacements string must be used.
@@ -423,6 +457,51 @@ protected:
    */
   void PopulateBlockAttributes(vtkCompositeDataDisplayAttributes* attrs, vtkDataObject* outputData);
 
+  /**
+   * Builds the LOD hierarchy for `data`, unless the current one was built from
+   * the same data using the same `resolution`. The LOD hierarchy is a
+   * vtkMultiBlockDataSet with one block per level, from the finest, decimated
+   * using `resolution`, to the coarsest. Levels are decimated progressively
+   * from the finest one. Each level can be selected for rendering without
+   * delivering the LOD geometry again.
+   */
+  void UpdateLODHierarchy(vtkDataObject* data, double resolution);
+
+  /**
+   * Returns the finest level of the LOD hierarchy `lod` that is not finer than
+   * `resolution`, or `lod` itself if it is not a LOD hierarchy e.g. when using
+   * outlines for LOD rendering. `level` is set to the index of the level.
+   */
+  static vtkDataObject* GetLODLevel(vtkDataObject* lod, double resolution, unsigned int& level);
+
+  /**
+   * Splits `data` into the coarse bricks used for frustum-culled delivery, if
+   * enabled, and sorts its cells by brick. Must be called on all data server
+   * processes.
+   */
+  void UpdateBricks(vtkDataObject* data);
+
+  /**
+   * Picks the next full resolution bricks to stream, the most visible first,
+   * and extracts them from the input into StreamedBricks. Returns false if no
+   * visible brick remains to be streamed.
+   */
+  bool StreamBricks(const double view_planes[24]);
+
+  /**
+   * Replaces the bricks rendered so far with the full resolution bricks of
+   * `piece` streamed by StreamBricks().
+   */
+  void AddStreamedBricks(vtkDataObject* piece);
+
+  /**
+   * Returns the geometry to render on the rendering processes: `delivered`
+   * itself unless it holds bricks, in which case the bricks rendered so far
+   * are combined back into the structure of the input.
+   */
+  vtkDataObject* GetRenderedBricks(vtkDataObject* delivered);
+  void AssembleBricks();
+
   /**
    * Computes the bounds of the visible data based on the block visibilities in the
    * composite data attributes of the mapper.
@@ -451,6 +530,28 @@ protected:
   vtkAlgorithm* MultiBlockMaker;
   vtkGeometryRepresentation_detail::DecimationFilterType* Decimator;
   vtkPVGeometryFilter* LODOutlineFilter;
+  vtkMultiBlockDataSet* LODHierarchy;
+  vtkDataObject* LODHierarchyInput = nullptr;
+  vtkMTimeType LODHierarchyInputTime = 0;
+  double LODHierarchyResolution = -1.0;
+  unsigned int LODLevel = 0;
+
+  bool UseFrustumCulledDelivery = false;
+  int BrickResolution = 4;
+  vtkMultiBlockDataSet* BrickedInput;
+  vtkMultiBlockDataSet* CoarseBricks;
+  vtkMultiBlockDataSet* StreamedBricks;
+  vtkBoundingBox BrickBounds;
+  // cells of each leaf of BrickedInput sorted by brick, and the offset of the
+  // first cell of each brick in them.
+  std::vector<std::vector<vtkIdType>> BrickCells;
+  std::vector<std::vector<vtkIdType>> BrickCellOffsets;
+  std::vector<bool> BrickStreamed;
+  bool DeliveringBricks = false;
+  vtkMultiBlockDataSet* RenderedBricks;
+  vtkMultiBlockDataSet* BrickedData;
+  vtkDataObject* DeliveredBricks = nullptr;
+  vtkMTimeType DeliveredBricksTime = 0;
 
   vtkMapper* Mapper;
   vtkMapper* LODMapper;
@@ -7,6 +7,8 @@
 #include "vtkObjectFactory.h"
 #include "vtkVector.h"
 
+#include <algorithm>
+
 namespace
 {
 struct BoxT
@@ -30,10 +32,80 @@ void vtkOrderedCompositingHelper::SetBoundingBoxes(const std::vector<vtkBounding
   if (this->Boxes != boxes)
   {
     this->Boxes = boxes;
+    this->CachedSortOrder.clear();
+    for (auto& planes : this->Planes)
+    {
+      planes.clear();
+    }
+
+    // the sort order is cached only if the boxes are valid and don't overlap.
+    bool disjoint = std::all_of(
+      boxes.begin(), boxes.end(), [](const vtkBoundingBox& box) { return box.IsValid(); });
+    for (size_t cc = 0; disjoint && cc < boxes.size(); ++cc)
+    {
+      for (size_t kk = cc + 1; disjoint && kk < boxes.size(); ++kk)
+      {
+        bool overlap = true;
+        for (int axis = 0; overlap && axis < 3; ++axis)
+        {
+          overlap = std::max(boxes[cc].GetMinPoint()[axis], boxes[kk].GetMinPoint()[axis]) <
+            std::min(boxes[cc].GetMaxPoint()[axis], boxes[kk].GetMaxPoint()[axis]);
+        }
+        disjoint = !overlap;
+      }
+    }
+    if (disjoint)
+    {
+      for (int axis = 0; axis < 3; ++axis)
+      {
+        auto& planes = this->Planes[axis];
+        for (const auto& box : boxes)
+        {
+          planes.push_back(box.GetMinPoint()[axis]);
+          planes.push_back(box.GetMaxPoint()[axis]);
+        }
+        std::sort(planes.begin(), planes.end());
+        planes.erase(std::unique(planes.begin(), planes.end()), planes.end());
+      }
+    }
     this->Modified();
   }
 }
 
+//----------------------------------------------------------------------------
+std::array<int, 4> vtkOrderedCompositingHelper::ComputeSortKey(
+  const double vector[3], bool parallel) const
+{
+  std::array<int, 4> key;
+  key[3] = parallel ? 1 : 0;
+  for (int axis = 0; axis < 3; ++axis)
+  {
+    if (parallel)
+    {
+      key[axis] = (vector[axis] > 0) - (vector[axis] < 0);
+    }
+    else
+    {
+      // index of the interval between planes, or of the plane, the position
+      // lies in.
+      const auto& planes = this->Planes[axis];
+      const auto iter = std::lower_bound(planes.begin(), planes.end(), vector[axis]);
+      key[axis] = 2 * static_cast<int>(iter - planes.begin()) +
+        (iter != planes.end() && *iter == vector[axis] ? 1 : 0);
+    }
+  }
+  return key;
+}
+
+//----------------------------------------------------------------------------
+const std::vector<int>& vtkOrderedCompositingHelper::GetCachedSortOrder(
+  const std::array<int, 4>& key) const
+{
+  static const std::vector<int> empty;
+  return !this->CachedSortOrder.empty() && this->CachedSortKey == key ? this->CachedSortOrder
+                                                                      : empty;
+}
+
 //----------------------------------------------------------------------------
 const vtkBoundingBox& vtkOrderedCompositingHelper::GetBoundingBox(int index) const
 {
@@ -57,6 +129,13 @@ std::vector<int> vtkOrderedCompositingHelper::ComputeSortOrder(vtkCamera* camera
 //------------------------------------------------------------------------------
 std::vector<int> vtkOrderedCompositingHelper::ComputeSortOrderInViewDirection(const double dop[3])
 {
+  const bool cacheable = !this->Planes[0].empty();
+  const auto key = this->ComputeSortKey(dop, /*parallel=*/true);
+  if (cacheable && !this->GetCachedSortOrder(key).empty())
+  {
+    return this->CachedSortOrder;
+  }
+
   std::vector<BoxT> boxes(this->Boxes.size());
   int rank = 0;
   for (auto& box : boxes)
@@ -71,12 +150,24 @@ std::vector<int> vtkOrderedCompositingHelper::ComputeSortOrderInViewDirection(co
   std::vector<int> indexes(boxes.size());
   std::transform(
     boxes.rbegin(), boxes.rend(), indexes.begin(), [](const BoxT& box) { return box.rank; });
+  if (cacheable)
+  {
+    this->CachedSortKey = key;
+    this->CachedSortOrder = indexes;
+  }
   return indexes;
 }
 
 //------------------------------------------------------------------------------
 std::vector<int> vtkOrderedCompositingHelper::ComputeSortOrderFromPosition(const double pos[3])
 {
+  const bool cacheable = !this->Planes[0].empty();
+  const auto key = this->ComputeSortKey(pos, /*parallel=*/false);
+  if (cacheable && !this->GetCachedSortOrder(key).empty())
+  {
+    return this->CachedSortOrder;
+  }
+
   std::vector<BoxT> boxes(this->Boxes.size());
   int rank = 0;
   for (auto& box : boxes)
@@ -91,6 +182,11 @@ std::vector<int> vtkOrderedCompositingHelper::ComputeSortOrderFromPosition(const
   std::vector<int> indexes(boxes.size());
   std::transform(
     boxes.rbegin(), boxes.rend(), indexes.begin(), [](const BoxT& box) { return box.rank; });
+  if (cacheable)
+  {
+    this->CachedSortKey = key;
+    this->CachedSortOrder = indexes;
+  }
   return indexes;
 }
 
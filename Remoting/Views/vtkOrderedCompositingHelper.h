@@ -6,6 +6,13 @@
  *
  * vtkOrderedCompositingHelper is used to help determine compositing order for
  * ranks when ordered-compositing is being used.
+ *
+ * When the bounding boxes do not overlap, as is the case for the cuts of a
+ * kd-tree, the sort order only depends on the position of the camera relative
+ * to the planes of the bounding boxes, or on the signs of the components of the
+ * direction of projection for parallel projections. The last sort order is
+ * then reused as long as the camera stays in the same region, hence
+ * interactions that only move the camera rarely need to sort the boxes again.
  */
 
 #ifndef vtkOrderedCompositingHelper_h
@@ -15,6 +22,7 @@
 #include "vtkObject.h"
 #include "vtkRemotingViewsModule.h" //needed for exports
 
+#include <array>  // for std::array
 #include <vector> // for std::vector
 
 class vtkBoundingBox;
@@ -41,6 +49,28 @@ protected:
 
   std::vector<vtkBoundingBox> Boxes;
 
+  /**
+   * Returns the cached sort order if it was computed for the same `key`,
+   * otherwise an empty vector.
+   */
+  const std::vector<int>& GetCachedSortOrder(const std::array<int, 4>& key) const;
+
+  /**
+   * Returns the key identifying the region of `position` (or the signs of the
+   * components of `direction` if `parallel` is true) for the sort order cache.
+   */
+  std::array<int, 4> ComputeSortKey(const double vector[3], bool parallel) const;
+
+  /**
+   * Sorted coordinates of the planes of the bounding boxes along each axis.
+   * These are empty when the boxes overlap, in which case the sort order is
+   * never cached.
+   */
+  std::array<std::vector<double>, 3> Planes;
+
+  std::array<int, 4> CachedSortKey{};
+  std::vector<int> CachedSortOrder;
+
 private:
   vtkOrderedCompositingHelper(const vtkOrderedCompositingHelper&) = delete;
   void operator=(const vtkOrderedCompositingHelper&) = delete;
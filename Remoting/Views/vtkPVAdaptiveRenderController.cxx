@@ -0,0 +1,245 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+#include "vtkPVAdaptiveRenderController.h"
+
+#include "vtkObjectFactory.h"
+#include "vtkPVLogger.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <sstream>
+#include <vector>
+
+namespace
+{
+// Weight of the last frame in the moving averages.
+constexpr double SmoothingFactor = 0.3;
+// Frames are too slow above this fraction of the target frame time, and fast
+// enough to raise the quality below that one. The gap avoids oscillations.
+constexpr double SlowFrameRatio = 1.15;
+constexpr double FastFrameRatio = 0.6;
+// Number of frames to render after a change before making another one.
+constexpr int FramesPerChange = 3;
+// Factor applied to the LOD resolution when changing it.
+constexpr double LODResolutionStep = 0.75;
+// Most lossy setting of the compressors.
+constexpr int MaximumLossyLevel = 5;
+}
+
+vtkStandardNewMacro(vtkPVAdaptiveRenderController);
+//----------------------------------------------------------------------------
+vtkPVAdaptiveRenderController::vtkPVAdaptiveRenderController() = default;
+
+//----------------------------------------------------------------------------
+vtkPVAdaptiveRenderController::~vtkPVAdaptiveRenderController() = default;
+
+//----------------------------------------------------------------------------
+std::string vtkPVAdaptiveRenderController::GetLossyCompressorConfiguration(
+  const std::string& configuration, int steps, int& appliedSteps)
+{
+  appliedSteps = 0;
+  std::istringstream iss(configuration);
+  std::vector<std::string> fields;
+  for (std::string field; iss >> field;)
+  {
+    fields.push_back(field);
+  }
+  if (fields.empty())
+  {
+    return configuration;
+  }
+
+  // Index of the field that makes the compression lossy: the quality of
+  // vtkLZ4Compressor, the squirt level of vtkSquirtCompressor and the color
+  // space reduction of vtkZlibImageCompressor. The first field after the class
+  // name is the loss-less mode.
+  size_t index = 0;
+  if (fields[0] == "vtkLZ4Compressor" || fields[0] == "vtkSquirtCompressor")
+  {
+    index = 2;
+  }
+  else if (fields[0] == "vtkZlibImageCompressor")
+  {
+    index = 3;
+  }
+  if (index == 0 || index >= fields.size())
+  {
+    return configuration;
+  }
+
+  const int level = std::atoi(fields[index].c_str());
+  const int newLevel = std::min(level + std::max(steps, 0), MaximumLossyLevel);
+  appliedSteps = std::max(newLevel - level, 0);
+  fields[index] = std::to_string(std::max(newLevel, level));
+
+  std::string result = fields[0];
+  for (size_t cc = 1; cc < fields.size(); ++cc)
+  {
+    result += " " + fields[cc];
+  }
+  return result;
+}
+
+//----------------------------------------------------------------------------
+void vtkPVAdaptiveRenderController::Reset()
+{
+  this->Initialized = false;
+  this->FrameTime = 0.0;
+  this->ImageDeliveryTime = 0.0;
+  this->NumberOfFrames = 0;
+  this->FramesSinceLastChange = 0;
+  this->CompressionSteps = 0;
+}
+
+//----------------------------------------------------------------------------
+void vtkPVAdaptiveRenderController::StartInteraction(int imageReductionFactor,
+  double lodResolution, const std::string& compressorConfiguration, bool remote)
+{
+  if (!this->Initialized || this->BaseLODResolution != lodResolution ||
+    this->BaseCompressorConfiguration != compressorConfiguration || this->Remote != remote)
+  {
+    // Start over from the user's settings.
+    this->Reset();
+    this->Initialized = true;
+    this->BaseLODResolution = lodResolution;
+    this->BaseCompressorConfiguration = compressorConfiguration;
+    this->Remote = remote;
+    this->ImageReductionFactor =
+      std::min(std::max(imageReductionFactor, 1), this->MaximumImageReductionFactor);
+    this->LODResolution = lodResolution;
+    vtkVLogF(PARAVIEW_LOG_RENDERING_VERBOSITY(),
+      "adaptive rendering: start from image reduction factor %d, LOD resolution %g, "
+      "compressor '%s'",
+      this->ImageReductionFactor, this->LODResolution,
+      this->GetCompressorConfiguration().c_str());
+    return;
+  }
+
+  // Keep the quality reached during the previous interaction, it is the best
+  // guess for this one.
+  this->NumberOfFrames = 0;
+  this->FramesSinceLastChange = 0;
+}
+
+//----------------------------------------------------------------------------
+bool vtkPVAdaptiveRenderController::AddFrame(double frameTime, double imageDeliveryTime)
+{
+  if (this->NumberOfFrames == 0)
+  {
+    this->FrameTime = frameTime;
+    this->ImageDeliveryTime = imageDeliveryTime;
+  }
+  else
+  {
+    this->FrameTime += SmoothingFactor * (frameTime - this->FrameTime);
+    this->ImageDeliveryTime += SmoothingFactor * (imageDeliveryTime - this->ImageDeliveryTime);
+  }
+  ++this->NumberOfFrames;
+  ++this->FramesSinceLastChange;
+
+  const double targetFrameTime = 1.0 / this->TargetFrameRate;
+  const bool slow = this->FrameTime > SlowFrameRatio * targetFrameTime;
+  const bool fast = this->FrameTime < FastFrameRatio * targetFrameTime;
+  if (this->FramesSinceLastChange < FramesPerChange || (!slow && !fast))
+  {
+    return false;
+  }
+
+  const int previousFactor = this->ImageReductionFactor;
+  const double previousResolution = this->LODResolution;
+  const std::string previousConfiguration = this->GetCompressorConfiguration();
+  if (!(slow ? this->Degrade() : this->Improve()))
+  {
+    return false;
+  }
+
+  this->FramesSinceLastChange = 0;
+  vtkVLogF(PARAVIEW_LOG_RENDERING_VERBOSITY(),
+    "adaptive rendering: frame time %g ms (image delivery %g ms, target %g ms), "
+    "image reduction factor %d -> %d, compressor '%s' -> '%s', LOD resolution %g -> %g",
+    this->FrameTime * 1000.0, this->ImageDeliveryTime * 1000.0, targetFrameTime * 1000.0,
+    previousFactor, this->ImageReductionFactor, previousConfiguration.c_str(),
+    this->GetCompressorConfiguration().c_str(), previousResolution, this->LODResolution);
+  return true;
+}
+
+//----------------------------------------------------------------------------
+bool vtkPVAdaptiveRenderController::Degrade()
+{
+  // When receiving images dominates, compress more rather than render less.
+  if (this->Remote && this->ImageDeliveryTime > 0.5 * this->FrameTime)
+  {
+    int applied = 0;
+    vtkPVAdaptiveRenderController::GetLossyCompressorConfiguration(
+      this->BaseCompressorConfiguration, this->CompressionSteps + 1, applied);
+    if (applied > this->CompressionSteps)
+    {
+      this->CompressionSteps = applied;
+      return true;
+    }
+  }
+
+  if (this->Remote && this->ImageReductionFactor < this->MaximumImageReductionFactor)
+  {
+    // The cost of rendering and compositing is roughly proportional to the
+    // number of pixels, i.e. to the inverse of the factor squared.
+    const double ratio = std::sqrt(this->FrameTime * this->TargetFrameRate);
+    const int factor = static_cast<int>(std::ceil(this->ImageReductionFactor * ratio));
+    this->ImageReductionFactor = std::min(
+      std::max(factor, this->ImageReductionFactor + 1), this->MaximumImageReductionFactor);
+    return true;
+  }
+
+  // Representations keep coarser levels of their LOD geometry, switching to one
+  // of them does not require the LOD geometry to be regenerated nor delivered.
+  if (this->LODResolution > this->MinimumLODResolution)
+  {
+    this->LODResolution =
+      std::max(this->LODResolution * LODResolutionStep, this->MinimumLODResolution);
+    return true;
+  }
+  return false;
+}
+
+//----------------------------------------------------------------------------
+bool vtkPVAdaptiveRenderController::Improve()
+{
+  if (this->LODResolution < this->BaseLODResolution)
+  {
+    this->LODResolution =
+      std::min(this->LODResolution / LODResolutionStep, this->BaseLODResolution);
+    return true;
+  }
+  if (this->Remote && this->ImageReductionFactor > 1)
+  {
+    --this->ImageReductionFactor;
+    return true;
+  }
+  if (this->Remote && this->CompressionSteps > 0)
+  {
+    --this->CompressionSteps;
+    return true;
+  }
+  return false;
+}
+
+//----------------------------------------------------------------------------
+std::string vtkPVAdaptiveRenderController::GetCompressorConfiguration() const
+{
+  int applied = 0;
+  return vtkPVAdaptiveRenderController::GetLossyCompressorConfiguration(
+    this->BaseCompressorConfiguration, this->CompressionSteps, applied);
+}
+
+//----------------------------------------------------------------------------
+void vtkPVAdaptiveRenderController::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "TargetFrameRate: " << this->TargetFrameRate << endl;
+  os << indent << "MaximumImageReductionFactor: " << this->MaximumImageReductionFactor << endl;
+  os << indent << "MinimumLODResolution: " << this->MinimumLODResolution << endl;
+  os << indent << "ImageReductionFactor: " << this->ImageReductionFactor << endl;
+  os << indent << "LODResolution: " << this->LODResolution << endl;
+  os << indent << "CompressorConfiguration: " << this->GetCompressorConfiguration() << endl;
+}
@@ -0,0 +1,144 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+/**
+ * @class   vtkPVAdaptiveRenderController
+ * @brief   adjusts interactive rendering quality to reach a target frame rate.
+ *
+ * vtkPVAdaptiveRenderController is used by vtkSMRenderViewProxy to choose the
+ * image reduction factor, the image compressor configuration and the LOD
+ * resolution used for interactive renders from the frame times measured during
+ * interaction, instead of relying on static thresholds.
+ *
+ * The frame times, i.e. the wall-clock time of each interactive render on the
+ * client including the round trip to the server, and the time spent receiving
+ * the rendered image from the server are smoothed using an exponential moving
+ * average. When the smoothed frame time exceeds the target frame time, the
+ * quality is lowered by one step: the compressor is made more lossy if
+ * receiving images takes most of the frame, otherwise the image reduction
+ * factor is increased, and once it reaches its maximum the LOD resolution is
+ * lowered. Representations keep a hierarchy of LOD levels (see
+ * vtkGeometryRepresentation), hence lowering the LOD resolution picks a
+ * coarser level without regenerating the LOD geometry. When frames are much
+ * faster than the target, the quality is raised back one step at a time, in
+ * the reverse order. A few frames are rendered after each change before the
+ * next one is made so that the measurements reflect it.
+ *
+ * The values set by the user (see StartInteraction()) bound the quality: the
+ * controller never uses a finer LOD resolution nor a less lossy compressor
+ * configuration than the user's, but the image reduction factor can go down to
+ * 1. The image reduction factor and the compressor are only adjusted when
+ * rendering remotely since they have no effect otherwise. The quality reached
+ * at the end of an interaction is used to start the next one.
+ *
+ * Decisions are reported using vtkLogger with
+ * `PARAVIEW_LOG_RENDERING_VERBOSITY()`.
+ */
+
+#ifndef vtkPVAdaptiveRenderController_h
+#define vtkPVAdaptiveRenderController_h
+
+#include "vtkObject.h"
+#include "vtkRemotingViewsModule.h" // needed for exports
+
+#include <string> // for std::string
+
+class VTKREMOTINGVIEWS_EXPORT vtkPVAdaptiveRenderController : public vtkObject
+{
+public:
+  static vtkPVAdaptiveRenderController* New();
+  vtkTypeMacro(vtkPVAdaptiveRenderController, vtkObject);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  ///@{
+  /**
+   * Get/Set the frame rate, in frames per second, to reach during
+   * interaction. Default is 15.
+   */
+  vtkSetClampMacro(TargetFrameRate, double, 1.0, 240.0);
+  vtkGetMacro(TargetFrameRate, double);
+  ///@}
+
+  ///@{
+  /**
+   * Get/Set the largest image reduction factor to use. Default is 8.
+   */
+  vtkSetClampMacro(MaximumImageReductionFactor, int, 1, 20);
+  vtkGetMacro(MaximumImageReductionFactor, int);
+  ///@}
+
+  ///@{
+  /**
+   * Get/Set the smallest LOD resolution to use. Default is 0.1.
+   */
+  vtkSetClampMacro(MinimumLODResolution, double, 0.0, 1.0);
+  vtkGetMacro(MinimumLODResolution, double);
+  ///@}
+
+  /**
+   * Must be called when an interaction starts, with the values set by the
+   * user. `remote` indicates whether interactive renders happen on the server.
+   */
+  void StartInteraction(int imageReductionFactor, double lodResolution,
+    const std::string& compressorConfiguration, bool remote);
+
+  /**
+   * Must be called after each interactive render with the wall-clock time of
+   * the render and the time spent receiving the image rendered remotely, in
+   * seconds. Returns true if the image reduction factor, the compressor
+   * configuration or the LOD resolution changed.
+   */
+  bool AddFrame(double frameTime, double imageDeliveryTime);
+
+  ///@{
+  /**
+   * Values to use for the next interactive render.
+   */
+  vtkGetMacro(ImageReductionFactor, int);
+  vtkGetMacro(LODResolution, double);
+  std::string GetCompressorConfiguration() const;
+  ///@}
+
+  /**
+   * Forgets the measurements and decisions, e.g. when the view is resized.
+   */
+  void Reset();
+
+  /**
+   * Returns the configuration obtained by making `configuration` `steps`
+   * steps more lossy, for the compressors that support it. Returns the number
+   * of steps that were actually applied in `appliedSteps`.
+   */
+  static std::string GetLossyCompressorConfiguration(
+    const std::string& configuration, int steps, int& appliedSteps);
+
+protected:
+  vtkPVAdaptiveRenderController();
+  ~vtkPVAdaptiveRenderController() override;
+
+  double TargetFrameRate = 15.0;
+  int MaximumImageReductionFactor = 8;
+  double MinimumLODResolution = 0.1;
+
+  int ImageReductionFactor = 1;
+  double LODResolution = 1.0;
+  int CompressionSteps = 0;
+
+private:
+  vtkPVAdaptiveRenderController(const vtkPVAdaptiveRenderController&) = delete;
+  void operator=(const vtkPVAdaptiveRenderController&) = delete;
+
+  bool Degrade();
+  bool Improve();
+
+  std::string BaseCompressorConfiguration;
+  double BaseLODResolution = 1.0;
+  bool Remote = false;
+  bool Initialized = false;
+
+  double FrameTime = 0.0;
+  double ImageDeliveryTime = 0.0;
+  int NumberOfFrames = 0;
+  int FramesSinceLastChange = 0;
+};
+
+#endif
@@ -3,19 +3,55 @@
 // SPDX-License-Identifier: BSD-3-Clause
 #include "vtkPVClientServerSynchronizedRenderers.h"
 
+#include "vtkClientSocket.h"
 #include "vtkLZ4Compressor.h"
 #include "vtkMultiProcessController.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkOpenGLRenderer.h"
+#include "vtkPVSession.h"
+#include "vtkSMPTools.h"
+#include "vtkSocketCommunicator.h"
 #include "vtkSquirtCompressor.h"
+#include "vtkThreadedTaskQueue.h"
+#include "vtkTimerLog.h"
 #include "vtkUnsignedCharArray.h"
 #include "vtkZlibImageCompressor.h"
 #if VTK_MODULE_ENABLE_ParaView_nvpipe
 #include "vtkNvPipeCompressor.h"
 #endif
 
+#include <algorithm>
+#include <atomic>
 #include <cassert>
+#include <cstring>
+#include <map>
 #include <sstream>
+#include <string>
+
+namespace
+{
+// Returns an array sharing the memory of the rows [first, first + count[ of
+// an image.
+vtkSmartPointer<vtkUnsignedCharArray> GetTile(
+  vtkUnsignedCharArray* image, int width, int first, int count)
+{
+  const int ncomps = image->GetNumberOfComponents();
+  const vtkIdType rowSize = static_cast<vtkIdType>(width) * ncomps;
+  auto tile = vtkSmartPointer<vtkUnsignedCharArray>::New();
+  tile->SetNumberOfComponents(ncomps);
+  tile->SetArray(image->GetPointer(first * rowSize), count * rowSize, /*save=*/1);
+  return tile;
+}
+
+// The renderers whose image was sent by the server but not received yet, per
+// connection. All the views of a session share the connection and the image
+// delivery tag, so that the images must be received in the order they were
+// rendered, whichever view renders next. At most one image is pending per
+// connection since every render receives the ones before its own. The
+// renderer is null when it was deleted before receiving its image.
+std::map<vtkMultiProcessController*, vtkPVClientServerSynchronizedRenderers*> PendingImages;
+}
 
 vtkStandardNewMacro(vtkPVClientServerSynchronizedRenderers);
 vtkCxxSetObjectMacro(vtkPVClientServerSynchronizedRenderers, Compressor, vtkImageCompressor);
@@ -31,6 +67,14 @@ vtkPVClientServerSynchronizedRenderers::vtkPVClientServerSynchronizedRenderers()
 //----------------------------------------------------------------------------
 vtkPVClientServerSynchronizedRenderers::~vtkPVClientServerSynchronizedRenderers()
 {
+  for (auto& pending : ::PendingImages)
+  {
+    if (pending.second == this)
+    {
+      // the image still needs to be received, the next render drops it.
+      pending.second = nullptr;
+    }
+  }
   this->SetCompressor(nullptr);
 }
 
@@ -41,27 +85,149 @@ void vtkPVClientServerSynchronizedRenderers::MasterEndRender()
   assert(this->ParallelController->IsA("vtkSocketController") ||
     this->ParallelController->IsA("vtkCompositeMultiProcessController"));
 
+  // NvPipe decodes the frames as a video stream, hence it cannot skip any.
+  const bool decodeAll = this->Compressor && this->Compressor->IsA("vtkNvPipeCompressor");
+
+  // the image left pending by the previous asynchronous render, of this view or
+  // another one, precedes the image of this render.
+  bool received = false;
+  this->LastImageDeliveryTime = 0.0;
+  auto pending = ::PendingImages.find(this->ParallelController);
+  if (pending != ::PendingImages.end())
+  {
+    vtkPVClientServerSynchronizedRenderers* owner = pending->second;
+    ::PendingImages.erase(pending);
+    if (owner == this)
+    {
+      // when rendering asynchronously, the image of the previous render is the
+      // one displayed. Otherwise, it is superseded and dropped undecoded.
+      const double time = this->ReceiveImage(this->AsynchronousRendering || decodeAll);
+      if (this->AsynchronousRendering)
+      {
+        this->LastImageDeliveryTime = time;
+        received = true;
+      }
+    }
+    else if (owner)
+    {
+      // the image of another view is kept for it to display on its next render.
+      owner->ReceiveImage(true);
+    }
+    else
+    {
+      this->ReceiveImage(false);
+    }
+  }
+
+  if (this->AsynchronousRendering && (received || this->ImageUpToDate))
+  {
+    // the image of this render is received by the next render of any view.
+    ::PendingImages[this->ParallelController] = this;
+  }
+  else
+  {
+    // asynchronous renders also wait for their own image when there is no
+    // image of this view to display, e.g. after it rendered locally.
+    this->LastImageDeliveryTime = this->ReceiveImage(true);
+    received = true;
+  }
+
+  if (!received && this->Image.GetWidth() > 0)
+  {
+    // keep displaying the last image received.
+    this->Image.MarkValid();
+  }
+}
+
+//----------------------------------------------------------------------------
+bool vtkPVClientServerSynchronizedRenderers::HasImageInFlight()
+{
+  if (::PendingImages.find(this->ParallelController) == ::PendingImages.end())
+  {
+    return false;
+  }
+
+  // the image may have been buffered while waiting for another message. When
+  // the connection cannot be polled, the next render waits for the image.
+  auto communicator =
+    vtkSocketCommunicator::SafeDownCast(this->ParallelController->GetCommunicator());
+  vtkSocket* socket = communicator ? communicator->GetSocket() : nullptr;
+  if (!socket || !socket->GetConnected() || communicator->HasBufferredMessages())
+  {
+    return false;
+  }
+
+  // the server sends the header once the image is rendered, poll the socket
+  // for it. A timeout of 0 would wait indefinitely, use the shortest one.
+  const int descriptor = socket->GetSocketDescriptor();
+  int selected = -1;
+  return vtkSocket::SelectSockets(&descriptor, 1, 1, &selected) == 0;
+}
+
+//----------------------------------------------------------------------------
+void vtkPVClientServerSynchronizedRenderers::DropPendingImage()
+{
+  auto pending = ::PendingImages.find(this->ParallelController);
+  if (pending != ::PendingImages.end() && pending->second == this)
+  {
+    // the next render of any view receives it without decompressing it.
+    pending->second = nullptr;
+  }
+  this->ImageUpToDate = false;
+}
+
+//----------------------------------------------------------------------------
+double vtkPVClientServerSynchronizedRenderers::ReceiveImage(bool decompress)
+{
+  const int tag = vtkPVSession::IMAGE_DELIVERY_TAG;
   vtkRawImage& rawImage = this->Image;
 
-  int header[4];
-  this->ParallelController->Receive(header, 4, 1, 0x023430);
-  if (header[0] > 0)
+  int header[5];
+  this->ParallelController->Receive(header, 5, 1, tag);
+  // the header is sent once the image is rendered, and compressed when it is
+  // split in tiles, time what follows.
+  const double start = vtkTimerLog::GetUniversalTime();
+  if (header[0] > 0 && !decompress)
+  {
+    // the messages are received all the same to keep the stream consistent.
+    // Tiles are only sent with a compressor, hence this does not depend on
+    // the compressor of this renderer.
+    const int numTiles = header[4] > 0 ? (header[2] + header[4] - 1) / header[4] : 1;
+    vtkNew<vtkUnsignedCharArray> data;
+    for (int cc = 0; cc < numTiles; ++cc)
+    {
+      this->ParallelController->Receive(data, 1, tag);
+    }
+  }
+  else if (header[0] > 0)
   {
     rawImage.Resize(header[1], header[2], header[3]);
-    if (this->Compressor)
+    if (this->Compressor && header[4] > 0)
+    {
+      if (!this->DecompressTiles(rawImage.GetRawPtr(), header[1], header[2], header[4]))
+      {
+        vtkErrorMacro("Image de-compression failed!");
+      }
+    }
+    else if (this->Compressor)
     {
       vtkUnsignedCharArray* data = vtkUnsignedCharArray::New();
-      this->ParallelController->Receive(data, 1, 0x023430);
+      this->ParallelController->Receive(data, 1, tag);
       this->Compressor->SetImageResolution(header[1], header[2]);
       this->Decompress(data, rawImage.GetRawPtr());
       data->Delete();
     }
     else
     {
-      this->ParallelController->Receive(rawImage.GetRawPtr(), 1, 0x023430);
+      this->ParallelController->Receive(rawImage.GetRawPtr(), 1, tag);
     }
     rawImage.MarkValid();
   }
+  if (decompress)
+  {
+    this->ImageUpToDate = header[0] > 0;
+  }
+  return vtkTimerLog::GetUniversalTime() - start;
 }
 
 //----------------------------------------------------------------------------
@@ -70,27 +236,43 @@ void vtkPVClientServerSynchronizedRenderers::SlaveEndRender()
   assert(this->ParallelController->IsA("vtkSocketController") ||
     this->ParallelController->IsA("vtkCompositeMultiProcessController"));
 
+  const int tag = vtkPVSession::IMAGE_DELIVERY_TAG;
   vtkRawImage& rawImage = this->CaptureRenderedImage();
 
-  int header[4];
+  int header[5];
   header[0] = rawImage.IsValid() ? 1 : 0;
   header[1] = rawImage.GetWidth();
   header[2] = rawImage.GetHeight();
   header[3] = rawImage.IsValid() ? rawImage.GetRawPtr()->GetNumberOfComponents() : 0;
+  header[4] = rawImage.IsValid() ? this->GetTileRows(header[1], header[2]) : 0;
+  if (header[4] > 0 &&
+    !this->CompressTiles(rawImage.GetRawPtr(), header[1], header[2], header[4]))
+  {
+    // send the whole image rather than tiles that could not be compressed.
+    header[4] = 0;
+  }
 
   // send the image to the client.
-  this->ParallelController->Send(header, 4, 1, 0x023430);
+  this->ParallelController->Send(header, 5, 1, tag);
 
   if (rawImage.IsValid())
   {
-    if (this->Compressor)
+    if (this->Compressor && header[4] > 0)
+    {
+      const int numTiles = (header[2] + header[4] - 1) / header[4];
+      for (int cc = 0; cc < numTiles; ++cc)
+      {
+        this->ParallelController->Send(this->TileCompressors[cc]->GetOutput(), 1, tag);
+      }
+    }
+    else if (this->Compressor)
     {
       this->Compressor->SetImageResolution(header[1], header[2]);
-      this->ParallelController->Send(this->Compress(rawImage.GetRawPtr()), 1, 0x023430);
+      this->ParallelController->Send(this->Compress(rawImage.GetRawPtr()), 1, tag);
     }
     else
     {
-      this->ParallelController->Send(rawImage.GetRawPtr(), 1, 0x023430);
+      this->ParallelController->Send(rawImage.GetRawPtr(), 1, tag);
     }
   }
 }
@@ -133,6 +315,115 @@ void vtkPVClientServerSynchronizedRenderers::Decompress(
   }
 }
 
+//----------------------------------------------------------------------------
+int vtkPVClientServerSynchronizedRenderers::GetTileRows(int width, int height) const
+{
+  // NvPipe encodes the frames as a video stream, hence it needs whole frames.
+  if (!this->Compressor || this->TileSize <= 0 || width <= 0 ||
+    this->Compressor->IsA("vtkNvPipeCompressor"))
+  {
+    return 0;
+  }
+  const int rows = std::max(1, this->TileSize / width);
+  return height >= 2 * rows ? rows : 0;
+}
+
+//----------------------------------------------------------------------------
+bool vtkPVClientServerSynchronizedRenderers::CompressTiles(
+  vtkUnsignedCharArray* image, int width, int height, int rows)
+{
+  const int numTiles = (height + rows - 1) / rows;
+  this->UpdateTileCompressors(numTiles);
+  std::atomic<bool> failed(false);
+  vtkSMPTools::For(0, numTiles, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType cc = begin; cc < end; ++cc)
+    {
+      const int first = static_cast<int>(cc) * rows;
+      const int count = std::min(rows, height - first);
+      auto tile = ::GetTile(image, width, first, count);
+      vtkImageCompressor* compressor = this->TileCompressors[cc];
+      compressor->SetImageResolution(width, count);
+      compressor->SetInput(tile);
+      if (compressor->Compress() == 0)
+      {
+        failed = true;
+      }
+      compressor->SetInput(nullptr);
+    }
+  });
+  return !failed;
+}
+
+//----------------------------------------------------------------------------
+bool vtkPVClientServerSynchronizedRenderers::DecompressTiles(
+  vtkUnsignedCharArray* image, int width, int height, int rows)
+{
+  // each tile is decompressed as soon as it is received.
+  const int numTiles = (height + rows - 1) / rows;
+  this->UpdateTileCompressors(numTiles);
+  std::vector<vtkSmartPointer<vtkUnsignedCharArray>> tiles(numTiles);
+  std::atomic<bool> failed(false);
+  vtkThreadedTaskQueue<void, int> decoder([&](int cc) {
+    const int first = cc * rows;
+    const int count = std::min(rows, height - first);
+    auto tile = ::GetTile(image, width, first, count);
+    unsigned char* tilePtr = tile->GetPointer(0);
+    vtkImageCompressor* compressor = this->TileCompressors[cc];
+    vtkSmartPointer<vtkUnsignedCharArray> output = compressor->GetOutput();
+    compressor->SetImageResolution(width, count);
+    compressor->SetInput(tiles[cc]);
+    compressor->SetOutput(tile);
+    if (compressor->Decompress() == 0)
+    {
+      failed = true;
+    }
+    else if (tile->GetPointer(0) != tilePtr)
+    {
+      // some compressors replace the output buffer e.g. to restore alpha.
+      std::memcpy(tilePtr, tile->GetPointer(0), tile->GetDataSize());
+    }
+    compressor->SetInput(nullptr);
+    compressor->SetOutput(output);
+  });
+  for (int cc = 0; cc < numTiles; ++cc)
+  {
+    tiles[cc] = vtkSmartPointer<vtkUnsignedCharArray>::New();
+    this->ReceiveTile(tiles[cc]);
+    decoder.Push(int(cc));
+  }
+  decoder.Flush();
+  return !failed;
+}
+
+//----------------------------------------------------------------------------
+void vtkPVClientServerSynchronizedRenderers::ReceiveTile(vtkUnsignedCharArray* tile)
+{
+  this->ParallelController->Receive(tile, 1, vtkPVSession::IMAGE_DELIVERY_TAG);
+}
+
+//----------------------------------------------------------------------------
+void vtkPVClientServerSynchronizedRenderers::UpdateTileCompressors(int count)
+{
+  assert(this->Compressor != nullptr);
+  // the Compressor may have been modified directly, always copy its
+  // configuration.
+  const std::string configuration = this->Compressor->SaveConfiguration();
+  if (static_cast<int>(this->TileCompressors.size()) < count)
+  {
+    this->TileCompressors.resize(count);
+  }
+  for (int cc = 0; cc < count; ++cc)
+  {
+    auto& compressor = this->TileCompressors[cc];
+    if (!compressor || strcmp(compressor->GetClassName(), this->Compressor->GetClassName()) != 0)
+    {
+      compressor.TakeReference(this->Compressor->NewInstance());
+    }
+    compressor->RestoreConfiguration(configuration.c_str());
+    compressor->SetLossLessMode(this->LossLessCompression);
+  }
+}
+
 //----------------------------------------------------------------------------
 void vtkPVClientServerSynchronizedRenderers::ConfigureCompressor(const char* stream)
 {
@@ -204,4 +495,6 @@ void vtkPVClientServerSynchronizedRenderers::ConfigureCompressor(const char* str
 void vtkPVClientServerSynchronizedRenderers::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
+  os << indent << "TileSize: " << this->TileSize << endl;
+  os << indent << "AsynchronousRendering: " << this->AsynchronousRendering << endl;
 }
@@ -7,14 +7,32 @@
  * vtkPVClientServerSynchronizedRenderers is similar to
  * vtkClientServerSynchronizedRenderers except that it optionally uses image
  * compressors to compress the image before transmitting.
+ *
+ * Large images are split in tiles, i.e. bands of whole rows, that are
+ * compressed in parallel, each one by its own copy of the compressor, and sent
+ * separately. Since the tiles are independent of one another, the client
+ * decompresses them in parallel as soon as they are received.
+ *
+ * In asynchronous mode, see SetAsynchronousRendering(), the client does not
+ * wait for the image of the current render: it displays the image of the
+ * previous render while the server renders the current one. As long as that
+ * image has not arrived, HasImageInFlight() is true without blocking and
+ * vtkSMRenderViewProxy drops the interactive renders, so that the server only
+ * renders the camera of the last one. Since all the views of a session share
+ * the connection, the pending image is received by the next render of any
+ * view. It is dropped without being decompressed if it is superseded by a
+ * synchronous render of the same view, or if the view rendered locally since.
  */
 
 #ifndef vtkPVClientServerSynchronizedRenderers_h
 #define vtkPVClientServerSynchronizedRenderers_h
 
 #include "vtkRemotingViewsModule.h" //needed for exports
+#include "vtkSmartPointer.h"        // for vtkSmartPointer
 #include "vtkSynchronizedRenderers.h"
 
+#include <vector> // for std::vector
+
 class vtkImageCompressor;
 class vtkUnsignedCharArray;
 
@@ -47,6 +65,50 @@ public:
    */
   virtual void ConfigureCompressor(const char* stream);
 
+  /**
+   * Returns the time, in seconds, spent receiving and decompressing the last
+   * image rendered remotely. This is only measured on the client.
+   */
+  vtkGetMacro(LastImageDeliveryTime, double);
+
+  ///@{
+  /**
+   * Get/Set the approximate number of pixels in the tiles compressed in
+   * parallel. Images smaller than twice this size are compressed as a whole.
+   * 0 disables tiling, which is never used with vtkNvPipeCompressor anyway.
+   * Default is 262144 i.e. 512x512 pixels.
+   */
+  vtkSetClampMacro(TileSize, int, 0, VTK_INT_MAX);
+  vtkGetMacro(TileSize, int);
+  ///@}
+
+  ///@{
+  /**
+   * Get/Set whether the client displays the image of the previous render
+   * instead of waiting for the image of the current one, i.e. whether renders
+   * are pipelined by one frame so that the server renders the current image
+   * while the client decompresses and displays the previous one. This is only
+   * used on the client, typically for interactive renders. Default is false.
+   */
+  vtkSetMacro(AsynchronousRendering, bool);
+  vtkGetMacro(AsynchronousRendering, bool);
+  ///@}
+
+  /**
+   * Returns true on the client when the image of an asynchronous render, of
+   * this renderer or of another one sharing the connection, has not arrived
+   * yet, i.e. when the server may still be rendering it. This does not block.
+   */
+  bool HasImageInFlight();
+
+  /**
+   * Drops the image of the last asynchronous render of this renderer, if it
+   * is still pending, and the last image received. This is called when the
+   * view renders locally, since these images are then stale: the next
+   * asynchronous render waits for its own image instead of displaying them.
+   */
+  void DropPendingImage();
+
 protected:
   vtkPVClientServerSynchronizedRenderers();
   ~vtkPVClientServerSynchronizedRenderers() override;
@@ -62,12 +124,64 @@ protected:
   vtkUnsignedCharArray* Compress(vtkUnsignedCharArray*);
   void Decompress(vtkUnsignedCharArray* input, vtkUnsignedCharArray* outputBuffer);
 
+  /**
+   * Returns the number of rows in the tiles an image with the given
+   * resolution is split in, or 0 if the image is not to be split.
+   */
+  int GetTileRows(int width, int height) const;
+
+  /**
+   * Ensures there are at least `count` TileCompressors, with the same
+   * configuration as the Compressor.
+   */
+  void UpdateTileCompressors(int count);
+
+  /**
+   * Compresses the tiles of `rows` rows of an image with the given resolution,
+   * each one into the output of its TileCompressors. Returns false if a tile
+   * could not be compressed.
+   */
+  bool CompressTiles(vtkUnsignedCharArray* image, int width, int height, int rows);
+
+  /**
+   * Decompresses the tiles of `rows` rows of an image with the given
+   * resolution into `image`, each one as soon as it is returned by
+   * ReceiveTile(). Returns false if a tile could not be decompressed.
+   */
+  bool DecompressTiles(vtkUnsignedCharArray* image, int width, int height, int rows);
+
+  /**
+   * Receives the next compressed tile sent by the server.
+   */
+  virtual void ReceiveTile(vtkUnsignedCharArray* tile);
+
+  /**
+   * Receives the next image sent by the server, decompressing it into Image
+   * unless `decompress` is false. Returns the time spent receiving it once the
+   * server sent it, in seconds.
+   */
+  double ReceiveImage(bool decompress);
+
   void MasterEndRender() override;
   void SlaveEndRender() override;
 
   vtkImageCompressor* Compressor;
   bool LossLessCompression;
   bool NVPipeSupport;
+  double LastImageDeliveryTime = 0.0;
+  int TileSize = 262144;
+  bool AsynchronousRendering = false;
+
+  /**
+   * Whether Image holds the last image rendered remotely for this renderer,
+   * which asynchronous renders display until the next one arrives.
+   */
+  bool ImageUpToDate = false;
+
+  /**
+   * Compressors used to process the tiles concurrently, one per tile.
+   */
+  std::vector<vtkSmartPointer<vtkImageCompressor>> TileCompressors;
 
 private:
   vtkPVClientServerSynchronizedRenderers(const vtkPVClientServerSynchronizedRenderers&) = delete;
@@ -2,18 +2,28 @@
 // SPDX-License-Identifier: BSD-3-Clause
 #include "vtkPVHardwareSelector.h"
 
+#include "vtkAbstractVolumeMapper.h"
+#include "vtkActor.h"
 #include "vtkCamera.h"
+#include "vtkDataObject.h"
+#include "vtkHomogeneousTransform.h"
+#include "vtkMapper.h"
+#include "vtkMatrix4x4.h"
 #include "vtkMultiProcessController.h"
 #include "vtkObjectFactory.h"
 #include "vtkPVLogger.h"
 #include "vtkPVRenderView.h"
 #include "vtkPVRenderViewSettings.h"
 #include "vtkProcessModule.h"
+#include "vtkPropCollection.h"
 #include "vtkRenderer.h"
 #include "vtkSelection.h"
+#include "vtkVolume.h"
 #include "vtkWeakPointer.h"
 
+#include <algorithm>
 #include <map>
+#include <vector>
 
 //#define vtkPVHardwareSelectorDEBUG
 #ifdef vtkPVHardwareSelectorDEBUG
@@ -24,6 +34,42 @@
 #include <sstream>
 #endif
 
+namespace
+{
+// Returns the camera parameters that affect the selection buffers. The view
+// transform covers the position, focal point and view up as well as the model
+// and user view transforms. The clipping range is ignored since it is reset on
+// every render.
+std::vector<double> GetCameraState(vtkCamera* camera)
+{
+  const double* view = camera->GetModelViewTransformMatrix()->GetData();
+  std::vector<double> state(view, view + 16);
+  state.push_back(camera->GetViewAngle());
+  state.push_back(camera->GetParallelScale());
+  state.push_back(camera->GetParallelProjection());
+  state.push_back(camera->GetUseHorizontalViewAngle());
+  const double* center = camera->GetWindowCenter();
+  state.insert(state.end(), center, center + 2);
+  const double* shear = camera->GetViewShear();
+  state.insert(state.end(), shear, shear + 3);
+  state.push_back(camera->GetUseOffAxisProjection());
+  state.push_back(camera->GetEyeAngle());
+  state.push_back(camera->GetLeftEye());
+  state.push_back(camera->GetEyeSeparation());
+  for (const double* corner :
+    { camera->GetScreenBottomLeft(), camera->GetScreenBottomRight(), camera->GetScreenTopRight() })
+  {
+    state.insert(state.end(), corner, corner + 3);
+  }
+  if (vtkHomogeneousTransform* transform = camera->GetUserTransform())
+  {
+    const double* matrix = transform->GetMatrix()->GetData();
+    state.insert(state.end(), matrix, matrix + 16);
+  }
+  return state;
+}
+}
+
 class vtkPVHardwareSelector::vtkInternals
 {
 public:
@@ -31,6 +77,9 @@ public:
   PropMapType PropMap;
 
   vtkWeakPointer<vtkPVRenderView> View;
+
+  // Camera parameters when the buffers were captured.
+  std::vector<double> CapturedCameraState;
 };
 
 //----------------------------------------------------------------------------
@@ -90,6 +139,7 @@ bool vtkPVHardwareSelector::PrepareSelect()
     int* size = this->Renderer->GetSize();
     int* origin = this->Renderer->GetOrigin();
     this->SetArea(origin[0], origin[1], origin[0] + size[0] - 1, origin[1] + size[1] - 1);
+    this->Internals->CapturedCameraState = ::GetCameraState(this->Renderer->GetActiveCamera());
     if (this->CaptureBuffers() == false)
     {
       this->CaptureTime.Modified();
@@ -145,7 +195,65 @@ bool vtkPVHardwareSelector::NeedToRenderForSelection()
   // We rely on external logic to ensure that the MTime for the
   // vtkPVHardwareSelector is explicitly modified when some action happens that
   // would result in invalidation of captured buffers.
-  return this->CaptureTime < this->GetMTime();
+  return this->CaptureTime < this->GetMTime() || this->HasSceneChanged();
+}
+
+//----------------------------------------------------------------------------
+bool vtkPVHardwareSelector::HasSceneChanged()
+{
+  vtkRenderer* renderer = this->Renderer;
+  if (renderer == nullptr)
+  {
+    return true;
+  }
+
+  const int* size = renderer->GetSize();
+  const int* origin = renderer->GetOrigin();
+  const unsigned int area[4] = { static_cast<unsigned int>(origin[0]),
+    static_cast<unsigned int>(origin[1]), static_cast<unsigned int>(origin[0] + size[0] - 1),
+    static_cast<unsigned int>(origin[1] + size[1] - 1) };
+  if (!std::equal(area, area + 4, this->Area) ||
+    ::GetCameraState(renderer->GetActiveCamera()) != this->Internals->CapturedCameraState)
+  {
+    return true;
+  }
+
+  const vtkMTimeType captureTime = this->CaptureTime.GetMTime();
+  vtkPropCollection* props = renderer->GetViewProps();
+  if (props->GetMTime() > captureTime)
+  {
+    return true;
+  }
+  vtkCollectionSimpleIterator iter;
+  props->InitTraversal(iter);
+  while (vtkProp* prop = props->GetNextProp(iter))
+  {
+    // the visibility or pickability of the prop changed.
+    if (prop->GetMTime() > captureTime)
+    {
+      return true;
+    }
+    // new data is rendered by the prop. Only the data is checked since the
+    // mappers may be modified by the renders that occur between selections.
+    vtkAbstractMapper* mapper = nullptr;
+    if (auto actor = vtkActor::SafeDownCast(prop))
+    {
+      mapper = actor->GetMapper();
+    }
+    else if (auto volume = vtkVolume::SafeDownCast(prop))
+    {
+      mapper = volume->GetMapper();
+    }
+    vtkDataObject* input =
+      mapper && prop->GetVisibility() && mapper->GetNumberOfInputConnections(0) > 0
+      ? mapper->GetInputDataObject(0, 0)
+      : nullptr;
+    if (input && input->GetMTime() > captureTime)
+    {
+      return true;
+    }
+  }
+  return false;
 }
 
 //----------------------------------------------------------------------------
@@ -8,7 +8,10 @@
  * vtkHardwareSelector is subclass of vtkHardwareSelector that adds logic to
  * reuse the captured buffers as much as possible. Thus avoiding repeated
  * selection-rendering of repeated selections or picking.
- * This class does not know, however, when the cached buffers are invalid.
+ * The cached buffers are captured again when the camera, the viewport, the
+ * props of the renderer or the data of their mappers changed since they were
+ * captured. This class does not know, however, about all the changes that
+ * invalidate the cached buffers, e.g. changes of the mappers parameters.
  * External logic must explicitly calls InvalidateCachedSelection() to ensure
  * that the cache is not reused.
  */
@@ -48,7 +51,8 @@ public:
 
   /**
    * Returns true when the next call to Select() will result in renders to
-   * capture the selection-buffers.
+   * capture the selection-buffers i.e. when InvalidateCachedSelection() was
+   * called or HasSceneChanged() returns true.
    */
   virtual bool NeedToRenderForSelection();
 
@@ -89,6 +93,13 @@ protected:
    */
   bool PrepareSelect();
 
+  /**
+   * Returns true if the camera, the viewport, the props of the renderer or the
+   * data of the mappers of their visible actors and volumes changed since the
+   * buffers were captured.
+   */
+  virtual bool HasSceneChanged();
+
   void SavePixelBuffer(int passNo) override;
 
   vtkTimeStamp CaptureTime;
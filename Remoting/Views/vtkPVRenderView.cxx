@@ -863,17 +863,31 @@ bool vtkPVRenderView::PrepareSelect(int fieldAssociation, const char* array)
   this->PreviousSwapBuffers = this->GetRenderWindow()->GetSwapBuffers();
   this->GetRenderWindow()->SwapBuffersOff();
 
+  this->Selector->SetRenderer(this->GetRenderer());
+  this->Selector->SetFieldAssociation(fieldAssociation);
+
   // Make sure that the representations are up-to-date. This is required since
   // due to delayed-switch-back-from-lod, the most recent render maybe a LOD
   // render (or a nonremote render) in which case we need to update the
-  // representation pipelines correctly.
-  this->Render(/*interactive*/ false, /*skip-rendering*/ false);
+  // representation pipelines correctly. The rendering itself is skipped when
+  // the buffers captured by a previous selection can be reused e.g. when
+  // hovering for preselection.
+  bool need_to_render = array != nullptr || this->NeedToRenderForSelection();
+  this->Render(/*interactive*/ false, /*skip-rendering*/ !need_to_render);
+  if (!need_to_render && this->NeedToRenderForSelection())
+  {
+    // representations updated their geometry while preparing to render.
+    need_to_render = true;
+    this->Render(/*interactive*/ false, /*skip-rendering*/ false);
+  }
+  if (need_to_render)
+  {
+    // ensures all processes capture the buffers.
+    this->Selector->InvalidateCachedSelection();
+  }
 
   this->SetLastSelection(nullptr);
 
-  this->Selector->SetRenderer(this->GetRenderer());
-  this->Selector->SetFieldAssociation(fieldAssociation);
-
   if (array)
   {
     for (int i = 0; i < this->GetNumberOfRepresentations(); i++)
@@ -906,6 +920,20 @@ bool vtkPVRenderView::PrepareSelect(int fieldAssociation, const char* array)
   return true;
 }
 
+//----------------------------------------------------------------------------
+bool vtkPVRenderView::NeedToRenderForSelection()
+{
+  vtkTypeUInt64 need = this->Selector->NeedToRenderForSelection() ? 1 : 0;
+  if (this->GetUseDistributedRenderingForRender())
+  {
+    // all processes must agree on capturing the buffers since they render
+    // together. Skip data server since this method is only called on processes
+    // involved in rendering.
+    this->AllReduce(need, need, vtkCommunicator::MAX_OP, /*skip_data_server=*/true);
+  }
+  return need != 0;
+}
+
 //----------------------------------------------------------------------------
 void vtkPVRenderView::Select(int fieldAssociation, int region[4], const char* array)
 {
@@ -1591,10 +1619,24 @@ void vtkPVRenderView::Render(bool interactive, bool skip_rendering)
   // Use loss-less image compression for client-server for full-res renders.
   this->SynchronizedRenderers->SetLossLessCompression(!interactive);
 
+  // Let the client display the previous image during interactions, if requested.
+  if (auto cssync = vtkPVClientServerSynchronizedRenderers::SafeDownCast(
+        this->SynchronizedRenderers->GetCSSynchronizer()))
+  {
+    cssync->SetAsynchronousRendering(
+      interactive && this->AsynchronousInteractiveRendering && !this->MakingSelection);
+  }
+
   bool use_lod_rendering = interactive ? this->GetUseLODForInteractiveRender() : false;
   if (use_lod_rendering)
   {
     this->RequestInformation->Set(USE_LOD(), 1);
+    // the LOD geometry is generated using LODResolution. Only the adaptive
+    // controller asks representations for a coarser level of it.
+    if (this->AdaptiveLODResolution >= 0.0 && this->AdaptiveLODResolution < this->LODResolution)
+    {
+      this->RequestInformation->Set(LOD_RESOLUTION(), this->AdaptiveLODResolution);
+    }
   }
 
   // Decide if we are doing remote rendering or local rendering.
@@ -1651,9 +1693,11 @@ void vtkPVRenderView::Render(bool interactive, bool skip_rendering)
     vtkPVView::REQUEST_RENDER(), this->RequestInformation, this->ReplyInformationVector);
 
   // set the image reduction factor.
+  const int interactiveImageReductionFactor = this->AdaptiveImageReductionFactor > 0
+    ? this->AdaptiveImageReductionFactor
+    : this->InteractiveRenderImageReductionFactor;
   this->SynchronizedRenderers->SetImageReductionFactor(
-    (interactive ? this->InteractiveRenderImageReductionFactor
-                 : this->StillRenderImageReductionFactor));
+    (interactive ? interactiveImageReductionFactor : this->StillRenderImageReductionFactor));
 
   this->UsedLODForLastRender = use_lod_rendering;
 
@@ -1671,6 +1715,14 @@ void vtkPVRenderView::Render(bool interactive, bool skip_rendering)
   this->SynchronizedRenderers->SetDataReplicatedOnAllProcesses(
     in_cave_mode || (!use_distributed_rendering && in_tile_display_mode));
 
+  auto cssync = vtkPVClientServerSynchronizedRenderers::SafeDownCast(
+    this->SynchronizedRenderers->GetCSSynchronizer());
+  if (cssync && !use_distributed_rendering)
+  {
+    // the images rendered remotely before are stale once rendered locally.
+    cssync->DropPendingImage();
+  }
+
   if (this->UseHiddenLineRemoval && !use_distributed_rendering)
   {
     this->GetRenderer()->SetUseHiddenLineRemoval(true);
@@ -2354,7 +2406,40 @@ void vtkPVRenderView::PrintSelf(ostream& os, vtkIndent indent)
 //----------------------------------------------------------------------------
 void vtkPVRenderView::ConfigureCompressor(const char* configuration)
 {
-  this->SynchronizedRenderers->ConfigureCompressor(configuration);
+  this->CompressorConfig = configuration ? configuration : "";
+  if (this->AdaptiveCompressorConfig.empty())
+  {
+    this->SynchronizedRenderers->ConfigureCompressor(configuration);
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkPVRenderView::SetAdaptiveCompressorConfig(const char* configuration)
+{
+  const std::string config = configuration ? configuration : "";
+  if (this->AdaptiveCompressorConfig != config)
+  {
+    this->AdaptiveCompressorConfig = config;
+    this->SynchronizedRenderers->ConfigureCompressor(
+      config.empty() ? this->CompressorConfig.c_str() : config.c_str());
+    this->Modified();
+  }
+}
+
+//----------------------------------------------------------------------------
+double vtkPVRenderView::GetLastImageDeliveryTime()
+{
+  auto cssync = vtkPVClientServerSynchronizedRenderers::SafeDownCast(
+    this->SynchronizedRenderers->GetCSSynchronizer());
+  return cssync ? cssync->GetLastImageDeliveryTime() : 0.0;
+}
+
+//----------------------------------------------------------------------------
+bool vtkPVRenderView::GetRemoteRenderInFlight()
+{
+  auto cssync = vtkPVClientServerSynchronizedRenderers::SafeDownCast(
+    this->SynchronizedRenderers->GetCSSynchronizer());
+  return this->AsynchronousInteractiveRendering && cssync && cssync->HasImageInFlight();
 }
 
 //----------------------------------------------------------------------------
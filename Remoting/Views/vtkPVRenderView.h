@@ -286,6 +286,31 @@ public:
    */
   void ConfigureCompressor(const char* configuration);
 
+  ///@{
+  /**
+   * Get/Set the settings chosen by vtkPVAdaptiveRenderController for
+   * interactive renders. When set, they are used instead of
+   * InteractiveRenderImageReductionFactor, LODResolution and the configuration
+   * passed to ConfigureCompressor(). The LOD geometry is still generated using
+   * LODResolution, AdaptiveLODResolution only selects a level of it to render.
+   * A factor of 0, a negative resolution or an empty configuration (defaults)
+   * use the regular settings.
+   * \note CallOnAllProcesses
+   */
+  vtkSetClampMacro(AdaptiveImageReductionFactor, int, 0, 20);
+  vtkGetMacro(AdaptiveImageReductionFactor, int);
+  vtkSetMacro(AdaptiveLODResolution, double);
+  vtkGetMacro(AdaptiveLODResolution, double);
+  void SetAdaptiveCompressorConfig(const char* configuration);
+  ///@}
+
+  /**
+   * Returns the time, in seconds, spent receiving and decompressing the image
+   * of the last remote render on the client. See
+   * vtkPVClientServerSynchronizedRenderers::GetLastImageDeliveryTime().
+   */
+  double GetLastImageDeliveryTime();
+
   /**
    * Resets the clipping range. One does not need to call this directly ever. It
    * is called periodically by the vtkRenderer to reset the camera range.
@@ -313,7 +338,10 @@ public:
   static vtkInformationIntegerKey* USE_LOD();
 
   /**
-   * Indicates the LOD resolution in REQUEST_UPDATE_LOD() pass.
+   * Indicates the LOD resolution in REQUEST_UPDATE_LOD() pass. In
+   * REQUEST_RENDER() pass, it is only set when rendering LOD geometry with a
+   * resolution coarser than the one it was generated with, see
+   * SetAdaptiveLODResolution().
    */
   static vtkInformationDoubleKey* LOD_RESOLUTION();
 
@@ -410,6 +438,29 @@ public:
   vtkGetMacro(UseInteractiveRenderingForScreenshots, bool);
   ///@}
 
+  ///@{
+  /**
+   * Set or get whether interactive renders done remotely are asynchronous,
+   * i.e. whether the client displays the image of the previous interactive
+   * render while the server renders the current one instead of waiting for
+   * it. Interactive renders requested before that image arrives are dropped.
+   * This is only used on the client in client-server mode. Default is false.
+   * See vtkPVClientServerSynchronizedRenderers::SetAsynchronousRendering().
+   */
+  vtkSetMacro(AsynchronousInteractiveRendering, bool);
+  vtkBooleanMacro(AsynchronousInteractiveRendering, bool);
+  vtkGetMacro(AsynchronousInteractiveRendering, bool);
+  ///@}
+
+  /**
+   * Returns true on the client when interactive renders are asynchronous and
+   * the image of a previous one has not arrived yet, i.e. when the server may
+   * still be rendering it. vtkSMRenderViewProxy then drops the interactive
+   * renders, so that the server does not render superseded cameras. This does
+   * not block.
+   */
+  bool GetRemoteRenderInFlight();
+
   ///@{
   /**
    * Returns if remote-rendering is possible on the current group of processes.
@@ -1198,6 +1249,13 @@ protected:
    */
   virtual bool PrepareSelect(int fieldAssociation, const char* array = nullptr);
 
+  /**
+   * Returns true if any of the processes involved in rendering needs to render
+   * to capture the selection buffers, see
+   * vtkPVHardwareSelector::NeedToRenderForSelection().
+   */
+  bool NeedToRenderForSelection();
+
   /**
    * Post process after selection.
    */
@@ -1274,6 +1332,7 @@ protected:
   vtkBoundingBox GeometryBounds;
 
   bool UseInteractiveRenderingForScreenshots;
+  bool AsynchronousInteractiveRendering = false;
   bool NeedsOrderedCompositing;
   bool RenderEmptyImages;
 
@@ -1292,6 +1351,11 @@ protected:
   double LODResolution;
   bool UseLightKit;
 
+  int AdaptiveImageReductionFactor = 0;
+  double AdaptiveLODResolution = -1.0;
+  std::string AdaptiveCompressorConfig;
+  std::string CompressorConfig;
+
   bool UsedLODForLastRender;
   bool UseLODForInteractiveRender;
   bool UseOutlineForLODRendering;
@@ -18,9 +18,11 @@
 #include "vtkMultiProcessController.h"
 #include "vtkNew.h"
 #include "vtkObjectFactory.h"
+#include "vtkPVAdaptiveRenderController.h"
 #include "vtkPVArrayInformation.h"
 #include "vtkPVDataInformation.h"
 #include "vtkPVEncodeSelectionForServer.h"
+#include "vtkPVLogger.h"
 #include "vtkPVRenderView.h"
 #include "vtkPVRenderViewSettings.h"
 #include "vtkPVRenderingCapabilitiesInformation.h"
@@ -51,10 +53,12 @@
 #include "vtkSelection.h"
 #include "vtkSelectionNode.h"
 #include "vtkSmartPointer.h"
+#include "vtkTimerLog.h"
 #include "vtkTransform.h"
 
 #include <cassert>
 #include <cmath>
+#include <string>
 
 namespace
 {
@@ -267,6 +271,7 @@ vtkTypeUInt32 vtkSMRenderViewProxy::PreRender(bool interactive)
 
   vtkPVRenderView* rv = vtkPVRenderView::SafeDownCast(this->GetClientSideObject());
   assert(rv != nullptr);
+  this->UpdateAdaptiveRendering(interactive);
   if (interactive && rv->GetUseLODForInteractiveRender())
   {
     // for interactive renders, we need to determine if we are going to use LOD.
@@ -280,6 +285,14 @@ vtkTypeUInt32 vtkSMRenderViewProxy::PreRender(bool interactive)
 //-----------------------------------------------------------------------------
 void vtkSMRenderViewProxy::PostRender(bool interactive)
 {
+  if (interactive && this->InAdaptiveInteraction)
+  {
+    vtkPVRenderView* rv = vtkPVRenderView::SafeDownCast(this->GetClientSideObject());
+    const double frameTime = vtkTimerLog::GetUniversalTime() - this->InteractiveRenderStartTime;
+    this->AdaptiveRenderController->AddFrame(frameTime,
+      rv->GetUseDistributedRenderingForLODRender() ? rv->GetLastImageDeliveryTime() : 0.0);
+  }
+
   vtkSMProxy* cameraProxy = this->GetSubProxy("ActiveCamera");
   cameraProxy->UpdatePropertyInformation();
   this->SynchronizeCameraProperties();
@@ -292,6 +305,68 @@ void vtkSMRenderViewProxy::PostRender(bool interactive)
   }
 }
 
+//-----------------------------------------------------------------------------
+void vtkSMRenderViewProxy::UpdateAdaptiveRendering(bool interactive)
+{
+  const bool enabled = this->ObjectsCreated && this->GetProperty("AdaptiveInteractiveRendering") &&
+    vtkSMPropertyHelper(this, "AdaptiveInteractiveRendering").GetAsInt() != 0;
+  if (!enabled && !this->AdaptiveSettingsApplied)
+  {
+    this->InAdaptiveInteraction = false;
+    return;
+  }
+
+  // The settings chosen by the controller are pushed through the Adaptive*
+  // properties of the view, which leaves the settings chosen by the user as
+  // they are. Only the properties that changed are pushed.
+  auto applySettings = [this](int factor, double resolution, const std::string& configuration) {
+    this->UpdatingAdaptiveSettings = true;
+    vtkSMPropertyHelper(this, "AdaptiveImageReductionFactor").Set(factor);
+    vtkSMPropertyHelper(this, "AdaptiveLODResolution").Set(resolution);
+    vtkSMPropertyHelper(this, "AdaptiveCompressorConfig").Set(configuration.c_str());
+    bool pushed = this->UpdateProperty("AdaptiveImageReductionFactor");
+    pushed = this->UpdateProperty("AdaptiveLODResolution") || pushed;
+    pushed = this->UpdateProperty("AdaptiveCompressorConfig") || pushed;
+    this->UpdatingAdaptiveSettings = false;
+    vtkVLogIfF(PARAVIEW_LOG_RENDERING_VERBOSITY(), pushed,
+      "%s: apply adaptive rendering settings (%d, %g, '%s')", this->GetLogNameOrDefault(), factor,
+      resolution, configuration.c_str());
+  };
+
+  vtkPVAdaptiveRenderController* controller = this->AdaptiveRenderController;
+  if (!enabled)
+  {
+    // use the values set by the user again.
+    applySettings(0, -1.0, std::string());
+    this->AdaptiveSettingsApplied = false;
+    this->InAdaptiveInteraction = false;
+    controller->Reset();
+  }
+  else if (!interactive)
+  {
+    // an interaction ends with a still render.
+    this->InAdaptiveInteraction = false;
+  }
+  else
+  {
+    vtkPVRenderView* rv = vtkPVRenderView::SafeDownCast(this->GetClientSideObject());
+    controller->SetTargetFrameRate(
+      vtkSMPropertyHelper(this, "TargetInteractiveFrameRate").GetAsDouble());
+    if (!this->InAdaptiveInteraction)
+    {
+      const char* compressorConfig = vtkSMPropertyHelper(this, "CompressorConfig").GetAsString();
+      controller->StartInteraction(vtkSMPropertyHelper(this, "ImageReductionFactor").GetAsInt(),
+        vtkSMPropertyHelper(this, "LODResolution").GetAsDouble(),
+        compressorConfig ? compressorConfig : "", rv->GetUseDistributedRenderingForLODRender());
+      this->InAdaptiveInteraction = true;
+    }
+    this->AdaptiveSettingsApplied = true;
+    applySettings(controller->GetImageReductionFactor(), controller->GetLODResolution(),
+      controller->GetCompressorConfiguration());
+    this->InteractiveRenderStartTime = vtkTimerLog::GetUniversalTime();
+  }
+}
+
 //-----------------------------------------------------------------------------
 void vtkSMRenderViewProxy::SynchronizeCameraProperties()
 {
@@ -844,6 +919,12 @@ void vtkSMRenderViewProxy::ResetCamera(double bounds[6], bool closest, const dou
 //-----------------------------------------------------------------------------
 void vtkSMRenderViewProxy::MarkDirty(vtkSMProxy* modifiedProxy)
 {
+  // the settings chosen by the adaptive controller only affect rendering.
+  if (this->UpdatingAdaptiveSettings)
+  {
+    return;
+  }
+
   vtkSMProxy* cameraProxy = this->GetSubProxy("ActiveCamera");
 
   // if modified proxy is the camera, we must clear the cache even if we're
@@ -1441,12 +1522,34 @@ bool vtkSMRenderViewProxy::SelectPolygonInternal(vtkIntArray* polygonPts,
     stream, selectedRepresentations, selectionSources, multiple_selections, modifier, selectBlocks);
 }
 
+//----------------------------------------------------------------------------
+void vtkSMRenderViewProxy::InteractiveRender()
+{
+  vtkPVRenderView* view = vtkPVRenderView::SafeDownCast(this->GetClientSideObject());
+  if (this->ObjectsCreated && view &&
+    (view->GetInteractiveRenderProcesses() & vtkPVSession::RENDER_SERVER) != 0 &&
+    view->GetRemoteRenderInFlight())
+  {
+    // the server is still rendering a previous frame, this one is superseded
+    // by the next interactive render.
+    vtkVLogF(PARAVIEW_LOG_RENDERING_VERBOSITY(), "%s: drop interactive render",
+      this->GetLogNameOrDefault());
+    return;
+  }
+  this->Superclass::InteractiveRender();
+}
+
 //----------------------------------------------------------------------------
 void vtkSMRenderViewProxy::RenderForImageCapture()
 {
   if (vtkSMPropertyHelper(this, "UseInteractiveRenderingForScreenshots", /*quiet=*/true).GetAsInt())
   {
+    // the captured image must be the one of this render, not the previous one.
+    vtkPVRenderView* view = vtkPVRenderView::SafeDownCast(this->GetClientSideObject());
+    const bool async = view->GetAsynchronousInteractiveRendering();
+    view->SetAsynchronousInteractiveRendering(false);
     this->InteractiveRender();
+    view->SetAsynchronousInteractiveRendering(async);
   }
   else
   {
@@ -20,6 +20,7 @@ class vtkCamera;
 class vtkCollection;
 class vtkFloatArray;
 class vtkIntArray;
+class vtkPVAdaptiveRenderController;
 class vtkRenderer;
 class vtkRenderWindow;
 class vtkSMViewProxyInteractorHelper;
@@ -268,6 +269,14 @@ public:
    */
   bool ClearSelectionCache(bool force = false);
 
+  /**
+   * Overridden to drop the interactive render when
+   * "AsynchronousInteractiveRendering" is enabled and the server has not
+   * delivered the image of a previous one yet. The last image stays displayed
+   * and the server only renders the camera of the next render instead.
+   */
+  void InteractiveRender() override;
+
 protected:
   vtkSMRenderViewProxy();
   ~vtkSMRenderViewProxy() override;
@@ -283,6 +292,14 @@ protected:
    */
   void UpdateLOD();
 
+  /**
+   * Called before each render to apply the interactive rendering settings
+   * chosen by the vtkPVAdaptiveRenderController when
+   * "AdaptiveInteractiveRendering" is enabled, and to restore the settings
+   * chosen by the user otherwise.
+   */
+  void UpdateAdaptiveRendering(bool interactive);
+
   /**
    * Overridden to ensure that we clean up the selection cache on the server
    * side.
@@ -326,6 +343,12 @@ protected:
 
   bool NeedsUpdateLOD;
 
+  vtkNew<vtkPVAdaptiveRenderController> AdaptiveRenderController;
+  bool InAdaptiveInteraction = false;
+  bool AdaptiveSettingsApplied = false;
+  bool UpdatingAdaptiveSettings = false;
+  double InteractiveRenderStartTime = 0.0;
+
 private:
   vtkSMRenderViewProxy(const vtkSMRenderViewProxy&) = delete;
   void operator=(const vtkSMRenderViewProxy&) = delete;
@@ -54,6 +54,10 @@ vtkSMRepresentedArrayListDomain::vtkSMRepresentedArrayListDomain()
   // may need to be reconsidered.
   this->PickFirstAvailableArrayByDefault = false;
 
+  // The arrays also depend on the representation and the settings, which are
+  // not tracked by vtkSMDomain::GetInputsMTime().
+  this->CacheUpdates = false;
+
   // Set up observer on vtkPVRepresentedArrayListSettings so that the domain
   // updates whenever the settings are changed.
   vtkSMRepresentedArrayListDomainUpdateCommand* observer =
@@ -18,14 +18,57 @@
 
 #include "vtk_jsoncpp.h"
 
+#include <algorithm>
 #include <cassert>
+#include <cctype>
+#include <cstring>
 #include <list>
 #include <memory>
 #include <sstream>
+#include <unordered_map>
 #include <unordered_set>
 
 vtkSmartPointer<vtkSMTransferFunctionPresets> vtkSMTransferFunctionPresets::Instance;
 
+namespace
+{
+// Returns the position right after the JSON string starting at `begin`, which
+// must point to the opening quote.
+const char* vtkSkipJSONString(const char* begin, const char* end)
+{
+  for (const char* iter = begin + 1; iter < end; ++iter)
+  {
+    if (*iter == '\\')
+    {
+      ++iter;
+    }
+    else if (*iter == '"')
+    {
+      return iter + 1;
+    }
+  }
+  return end;
+}
+
+// Skips the spaces and the colon that follow a member name.
+const char* vtkSkipToJSONValue(const char* begin, const char* end)
+{
+  while (begin < end && (isspace(static_cast<unsigned char>(*begin)) || *begin == ':'))
+  {
+    ++begin;
+  }
+  return begin;
+}
+
+bool vtkParseJSON(const char* begin, const char* end, Json::Value& value, std::string& errors)
+{
+  Json::CharReaderBuilder builder;
+  builder["collectComments"] = false;
+  std::unique_ptr<Json::CharReader> reader(builder.newCharReader());
+  return reader->parse(begin, end, &value, &errors);
+}
+}
+
 class vtkSMTransferFunctionPresets::vtkInternals
 {
 public:
@@ -57,41 +100,101 @@ public:
     settings->SetSetting("TransferFunctionPresets.CustomPresets", stream.str());
   }
 
-  void Reload()
+  void Reload() { this->FirstPresetWithName.clear(); }
+
+  unsigned int GetNumberOfPresets()
+  {
+    this->LoadBuiltinPresets();
+    this->LoadCustomPresets();
+    return static_cast<unsigned int>(this->BuiltinPresets.size() + this->CustomPresets.size());
+  }
+
+  unsigned int GetNumberOfBuiltinPresets()
+  {
+    this->LoadBuiltinPresets();
+    return static_cast<unsigned int>(this->BuiltinPresets.size());
+  }
+
+  const Json::Value* GetPreset(unsigned int index)
+  {
+    const unsigned int numBuiltins = this->GetNumberOfBuiltinPresets();
+    if (index < numBuiltins)
+    {
+      return &this->DecodeBuiltinPreset(this->BuiltinPresets[index]);
+    }
+    this->LoadCustomPresets();
+    index -= numBuiltins;
+    return index < this->CustomPresets.size() ? &this->CustomPresets[index] : nullptr;
+  }
+
+  // Builtin presets are answered from the index, without decoding them.
+  std::string GetPresetName(unsigned int index)
+  {
+    const unsigned int numBuiltins = this->GetNumberOfBuiltinPresets();
+    if (index < numBuiltins)
+    {
+      return this->BuiltinPresets[index].Name;
+    }
+    const Json::Value* preset = this->GetPreset(index);
+    return preset ? (*preset)["Name"].asString() : std::string();
+  }
+
+  bool GetPresetHasMember(unsigned int index, const char* member)
   {
-    this->Presets.clear();
-    this->GetPresets();
+    const unsigned int numBuiltins = this->GetNumberOfBuiltinPresets();
+    if (index < numBuiltins)
+    {
+      const auto& members = this->BuiltinPresets[index].Members;
+      return std::find(members.begin(), members.end(), member) != members.end();
+    }
+    const Json::Value* preset = this->GetPreset(index);
+    return preset && !preset->empty() && preset->isMember(member);
   }
 
-  const std::vector<Json::Value>& GetPresets()
+  int GetFirstPresetWithName(const std::string& name)
   {
-    if (this->Presets.empty())
+    if (this->FirstPresetWithName.empty())
     {
-      this->LoadBuiltinPresets();
-      this->LoadCustomPresets();
-      this->Presets.insert(
-        this->Presets.end(), this->BuiltinPresets.begin(), this->BuiltinPresets.end());
-      this->Presets.insert(
-        this->Presets.end(), this->CustomPresets.begin(), this->CustomPresets.end());
+      const unsigned int numPresets = this->GetNumberOfPresets();
+      this->FirstPresetWithName.reserve(numPresets);
+      for (unsigned int cc = 0; cc < numPresets; ++cc)
+      {
+        this->FirstPresetWithName.emplace(this->GetPresetName(cc), cc);
+      }
     }
-    return this->Presets;
+    auto iter = this->FirstPresetWithName.find(name);
+    return iter != this->FirstPresetWithName.end() ? static_cast<int>(iter->second) : -1;
+  }
+
+  std::vector<unsigned int> FindPresets(const char* substring)
+  {
+    const std::string lowerSubstring = vtksys::SystemTools::LowerCase(substring ? substring : "");
+    std::vector<unsigned int> result;
+    const unsigned int numPresets = this->GetNumberOfPresets();
+    for (unsigned int cc = 0; cc < numPresets; ++cc)
+    {
+      if (vtksys::SystemTools::LowerCase(this->GetPresetName(cc)).find(lowerSubstring) !=
+        std::string::npos)
+      {
+        result.push_back(cc);
+      }
+    }
+    return result;
   }
 
   bool RemovePreset(unsigned int index)
   {
-    this->GetPresets();
-    if (index >= static_cast<unsigned int>(this->Presets.size()) ||
-      index < static_cast<unsigned int>(this->BuiltinPresets.size()))
+    const unsigned int numBuiltins = this->GetNumberOfBuiltinPresets();
+    if (index >= this->GetNumberOfPresets() || index < numBuiltins)
     {
       return false;
     }
-    this->Presets.erase(this->Presets.begin() + index);
-    index = (index - static_cast<unsigned int>(this->BuiltinPresets.size()));
+    index = (index - numBuiltins);
 
     assert(this->CustomPresets.size() > index);
     this->CustomPresets.erase(this->CustomPresets.begin() + index);
     this->SaveToSettings();
-    this->Presets.clear();
+    this->Reload();
     return true;
   }
 
@@ -104,36 +207,27 @@ public:
     this->Reload();
   }
 
-  bool IsPresetBuiltin(unsigned int index)
-  {
-    this->LoadBuiltinPresets();
-    return index < static_cast<unsigned int>(this->BuiltinPresets.size());
-  }
+  bool IsPresetBuiltin(unsigned int index) { return index < this->GetNumberOfBuiltinPresets(); }
 
   bool RenamePreset(unsigned int index, const char* newname)
   {
     if (newname && newname[0])
     {
       // Check that the newname is not already used
-      if (std::any_of(
-            this->Presets.begin(), this->Presets.end(), [newname](Json::Value const& preset) {
-              return preset.get("Name", "").asString() == newname;
-            }))
+      if (this->GetFirstPresetWithName(newname) >= 0)
       {
         return false;
       }
 
-      const std::vector<Json::Value>& presets = this->GetPresets();
-      if (index < static_cast<unsigned int>(presets.size()) &&
-        index >= static_cast<unsigned int>(this->BuiltinPresets.size()))
+      const unsigned int numBuiltins = this->GetNumberOfBuiltinPresets();
+      if (index < this->GetNumberOfPresets() && index >= numBuiltins)
       {
-        this->Presets[index]["Name"] = newname;
-
-        index = (index - static_cast<unsigned int>(this->BuiltinPresets.size()));
+        index = (index - numBuiltins);
         assert(this->CustomPresets.size() > index);
 
         this->CustomPresets[index]["Name"] = newname;
         this->SaveToSettings();
+        this->Reload();
         return true;
       }
     }
@@ -157,12 +251,7 @@ public:
       return false;
     }
 
-    std::unordered_set<std::string> presetNames;
-    presetNames.reserve(this->Presets.size());
-    std::transform(this->Presets.begin(), this->Presets.end(),
-      std::inserter(presetNames, presetNames.end()),
-      [](Json::Value const& preset) { return preset.get("Name", Json::Value()).asString(); });
-
+    std::unordered_set<std::string> presetNames = this->GetPresetNames();
     for (Json::Value& preset : root)
     {
       const std::string basename = preset.get("Name", "Preset").asString();
@@ -216,12 +305,7 @@ public:
   // Adds a suffix to basename to make sure the preset name is unique
   std::string FindUniquePresetName(std::string const& basename)
   {
-    std::unordered_set<std::string> presetNames;
-    presetNames.reserve(this->Presets.size());
-    std::transform(this->Presets.begin(), this->Presets.end(),
-      std::inserter(presetNames, presetNames.end()),
-      [](Json::Value const& preset) { return preset.get("Name", Json::Value()).asString(); });
-    return this->FindUniquePresetNameWithinPresets(basename, presetNames);
+    return this->FindUniquePresetNameWithinPresets(basename, this->GetPresetNames());
   }
 
   // Same as FindUniquePresetName, but takes the unordered_set containing all preset names, when the
@@ -251,32 +335,159 @@ public:
   }
 
 private:
-  std::vector<Json::Value> BuiltinPresets;
+  // A builtin preset is only an entry in the index until it is requested: the
+  // JSON it is decoded from stays in BuiltinJSON.
+  struct BuiltinPreset
+  {
+    std::string Name;
+    std::vector<std::string> Members;
+    const char* Begin = nullptr;
+    const char* End = nullptr;
+    std::unique_ptr<Json::Value> Value;
+  };
+
+  std::unique_ptr<char[]> BuiltinJSON;
+  std::vector<BuiltinPreset> BuiltinPresets;
   std::vector<Json::Value> CustomPresets;
-  std::vector<Json::Value> Presets;
+  std::unordered_map<std::string, unsigned int> FirstPresetWithName;
   bool CustomPresetsLoaded;
 
+  std::unordered_set<std::string> GetPresetNames()
+  {
+    const unsigned int numPresets = this->GetNumberOfPresets();
+    std::unordered_set<std::string> presetNames;
+    presetNames.reserve(numPresets);
+    for (unsigned int cc = 0; cc < numPresets; ++cc)
+    {
+      presetNames.insert(this->GetPresetName(cc));
+    }
+    return presetNames;
+  }
+
+  const Json::Value& DecodeBuiltinPreset(BuiltinPreset& preset)
+  {
+    if (!preset.Value)
+    {
+      preset.Value.reset(new Json::Value());
+      std::string formattedErrors;
+      if (!vtkParseJSON(preset.Begin, preset.End, *preset.Value, formattedErrors))
+      {
+        vtkGenericWarningMacro(<< "Failed to parse builtin transfer function preset '"
+                               << preset.Name << "': " << formattedErrors);
+      }
+    }
+    return *preset.Value;
+  }
+
+  // Indexes the builtin presets by scanning the array of objects in
+  // BuiltinJSON for their spans and top-level member names, without decoding
+  // any of them.
+  bool IndexBuiltinPresets()
+  {
+    const char* begin = this->BuiltinJSON.get();
+    const char* end = begin + strlen(begin);
+    int depth = 0;
+    bool expectKey = false;
+    BuiltinPreset current;
+    for (const char* iter = begin; iter < end;)
+    {
+      const char c = *iter;
+      if (c == '"')
+      {
+        const char* stringEnd = vtkSkipJSONString(iter, end);
+        if (stringEnd == end)
+        {
+          return false;
+        }
+        if (depth == 2 && expectKey)
+        {
+          expectKey = false;
+          current.Members.emplace_back(iter + 1, stringEnd - 1);
+          const char* value = vtkSkipToJSONValue(stringEnd, end);
+          if (current.Members.back() == "Name" && value < end && *value == '"')
+          {
+            const char* valueEnd = vtkSkipJSONString(value, end);
+            current.Name.assign(value + 1, valueEnd - 1);
+            stringEnd = valueEnd;
+          }
+        }
+        iter = stringEnd;
+        continue;
+      }
+
+      switch (c)
+      {
+        case '[':
+        case '{':
+          ++depth;
+          if (depth == 2)
+          {
+            if (c != '{')
+            {
+              return false;
+            }
+            current = BuiltinPreset();
+            current.Begin = iter;
+            expectKey = true;
+          }
+          break;
+
+        case ',':
+          expectKey = (depth == 2);
+          break;
+
+        case ']':
+        case '}':
+          if (depth == 2)
+          {
+            current.End = iter + 1;
+            if (current.Name.find('\\') != std::string::npos)
+            {
+              // Escaped names are rare enough to decode the preset for them.
+              current.Name = this->DecodeBuiltinPreset(current)["Name"].asString();
+            }
+            this->BuiltinPresets.push_back(std::move(current));
+          }
+          --depth;
+          break;
+
+        default:
+          break;
+      }
+      ++iter;
+    }
+    return depth == 0;
+  }
+
   void LoadBuiltinPresets()
   {
-    if (this->BuiltinPresets.empty() == false)
+    if (this->BuiltinJSON)
     {
       return;
     }
-    char* rawJSON = vtkSMTransferFunctionPresetsColorMapsJSON();
-    Json::CharReaderBuilder builder;
-    builder["collectComments"] = false;
-    std::unique_ptr<Json::CharReader> reader(builder.newCharReader());
+    this->BuiltinJSON.reset(vtkSMTransferFunctionPresetsColorMapsJSON());
+    if (this->IndexBuiltinPresets())
+    {
+      return;
+    }
+
+    // Fall back to decoding everything if the index could not be built.
+    this->BuiltinPresets.clear();
+    const char* rawJSON = this->BuiltinJSON.get();
     std::string formattedErrors;
     Json::Value value;
-    if (!reader->parse(rawJSON, rawJSON + strlen(rawJSON), &value, &formattedErrors))
+    if (!vtkParseJSON(rawJSON, rawJSON + strlen(rawJSON), value, formattedErrors))
     {
       vtkGenericWarningMacro(<< "Failed to parse builtin transfer function presets: "
                              << formattedErrors);
     }
-    delete[] rawJSON;
     for (auto const& preset : value)
     {
-      this->BuiltinPresets.push_back(preset);
+      BuiltinPreset builtin;
+      builtin.Name = preset.get("Name", "").asString();
+      builtin.Members = preset.isObject() ? preset.getMemberNames() : std::vector<std::string>();
+      builtin.Value.reset(new Json::Value(preset));
+      this->BuiltinPresets.push_back(std::move(builtin));
     }
   }
 
@@ -297,13 +508,9 @@ private:
 
     std::string presetJSON = settings->GetSettingAsString(settingsKey, "");
     const char* input = presetJSON.c_str();
-    Json::CharReaderBuilder builder;
-    builder["collectComments"] = false;
-    std::unique_ptr<Json::CharReader> reader(builder.newCharReader());
     std::string formattedErrors;
     Json::Value value;
-    if (!presetJSON.empty() &&
-      !reader->parse(input, input + strlen(input), &value, &formattedErrors))
+    if (!presetJSON.empty() && !vtkParseJSON(input, input + strlen(input), value, formattedErrors))
     {
       vtkGenericWarningMacro(<< "Failed to parse custom transfer function presets: "
                              << formattedErrors);
@@ -351,17 +558,16 @@ vtkSMTransferFunctionPresets* vtkSMTransferFunctionPresets::GetInstance()
 //----------------------------------------------------------------------------
 std::string vtkSMTransferFunctionPresets::GetPresetAsString(unsigned int index)
 {
-  const std::vector<Json::Value>& presets = this->Internals->GetPresets();
-  return index < static_cast<unsigned int>(presets.size()) ? presets[index].toStyledString()
-                                                           : std::string();
+  const Json::Value* preset = this->Internals->GetPreset(index);
+  return preset ? preset->toStyledString() : std::string();
 }
 
 //----------------------------------------------------------------------------
 const Json::Value& vtkSMTransferFunctionPresets::GetPreset(unsigned int index)
 {
   static Json::Value nullValue;
-  const std::vector<Json::Value>& presets = this->Internals->GetPresets();
-  return index < static_cast<unsigned int>(presets.size()) ? presets[index] : nullValue;
+  const Json::Value* preset = this->Internals->GetPreset(index);
+  return preset ? *preset : nullValue;
 }
 
 //----------------------------------------------------------------------------
@@ -372,20 +578,8 @@ const Json::Value& vtkSMTransferFunctionPresets::GetFirstPresetWithName(const ch
   {
     return nullValue;
   }
-  idx = 0;
-  const std::vector<Json::Value>& presets = this->Internals->GetPresets();
-  for (std::vector<Json::Value>::const_iterator iter = presets.begin(); iter != presets.end();
-       ++iter)
-  {
-    if (iter->get("Name", Json::Value()).asString() == name)
-    {
-      return (*iter);
-    }
-    idx++;
-  }
-
-  idx = -1;
-  return nullValue;
+  idx = this->Internals->GetFirstPresetWithName(name);
+  return idx >= 0 ? this->GetPreset(static_cast<unsigned int>(idx)) : nullValue;
 }
 
 //----------------------------------------------------------------------------
@@ -398,15 +592,19 @@ const Json::Value& vtkSMTransferFunctionPresets::GetFirstPresetWithName(const ch
 //----------------------------------------------------------------------------
 bool vtkSMTransferFunctionPresets::HasPreset(const char* name)
 {
-  return !this->GetFirstPresetWithName(name).isNull();
+  return name != nullptr && this->Internals->GetFirstPresetWithName(name) >= 0;
 }
 
 //----------------------------------------------------------------------------
 std::string vtkSMTransferFunctionPresets::GetPresetName(unsigned int index)
 {
-  const std::vector<Json::Value>& presets = this->Internals->GetPresets();
-  return index < static_cast<unsigned int>(presets.size()) ? presets[index]["Name"].asString()
-                                                           : std::string();
+  return this->Internals->GetPresetName(index);
+}
+
+//----------------------------------------------------------------------------
+std::vector<unsigned int> vtkSMTransferFunctionPresets::FindPresets(const char* substring)
+{
+  return this->Internals->FindPresets(substring);
 }
 
 //----------------------------------------------------------------------------
@@ -490,7 +688,7 @@ bool vtkSMTransferFunctionPresets::RemovePreset(unsigned int index)
 //----------------------------------------------------------------------------
 unsigned int vtkSMTransferFunctionPresets::GetNumberOfPresets()
 {
-  return static_cast<unsigned int>(this->Internals->GetPresets().size());
+  return this->Internals->GetNumberOfPresets();
 }
 
 //----------------------------------------------------------------------------
@@ -499,18 +697,36 @@ bool vtkSMTransferFunctionPresets::GetPresetHasOpacities(const Json::Value& pres
   return (!preset.empty() && preset.isMember("Points"));
 }
 
+//----------------------------------------------------------------------------
+bool vtkSMTransferFunctionPresets::GetPresetHasOpacities(unsigned int index)
+{
+  return this->Internals->GetPresetHasMember(index, "Points");
+}
+
 //----------------------------------------------------------------------------
 bool vtkSMTransferFunctionPresets::GetPresetHasIndexedColors(const Json::Value& preset)
 {
   return (!preset.empty() && preset.isMember("IndexedColors"));
 }
 
+//----------------------------------------------------------------------------
+bool vtkSMTransferFunctionPresets::GetPresetHasIndexedColors(unsigned int index)
+{
+  return this->Internals->GetPresetHasMember(index, "IndexedColors");
+}
+
 //----------------------------------------------------------------------------
 bool vtkSMTransferFunctionPresets::GetPresetHasAnnotations(const Json::Value& preset)
 {
   return (!preset.empty() && preset.isMember("Annotations"));
 }
 
+//----------------------------------------------------------------------------
+bool vtkSMTransferFunctionPresets::GetPresetHasAnnotations(unsigned int index)
+{
+  return this->Internals->GetPresetHasMember(index, "Annotations");
+}
+
 //----------------------------------------------------------------------------
 bool vtkSMTransferFunctionPresets::IsPresetBuiltin(unsigned int index)
 {
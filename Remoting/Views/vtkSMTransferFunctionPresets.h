@@ -13,6 +13,9 @@
  * the `GetInstance()` static method.
  * Public API ensure that presets are loaded, but a reload can be explictly asked (see
  * `ReloadPresets()`).
+ *
+ * Builtin presets are indexed by name on first access and each one is only
+ * decoded when it is requested with `GetPreset()` or `GetPresetAsString()`.
  */
 
 #ifndef vtkSMTransferFunctionPresets_h
@@ -22,6 +25,7 @@
 
 #include "vtkRemotingViewsModule.h" // needed for exports
 #include "vtkSmartPointer.h"        // for ivars
+#include <string>                   // for string
 #include <vector>                   // for vector
 #include <vtk_jsoncpp_fwd.h>        // for forward declarations
 
@@ -99,32 +103,29 @@ public:
    */
   bool HasPreset(const char* name);
 
+  /**
+   * Returns the indices of the presets whose name contains \c substring,
+   * ignoring case. This does not decode the builtin presets.
+   */
+  std::vector<unsigned int> FindPresets(const char* substring);
+
   /**
    * Returns true if the preset has opacities i.e. values for a piecewise function.
    */
   bool GetPresetHasOpacities(const Json::Value& preset);
-  bool GetPresetHasOpacities(unsigned int index)
-  {
-    return this->GetPresetHasOpacities(this->GetPreset(index));
-  }
+  bool GetPresetHasOpacities(unsigned int index);
 
   /**
    * Returns true is the preset has indexed colors.
    */
   bool GetPresetHasIndexedColors(const Json::Value& preset);
-  bool GetPresetHasIndexedColors(unsigned int index)
-  {
-    return this->GetPresetHasIndexedColors(this->GetPreset(index));
-  }
+  bool GetPresetHasIndexedColors(unsigned int index);
 
   /**
    * Returns true is the preset has annotations.
    */
   bool GetPresetHasAnnotations(const Json::Value& preset);
-  bool GetPresetHasAnnotations(unsigned int index)
-  {
-    return this->GetPresetHasAnnotations(this->GetPreset(index));
-  }
+  bool GetPresetHasAnnotations(unsigned int index);
 
   /**
    * Set the Json::Value object for preset 'name' if such a preset was found in the custom presets.
@@ -27,6 +27,7 @@
 #include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
 #include "vtkSmartVolumeMapper.h"
+#include "vtkStaticMeshResampleToImage.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkUnstructuredGrid.h"
 #include "vtkVolumeProperty.h"
@@ -52,6 +53,7 @@ vtkUnstructuredGridVolumeRepresentation::vtkUnstructuredGridVolumeRepresentation
   this->Preprocessor->SetTetrahedraOnly(1);
 
   this->ResampleToImageFilter->SetSamplingDimensions(128, 128, 128);
+  this->StaticMeshResampleToImageFilter->SetSamplingDimensions(128, 128, 128);
 
   this->LODGeometryFilter->SetUseOutline(0);
 
@@ -413,6 +415,7 @@ void vtkUnstructuredGridVolumeRepresentation::RemoveAllBlockSelectors()
 void vtkUnstructuredGridVolumeRepresentation::SetSamplingDimensions(int xdim, int ydim, int zdim)
 {
   this->ResampleToImageFilter->SetSamplingDimensions(xdim, ydim, zdim);
+  this->StaticMeshResampleToImageFilter->SetSamplingDimensions(xdim, ydim, zdim);
 }
 
 //***************************************************************************
@@ -468,12 +471,31 @@ int vtkUnstructuredGridVolumeRepresentation::RequestDataResampleToImage(
   if (inputVector[0]->GetNumberOfInformationObjects() == 1)
   {
     vtkDataObject* input = vtkDataObject::GetData(inputVector[0], 0);
-    this->ResampleToImageFilter->SetInputDataObject(input);
-    this->ResampleToImageFilter->Update();
+    vtkMultiProcessController* controller = vtkMultiProcessController::GetGlobalController();
+    auto grid = vtkUnstructuredGrid::SafeDownCast(input);
+    vtkSmartPointer<vtkImageData> resampleOutput;
+    if (grid && (!controller || controller->GetNumberOfProcesses() <= 1))
+    {
+      // vtkStaticMeshResampleToImage only locates the samples again when the
+      // mesh changes. vtkResampleToImage is still used for distributed or
+      // composite data since the image then needs to be partitioned across
+      // processes.
+      this->ResampleToImageFilter->SetInputDataObject(nullptr);
+      this->StaticMeshResampleToImageFilter->SetInputDataObject(grid);
+      this->StaticMeshResampleToImageFilter->Update();
+      resampleOutput = this->StaticMeshResampleToImageFilter->GetOutput();
+    }
+    else
+    {
+      this->StaticMeshResampleToImageFilter->SetInputDataObject(nullptr);
+      this->StaticMeshResampleToImageFilter->ReleaseCache();
+      this->ResampleToImageFilter->SetInputDataObject(input);
+      this->ResampleToImageFilter->Update();
+      resampleOutput = this->ResampleToImageFilter->GetOutput();
+    }
 
     this->Actor->SetEnableLOD(0);
 
-    auto resampleOutput = this->ResampleToImageFilter->GetOutput();
     vtkSmartPointer<vtkDataSet> ds;
     ds.TakeReference(resampleOutput->NewInstance());
     ds->ShallowCopy(resampleOutput);
@@ -484,7 +506,7 @@ int vtkUnstructuredGridVolumeRepresentation::RequestDataResampleToImage(
 
     volumeMapper->SetInputDataObject(ds);
 
-    vtkImageData* output = vtkImageData::SafeDownCast(resampleOutput);
+    vtkImageData* output = resampleOutput;
     this->OutlineSource->SetBounds(output->GetBounds());
     this->OutlineSource->GetBounds(this->DataBounds);
     this->OutlineSource->Update();
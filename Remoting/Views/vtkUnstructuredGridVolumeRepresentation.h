@@ -8,6 +8,12 @@
  * vtkUnstructuredGridVolumeRepresentation is a representation for volume
  * rendering vtkUnstructuredGrid datasets. It simply renders a translucent
  * surface for LOD i.e. interactive rendering.
+ *
+ * With the "Resample To Image" mapper, an unstructured grid processed by a
+ * single process is resampled using vtkStaticMeshResampleToImage, which only
+ * locates the samples again when the mesh changes, hence new time steps of a
+ * static mesh are only interpolated. Other inputs are resampled using
+ * vtkResampleToImage.
  */
 
 #ifndef vtkUnstructuredGridVolumeRepresentation_h
@@ -26,6 +32,7 @@ class vtkProjectedTetrahedraMapper;
 class vtkPVGeometryFilter;
 class vtkPVLODVolume;
 class vtkResampleToImage;
+class vtkStaticMeshResampleToImage;
 class vtkVolumeProperty;
 class vtkVolumeRepresentationPreprocessor;
 
@@ -128,6 +135,7 @@ protected:
   vtkNew<vtkProjectedTetrahedraMapper> DefaultMapper;
 
   vtkNew<vtkResampleToImage> ResampleToImageFilter;
+  vtkNew<vtkStaticMeshResampleToImage> StaticMeshResampleToImageFilter;
 
   vtkNew<vtkPVGeometryFilter> LODGeometryFilter;
   vtkNew<vtkPolyDataMapper> LODMapper;
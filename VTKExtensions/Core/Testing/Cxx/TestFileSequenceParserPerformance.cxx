@@ -0,0 +1,83 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+
+// Benchmarks grouping a synthetic directory listing of 10^6 entries into file
+// sequences, the way vtkPVFileInformation does it when browsing directories.
+
+#include <vtkFileSequenceParser.h>
+#include <vtkNew.h>
+#include <vtkTimerLog.h>
+
+#include <cstdio>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+int TestFileSequenceParserPerformance(int, char*[])
+{
+  constexpr int numberOfSteps = 199999;
+  const char* patterns[] = { "run_%06d.vtu", "plt%07d", "data.%d.csv", "%05d_mesh.vtk",
+    "case.vtm.%d" };
+  const char* expectedNames[] = { "run_..vtu", "plt..", "data...csv", ".._mesh.vtk", "case.vtm" };
+  constexpr int numberOfPatterns = sizeof(patterns) / sizeof(patterns[0]);
+
+  // 5 sequences of 199999 files and 5 files that are not part of a sequence.
+  std::vector<std::string> listing;
+  listing.reserve(numberOfPatterns * numberOfSteps + 5);
+  char buffer[64];
+  for (int step = 0; step < numberOfSteps; ++step)
+  {
+    for (int cc = 0; cc < numberOfPatterns; ++cc)
+    {
+      snprintf(buffer, sizeof(buffer), patterns[cc], step);
+      listing.emplace_back(buffer);
+    }
+  }
+  for (const char* single : { "README", "notes.txt", "mesh.3dm", "CMakeLists.txt", "a.b" })
+  {
+    listing.emplace_back(single);
+  }
+
+  vtkNew<vtkFileSequenceParser> parser;
+  std::unordered_map<std::string, std::vector<int>> groups;
+  vtkNew<vtkTimerLog> timer;
+  timer->StartTimer();
+  std::string key;
+  size_t ungrouped = 0;
+  for (const auto& fname : listing)
+  {
+    if (parser->ParseFileSequence(fname.c_str()))
+    {
+      key.assign(parser->GetSequenceName());
+      groups[key].push_back(parser->GetSequenceIndex());
+    }
+    else
+    {
+      ++ungrouped;
+    }
+  }
+  timer->StopTimer();
+  cout << "Grouped " << listing.size() << " file names in " << timer->GetElapsedTime() << " s"
+       << endl;
+
+  for (int cc = 0; cc < numberOfPatterns; ++cc)
+  {
+    auto iter = groups.find(expectedNames[cc]);
+    if (iter == groups.end() || iter->second.size() != numberOfSteps)
+    {
+      cerr << "ERROR: sequence '" << expectedNames[cc] << "' was not grouped correctly." << endl;
+      return EXIT_FAILURE;
+    }
+    if (iter->second.back() != numberOfSteps - 1)
+    {
+      cerr << "ERROR: wrong index in sequence '" << expectedNames[cc] << "'." << endl;
+      return EXIT_FAILURE;
+    }
+  }
+  if (ungrouped != 5 || groups.size() != numberOfPatterns)
+  {
+    cerr << "ERROR: unexpected grouping of the files that are not sequences." << endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
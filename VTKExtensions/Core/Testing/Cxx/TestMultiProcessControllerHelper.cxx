@@ -0,0 +1,66 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+#include "vtkMultiProcessControllerHelper.h"
+
+#include "vtkFieldData.h"
+#include "vtkLogger.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkNew.h"
+#include "vtkPolyData.h"
+#include "vtkSmartPointer.h"
+#include "vtkSphereSource.h"
+#include "vtkUnsignedIntArray.h"
+
+#include <cstdlib>
+#include <vector>
+
+namespace
+{
+// Returns the piece delivered by a process owning block `block` out of 2,
+// with the field data shared by the pieces of all the processes.
+vtkSmartPointer<vtkDataObject> CreatePiece(unsigned int block)
+{
+  vtkNew<vtkSphereSource> sphere;
+  sphere->SetCenter(block, 0, 0);
+  sphere->Update();
+
+  auto piece = vtkSmartPointer<vtkMultiBlockDataSet>::New();
+  piece->SetNumberOfBlocks(2);
+  piece->SetBlock(block, sphere->GetOutput());
+
+  vtkNew<vtkUnsignedIntArray> array;
+  array->SetName("FieldArray");
+  array->InsertNextValue(3);
+  array->InsertNextValue(5);
+  piece->GetFieldData()->AddArray(array);
+  return piece;
+}
+}
+
+int TestMultiProcessControllerHelper(int, char*[])
+{
+  std::vector<vtkSmartPointer<vtkDataObject>> pieces{ CreatePiece(0), CreatePiece(1) };
+  vtkNew<vtkMultiBlockDataSet> result;
+  if (!vtkMultiProcessControllerHelper::MergePieces(pieces, result))
+  {
+    vtkLogF(ERROR, "Failed to merge composite pieces.");
+    return EXIT_FAILURE;
+  }
+
+  if (result->GetNumberOfBlocks() != 2 || !vtkPolyData::SafeDownCast(result->GetBlock(0)) ||
+    !vtkPolyData::SafeDownCast(result->GetBlock(1)))
+  {
+    vtkLogF(ERROR, "Blocks of the pieces were not merged.");
+    return EXIT_FAILURE;
+  }
+
+  auto array = vtkUnsignedIntArray::SafeDownCast(result->GetFieldData()->GetArray("FieldArray"));
+  if (!array || array->GetNumberOfValues() != 2 || array->GetValue(0) != 3 ||
+    array->GetValue(1) != 5)
+  {
+    vtkLogF(ERROR, "Field data of the pieces was not kept.");
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -4,111 +4,242 @@
 
 #include "vtkObjectFactory.h"
 
-#include <set>
+#include <cstdlib>
+#include <cstring>
 #include <string>
-#include <vtksys/RegularExpression.hxx>
-#include <vtksys/SystemTools.hxx>
 
-vtkStandardNewMacro(vtkFileSequenceParser);
-//-----------------------------------------------------------------------------
-vtkFileSequenceParser::vtkFileSequenceParser()
-  : // sequence ending with numbers.
-  reg_ex(new vtksys::RegularExpression("^(.*)\\.([0-9.]+)$"))
-  ,
-  // sequence ending with extension.
-  reg_ex2(new vtksys::RegularExpression("^(.*)(\\.|_|-)([0-9.]+)\\.(.*)$"))
-  ,
-  // sequence ending with extension, but with no ". or _" before
-  // the series number.
-  reg_ex3(new vtksys::RegularExpression("^(.*)([a-zA-Z])([0-9.]+)\\.(.*)$"))
-  ,
-  // sequence ending with extension, and starting with series number
-  // followed by ". or _".
-  reg_ex4(new vtksys::RegularExpression("^([0-9.]+)(\\.|_|-)(.*)\\.(.*)$"))
-  ,
-  // sequence ending with extension, and starting with series number,
-  // but not followed by ". or _".
-  reg_ex5(new vtksys::RegularExpression("^([0-9.]+)([a-zA-Z])(.*)\\.(.*)$"))
-
-  ,
-  // fallback: any sequence with a number in the middle (taking the last number
-  // if multiple exist).
-  reg_ex_last(new vtksys::RegularExpression("^(.*[^0-9])([0-9]+)([^0-9]*)$"))
-  , SequenceIndex(-1)
-  , SequenceName(nullptr)
+namespace
+{
+constexpr size_t NPOS = std::string::npos;
+
+inline bool IsDigit(char c)
 {
+  return c >= '0' && c <= '9';
 }
 
-//-----------------------------------------------------------------------------
-vtkFileSequenceParser::~vtkFileSequenceParser()
+// Characters of the indices matched by all but the last pattern.
+inline bool IsIndexChar(char c)
 {
-  delete this->reg_ex;
-  delete this->reg_ex2;
-  delete this->reg_ex3;
-  delete this->reg_ex4;
-  delete this->reg_ex5;
-  delete this->reg_ex_last;
-
-  this->SetSequenceName(nullptr);
+  return IsDigit(c) || c == '.';
 }
 
-//-----------------------------------------------------------------------------
-bool vtkFileSequenceParser::ParseFileSequence(const char* file)
+inline bool IsLetter(char c)
+{
+  return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z');
+}
+
+inline bool IsSeparator(char c)
+{
+  return c == '.' || c == '_' || c == '-';
+}
+
+// Matches `^(.*)\.([0-9.]+)$`. On success, the index is [indexBegin, n).
+bool MatchTrailingIndex(const char* s, size_t n, size_t& indexBegin)
+{
+  // Start of the longest suffix made of index characters.
+  size_t suffix = n;
+  while (suffix > 0 && IsIndexChar(s[suffix - 1]))
+  {
+    --suffix;
+  }
+  // The last dot followed by at least one index character.
+  const size_t first = suffix > 0 ? suffix - 1 : 0;
+  for (size_t i = n >= 2 ? n - 1 : 0; i-- > first;)
+  {
+    if (s[i] == '.')
+    {
+      indexBegin = i + 1;
+      return true;
+    }
+  }
+  return false;
+}
+
+// Matches `^(.*)(<sep>)([0-9.]+)\.(.*)$` where `<sep>` is a character for
+// which `isSeparator` returns true. On success, the separator is at `sep` and
+// the index is [sep + 1, dot).
+template <typename Predicate>
+bool MatchIndexBeforeExtension(
+  const char* s, size_t n, Predicate isSeparator, size_t& sep, size_t& dot)
+{
+  // Scan from the right, the greedy `(.*)` prefers the last separator. While
+  // scanning, `lastDot` is the last dot of the run of index characters that
+  // starts right after the candidate separator.
+  size_t lastDot = NPOS;
+  for (size_t j = n; j-- > 1;)
+  {
+    if (!IsIndexChar(s[j]))
+    {
+      lastDot = NPOS;
+      continue;
+    }
+    if (j + 1 == n || !IsIndexChar(s[j + 1]))
+    {
+      lastDot = NPOS; // new run.
+    }
+    if (lastDot == NPOS && s[j] == '.')
+    {
+      lastDot = j;
+    }
+    if (isSeparator(s[j - 1]) && lastDot != NPOS && lastDot > j)
+    {
+      sep = j - 1;
+      dot = lastDot;
+      return true;
+    }
+  }
+  return false;
+}
+
+// Number of leading index characters.
+size_t LeadingIndexLength(const char* s, size_t n)
 {
-  bool match = false;
-  if (this->reg_ex->find(file))
+  size_t length = 0;
+  while (length < n && IsIndexChar(s[length]))
   {
-    this->SetSequenceName(this->reg_ex->match(1).c_str());
-    this->SequenceIndexString = this->reg_ex->match(2);
-    match = true;
+    ++length;
   }
-  else if (this->reg_ex2->find(file))
+  return length;
+}
+
+size_t LastDot(const char* s, size_t n)
+{
+  for (size_t i = n; i-- > 0;)
   {
-    this->SetSequenceName(std::string(
-      this->reg_ex2->match(1) + this->reg_ex2->match(2) + ".." + this->reg_ex2->match(4))
-                            .c_str());
-    this->SequenceIndexString = this->reg_ex2->match(3);
-    match = true;
+    if (s[i] == '.')
+    {
+      return i;
+    }
   }
-  else if (this->reg_ex3->find(file))
+  return NPOS;
+}
+}
+
+vtkStandardNewMacro(vtkFileSequenceParser);
+//-----------------------------------------------------------------------------
+vtkFileSequenceParser::vtkFileSequenceParser()
+  : SequenceIndex(-1)
+{
+}
+
+//-----------------------------------------------------------------------------
+vtkFileSequenceParser::~vtkFileSequenceParser() = default;
+
+//-----------------------------------------------------------------------------
+bool vtkFileSequenceParser::ParseFileSequence(const char* file)
+{
+  if (!file)
   {
-    this->SetSequenceName(std::string(
-      this->reg_ex3->match(1) + this->reg_ex3->match(2) + ".." + this->reg_ex3->match(4))
-                            .c_str());
-    this->SequenceIndexString = this->reg_ex3->match(3);
-    match = true;
+    return false;
   }
-  else if (this->reg_ex4->find(file))
+
+  const char* s = file;
+  const size_t n = strlen(file);
+  std::string& name = this->SequenceName;
+  std::string& index = this->SequenceIndexString;
+
+  size_t sep = 0, dot = 0;
+  const size_t lastDot = LastDot(s, n);
+  const size_t leadingIndex = LeadingIndexLength(s, n);
+  bool match = true;
+
+  // sequence ending with numbers: `^(.*)\.([0-9.]+)$`
+  if (MatchTrailingIndex(s, n, sep))
   {
-    this->SetSequenceName(std::string(
-      ".." + this->reg_ex4->match(2) + this->reg_ex4->match(3) + "." + this->reg_ex4->match(4))
-                            .c_str());
-    this->SequenceIndexString = this->reg_ex4->match(1);
-    match = true;
+    name.assign(s, sep - 1);
+    index.assign(s + sep, n - sep);
   }
-  else if (this->reg_ex5->find(file))
+  // sequence ending with extension: `^(.*)(\.|_|-)([0-9.]+)\.(.*)$`, or with
+  // no ". or _" before the series number: `^(.*)([a-zA-Z])([0-9.]+)\.(.*)$`
+  else if (MatchIndexBeforeExtension(s, n, IsSeparator, sep, dot) ||
+    MatchIndexBeforeExtension(s, n, IsLetter, sep, dot))
   {
-    this->SetSequenceName(std::string(
-      ".." + this->reg_ex5->match(2) + this->reg_ex5->match(3) + "." + this->reg_ex5->match(4))
-                            .c_str());
-    this->SequenceIndexString = this->reg_ex5->match(1);
-    match = true;
+    name.assign(s, sep + 1);
+    name.append("..");
+    name.append(s + dot + 1, n - dot - 1);
+    index.assign(s + sep + 1, dot - sep - 1);
   }
   else
   {
-    std::string fname_wo_ext = vtksys::SystemTools::GetFilenameWithoutExtension(file);
-    std::string ext = vtksys::SystemTools::GetFilenameExtension(file);
-    if (this->reg_ex_last->find(fname_wo_ext))
+    // sequence ending with extension, and starting with series number followed
+    // by ". or _": `^([0-9.]+)(\.|_|-)(.*)\.(.*)$`. The greedy index prefers the
+    // last separator, only dots can be followed by more index characters.
+    sep = NPOS;
+    if (leadingIndex > 0 && lastDot != NPOS)
+    {
+      if (leadingIndex < n && (s[leadingIndex] == '_' || s[leadingIndex] == '-') &&
+        lastDot > leadingIndex)
+      {
+        sep = leadingIndex;
+      }
+      for (size_t k = leadingIndex; sep == NPOS && k-- > 1;)
+      {
+        if (s[k] == '.' && lastDot > k)
+        {
+          sep = k;
+        }
+      }
+      // starting with series number, but not followed by ". or _":
+      // `^([0-9.]+)([a-zA-Z])(.*)\.(.*)$`
+      if (sep == NPOS && leadingIndex < n && IsLetter(s[leadingIndex]) && lastDot > leadingIndex)
+      {
+        sep = leadingIndex;
+      }
+    }
+    if (sep != NPOS)
     {
-      this->SetSequenceName(
-        (this->reg_ex_last->match(1) + ".." + this->reg_ex_last->match(3) + ext).c_str());
-      this->SequenceIndexString = this->reg_ex_last->match(2);
-      match = true;
+      name.assign("..");
+      name.append(s + sep, lastDot - sep);
+      name.append(".");
+      name.append(s + lastDot + 1, n - lastDot - 1);
+      index.assign(s, sep);
+    }
+    else
+    {
+      // fallback: any sequence with a number in the middle (taking the last
+      // number if multiple exist) of the file name without extensions:
+      // `^(.*[^0-9])([0-9]+)([^0-9]*)$`
+#if defined(_WIN32)
+      const char* slash = strpbrk(s, "/\\");
+      for (const char* next = slash; next; next = strpbrk(next + 1, "/\\"))
+      {
+        slash = next;
+      }
+#else
+      const char* slash = strrchr(s, '/');
+#endif
+      const char* base = slash ? slash + 1 : s;
+      const char* extension = strchr(base, '.');
+      const size_t baseLength = extension ? extension - base : strlen(base);
+
+      size_t suffix = baseLength;
+      while (suffix > 0 && !IsDigit(base[suffix - 1]))
+      {
+        --suffix;
+      }
+      size_t number = suffix;
+      while (number > 0 && IsDigit(base[number - 1]))
+      {
+        --number;
+      }
+      match = number > 0 && number < suffix;
+      if (match)
+      {
+        name.assign(base, number);
+        name.append("..");
+        name.append(base + suffix, baseLength - suffix);
+        if (extension)
+        {
+          name.append(extension);
+        }
+        index.assign(base + number, suffix - number);
+      }
     }
   }
+
   if (match)
   {
-    this->SequenceIndex = atoi(this->SequenceIndexString.c_str());
+    this->SequenceIndex = atoi(index.c_str());
   }
   return match;
 }
@@ -117,4 +248,6 @@ bool vtkFileSequenceParser::ParseFileSequence(const char* file)
 void vtkFileSequenceParser::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
+  os << indent << "SequenceName: " << this->SequenceName << endl;
+  os << indent << "SequenceIndex: " << this->SequenceIndex << endl;
 }
@@ -9,7 +9,10 @@
  * extract the base portion of the file name that is common to all the files
  * in the sequence. It will also provide the current sequence index of the
  * provided file name.
- * by several vtkPVUpdateSuppressor objects.
+ *
+ * The file name is matched in a single pass against the patterns listed in
+ * ParseFileSequence(), without allocating memory once the parser has been
+ * used, so that a parser can be reused on very large directory listings.
  */
 
 #ifndef vtkFileSequenceParser_h
@@ -20,11 +23,6 @@
 
 #include <string> // for std::string
 
-namespace vtksys
-{
-class RegularExpression;
-}
-
 class VTKPVVTKEXTENSIONSCORE_EXPORT vtkFileSequenceParser : public vtkObject
 {
 public:
@@ -36,6 +34,19 @@ public:
    * Extract base file name sequence from the file.
    * Returns true if a sequence is detected and
    * sets SequenceName and SequenceIndex.
+   *
+   * The following patterns are tried in order, the first one matching wins
+   * (`..` in the sequence name stands for the sequence index):
+   * \li `<name>.<index>`, e.g. `foo.csv.1` gives `foo.csv`,
+   * \li `<name><. or _ or -><index>.<ext>`, e.g. `foo_1.csv` gives `foo_..csv`,
+   * \li `<name><letter><index>.<ext>`, e.g. `foo1.csv` gives `foo..csv`,
+   * \li `<index><. or _ or -><name>.<ext>`, e.g. `1_foo.csv` gives `.._foo.csv`,
+   * \li `<index><letter><name>.<ext>`, e.g. `1foo.csv` gives `..foo.csv`,
+   * \li the last number of the file name without extensions, e.g.
+   *     `Project_01_solution.cgns` gives `Project_.._solution.cgns`.
+   *
+   * Indices are made of digits and dots, except for the last pattern.
+   * Names are matched greedily, i.e. the last possible index is used.
    */
   bool ParseFileSequence(const char* file);
 
@@ -43,7 +54,7 @@ public:
    * Getter to use to get the sequence name after
    * calling ParseFileSequence
    */
-  vtkGetStringMacro(SequenceName);
+  const char* GetSequenceName() const { return this->SequenceName.c_str(); }
 
   /**
    * Getter to use to get the sequence index after
@@ -62,18 +73,8 @@ protected:
   vtkFileSequenceParser();
   ~vtkFileSequenceParser() override;
 
-  vtksys::RegularExpression* reg_ex;
-  vtksys::RegularExpression* reg_ex2;
-  vtksys::RegularExpression* reg_ex3;
-  vtksys::RegularExpression* reg_ex4;
-  vtksys::RegularExpression* reg_ex5;
-  vtksys::RegularExpression* reg_ex_last;
-
-  // Used internal so char * allocations are done automatically.
-  vtkSetStringMacro(SequenceName);
-
   int SequenceIndex;
-  char* SequenceName;
+  std::string SequenceName;
   std::string SequenceIndexString;
 
 private:
@@ -6,6 +6,7 @@
 #include "vtkAppendFilter.h"
 #include "vtkAppendPolyData.h"
 #include "vtkCompositeDataSet.h"
+#include "vtkFieldData.h"
 #include "vtkGraph.h"
 #include "vtkImageAppend.h"
 #include "vtkImageData.h"
@@ -186,6 +187,13 @@ bool vtkMultiProcessControllerHelper::MergePieces(
     result->ShallowCopy(appender->GetOutputDataObject(0));
   }
   appender->Delete();
+
+  if (vtkCompositeDataSet::SafeDownCast(result))
+  {
+    // vtkAppendCompositeDataLeaves only appends the field data of the leaves,
+    // keep the field data of the composite dataset from the first piece.
+    result->GetFieldData()->ShallowCopy(pieces[0]->GetFieldData());
+  }
   return true;
 }
 
@@ -41,7 +41,8 @@ public:
    * handle all data types, and hence not meant for non-paraview specific use.
    * Returns a new instance of data object containing the merged result on
    * success, else returns nullptr. The caller is expected to release the memory
-   * from the returned data-object.
+   * from the returned data-object. The field data of merged composite datasets
+   * is the one of the first piece.
    */
   static vtkDataObject* MergePieces(vtkDataObject** pieces, unsigned int num_pieces);
 
@@ -60,6 +60,13 @@ public:
    */
   virtual bool Merge(vtkUndoElement* vtkNotUsed(new_element)) { return false; }
 
+  /**
+   * Returns an estimate of the memory used by this element, in bytes. It is
+   * used by vtkUndoStack to honor its MaximumMemorySize.
+   * Default implementation returns 0 i.e. unknown.
+   */
+  virtual vtkTypeUInt64 GetMemorySize() { return 0; }
+
   // Set the working context if run inside a UndoSet context, so object
   // that are cross referenced can leave long enough to be associated
   // to another object. Otherwise the undo of a Delete will create the object
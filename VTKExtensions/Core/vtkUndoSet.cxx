@@ -69,6 +69,18 @@ int vtkUndoSet::GetNumberOfElements()
   return this->Collection->GetNumberOfItems();
 }
 
+//-----------------------------------------------------------------------------
+vtkTypeUInt64 vtkUndoSet::GetMemorySize()
+{
+  vtkTypeUInt64 size = 0;
+  for (int cc = 0, max = this->GetNumberOfElements(); cc < max; ++cc)
+  {
+    vtkUndoElement* elem = this->GetElement(cc);
+    size += elem ? elem->GetMemorySize() : 0;
+  }
+  return size;
+}
+
 //-----------------------------------------------------------------------------
 int vtkUndoSet::Redo()
 {
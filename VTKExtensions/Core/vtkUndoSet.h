@@ -74,6 +74,12 @@ public:
    */
   int GetNumberOfElements();
 
+  /**
+   * Returns the sum of vtkUndoElement::GetMemorySize() over all elements, in
+   * bytes.
+   */
+  vtkTypeUInt64 GetMemorySize();
+
 protected:
   vtkUndoSet();
   ~vtkUndoSet() override;
@@ -14,6 +14,7 @@ vtkUndoStack::vtkUndoStack()
   this->InUndo = false;
   this->InRedo = false;
   this->StackDepth = 10;
+  this->MaximumMemorySize = 0;
 }
 
 //-----------------------------------------------------------------------------
@@ -43,9 +44,35 @@ void vtkUndoStack::Push(const char* label, vtkUndoSet* changeSet)
     this->InvokeEvent(vtkUndoStack::UndoSetRemovedEvent);
   }
   this->Internal->UndoStack.push_back(vtkUndoStackInternal::Element(label, changeSet));
+
+  if (this->MaximumMemorySize > 0)
+  {
+    vtkTypeUInt64 size = this->GetMemorySize();
+    while (size > this->MaximumMemorySize && this->Internal->UndoStack.size() > 1)
+    {
+      size -= this->Internal->UndoStack.front().MemorySize;
+      this->Internal->UndoStack.erase(this->Internal->UndoStack.begin());
+      this->InvokeEvent(vtkUndoStack::UndoSetRemovedEvent);
+    }
+  }
   this->Modified();
 }
 
+//-----------------------------------------------------------------------------
+vtkTypeUInt64 vtkUndoStack::GetMemorySize()
+{
+  vtkTypeUInt64 size = 0;
+  for (const auto& elem : this->Internal->UndoStack)
+  {
+    size += elem.MemorySize;
+  }
+  for (const auto& elem : this->Internal->RedoStack)
+  {
+    size += elem.MemorySize;
+  }
+  return size;
+}
+
 //-----------------------------------------------------------------------------
 unsigned int vtkUndoStack::GetNumberOfUndoSets()
 {
@@ -169,4 +196,5 @@ void vtkUndoStack::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "InUndo: " << this->InUndo << endl;
   os << indent << "InRedo: " << this->InRedo << endl;
   os << indent << "StackDepth: " << this->StackDepth << endl;
+  os << indent << "MaximumMemorySize: " << this->MaximumMemorySize << endl;
 }
@@ -158,14 +158,31 @@ public:
    */
   vtkSetClampMacro(StackDepth, int, 1, 100);
   vtkGetMacro(StackDepth, int);
+  ///@}
+
+  ///@{
+  /**
+   * Get/set the maximum memory, in bytes, used by the sets on the undo stack,
+   * as reported by vtkUndoSet::GetMemorySize(). When a set is pushed and the
+   * sets exceed this budget, the oldest ones are removed. The set just pushed
+   * is always kept. 0 means no limit, which is the default.
+   */
+  vtkSetMacro(MaximumMemorySize, vtkTypeUInt64);
+  vtkGetMacro(MaximumMemorySize, vtkTypeUInt64);
+  ///@}
+
+  /**
+   * Returns the memory, in bytes, used by the sets on the undo and redo stacks.
+   */
+  vtkTypeUInt64 GetMemorySize();
 
 protected:
   vtkUndoStack();
   ~vtkUndoStack() override;
-  ///@}
 
   vtkUndoStackInternal* Internal;
   int StackDepth;
+  vtkTypeUInt64 MaximumMemorySize;
 
 private:
   vtkUndoStack(const vtkUndoStack&) = delete;
@@ -17,6 +17,7 @@ public:
   {
     std::string Label;
     vtkSmartPointer<vtkUndoSet> UndoSet;
+    vtkTypeUInt64 MemorySize;
     Element(const char* label, vtkUndoSet* set)
     {
       this->Label = label;
@@ -25,6 +26,7 @@ public:
       {
         this->UndoSet->AddElement(set->GetElement(i));
       }
+      this->MemorySize = this->UndoSet->GetMemorySize();
     }
   };
   typedef std::vector<Element> VectorOfElements;
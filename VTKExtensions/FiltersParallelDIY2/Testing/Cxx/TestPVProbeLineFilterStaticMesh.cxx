@@ -0,0 +1,234 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "vtkCellData.h"
+#include "vtkCellType.h"
+#include "vtkCellTypeSource.h"
+#include "vtkDataArray.h"
+#include "vtkDoubleArray.h"
+#include "vtkLogger.h"
+#include "vtkMathUtilities.h"
+#include "vtkNew.h"
+#include "vtkPVProbeLineFilter.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkStringArray.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <cmath>
+#include <string>
+
+namespace
+{
+//----------------------------------------------------------------------------
+void SetupFilter(vtkPVProbeLineFilter* filter, vtkUnstructuredGrid* input, bool staticMesh)
+{
+  filter->SetInputData(input);
+  filter->SetSamplingPattern(2); // SAMPLE_LINE_UNIFORMLY
+  filter->SetLineResolution(50);
+  filter->SetPoint1(0.1, 0.2, 0.3);
+  filter->SetPoint2(3.9, 3.7, 3.5);
+  filter->SetStaticMesh(staticMesh);
+}
+
+//----------------------------------------------------------------------------
+// Replaces the attributes of the input with values depending on the time step.
+void UpdateAttributes(vtkUnstructuredGrid* input, int step)
+{
+  vtkNew<vtkDoubleArray> pointArray;
+  pointArray->SetName("pointField");
+  pointArray->SetNumberOfTuples(input->GetNumberOfPoints());
+  for (vtkIdType ptId = 0; ptId < input->GetNumberOfPoints(); ++ptId)
+  {
+    double pt[3];
+    input->GetPoint(ptId, pt);
+    pointArray->SetValue(ptId, pt[0] + 2.0 * pt[1] + 3.0 * pt[2] + 10.0 * step);
+  }
+  input->GetPointData()->AddArray(pointArray);
+
+  vtkNew<vtkDoubleArray> cellArray;
+  cellArray->SetName("cellField");
+  cellArray->SetNumberOfTuples(input->GetNumberOfCells());
+  for (vtkIdType cellId = 0; cellId < input->GetNumberOfCells(); ++cellId)
+  {
+    cellArray->SetValue(cellId, static_cast<double>(cellId * (step + 1)));
+  }
+  input->GetCellData()->AddArray(cellArray);
+}
+
+//----------------------------------------------------------------------------
+bool CompareOutputs(vtkPolyData* cached, vtkPolyData* reference, const std::string& step)
+{
+  if (cached->GetNumberOfPoints() != reference->GetNumberOfPoints())
+  {
+    vtkLogF(ERROR, "%s: wrong number of samples (%lld != %lld).", step.c_str(),
+      static_cast<long long>(cached->GetNumberOfPoints()),
+      static_cast<long long>(reference->GetNumberOfPoints()));
+    return false;
+  }
+
+  vtkPointData* refPD = reference->GetPointData();
+  if (cached->GetPointData()->GetNumberOfArrays() != refPD->GetNumberOfArrays())
+  {
+    vtkLogF(ERROR, "%s: wrong number of arrays (%d != %d).", step.c_str(),
+      cached->GetPointData()->GetNumberOfArrays(), refPD->GetNumberOfArrays());
+    return false;
+  }
+  for (int arrayIdx = 0; arrayIdx < refPD->GetNumberOfArrays(); ++arrayIdx)
+  {
+    vtkAbstractArray* refAbstractArray = refPD->GetAbstractArray(arrayIdx);
+    vtkAbstractArray* abstractArray =
+      cached->GetPointData()->GetAbstractArray(refAbstractArray->GetName());
+    if (!abstractArray)
+    {
+      vtkLogF(ERROR, "%s: missing array '%s'.", step.c_str(), refAbstractArray->GetName());
+      return false;
+    }
+    vtkDataArray* refArray = vtkDataArray::SafeDownCast(refAbstractArray);
+    if (!refArray)
+    {
+      for (vtkIdType valueId = 0; valueId < refAbstractArray->GetNumberOfValues(); ++valueId)
+      {
+        if (refAbstractArray->GetVariantValue(valueId) != abstractArray->GetVariantValue(valueId))
+        {
+          vtkLogF(ERROR, "%s: array '%s' differs at value %lld.", step.c_str(),
+            refAbstractArray->GetName(), static_cast<long long>(valueId));
+          return false;
+        }
+      }
+      continue;
+    }
+    vtkDataArray* array = cached->GetPointData()->GetArray(refArray->GetName());
+    if (!array || array->GetNumberOfComponents() != refArray->GetNumberOfComponents())
+    {
+      vtkLogF(ERROR, "%s: missing or invalid array '%s'.", step.c_str(), refArray->GetName());
+      return false;
+    }
+    for (vtkIdType tupleId = 0; tupleId < refArray->GetNumberOfTuples(); ++tupleId)
+    {
+      for (int comp = 0; comp < refArray->GetNumberOfComponents(); ++comp)
+      {
+        const double expected = refArray->GetComponent(tupleId, comp);
+        const double value = array->GetComponent(tupleId, comp);
+        if (!(std::isnan(expected) && std::isnan(value)) &&
+          !vtkMathUtilities::FuzzyCompare(expected, value, 1e-6))
+        {
+          vtkLogF(ERROR, "%s: array '%s' differs at sample %lld (%g != %g).", step.c_str(),
+            refArray->GetName(), static_cast<long long>(tupleId), value, expected);
+          return false;
+        }
+      }
+    }
+  }
+  return true;
+}
+
+//----------------------------------------------------------------------------
+bool CheckStep(vtkPVProbeLineFilter* cachedFilter, vtkUnstructuredGrid* input,
+  const std::string& step)
+{
+  cachedFilter->Update();
+
+  vtkNew<vtkPVProbeLineFilter> reference;
+  SetupFilter(reference, input, false);
+  reference->Update();
+
+  return CompareOutputs(vtkPolyData::SafeDownCast(cachedFilter->GetOutput()),
+    vtkPolyData::SafeDownCast(reference->GetOutput()), step);
+}
+}
+
+//----------------------------------------------------------------------------
+int TestPVProbeLineFilterStaticMesh(int, char*[])
+{
+  vtkNew<vtkCellTypeSource> source;
+  source->SetCellType(VTK_HEXAHEDRON);
+  source->SetBlocksDimensions(4, 4, 4);
+  source->Update();
+
+  vtkNew<vtkUnstructuredGrid> input;
+  input->DeepCopy(source->GetOutput());
+  UpdateAttributes(input, 0);
+
+  vtkNew<vtkPVProbeLineFilter> cachedFilter;
+  SetupFilter(cachedFilter, input, true);
+  if (!CheckStep(cachedFilter, input, "initial step"))
+  {
+    return EXIT_FAILURE;
+  }
+
+  // New attributes on the same mesh: the cache is reused.
+  for (int step = 1; step < 3; ++step)
+  {
+    UpdateAttributes(input, step);
+    if (!CheckStep(cachedFilter, input, "static step " + std::to_string(step)))
+    {
+      return EXIT_FAILURE;
+    }
+  }
+
+  // Identical points stored in a new array: results must not change.
+  vtkNew<vtkPoints> points;
+  points->DeepCopy(input->GetPoints());
+  input->SetPoints(points);
+  UpdateAttributes(input, 3);
+  if (!CheckStep(cachedFilter, input, "copied points"))
+  {
+    return EXIT_FAILURE;
+  }
+
+  // Points moved in place: the cache must be rebuilt.
+  for (vtkIdType ptId = 0; ptId < points->GetNumberOfPoints(); ++ptId)
+  {
+    double pt[3];
+    points->GetPoint(ptId, pt);
+    points->SetPoint(ptId, 0.9 * pt[0], pt[1] + 0.1 * pt[2], 1.1 * pt[2]);
+  }
+  points->Modified();
+  UpdateAttributes(input, 4);
+  if (!CheckStep(cachedFilter, input, "moved points"))
+  {
+    return EXIT_FAILURE;
+  }
+
+  // Moved points and a new time step on the moved mesh.
+  UpdateAttributes(input, 5);
+  if (!CheckStep(cachedFilter, input, "static step after move"))
+  {
+    return EXIT_FAILURE;
+  }
+
+  // An array removed from the input must not be kept from the cache.
+  UpdateAttributes(input, 6);
+  input->GetCellData()->RemoveArray("cellField");
+  if (!CheckStep(cachedFilter, input, "removed array"))
+  {
+    return EXIT_FAILURE;
+  }
+
+  // String arrays cannot be interpolated with the cached weights.
+  vtkNew<vtkStringArray> labels;
+  labels->SetName("labels");
+  labels->SetNumberOfValues(input->GetNumberOfPoints());
+  for (vtkIdType ptId = 0; ptId < input->GetNumberOfPoints(); ++ptId)
+  {
+    labels->SetValue(ptId, "point" + std::to_string(ptId));
+  }
+  input->GetPointData()->AddArray(labels);
+  UpdateAttributes(input, 7);
+  if (!CheckStep(cachedFilter, input, "string array"))
+  {
+    return EXIT_FAILURE;
+  }
+
+  // Back to the arrays the cache was built with.
+  input->GetPointData()->RemoveArray("labels");
+  UpdateAttributes(input, 8);
+  if (!CheckStep(cachedFilter, input, "static step after string array"))
+  {
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
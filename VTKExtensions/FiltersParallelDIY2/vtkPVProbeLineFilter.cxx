@@ -3,23 +3,287 @@
 
 #include "vtkPVProbeLineFilter.h"
 
+#include "vtkArrayDispatch.h"
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkDataArrayRange.h"
+#include "vtkDataSet.h"
 #include "vtkDemandDrivenPipeline.h"
+#include "vtkGenericCell.h"
+#include "vtkIdList.h"
+#include "vtkImageData.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkLineSource.h"
+#include "vtkMath.h"
+#include "vtkMatrix3x3.h"
+#include "vtkMultiProcessController.h"
 #include "vtkObjectFactory.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
 #include "vtkProbeLineFilter.h"
+#include "vtkRectilinearGrid.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
+#include "vtkStaticCellLocator.h"
+#include "vtkStructuredGrid.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace
+{
+constexpr const char* VALID_MASK_NAME = "vtkValidPointMask";
+
+//----------------------------------------------------------------------------
+// For each sample, the id of the cell containing it (-1 when the sample is
+// invalid), and the input point ids and weights used to interpolate it, stored
+// contiguously using Offsets.
+struct SampleWeights
+{
+  std::vector<vtkIdType> CellIds;
+  std::vector<vtkIdType> Offsets;
+  std::vector<vtkIdType> PointIds;
+  std::vector<double> Weights;
+};
+
+//----------------------------------------------------------------------------
+// Identifies the mesh of a dataset, i.e. its points and cells but not its
+// attributes. The arrays defining the mesh are compared by MTime when the same
+// arrays are used again, and by content otherwise since readers of transient
+// data with a static mesh often read it again for each time step. Implicit
+// meshes are identified by their parameters.
+class MeshKey
+{
+public:
+  void Set(vtkDataSet* ds)
+  {
+    this->ClassName = ds->GetClassName();
+    std::vector<vtkDataArray*> arrays;
+    MeshKey::Collect(ds, arrays, this->Parameters);
+    this->Arrays.assign(arrays.begin(), arrays.end());
+    this->MTimes.clear();
+    for (vtkDataArray* array : arrays)
+    {
+      this->MTimes.push_back(array ? array->GetMTime() : 0);
+    }
+  }
+
+  void Reset()
+  {
+    this->ClassName.clear();
+    this->Arrays.clear();
+    this->MTimes.clear();
+    this->Parameters.clear();
+  }
+
+  bool Matches(vtkDataSet* ds) const
+  {
+    std::vector<vtkDataArray*> arrays;
+    std::vector<double> parameters;
+    MeshKey::Collect(ds, arrays, parameters);
+    if (this->ClassName != ds->GetClassName() || parameters != this->Parameters ||
+      arrays.size() != this->Arrays.size())
+    {
+      return false;
+    }
+    for (size_t cc = 0; cc < arrays.size(); ++cc)
+    {
+      if (!MeshKey::HasSameValues(this->Arrays[cc], this->MTimes[cc], arrays[cc]))
+      {
+        return false;
+      }
+    }
+    return true;
+  }
+
+private:
+  static void Collect(
+    vtkDataSet* ds, std::vector<vtkDataArray*>& arrays, std::vector<double>& params)
+  {
+    params.clear();
+    params.push_back(static_cast<double>(ds->GetNumberOfPoints()));
+    params.push_back(static_cast<double>(ds->GetNumberOfCells()));
+    if (auto ps = vtkPointSet::SafeDownCast(ds))
+    {
+      arrays.push_back(ps->GetPoints() ? ps->GetPoints()->GetData() : nullptr);
+    }
+    if (auto ug = vtkUnstructuredGrid::SafeDownCast(ds))
+    {
+      vtkCellArray* cells = ug->GetCells();
+      arrays.push_back(cells ? cells->GetConnectivityArray() : nullptr);
+      arrays.push_back(cells ? cells->GetOffsetsArray() : nullptr);
+      arrays.push_back(ug->GetCellTypesArray());
+    }
+    else if (auto pd = vtkPolyData::SafeDownCast(ds))
+    {
+      for (vtkCellArray* cells :
+        { pd->GetVerts(), pd->GetLines(), pd->GetPolys(), pd->GetStrips() })
+      {
+        arrays.push_back(cells ? cells->GetConnectivityArray() : nullptr);
+        arrays.push_back(cells ? cells->GetOffsetsArray() : nullptr);
+      }
+    }
+    else if (auto image = vtkImageData::SafeDownCast(ds))
+    {
+      const int* extent = image->GetExtent();
+      params.insert(params.end(), extent, extent + 6);
+      params.insert(params.end(), image->GetOrigin(), image->GetOrigin() + 3);
+      params.insert(params.end(), image->GetSpacing(), image->GetSpacing() + 3);
+      const double* direction = image->GetDirectionMatrix()->GetData();
+      params.insert(params.end(), direction, direction + 9);
+    }
+    else if (auto rg = vtkRectilinearGrid::SafeDownCast(ds))
+    {
+      const int* extent = rg->GetExtent();
+      params.insert(params.end(), extent, extent + 6);
+      arrays.push_back(rg->GetXCoordinates());
+      arrays.push_back(rg->GetYCoordinates());
+      arrays.push_back(rg->GetZCoordinates());
+    }
+    else if (auto sg = vtkStructuredGrid::SafeDownCast(ds))
+    {
+      const int* extent = sg->GetExtent();
+      params.insert(params.end(), extent, extent + 6);
+    }
+    else if (!vtkPointSet::SafeDownCast(ds))
+    {
+      // unknown implicit mesh, assume it changes whenever the dataset does.
+      params.push_back(static_cast<double>(ds->GetMTime()));
+    }
+  }
+
+  static bool HasSameValues(vtkDataArray* cached, vtkMTimeType cachedMTime, vtkDataArray* array)
+  {
+    if (!cached || !array)
+    {
+      return cached == array;
+    }
+    if (cached == array)
+    {
+      return array->GetMTime() == cachedMTime;
+    }
+    if (cached->GetDataType() != array->GetDataType() ||
+      cached->GetNumberOfValues() != array->GetNumberOfValues() ||
+      !cached->HasStandardMemoryLayout() || !array->HasStandardMemoryLayout())
+    {
+      return false;
+    }
+    const size_t size = static_cast<size_t>(array->GetNumberOfValues()) * array->GetDataTypeSize();
+    return size == 0 ||
+      std::memcmp(cached->GetVoidPointer(0), array->GetVoidPointer(0), size) == 0;
+  }
+
+  std::string ClassName;
+  std::vector<vtkSmartPointer<vtkDataArray>> Arrays;
+  std::vector<vtkMTimeType> MTimes;
+  std::vector<double> Parameters;
+};
+
+//----------------------------------------------------------------------------
+struct InterpolateWorker
+{
+  template <typename InArrayT, typename OutArrayT>
+  void operator()(
+    InArrayT* inArray, OutArrayT* outArray, const SampleWeights& samples, bool fromCells)
+  {
+    using OutValueType = vtk::GetAPIType<OutArrayT>;
+
+    const auto inTuples = vtk::DataArrayTupleRange(inArray);
+    auto outTuples = vtk::DataArrayTupleRange(outArray);
+    const int numComp = inArray->GetNumberOfComponents();
+    const vtkIdType numSamples = static_cast<vtkIdType>(samples.CellIds.size());
+
+    vtkSMPTools::For(0, numSamples, [&](vtkIdType begin, vtkIdType end) {
+      std::vector<double> tuple(numComp);
+      for (vtkIdType sampleId = begin; sampleId < end; ++sampleId)
+      {
+        const vtkIdType cellId = samples.CellIds[sampleId];
+        if (cellId < 0)
+        {
+          // keep the value the prober used for invalid samples.
+          continue;
+        }
+        auto outTuple = outTuples[sampleId];
+        if (fromCells)
+        {
+          const auto inTuple = inTuples[cellId];
+          for (int comp = 0; comp < numComp; ++comp)
+          {
+            outTuple[comp] = static_cast<OutValueType>(inTuple[comp]);
+          }
+          continue;
+        }
+
+        std::fill(tuple.begin(), tuple.end(), 0.0);
+        for (vtkIdType idx = samples.Offsets[sampleId]; idx < samples.Offsets[sampleId + 1];
+             ++idx)
+        {
+          const auto inTuple = inTuples[samples.PointIds[idx]];
+          const double weight = samples.Weights[idx];
+          for (int comp = 0; comp < numComp; ++comp)
+          {
+            tuple[comp] += weight * static_cast<double>(inTuple[comp]);
+          }
+        }
+        for (int comp = 0; comp < numComp; ++comp)
+        {
+          OutValueType value;
+          vtkMath::RoundDoubleToIntegralIfNecessary(tuple[comp], &value);
+          outTuple[comp] = value;
+        }
+      }
+    });
+  }
+};
+}
+
+//----------------------------------------------------------------------------
+struct vtkPVProbeLineFilter::vtkStaticMeshCache
+{
+  // Key of the cached samples.
+  vtkMTimeType FilterMTime = 0;
+  MeshKey Mesh;
+  bool Valid = false;
+  bool Attempted = false;
+
+  // Output of the prober, used as a template for subsequent executions.
+  vtkSmartPointer<vtkPolyData> Output;
+
+  // Location of the samples in the input mesh.
+  SampleWeights Samples;
+
+  // Names of the input point and cell arrays when the samples were located,
+  // and of those the prober sampled, which are interpolated again.
+  std::set<std::string> InputArrays;
+  std::set<std::string> InterpolatedArrays;
+
+  // The locator is kept around and only rebuilt when the mesh changes.
+  vtkNew<vtkStaticCellLocator> Locator;
+  vtkMTimeType LocatorMeshMTime = 0;
+};
 
 vtkStandardNewMacro(vtkPVProbeLineFilter);
 
 //----------------------------------------------------------------------------
 vtkPVProbeLineFilter::vtkPVProbeLineFilter()
+  : Cache(new vtkStaticMeshCache())
 {
   this->LineSource->SetResolution(1);
   this->Prober->SetAggregateAsPolyData(true);
   this->Prober->SetSourceConnection(this->LineSource->GetOutputPort());
 }
 
+//----------------------------------------------------------------------------
+vtkPVProbeLineFilter::~vtkPVProbeLineFilter() = default;
+
 //----------------------------------------------------------------------------
 int vtkPVProbeLineFilter::RequestData(
   vtkInformation*, vtkInformationVector** inputVector, vtkInformationVector* outputVector)
@@ -41,6 +305,13 @@ int vtkPVProbeLineFilter::RequestData(
     return 0;
   }
 
+  vtkDataSet* dsInput = vtkDataSet::SafeDownCast(input);
+  const bool useCache = this->CanUseStaticMeshCache(input);
+  if (useCache && this->Cache->Valid && this->InterpolateFromStaticMeshCache(dsInput, output))
+  {
+    return 1;
+  }
+
   this->LineSource->SetPoint1(this->Point1);
   this->LineSource->SetPoint2(this->Point2);
   this->Prober->SetLineResolution(this->LineResolution);
@@ -56,9 +327,257 @@ int vtkPVProbeLineFilter::RequestData(
   this->Prober->Update();
   output->ShallowCopy(this->Prober->GetOutputDataObject(0));
 
+  if (useCache)
+  {
+    if (!this->Cache->Attempted)
+    {
+      this->BuildStaticMeshCache(dsInput, output);
+    }
+  }
+  else
+  {
+    this->Cache->Valid = false;
+    this->Cache->Attempted = false;
+    this->Cache->Output = nullptr;
+    this->Cache->Mesh.Reset();
+  }
+
   return 1;
 }
 
+//----------------------------------------------------------------------------
+bool vtkPVProbeLineFilter::CanUseStaticMeshCache(vtkDataObject* input)
+{
+  vtkDataSet* dsInput = vtkDataSet::SafeDownCast(input);
+  auto controller = vtkMultiProcessController::GetGlobalController();
+  if (!this->StaticMesh || !dsInput || this->PassCellArrays || this->PassPointArrays ||
+    this->SamplingPattern != vtkProbeLineFilter::SAMPLE_LINE_UNIFORMLY ||
+    (controller && controller->GetNumberOfProcesses() > 1))
+  {
+    return false;
+  }
+
+  vtkStaticMeshCache& cache = *this->Cache;
+  if (cache.FilterMTime != this->GetMTime() || !cache.Mesh.Matches(dsInput))
+  {
+    // the samples must be located again.
+    cache.Valid = false;
+    cache.Attempted = false;
+    cache.Output = nullptr;
+  }
+  return true;
+}
+
+//----------------------------------------------------------------------------
+void vtkPVProbeLineFilter::BuildStaticMeshCache(vtkDataSet* input, vtkPolyData* output)
+{
+  vtkStaticMeshCache& cache = *this->Cache;
+  cache.FilterMTime = this->GetMTime();
+  cache.Mesh.Set(input);
+  cache.Valid = false;
+  cache.Attempted = true;
+  cache.Output = nullptr;
+  const vtkIdType numCells = input->GetNumberOfCells();
+  if (numCells == 0)
+  {
+    return;
+  }
+
+  if (cache.Locator->GetDataSet() != input || cache.LocatorMeshMTime != input->GetMeshMTime())
+  {
+    cache.Locator->SetDataSet(input);
+    cache.Locator->BuildLocator();
+    cache.LocatorMeshMTime = input->GetMeshMTime();
+  }
+
+  const double tolerance = this->ComputeTolerance ? 1e-6 * input->GetLength() : this->Tolerance;
+  const double tol2 = tolerance * tolerance;
+  vtkDataArray* validMask = output->GetPointData()->GetArray(VALID_MASK_NAME);
+
+  // the samples are located concurrently, each one storing up to maxCellSize
+  // point ids and weights, then compacted.
+  const vtkIdType numSamples = output->GetNumberOfPoints();
+  const int maxCellSize = std::max(input->GetMaxCellSize(), 1);
+  std::vector<vtkIdType> cellIds(numSamples, -1);
+  std::vector<int> cellSizes(numSamples, 0);
+  std::vector<vtkIdType> pointIds(numSamples * maxCellSize);
+  std::vector<double> weights(numSamples * maxCellSize);
+  std::atomic<bool> missed(false);
+
+  // make the cell accessors thread safe by calling them once first.
+  {
+    vtkNew<vtkGenericCell> cell;
+    vtkNew<vtkIdList> cellPointIds;
+    input->GetCell(0, cell);
+    input->GetCellPoints(0, cellPointIds);
+  }
+
+  vtkSMPThreadLocalObject<vtkGenericCell> tlCell;
+  vtkSMPThreadLocalObject<vtkIdList> tlCellPointIds;
+  vtkSMPTools::For(0, numSamples, [&](vtkIdType begin, vtkIdType end) {
+    vtkGenericCell* cell = tlCell.Local();
+    vtkIdList* cellPointIds = tlCellPointIds.Local();
+    for (vtkIdType sampleId = begin; sampleId < end && !missed; ++sampleId)
+    {
+      if (validMask && validMask->GetComponent(sampleId, 0) == 0)
+      {
+        continue;
+      }
+      double x[3], pcoords[3];
+      int subId;
+      output->GetPoint(sampleId, x);
+      double* sampleWeights = weights.data() + sampleId * maxCellSize;
+      const vtkIdType cellId =
+        cache.Locator->FindCell(x, tol2, cell, subId, pcoords, sampleWeights);
+      if (cellId < 0)
+      {
+        // the prober found this sample but we did not: do not risk returning
+        // different values than the prober would, and use the prober every time.
+        missed = true;
+        return;
+      }
+      input->GetCellPoints(cellId, cellPointIds);
+      cellIds[sampleId] = cellId;
+      cellSizes[sampleId] = static_cast<int>(cellPointIds->GetNumberOfIds());
+      std::copy_n(cellPointIds->GetPointer(0), cellSizes[sampleId],
+        pointIds.begin() + sampleId * maxCellSize);
+    }
+  });
+  if (missed)
+  {
+    return;
+  }
+
+  SampleWeights& samples = cache.Samples;
+  samples.CellIds = std::move(cellIds);
+  samples.Offsets.assign(1, 0);
+  samples.Offsets.reserve(numSamples + 1);
+  samples.PointIds.clear();
+  samples.Weights.clear();
+  for (vtkIdType sampleId = 0; sampleId < numSamples; ++sampleId)
+  {
+    const vtkIdType first = sampleId * maxCellSize;
+    samples.PointIds.insert(samples.PointIds.end(), pointIds.begin() + first,
+      pointIds.begin() + first + cellSizes[sampleId]);
+    samples.Weights.insert(samples.Weights.end(), weights.begin() + first,
+      weights.begin() + first + cellSizes[sampleId]);
+    samples.Offsets.push_back(static_cast<vtkIdType>(samples.PointIds.size()));
+  }
+
+  cache.InputArrays.clear();
+  cache.InterpolatedArrays.clear();
+  vtkPointData* outPD = output->GetPointData();
+  for (vtkDataSetAttributes* inAttributes :
+    { static_cast<vtkDataSetAttributes*>(input->GetPointData()),
+      static_cast<vtkDataSetAttributes*>(input->GetCellData()) })
+  {
+    for (int arrayIdx = 0; arrayIdx < inAttributes->GetNumberOfArrays(); ++arrayIdx)
+    {
+      const char* name = inAttributes->GetAbstractArray(arrayIdx)->GetName();
+      if (name)
+      {
+        cache.InputArrays.insert(name);
+        if (outPD->GetAbstractArray(name))
+        {
+          cache.InterpolatedArrays.insert(name);
+        }
+      }
+    }
+  }
+
+  cache.Output = vtkSmartPointer<vtkPolyData>::New();
+  cache.Output->ShallowCopy(output);
+  cache.Valid = true;
+
+  // Interpolate right away so that all time steps use the same locations,
+  // the output of the prober is kept if some arrays cannot be interpolated.
+  this->InterpolateFromStaticMeshCache(input, output);
+}
+
+//----------------------------------------------------------------------------
+bool vtkPVProbeLineFilter::InterpolateFromStaticMeshCache(vtkDataSet* input, vtkPolyData* output)
+{
+  vtkStaticMeshCache& cache = *this->Cache;
+  vtkPointData* inPD = input->GetPointData();
+  vtkCellData* inCD = input->GetCellData();
+  vtkPointData* cachedPD = cache.Output->GetPointData();
+  const vtkIdType numSamples = cache.Output->GetNumberOfPoints();
+
+  // Arrays added since the samples were located and sampled arrays that cannot
+  // be interpolated with the cached weights, such as string arrays, must be
+  // probed again.
+  for (vtkDataSetAttributes* inAttributes :
+    { static_cast<vtkDataSetAttributes*>(inPD), static_cast<vtkDataSetAttributes*>(inCD) })
+  {
+    for (int arrayIdx = 0; arrayIdx < inAttributes->GetNumberOfArrays(); ++arrayIdx)
+    {
+      vtkAbstractArray* inArray = inAttributes->GetAbstractArray(arrayIdx);
+      const char* name = inArray->GetName();
+      if (!name)
+      {
+        continue;
+      }
+      if (cache.InputArrays.count(name) == 0)
+      {
+        return false;
+      }
+      if (cache.InterpolatedArrays.count(name) != 0)
+      {
+        vtkDataArray* cachedArray = cachedPD->GetArray(name);
+        if (!vtkDataArray::SafeDownCast(inArray) || !cachedArray ||
+          cachedArray->GetNumberOfTuples() != numSamples ||
+          cachedArray->GetNumberOfComponents() != inArray->GetNumberOfComponents())
+        {
+          return false;
+        }
+      }
+    }
+  }
+
+  output->ShallowCopy(cache.Output);
+  vtkPointData* outPD = output->GetPointData();
+  for (const std::string& name : cache.InterpolatedArrays)
+  {
+    // sampled point data arrays take precedence over sampled cell data arrays.
+    bool fromCells = false;
+    vtkDataArray* inArray = inPD->GetArray(name.c_str());
+    if (!inArray)
+    {
+      inArray = inCD->GetArray(name.c_str());
+      fromCells = true;
+    }
+    if (!inArray)
+    {
+      // the array is not part of this input anymore.
+      outPD->RemoveArray(name.c_str());
+      continue;
+    }
+
+    // do not modify the cached arrays, they may be shared with previous outputs.
+    vtkDataArray* cachedArray = cachedPD->GetArray(name.c_str());
+    vtkSmartPointer<vtkDataArray> outArray = vtk::TakeSmartPointer(cachedArray->NewInstance());
+    outArray->DeepCopy(cachedArray);
+
+    ::InterpolateWorker worker;
+    using Dispatcher = vtkArrayDispatch::Dispatch2SameValueType;
+    if (!Dispatcher::Execute(inArray, outArray.Get(), worker, cache.Samples, fromCells))
+    {
+      worker(inArray, outArray.Get(), cache.Samples, fromCells);
+    }
+    outPD->AddArray(outArray);
+  }
+
+  if (this->PassFieldArrays)
+  {
+    vtkFieldData* inFD = input->GetFieldData();
+    for (int arrayIdx = 0; arrayIdx < inFD->GetNumberOfArrays(); ++arrayIdx)
+    {
+      output->GetFieldData()->AddArray(inFD->GetAbstractArray(arrayIdx));
+    }
+  }
+  return true;
+}
+
 //----------------------------------------------------------------------------
 int vtkPVProbeLineFilter::FillInputPortInformation(int port, vtkInformation* info)
 {
@@ -100,4 +619,5 @@ void vtkPVProbeLineFilter::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "PassFieldArrays: " << this->PassFieldArrays << endl;
   os << indent << "ComputeTolerance: " << this->ComputeTolerance << endl;
   os << indent << "Tolerance: " << this->Tolerance << endl;
+  os << indent << "StaticMesh: " << this->StaticMesh << endl;
 }
@@ -7,6 +7,14 @@
  * Internal Paraview filters for API backward compatibilty and ease of use.
  * Internally build a line source as well as a vtkProbeLineFilter and exposes
  * their properties.
+ *
+ * When StaticMesh is enabled and the input is a single vtkDataSet processed
+ * by a single rank, the cells containing each sample and the interpolation
+ * weights are computed concurrently and cached the first time the filter
+ * executes. Subsequent
+ * executions with the same mesh, typically other time steps, then only
+ * re-interpolate the input attributes using the cached weights, in parallel
+ * over the samples, instead of locating the samples again.
  */
 
 #ifndef vtkPVProbeLineFilter_h
@@ -16,6 +24,9 @@
 #include "vtkPVVTKExtensionsFiltersParallelDIY2Module.h" //needed for exports
 #include "vtkPolyDataAlgorithm.h"
 
+#include <memory> // for std::unique_ptr
+
+class vtkDataSet;
 class vtkLineSource;
 class vtkProbeLineFilter;
 
@@ -125,13 +136,49 @@ public:
   vtkSetVector3Macro(Point2, double);
   ///@}
 
+  ///@{
+  /**
+   * Set whether the input mesh (points and cells) is assumed to be constant
+   * over time. When on, the located cells and interpolation weights of the
+   * samples are cached and reused as long as the arrays defining the input
+   * points and cells hold the same values and the filter is not modified, so
+   * that only the attributes are re-interpolated. This is only used for non-composite
+   * vtkDataSet inputs in serial runs, and when neither PassCellArrays nor
+   * PassPointArrays are on. Off by default.
+   */
+  vtkSetMacro(StaticMesh, bool);
+  vtkBooleanMacro(StaticMesh, bool);
+  vtkGetMacro(StaticMesh, bool);
+  ///@}
+
 protected:
   vtkPVProbeLineFilter();
-  ~vtkPVProbeLineFilter() = default;
+  ~vtkPVProbeLineFilter() override;
 
   int RequestData(vtkInformation*, vtkInformationVector**, vtkInformationVector*) override;
   int FillInputPortInformation(int, vtkInformation*) override;
 
+  /**
+   * Returns true if the static mesh cache can be used for this input.
+   * Invalidates the cache when the input mesh or the filter changed.
+   */
+  bool CanUseStaticMeshCache(vtkDataObject* input);
+
+  /**
+   * Locates the output samples in the input mesh and stores the cells and
+   * interpolation weights in the static mesh cache.
+   */
+  void BuildStaticMeshCache(vtkDataSet* input, vtkPolyData* output);
+
+  /**
+   * Interpolates the input attributes on the output samples using the
+   * static mesh cache. Sampled arrays missing from the input are removed.
+   * Returns false, leaving the output untouched, if the input has arrays that
+   * were not there when the cache was built or that are not vtkDataArrays,
+   * in which case the input must be probed again.
+   */
+  bool InterpolateFromStaticMeshCache(vtkDataSet* input, vtkPolyData* output);
+
   int SamplingPattern = 0;
   int LineResolution = 1000;
   bool PassPartialArrays = false;
@@ -142,6 +189,7 @@ protected:
   double Tolerance = 1.0;
   double Point1[3] = { 0, 0, 0 };
   double Point2[3] = { 1, 1, 1 };
+  bool StaticMesh = false;
 
   vtkNew<vtkLineSource> LineSource;
   vtkNew<vtkProbeLineFilter> Prober;
@@ -149,6 +197,9 @@ protected:
 private:
   vtkPVProbeLineFilter(const vtkPVProbeLineFilter&) = delete;
   void operator=(const vtkPVProbeLineFilter&) = delete;
+
+  struct vtkStaticMeshCache;
+  std::unique_ptr<vtkStaticMeshCache> Cache;
 };
 
 #endif // vtkPVProbeLineFilter_h
@@ -17,6 +17,12 @@
  * valid Python variable, it has to be accessed through a dictionary called
  * arrays (i.e. arrays['array_name']). The points can be accessed using the
  * points variable.
+ *
+ * When UseNumExpr is enabled and the `numexpr` Python module is available,
+ * single-line expressions made only of element-wise operations are evaluated
+ * with numexpr's multithreaded engine. For composite inputs, all blocks are
+ * evaluated in a single call and the results are mapped back to the output
+ * blocks without copies. Other expressions silently use the default path.
  */
 
 #ifndef vtkPythonCalculator_h
@@ -89,6 +95,20 @@ public:
   vtkSetMacro(UseMultilineExpression, bool);
   ///@}
 
+  ///@{
+  /**
+   * If true, try to evaluate single-line element-wise expressions using the
+   * `numexpr` module, which is multithreaded and avoids the per-block Python
+   * overhead on composite datasets. Falls back to the default evaluation if
+   * `numexpr` is not available or the expression is not supported by it.
+   * Ignored when `UseMultilineExpression` is true.
+   * Initial value is false.
+   */
+  vtkGetMacro(UseNumExpr, bool);
+  vtkSetMacro(UseNumExpr, bool);
+  vtkBooleanMacro(UseNumExpr, bool);
+  ///@}
+
   /**
    * For internal use only.
    */
@@ -119,6 +139,7 @@ protected:
   std::string Expression;
   std::string MultilineExpression;
   bool UseMultilineExpression = false;
+  bool UseNumExpr = false;
 
   char* ArrayName = nullptr;
   int ArrayAssociation = vtkDataObject::FIELD_ASSOCIATION_POINTS;
@@ -0,0 +1,140 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "vtkCellData.h"
+#include "vtkDoubleArray.h"
+#include "vtkImageData.h"
+#include "vtkIntArray.h"
+#include "vtkLogger.h"
+#include "vtkNew.h"
+#include "vtkPVGeometryFilter.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSmartPointer.h"
+
+namespace
+{
+// Sets a "pointValues" and a "cellValues" array holding (i * scale) on `image`.
+void SetAttributes(vtkImageData* image, int scale)
+{
+  vtkNew<vtkDoubleArray> pointValues;
+  pointValues->SetName("pointValues");
+  pointValues->SetNumberOfTuples(image->GetNumberOfPoints());
+  for (vtkIdType i = 0; i < image->GetNumberOfPoints(); ++i)
+  {
+    pointValues->SetValue(i, static_cast<double>(i * scale));
+  }
+  image->GetPointData()->SetScalars(pointValues);
+
+  vtkNew<vtkIntArray> cellValues;
+  cellValues->SetName("cellValues");
+  cellValues->SetNumberOfTuples(image->GetNumberOfCells());
+  for (vtkIdType i = 0; i < image->GetNumberOfCells(); ++i)
+  {
+    cellValues->SetValue(i, static_cast<int>(i * scale));
+  }
+  image->GetCellData()->AddArray(cellValues);
+}
+
+bool SameArray(vtkDataArray* a, vtkDataArray* b)
+{
+  if (!a || !b || a->GetNumberOfValues() != b->GetNumberOfValues())
+  {
+    return false;
+  }
+  for (vtkIdType i = 0; i < a->GetNumberOfValues(); ++i)
+  {
+    if (a->GetVariantValue(i) != b->GetVariantValue(i))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool SameSurface(vtkPolyData* a, vtkPolyData* b)
+{
+  return a->GetNumberOfPoints() == b->GetNumberOfPoints() &&
+    a->GetNumberOfCells() == b->GetNumberOfCells() &&
+    SameArray(a->GetPoints()->GetData(), b->GetPoints()->GetData()) &&
+    SameArray(
+      a->GetPointData()->GetArray("pointValues"), b->GetPointData()->GetArray("pointValues")) &&
+    SameArray(a->GetCellData()->GetArray("cellValues"), b->GetCellData()->GetArray("cellValues"));
+}
+}
+
+int TestPVGeometryFilterStaticMesh(int, char*[])
+{
+  vtkNew<vtkImageData> image;
+  image->SetDimensions(6, 5, 4);
+  SetAttributes(image, 1);
+
+  vtkNew<vtkPVGeometryFilter> cached;
+  cached->SetUseOutline(0);
+  cached->SetGenerateProcessIds(false);
+  cached->SetPassThroughCellIds(1);
+  cached->SetPassThroughPointIds(1);
+  cached->UseStaticMeshCacheOn();
+  cached->SetInputData(image);
+
+  vtkNew<vtkPVGeometryFilter> reference;
+  reference->SetUseOutline(0);
+  reference->SetGenerateProcessIds(false);
+  reference->SetPassThroughCellIds(1);
+  reference->SetPassThroughPointIds(1);
+  reference->SetInputData(image);
+
+  cached->Update();
+  reference->Update();
+  vtkPolyData* output = vtkPolyData::SafeDownCast(cached->GetOutputDataObject(0));
+  vtkPolyData* expected = vtkPolyData::SafeDownCast(reference->GetOutputDataObject(0));
+  if (output->GetNumberOfCells() <= 0)
+  {
+    vtkLogF(ERROR, "Expected a surface.");
+    return EXIT_FAILURE;
+  }
+  if (!SameSurface(output, expected))
+  {
+    vtkLogF(ERROR, "Initial surface differs from the reference.");
+    return EXIT_FAILURE;
+  }
+  vtkSmartPointer<vtkPoints> firstPoints = output->GetPoints();
+
+  // Only the attributes change: the cached surface must be reused.
+  SetAttributes(image, 3);
+  image->Modified();
+  cached->Update();
+  reference->Update();
+  output = vtkPolyData::SafeDownCast(cached->GetOutputDataObject(0));
+  expected = vtkPolyData::SafeDownCast(reference->GetOutputDataObject(0));
+  if (output->GetPoints() != firstPoints)
+  {
+    vtkLogF(ERROR, "Surface was not reused for a static mesh.");
+    return EXIT_FAILURE;
+  }
+  if (!SameSurface(output, expected))
+  {
+    vtkLogF(ERROR, "Attributes were not updated on the cached surface.");
+    return EXIT_FAILURE;
+  }
+
+  // The mesh changes: the surface must be extracted again.
+  image->SetSpacing(2.0, 1.0, 1.0);
+  cached->Update();
+  reference->Update();
+  output = vtkPolyData::SafeDownCast(cached->GetOutputDataObject(0));
+  expected = vtkPolyData::SafeDownCast(reference->GetOutputDataObject(0));
+  if (output->GetPoints() == firstPoints)
+  {
+    vtkLogF(ERROR, "Surface was reused for a modified mesh.");
+    return EXIT_FAILURE;
+  }
+  if (!SameSurface(output, expected))
+  {
+    vtkLogF(ERROR, "Surface of the modified mesh differs from the reference.");
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
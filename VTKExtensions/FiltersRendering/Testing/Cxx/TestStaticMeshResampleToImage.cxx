@@ -0,0 +1,213 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "vtkCellData.h"
+#include "vtkCellType.h"
+#include "vtkDoubleArray.h"
+#include "vtkFloatArray.h"
+#include "vtkIdList.h"
+#include "vtkImageData.h"
+#include "vtkIntArray.h"
+#include "vtkLogger.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkResampleToImage.h"
+#include "vtkSmartPointer.h"
+#include "vtkStaticMeshResampleToImage.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <cmath>
+#include <cstdlib>
+
+namespace
+{
+constexpr int Resolution = 5;
+
+// Returns an L-shaped grid of voxels covering [0, 1]^3, the cells with x and y
+// greater than 0.6 being removed so that some samples fall outside of the
+// grid. Samples of a 7x7x7 image never lie on the faces of the cells.
+vtkSmartPointer<vtkUnstructuredGrid> CreateGrid()
+{
+  vtkNew<vtkImageData> image;
+  image->SetDimensions(Resolution + 1, Resolution + 1, Resolution + 1);
+  image->SetSpacing(1.0 / Resolution, 1.0 / Resolution, 1.0 / Resolution);
+
+  vtkNew<vtkPoints> points;
+  points->SetDataTypeToDouble();
+  points->SetNumberOfPoints(image->GetNumberOfPoints());
+  for (vtkIdType cc = 0; cc < image->GetNumberOfPoints(); ++cc)
+  {
+    points->SetPoint(cc, image->GetPoint(cc));
+  }
+
+  auto grid = vtkSmartPointer<vtkUnstructuredGrid>::New();
+  grid->SetPoints(points);
+  grid->Allocate(image->GetNumberOfCells());
+  vtkNew<vtkIdList> ptIds;
+  for (vtkIdType cc = 0; cc < image->GetNumberOfCells(); ++cc)
+  {
+    const vtkIdType i = cc % Resolution;
+    const vtkIdType j = (cc / Resolution) % Resolution;
+    if (i < 3 || j < 3)
+    {
+      image->GetCellPoints(cc, ptIds);
+      grid->InsertNextCell(VTK_VOXEL, ptIds);
+    }
+  }
+  return grid;
+}
+
+// Sets the point and cell arrays of the time step `step` on `grid`.
+void SetAttributes(vtkUnstructuredGrid* grid, int step)
+{
+  vtkNew<vtkDoubleArray> pointScalars;
+  pointScalars->SetName("pointScalars");
+  vtkNew<vtkFloatArray> pointVectors;
+  pointVectors->SetName("pointVectors");
+  pointVectors->SetNumberOfComponents(3);
+  // interpolated integral values are not integral, they need to be rounded.
+  vtkNew<vtkIntArray> pointInts;
+  pointInts->SetName("pointInts");
+  for (vtkIdType cc = 0; cc < grid->GetNumberOfPoints(); ++cc)
+  {
+    double x[3];
+    grid->GetPoint(cc, x);
+    pointScalars->InsertNextValue(step + x[0] + 2 * x[1] + 3 * x[2]);
+    pointVectors->InsertNextTuple3(x[1] * x[2], step * x[0], -x[2]);
+    pointInts->InsertNextValue(7 * ((cc + step) % 3) - 5);
+  }
+  grid->GetPointData()->SetScalars(pointScalars);
+  grid->GetPointData()->AddArray(pointVectors);
+  grid->GetPointData()->AddArray(pointInts);
+
+  vtkNew<vtkIntArray> cellInts;
+  cellInts->SetName("cellInts");
+  for (vtkIdType cc = 0; cc < grid->GetNumberOfCells(); ++cc)
+  {
+    cellInts->InsertNextValue(static_cast<int>(cc * (step + 1)));
+  }
+  grid->GetCellData()->AddArray(cellInts);
+}
+
+bool SameArray(vtkDataArray* expected, vtkDataArray* result)
+{
+  if (!expected || !result || result->GetDataType() != expected->GetDataType() ||
+    result->GetNumberOfTuples() != expected->GetNumberOfTuples() ||
+    result->GetNumberOfComponents() != expected->GetNumberOfComponents())
+  {
+    return false;
+  }
+  for (vtkIdType cc = 0; cc < expected->GetNumberOfValues(); ++cc)
+  {
+    const double a = expected->GetComponent(cc / expected->GetNumberOfComponents(),
+      static_cast<int>(cc % expected->GetNumberOfComponents()));
+    const double b = result->GetComponent(cc / result->GetNumberOfComponents(),
+      static_cast<int>(cc % result->GetNumberOfComponents()));
+    if (std::abs(a - b) > 1e-5 * (1.0 + std::abs(a)))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Compares the image, the arrays, the valid point mask and the ghost arrays
+// produced by vtkStaticMeshResampleToImage with the ones of vtkResampleToImage.
+bool SameAsResampleToImage(vtkStaticMeshResampleToImage* cached, vtkUnstructuredGrid* grid)
+{
+  vtkNew<vtkResampleToImage> reference;
+  reference->SetSamplingDimensions(cached->GetSamplingDimensions());
+  reference->SetInputData(grid);
+  reference->Update();
+  vtkImageData* expected = reference->GetOutput();
+
+  cached->SetInputData(grid);
+  cached->Update();
+  vtkImageData* result = cached->GetOutput();
+
+  const double tol = 1e-9;
+  double expectedBounds[6], resultBounds[6];
+  expected->GetBounds(expectedBounds);
+  result->GetBounds(resultBounds);
+  for (int cc = 0; cc < 6; ++cc)
+  {
+    if (std::abs(expectedBounds[cc] - resultBounds[cc]) > tol)
+    {
+      vtkLogF(ERROR, "Image bounds differ.");
+      return false;
+    }
+  }
+  if (result->GetNumberOfPoints() != expected->GetNumberOfPoints())
+  {
+    vtkLogF(ERROR, "Image dimensions differ.");
+    return false;
+  }
+
+  // the expected point arrays include the valid point mask and the point
+  // ghosts.
+  vtkPointData* expectedPD = expected->GetPointData();
+  if (!expectedPD->GetArray("vtkValidPointMask") || !expectedPD->GetGhostArray())
+  {
+    vtkLogF(ERROR, "vtkResampleToImage did not blank the samples.");
+    return false;
+  }
+  for (int cc = 0; cc < expectedPD->GetNumberOfArrays(); ++cc)
+  {
+    vtkDataArray* array = expectedPD->GetArray(cc);
+    if (!SameArray(array, result->GetPointData()->GetArray(array->GetName())))
+    {
+      vtkLogF(ERROR, "Point array '%s' differs.", array->GetName());
+      return false;
+    }
+  }
+  if (!SameArray(expected->GetCellData()->GetGhostArray(), result->GetCellData()->GetGhostArray()))
+  {
+    vtkLogF(ERROR, "Cell ghosts differ.");
+    return false;
+  }
+  return true;
+}
+}
+
+int TestStaticMeshResampleToImage(int, char*[])
+{
+  vtkNew<vtkStaticMeshResampleToImage> cached;
+  cached->SetSamplingDimensions(7, 7, 7);
+
+  vtkSmartPointer<vtkUnstructuredGrid> grid = CreateGrid();
+  SetAttributes(grid, 0);
+  if (!SameAsResampleToImage(cached, grid))
+  {
+    vtkLogF(ERROR, "Failed for the first time step.");
+    return EXIT_FAILURE;
+  }
+
+  // a reader loads the same mesh again for the next time step.
+  vtkSmartPointer<vtkUnstructuredGrid> next = CreateGrid();
+  SetAttributes(next, 1);
+  if (!SameAsResampleToImage(cached, next))
+  {
+    vtkLogF(ERROR, "Failed for a new time step of the same mesh.");
+    return EXIT_FAILURE;
+  }
+
+  // moving the points changes the bounds and the cells containing the samples,
+  // the cache needs to be rebuilt.
+  vtkPoints* points = next->GetPoints();
+  for (vtkIdType cc = 0; cc < points->GetNumberOfPoints(); ++cc)
+  {
+    double x[3];
+    points->GetPoint(cc, x);
+    x[0] += 0.3 * x[0] * x[0];
+    points->SetPoint(cc, x);
+  }
+  points->Modified();
+  if (!SameAsResampleToImage(cached, next))
+  {
+    vtkLogF(ERROR, "Failed once the points were moved.");
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -20,6 +20,7 @@
 #include "vtkExplicitStructuredGrid.h"
 #include "vtkExplicitStructuredGridSurfaceFilter.h"
 #include "vtkFeatureEdges.h"
+#include "vtkFieldData.h"
 #include "vtkFloatArray.h"
 #include "vtkGarbageCollector.h"
 #include "vtkGenericDataSet.h"
@@ -28,11 +29,14 @@
 #include "vtkHyperTreeGrid.h"
 #include "vtkHyperTreeGridFeatureEdges.h"
 #include "vtkHyperTreeGridGeometry.h"
+#include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
 #include "vtkImageData.h"
 #include "vtkInformation.h"
 #include "vtkInformationIntegerVectorKey.h"
 #include "vtkInformationVector.h"
 #include "vtkMath.h"
+#include "vtkMatrix3x3.h"
 #include "vtkMultiBlockDataSet.h"
 #include "vtkMultiPieceDataSet.h"
 #include "vtkMultiProcessController.h"
@@ -43,11 +47,13 @@
 #include "vtkPVTrivialProducer.h"
 #include "vtkPartitionedDataSetCollection.h"
 #include "vtkPointData.h"
+#include "vtkPoints.h"
 #include "vtkPolyData.h"
 #include "vtkPolygon.h"
 #include "vtkRecoverGeometryWireframe.h"
 #include "vtkRectilinearGrid.h"
 #include "vtkRectilinearGridOutlineFilter.h"
+#include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkStringArray.h"
@@ -56,13 +62,17 @@
 #include "vtkTimerLog.h"
 #include "vtkTriangleFilter.h"
 #include "vtkUniformGrid.h"
+#include "vtkUnsignedCharArray.h"
 #include "vtkUnsignedIntArray.h"
 #include "vtkUnstructuredGrid.h"
 #include "vtkUnstructuredGridGeometryFilter.h"
 
+#include <algorithm>
 #include <cassert>
 #include <cmath>
+#include <cstring>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace details
@@ -140,6 +150,298 @@ public:
   int Commutative() override { return 1; }
 };
 
+//----------------------------------------------------------------------------
+struct vtkPVGeometryFilter::vtkStaticMeshCache
+{
+  // Surface generated for the cached input and the ids of the input points and
+  // cells each of its points and cells comes from.
+  vtkSmartPointer<vtkPolyData> Surface;
+  vtkNew<vtkIdList> PointIds;
+  vtkNew<vtkIdList> CellIds;
+  int OutlineFlag = 0;
+
+  // Keys identifying the cached input mesh.
+  vtkMTimeType FilterMTime = 0;
+  std::string InputClassName;
+  vtkIdType NumberOfPoints = 0;
+  vtkIdType NumberOfCells = 0;
+  int WholeExtent[6] = { 0, -1, 0, -1, 0, -1 };
+  std::vector<std::string> ArraysSignature;
+  vtkMTimeType MeshMTime = 0;
+  bool HasMeshHash = false;
+  vtkTypeUInt64 MeshHash = 0;
+
+  // Mesh hash computed by the last lookup that could not use the mesh MTime.
+  // Kept so that it needs not be computed again when that lookup misses and
+  // the newly generated surface gets cached.
+  vtkMTimeType LookupMeshMTime = 0;
+  bool LookupHasMeshHash = false;
+  vtkTypeUInt64 LookupMeshHash = 0;
+};
+
+namespace
+{
+//----------------------------------------------------------------------------
+// Computes a (non cryptographic) hash of raw mesh arrays. Buffers are hashed in
+// fixed size chunks in parallel and the chunk hashes are combined in order so
+// that the result does not depend on the SMP backend.
+class vtkMeshHasher
+{
+public:
+  void AddValue(vtkTypeUInt64 value) { this->Hash = vtkMeshHasher::Mix(this->Hash, value); }
+
+  void AddBytes(const void* data, size_t size)
+  {
+    constexpr size_t chunkSize = 1 << 20;
+    const vtkIdType numChunks = static_cast<vtkIdType>((size + chunkSize - 1) / chunkSize);
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    std::vector<vtkTypeUInt64> chunkHashes(numChunks);
+    vtkSMPTools::For(0, numChunks, [&](vtkIdType begin, vtkIdType end) {
+      for (vtkIdType chunk = begin; chunk < end; ++chunk)
+      {
+        const size_t offset = static_cast<size_t>(chunk) * chunkSize;
+        chunkHashes[chunk] =
+          vtkMeshHasher::HashBytes(bytes + offset, std::min(chunkSize, size - offset));
+      }
+    });
+    this->AddValue(size);
+    for (const vtkTypeUInt64 chunkHash : chunkHashes)
+    {
+      this->AddValue(chunkHash);
+    }
+  }
+
+  // Returns false if the array cannot be hashed without copying it.
+  bool AddArray(vtkDataArray* array)
+  {
+    if (!array)
+    {
+      this->AddValue(0);
+      return true;
+    }
+    if (!array->HasStandardMemoryLayout())
+    {
+      return false;
+    }
+    this->AddValue(static_cast<vtkTypeUInt64>(array->GetDataType()));
+    this->AddValue(static_cast<vtkTypeUInt64>(array->GetNumberOfComponents()));
+    this->AddValue(static_cast<vtkTypeUInt64>(array->GetNumberOfTuples()));
+    if (array->GetNumberOfValues() > 0)
+    {
+      this->AddBytes(array->GetVoidPointer(0),
+        static_cast<size_t>(array->GetNumberOfValues()) * array->GetDataTypeSize());
+    }
+    return true;
+  }
+
+  bool AddPoints(vtkPoints* points) { return this->AddArray(points ? points->GetData() : nullptr); }
+
+  bool AddCells(vtkCellArray* cells)
+  {
+    if (!cells)
+    {
+      this->AddValue(0);
+      return true;
+    }
+    return this->AddArray(cells->GetOffsetsArray()) &&
+      this->AddArray(cells->GetConnectivityArray());
+  }
+
+  vtkTypeUInt64 GetHash() const { return this->Hash; }
+
+private:
+  static constexpr vtkTypeUInt64 Offset = 14695981039346656037ULL;
+  static constexpr vtkTypeUInt64 Prime = 1099511628211ULL;
+
+  // FNV-1a on 64 bit words, with a xor-shift so that the high bits of a word
+  // also end up affecting the low bits of the hash.
+  static vtkTypeUInt64 Mix(vtkTypeUInt64 hash, vtkTypeUInt64 word)
+  {
+    hash = (hash ^ word) * Prime;
+    return hash ^ (hash >> 32);
+  }
+
+  static vtkTypeUInt64 HashBytes(const unsigned char* bytes, size_t size)
+  {
+    vtkTypeUInt64 hash = Offset;
+    size_t cc = 0;
+    for (; cc + sizeof(vtkTypeUInt64) <= size; cc += sizeof(vtkTypeUInt64))
+    {
+      vtkTypeUInt64 word;
+      std::memcpy(&word, bytes + cc, sizeof(word));
+      hash = vtkMeshHasher::Mix(hash, word);
+    }
+    for (; cc < size; ++cc)
+    {
+      hash = vtkMeshHasher::Mix(hash, bytes[cc]);
+    }
+    return hash;
+  }
+
+  vtkTypeUInt64 Hash = Offset;
+};
+
+//----------------------------------------------------------------------------
+// Hashes everything the extracted surface depends on: points, cells, structure
+// and ghost arrays. Returns false for dataset types or array layouts that are
+// not supported, in which case only the mesh MTime can be used.
+bool vtkHashMesh(vtkDataSet* ds, vtkTypeUInt64& hash)
+{
+  vtkMeshHasher hasher;
+  hasher.AddValue(static_cast<vtkTypeUInt64>(ds->GetDataObjectType()));
+
+  bool valid = true;
+  int extent[6];
+  if (auto pd = vtkPolyData::SafeDownCast(ds))
+  {
+    valid = hasher.AddPoints(pd->GetPoints()) && hasher.AddCells(pd->GetVerts()) &&
+      hasher.AddCells(pd->GetLines()) && hasher.AddCells(pd->GetPolys()) &&
+      hasher.AddCells(pd->GetStrips());
+  }
+  else if (auto ug = vtkUnstructuredGrid::SafeDownCast(ds))
+  {
+    valid = hasher.AddPoints(ug->GetPoints()) && hasher.AddCells(ug->GetCells()) &&
+      hasher.AddArray(ug->GetCellTypesArray()) && hasher.AddArray(ug->GetFaces()) &&
+      hasher.AddArray(ug->GetFaceLocations());
+  }
+  else if (auto esg = vtkExplicitStructuredGrid::SafeDownCast(ds))
+  {
+    esg->GetExtent(extent);
+    hasher.AddBytes(extent, sizeof(extent));
+    valid = hasher.AddPoints(esg->GetPoints()) && hasher.AddCells(esg->GetCells());
+  }
+  else if (auto sg = vtkStructuredGrid::SafeDownCast(ds))
+  {
+    sg->GetExtent(extent);
+    hasher.AddBytes(extent, sizeof(extent));
+    valid = hasher.AddPoints(sg->GetPoints());
+  }
+  else if (auto rg = vtkRectilinearGrid::SafeDownCast(ds))
+  {
+    rg->GetExtent(extent);
+    hasher.AddBytes(extent, sizeof(extent));
+    valid = hasher.AddArray(rg->GetXCoordinates()) && hasher.AddArray(rg->GetYCoordinates()) &&
+      hasher.AddArray(rg->GetZCoordinates());
+  }
+  else if (auto id = vtkImageData::SafeDownCast(ds))
+  {
+    id->GetExtent(extent);
+    hasher.AddBytes(extent, sizeof(extent));
+    hasher.AddBytes(id->GetOrigin(), 3 * sizeof(double));
+    hasher.AddBytes(id->GetSpacing(), 3 * sizeof(double));
+    hasher.AddBytes(id->GetDirectionMatrix()->GetData(), 9 * sizeof(double));
+  }
+  else
+  {
+    valid = false;
+  }
+
+  valid = valid && hasher.AddArray(ds->GetPointGhostArray()) &&
+    hasher.AddArray(ds->GetCellGhostArray());
+  hash = hasher.GetHash();
+  return valid;
+}
+
+//----------------------------------------------------------------------------
+// Describes the point and cell arrays of the input, including the active
+// attributes, so that a cached surface is not reused with a different set of
+// arrays than the one it was generated with.
+std::vector<std::string> vtkGetArraysSignature(vtkDataSet* ds)
+{
+  std::vector<std::string> signature;
+  for (vtkDataSetAttributes* dsa :
+    { static_cast<vtkDataSetAttributes*>(ds->GetPointData()),
+      static_cast<vtkDataSetAttributes*>(ds->GetCellData()) })
+  {
+    for (int cc = 0; cc < dsa->GetNumberOfArrays(); ++cc)
+    {
+      vtkAbstractArray* array = dsa->GetAbstractArray(cc);
+      signature.push_back(std::string(array->GetName() ? array->GetName() : "") + ":" +
+        std::to_string(array->GetDataType()) + ":" +
+        std::to_string(array->GetNumberOfComponents()));
+    }
+    int attributes[vtkDataSetAttributes::NUM_ATTRIBUTES];
+    dsa->GetAttributeIndices(attributes);
+    std::string active;
+    for (int attribute : attributes)
+    {
+      active += std::to_string(attribute) + ",";
+    }
+    signature.push_back(active);
+  }
+  return signature;
+}
+
+//----------------------------------------------------------------------------
+// Copies the original ids recorded on the surface into `ids`, checking that
+// each one refers to an existing input element. Returns false otherwise, e.g.
+// for points added by nonlinear subdivision which are flagged with -1.
+bool vtkExtractOriginalIds(vtkIdTypeArray* originalIds, vtkIdType numInputIds, vtkIdList* ids)
+{
+  if (!originalIds)
+  {
+    ids->Reset();
+    return true;
+  }
+  const vtkIdType numIds = originalIds->GetNumberOfTuples();
+  ids->SetNumberOfIds(numIds);
+  const vtkIdType* source = originalIds->GetPointer(0);
+  vtkIdType* dest = ids->GetPointer(0);
+  for (vtkIdType cc = 0; cc < numIds; ++cc)
+  {
+    if (source[cc] < 0 || source[cc] >= numInputIds)
+    {
+      return false;
+    }
+    dest[cc] = source[cc];
+  }
+  return true;
+}
+
+//----------------------------------------------------------------------------
+// Replaces each array of `outDSA` that comes from `inDSA` with the tuples of
+// the current input array at `ids`. Arrays generated by the filter itself are
+// listed in `skipped` and kept as is.
+void vtkGatherAttributes(vtkDataSetAttributes* inDSA, vtkDataSetAttributes* outDSA,
+  vtkIdList* ids, const std::vector<std::string>& skipped)
+{
+  std::vector<std::pair<vtkAbstractArray*, vtkSmartPointer<vtkAbstractArray>>> arrays;
+  for (int cc = 0; cc < outDSA->GetNumberOfArrays(); ++cc)
+  {
+    const char* name = outDSA->GetAbstractArray(cc)->GetName();
+    if (!name || std::find(skipped.begin(), skipped.end(), name) != skipped.end())
+    {
+      continue;
+    }
+    if (vtkAbstractArray* inArray = inDSA->GetAbstractArray(name))
+    {
+      arrays.emplace_back(inArray, nullptr);
+    }
+  }
+
+  vtkSMPTools::For(0, static_cast<vtkIdType>(arrays.size()), [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType cc = begin; cc < end; ++cc)
+    {
+      vtkAbstractArray* inArray = arrays[cc].first;
+      auto outArray = vtk::TakeSmartPointer(inArray->NewInstance());
+      outArray->SetName(inArray->GetName());
+      outArray->SetNumberOfComponents(inArray->GetNumberOfComponents());
+      outArray->CopyComponentNames(inArray);
+      outArray->SetNumberOfTuples(ids->GetNumberOfIds());
+      inArray->GetTuples(ids, outArray);
+      arrays[cc].second = outArray;
+    }
+  });
+
+  // Arrays with an existing name are replaced in place so the active
+  // attributes of the cached surface remain valid.
+  for (const auto& item : arrays)
+  {
+    outDSA->AddArray(item.second);
+  }
+}
+}
+
 //----------------------------------------------------------------------------
 vtkPVGeometryFilter::vtkPVGeometryFilter()
 {
@@ -501,6 +803,7 @@ int vtkPVGeometryFilter::RequestData(
   vtkDataObject* input = vtkDataObject::GetData(inputVector[0], 0);
   if (vtkCompositeDataSet::SafeDownCast(input))
   {
+    this->StaticMeshCache.reset();
     vtkTimerLog::MarkStartEvent("vtkPVGeometryFilter::RequestData");
     vtkGarbageCollector::DeferredCollectionPush();
     if (input->IsA("vtkUniformGridAMR"))
@@ -538,12 +841,146 @@ int vtkPVGeometryFilter::RequestData(
   }
   else
   {
+    vtkDataSet* inputDS = vtkDataSet::SafeDownCast(input);
+    if (this->ReuseStaticMeshSurface(inputDS, output, wholeExtent))
+    {
+      return 1;
+    }
     this->ExecuteBlock(input, output, 1, procid, numProcs, 0, wholeExtent);
     this->CleanupOutputData(output, 1);
+    this->UpdateStaticMeshCache(inputDS, output, wholeExtent);
   }
   return 1;
 }
 
+//----------------------------------------------------------------------------
+bool vtkPVGeometryFilter::ReuseStaticMeshSurface(
+  vtkDataSet* input, vtkPolyData* output, const int* wholeExtent)
+{
+  if (!this->UseStaticMeshCache)
+  {
+    this->StaticMeshCache.reset();
+    return false;
+  }
+
+  auto& cache = this->StaticMeshCache;
+  int reuse = 0;
+  if (input && cache && cache->FilterMTime == this->GetMTime() &&
+    cache->InputClassName == input->GetClassName() &&
+    cache->NumberOfPoints == input->GetNumberOfPoints() &&
+    cache->NumberOfCells == input->GetNumberOfCells() &&
+    (!wholeExtent || std::equal(wholeExtent, wholeExtent + 6, cache->WholeExtent)) &&
+    cache->ArraysSignature == vtkGetArraysSignature(input))
+  {
+    const vtkMTimeType meshMTime = input->GetMeshMTime();
+    if (meshMTime == cache->MeshMTime)
+    {
+      reuse = 1;
+    }
+    else if (cache->HasMeshHash)
+    {
+      // Readers typically create new points and cells for every timestep even
+      // when the mesh is static, so fall back to comparing the mesh content.
+      cache->LookupMeshMTime = meshMTime;
+      cache->LookupHasMeshHash = vtkHashMesh(input, cache->LookupMeshHash);
+      if (cache->LookupHasMeshHash && cache->LookupMeshHash == cache->MeshHash)
+      {
+        cache->MeshMTime = meshMTime;
+        reuse = 1;
+      }
+    }
+  }
+
+  if (this->Controller && this->Controller->GetNumberOfProcesses() > 1)
+  {
+    // The regular path may communicate (see ExecuteCellNormals), so all ranks
+    // have to agree on skipping it.
+    int allReuse = 0;
+    this->Controller->AllReduce(&reuse, &allReuse, 1, vtkCommunicator::MIN_OP);
+    reuse = allReuse;
+  }
+  if (!reuse)
+  {
+    return false;
+  }
+
+  vtkTimerLog::MarkStartEvent("vtkPVGeometryFilter::ReuseStaticMeshSurface");
+  output->ShallowCopy(cache->Surface);
+  vtkNew<vtkFieldData> fieldData;
+  fieldData->PassData(input->GetFieldData());
+  output->SetFieldData(fieldData);
+
+  std::vector<std::string> skipped = { "vtkOriginalPointIds", "vtkOriginalCellIds" };
+  if (this->GenerateProcessIds)
+  {
+    skipped.emplace_back("vtkProcessId");
+  }
+  if (this->GenerateCellNormals)
+  {
+    skipped.emplace_back("cellNormals");
+  }
+  vtkGatherAttributes(input->GetPointData(), output->GetPointData(), cache->PointIds, skipped);
+  vtkGatherAttributes(input->GetCellData(), output->GetCellData(), cache->CellIds, skipped);
+  this->OutlineFlag = cache->OutlineFlag;
+  vtkTimerLog::MarkEndEvent("vtkPVGeometryFilter::ReuseStaticMeshSurface");
+  return true;
+}
+
+//----------------------------------------------------------------------------
+void vtkPVGeometryFilter::UpdateStaticMeshCache(
+  vtkDataSet* input, vtkPolyData* output, const int* wholeExtent)
+{
+  // Outlines carry no attributes to update and a surface shallow copied from
+  // a polydata input is cheaper to produce again than to gather.
+  if (!this->UseStaticMeshCache || !input || this->OutlineFlag ||
+    (vtkPolyData::SafeDownCast(input) && !this->Triangulate))
+  {
+    this->StaticMeshCache.reset();
+    return;
+  }
+
+  auto pointIds =
+    vtkIdTypeArray::SafeDownCast(output->GetPointData()->GetArray("vtkOriginalPointIds"));
+  auto cellIds =
+    vtkIdTypeArray::SafeDownCast(output->GetCellData()->GetArray("vtkOriginalCellIds"));
+  std::unique_ptr<vtkStaticMeshCache> cache(new vtkStaticMeshCache());
+  if ((!pointIds && output->GetNumberOfPoints() > 0) ||
+    (!cellIds && output->GetNumberOfCells() > 0) ||
+    !vtkExtractOriginalIds(pointIds, input->GetNumberOfPoints(), cache->PointIds) ||
+    !vtkExtractOriginalIds(cellIds, input->GetNumberOfCells(), cache->CellIds))
+  {
+    this->StaticMeshCache.reset();
+    return;
+  }
+
+  const vtkMTimeType meshMTime = input->GetMeshMTime();
+  const auto& previous = this->StaticMeshCache;
+  if (previous && previous->LookupMeshMTime == meshMTime)
+  {
+    cache->HasMeshHash = previous->LookupHasMeshHash;
+    cache->MeshHash = previous->LookupMeshHash;
+  }
+  else
+  {
+    cache->HasMeshHash = vtkHashMesh(input, cache->MeshHash);
+  }
+
+  cache->Surface = vtkSmartPointer<vtkPolyData>::New();
+  cache->Surface->ShallowCopy(output);
+  cache->OutlineFlag = this->OutlineFlag;
+  cache->FilterMTime = this->GetMTime();
+  cache->InputClassName = input->GetClassName();
+  cache->NumberOfPoints = input->GetNumberOfPoints();
+  cache->NumberOfCells = input->GetNumberOfCells();
+  if (wholeExtent)
+  {
+    std::copy(wholeExtent, wholeExtent + 6, cache->WholeExtent);
+  }
+  cache->ArraysSignature = vtkGetArraysSignature(input);
+  cache->MeshMTime = meshMTime;
+  this->StaticMeshCache = std::move(cache);
+}
+
 //----------------------------------------------------------------------------
 void vtkPVGeometryFilter::GenerateFeatureEdgesHTG(vtkHyperTreeGrid* input, vtkPolyData* output)
 {
@@ -1824,6 +2261,7 @@ void vtkPVGeometryFilter::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "HideInternalAMRFaces: " << (this->HideInternalAMRFaces ? "on" : "off") << endl;
   os << indent << "UseNonOverlappingAMRMetaDataForOutlines: "
      << (this->UseNonOverlappingAMRMetaDataForOutlines ? "on" : "off") << endl;
+  os << indent << "UseStaticMeshCache: " << (this->UseStaticMeshCache ? "on" : "off") << endl;
 }
 
 //----------------------------------------------------------------------------
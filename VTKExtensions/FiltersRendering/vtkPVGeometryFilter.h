@@ -14,6 +14,8 @@
 #include "vtkDataObjectAlgorithm.h"
 #include "vtkPVVTKExtensionsFiltersRenderingModule.h" // needed for export macro
 
+#include <memory> // for std::unique_ptr
+
 class vtkCallbackCommand;
 class vtkCellGrid;
 class vtkDataSet;
@@ -191,6 +193,25 @@ public:
   vtkBooleanMacro(UseNonOverlappingAMRMetaDataForOutlines, bool);
   ///@}
 
+  ///@{
+  /**
+   * When set to true, the surface extracted from a non-composite vtkDataSet
+   * input is kept and reused on subsequent executions as long as the input
+   * points and cells are unchanged. The mesh is considered unchanged when its
+   * mesh MTime did not change or, failing that, when a hash of its points,
+   * cells and ghost arrays matches the cached one. In that case only the point
+   * and cell attributes are gathered from the input onto the cached surface
+   * using the vtkOriginalPointIds and vtkOriginalCellIds arrays, which is much
+   * cheaper than extracting the surface again for time-varying attributes on a
+   * static mesh. This requires PassThroughPointIds and PassThroughCellIds;
+   * surfaces with points that do not exist in the input (e.g. from nonlinear
+   * subdivision) or outlines are never cached. Default is false.
+   */
+  vtkSetMacro(UseStaticMeshCache, bool);
+  vtkGetMacro(UseStaticMeshCache, bool);
+  vtkBooleanMacro(UseStaticMeshCache, bool);
+  ///@}
+
   // These keys are put in the output composite-data metadata for multipieces
   // since this filter merges multipieces together.
   static vtkInformationIntegerVectorKey* POINT_OFFSETS();
@@ -309,6 +330,7 @@ protected:
   bool HideInternalAMRFaces;
   bool UseNonOverlappingAMRMetaDataForOutlines;
   bool GenerateFeatureEdges;
+  bool UseStaticMeshCache = false;
 
 private:
   vtkPVGeometryFilter(const vtkPVGeometryFilter&) = delete;
@@ -342,6 +364,19 @@ private:
    * vtkPolydata.
    */
   void GenerateProcessIdsArrays(vtkPolyData* output);
+
+  ///@{
+  /**
+   * Support for UseStaticMeshCache. ReuseStaticMeshSurface() fills \c output
+   * from the cached surface and returns true when the cache is valid for \c
+   * input on all ranks. UpdateStaticMeshCache() records the surface just
+   * generated for \c input, or drops the cache if it cannot be reused.
+   */
+  bool ReuseStaticMeshSurface(vtkDataSet* input, vtkPolyData* output, const int* wholeExtent);
+  void UpdateStaticMeshCache(vtkDataSet* input, vtkPolyData* output, const int* wholeExtent);
+  struct vtkStaticMeshCache;
+  std::unique_ptr<vtkStaticMeshCache> StaticMeshCache;
+  ///@}
 };
 
 #endif
@@ -0,0 +1,425 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+#include "vtkStaticMeshResampleToImage.h"
+
+#include "vtkArrayDispatch.h"
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkCharArray.h"
+#include "vtkDataArrayRange.h"
+#include "vtkDataSetAttributes.h"
+#include "vtkFieldData.h"
+#include "vtkGenericCell.h"
+#include "vtkIdList.h"
+#include "vtkImageData.h"
+#include "vtkInformation.h"
+#include "vtkInformationVector.h"
+#include "vtkMath.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPVLogger.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
+#include "vtkStaticCellLocator.h"
+#include "vtkStreamingDemandDrivenPipeline.h"
+#include "vtkUnsignedCharArray.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+namespace
+{
+//----------------------------------------------------------------------------
+// Returns true if `array`, modified at `mtime` along with the object owning it,
+// holds the same values as `cached`, the array of the mesh the samples were
+// located in, which was modified at `cachedMTime`.
+bool HasSameValues(
+  vtkDataArray* cached, vtkMTimeType cachedMTime, vtkDataArray* array, vtkMTimeType mtime)
+{
+  if (!cached || !array)
+  {
+    return cached == array;
+  }
+  if (cached == array)
+  {
+    return mtime == cachedMTime;
+  }
+
+  // readers of transient data with a static mesh often read it again for each
+  // time step.
+  if (cached->GetDataType() != array->GetDataType() ||
+    cached->GetNumberOfValues() != array->GetNumberOfValues() ||
+    !cached->HasStandardMemoryLayout() || !array->HasStandardMemoryLayout())
+  {
+    return false;
+  }
+  const size_t size = static_cast<size_t>(array->GetNumberOfValues()) * array->GetDataTypeSize();
+  return size == 0 || std::memcmp(cached->GetVoidPointer(0), array->GetVoidPointer(0), size) == 0;
+}
+
+//----------------------------------------------------------------------------
+// Returns the time `array` of the mesh was last modified, including through
+// `owner`, the points or cells holding it, e.g. using vtkPoints::SetPoint().
+vtkMTimeType GetMeshMTime(vtkObject* owner, vtkDataArray* array)
+{
+  return array ? std::max(owner->GetMTime(), array->GetMTime()) : 0;
+}
+
+//----------------------------------------------------------------------------
+// Cell containing each sample, -1 if none, and the interpolation weights of
+// its points.
+struct SampleLocations
+{
+  std::vector<vtkIdType> CellIds;
+  std::vector<vtkIdType> WeightOffsets;
+  std::vector<double> Weights;
+};
+
+//----------------------------------------------------------------------------
+// Fills `outArray` with the values of `inArray` at each sample. Point values
+// are interpolated and rounded for integral types the way vtkProbeFilter does,
+// cell values are copied. Samples outside of the mesh are set to 0.
+struct InterpolateWorker
+{
+  template <typename InArrayT, typename OutArrayT>
+  void operator()(InArrayT* inArray, OutArrayT* outArray, vtkCellArray* cells,
+    const SampleLocations& samples, bool fromCells)
+  {
+    using OutValueType = vtk::GetAPIType<OutArrayT>;
+    const auto inTuples = vtk::DataArrayTupleRange(inArray);
+    auto outTuples = vtk::DataArrayTupleRange(outArray);
+    const int numComp = inArray->GetNumberOfComponents();
+    const vtkIdType numSamples = static_cast<vtkIdType>(samples.CellIds.size());
+
+    vtkSMPThreadLocalObject<vtkIdList> tlIds;
+    vtkSMPTools::For(0, numSamples, [&](vtkIdType begin, vtkIdType end) {
+      vtkIdList* ids = tlIds.Local();
+      std::vector<double> tuple(numComp);
+      for (vtkIdType sampleId = begin; sampleId < end; ++sampleId)
+      {
+        const vtkIdType cellId = samples.CellIds[sampleId];
+        auto outTuple = outTuples[sampleId];
+        if (cellId < 0)
+        {
+          std::fill(outTuple.begin(), outTuple.end(), OutValueType(0));
+          continue;
+        }
+        if (fromCells)
+        {
+          const auto inTuple = inTuples[cellId];
+          for (int comp = 0; comp < numComp; ++comp)
+          {
+            outTuple[comp] = static_cast<OutValueType>(inTuple[comp]);
+          }
+          continue;
+        }
+
+        vtkIdType npts;
+        const vtkIdType* pts;
+        cells->GetCellAtId(cellId, npts, pts, ids);
+        const double* weights = samples.Weights.data() + samples.WeightOffsets[sampleId];
+        std::fill(tuple.begin(), tuple.end(), 0.0);
+        for (vtkIdType pt = 0; pt < npts; ++pt)
+        {
+          const auto inTuple = inTuples[pts[pt]];
+          for (int comp = 0; comp < numComp; ++comp)
+          {
+            tuple[comp] += weights[pt] * static_cast<double>(inTuple[comp]);
+          }
+        }
+        for (int comp = 0; comp < numComp; ++comp)
+        {
+          OutValueType value;
+          vtkMath::RoundDoubleToIntegralIfNecessary(tuple[comp], &value);
+          outTuple[comp] = value;
+        }
+      }
+    });
+  }
+};
+}
+
+//----------------------------------------------------------------------------
+struct vtkStaticMeshResampleToImage::vtkSampleCache
+{
+  int Dimensions[3] = { 0, 0, 0 };
+  double Origin[3] = { 0, 0, 0 };
+  double Spacing[3] = { 0, 0, 0 };
+
+  // Arrays of the mesh the samples were located in.
+  vtkSmartPointer<vtkDataArray> Points;
+  vtkSmartPointer<vtkDataArray> Connectivity;
+  vtkSmartPointer<vtkDataArray> Offsets;
+  vtkSmartPointer<vtkDataArray> CellTypes;
+  vtkMTimeType PointsMTime = 0;
+  vtkMTimeType ConnectivityMTime = 0;
+  vtkMTimeType OffsetsMTime = 0;
+  vtkMTimeType CellTypesMTime = 0;
+
+  SampleLocations Samples;
+
+  bool IsValid(vtkUnstructuredGrid* grid, const int dims[3]) const
+  {
+    vtkPoints* points = grid->GetPoints();
+    vtkCellArray* cells = grid->GetCells();
+    if (!this->Points || !points || !cells || !std::equal(dims, dims + 3, this->Dimensions))
+    {
+      return false;
+    }
+    vtkDataArray* connectivity = cells->GetConnectivityArray();
+    vtkDataArray* offsets = cells->GetOffsetsArray();
+    vtkDataArray* cellTypes = grid->GetCellTypesArray();
+    return HasSameValues(this->Points, this->PointsMTime, points->GetData(),
+             GetMeshMTime(points, points->GetData())) &&
+      HasSameValues(this->Connectivity, this->ConnectivityMTime, connectivity,
+        GetMeshMTime(cells, connectivity)) &&
+      HasSameValues(this->Offsets, this->OffsetsMTime, offsets, GetMeshMTime(cells, offsets)) &&
+      HasSameValues(this->CellTypes, this->CellTypesMTime, cellTypes,
+        cellTypes ? cellTypes->GetMTime() : 0);
+  }
+
+  void Build(vtkUnstructuredGrid* grid, const int dims[3]);
+};
+
+//----------------------------------------------------------------------------
+void vtkStaticMeshResampleToImage::vtkSampleCache::Build(
+  vtkUnstructuredGrid* grid, const int dims[3])
+{
+  std::copy(dims, dims + 3, this->Dimensions);
+  double bounds[6];
+  grid->GetBounds(bounds);
+  for (int cc = 0; cc < 3; ++cc)
+  {
+    this->Origin[cc] = bounds[2 * cc];
+    this->Spacing[cc] =
+      dims[cc] > 1 ? (bounds[2 * cc + 1] - bounds[2 * cc]) / (dims[cc] - 1) : 0.0;
+  }
+
+  const vtkIdType numSamples =
+    static_cast<vtkIdType>(dims[0]) * static_cast<vtkIdType>(dims[1]) * dims[2];
+  auto& samples = this->Samples;
+  samples.CellIds.assign(numSamples, -1);
+  samples.WeightOffsets.assign(numSamples + 1, 0);
+  vtkCellArray* cells = grid->GetCells();
+  if (!grid->GetPoints() || !cells || grid->GetNumberOfCells() == 0)
+  {
+    return;
+  }
+  this->Points = grid->GetPoints()->GetData();
+  this->PointsMTime = GetMeshMTime(grid->GetPoints(), this->Points);
+  this->Connectivity = cells->GetConnectivityArray();
+  this->ConnectivityMTime = GetMeshMTime(cells, this->Connectivity);
+  this->Offsets = cells->GetOffsetsArray();
+  this->OffsetsMTime = GetMeshMTime(cells, this->Offsets);
+  this->CellTypes = grid->GetCellTypesArray();
+  this->CellTypesMTime = this->CellTypes ? this->CellTypes->GetMTime() : 0;
+
+  vtkNew<vtkStaticCellLocator> locator;
+  locator->SetDataSet(grid);
+  locator->BuildLocator();
+
+  // GetCell() is only thread safe once it was called from a single thread.
+  vtkNew<vtkGenericCell> firstCell;
+  grid->GetCell(0, firstCell);
+
+  const double tol = 1e-6 * grid->GetLength();
+  const double tol2 = tol * tol;
+  const int maxCellSize = std::max(grid->GetMaxCellSize(), 1);
+  std::vector<double> pcoords(3 * numSamples);
+  vtkSMPThreadLocalObject<vtkGenericCell> tlCell;
+  vtkSMPThreadLocal<std::vector<double>> tlWeights;
+  vtkSMPTools::For(0, numSamples, [&](vtkIdType begin, vtkIdType end) {
+    vtkGenericCell* cell = tlCell.Local();
+    std::vector<double>& weights = tlWeights.Local();
+    weights.resize(maxCellSize);
+    double x[3];
+    int subId;
+    for (vtkIdType idx = begin; idx < end; ++idx)
+    {
+      const vtkIdType ijk[3] = { idx % dims[0], (idx / dims[0]) % dims[1],
+        idx / (static_cast<vtkIdType>(dims[0]) * dims[1]) };
+      for (int cc = 0; cc < 3; ++cc)
+      {
+        x[cc] = this->Origin[cc] + ijk[cc] * this->Spacing[cc];
+      }
+      samples.CellIds[idx] =
+        locator->FindCell(x, tol2, cell, subId, &pcoords[3 * idx], weights.data());
+    }
+  });
+
+  for (vtkIdType idx = 0; idx < numSamples; ++idx)
+  {
+    const vtkIdType cellId = samples.CellIds[idx];
+    samples.WeightOffsets[idx + 1] =
+      samples.WeightOffsets[idx] + (cellId >= 0 ? grid->GetCellSize(cellId) : 0);
+  }
+  samples.Weights.resize(samples.WeightOffsets[numSamples]);
+
+  vtkSMPTools::For(0, numSamples, [&](vtkIdType begin, vtkIdType end) {
+    vtkGenericCell* cell = tlCell.Local();
+    for (vtkIdType idx = begin; idx < end; ++idx)
+    {
+      if (samples.CellIds[idx] >= 0)
+      {
+        grid->GetCell(samples.CellIds[idx], cell);
+        cell->InterpolateFunctions(
+          &pcoords[3 * idx], samples.Weights.data() + samples.WeightOffsets[idx]);
+      }
+    }
+  });
+}
+
+vtkStandardNewMacro(vtkStaticMeshResampleToImage);
+//----------------------------------------------------------------------------
+vtkStaticMeshResampleToImage::vtkStaticMeshResampleToImage() = default;
+
+//----------------------------------------------------------------------------
+vtkStaticMeshResampleToImage::~vtkStaticMeshResampleToImage() = default;
+
+//----------------------------------------------------------------------------
+void vtkStaticMeshResampleToImage::ReleaseCache()
+{
+  this->SampleCache.reset();
+}
+
+//----------------------------------------------------------------------------
+int vtkStaticMeshResampleToImage::FillInputPortInformation(int, vtkInformation* info)
+{
+  info->Set(vtkAlgorithm::INPUT_REQUIRED_DATA_TYPE(), "vtkUnstructuredGrid");
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+int vtkStaticMeshResampleToImage::RequestInformation(
+  vtkInformation*, vtkInformationVector**, vtkInformationVector* outputVector)
+{
+  const int wholeExtent[6] = { 0, this->SamplingDimensions[0] - 1, 0,
+    this->SamplingDimensions[1] - 1, 0, this->SamplingDimensions[2] - 1 };
+  outputVector->GetInformationObject(0)->Set(
+    vtkStreamingDemandDrivenPipeline::WHOLE_EXTENT(), wholeExtent, 6);
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+int vtkStaticMeshResampleToImage::RequestData(
+  vtkInformation*, vtkInformationVector** inputVector, vtkInformationVector* outputVector)
+{
+  auto grid = vtkUnstructuredGrid::GetData(inputVector[0], 0);
+  auto output = vtkImageData::GetData(outputVector, 0);
+  const int* dims = this->SamplingDimensions;
+  if (dims[0] < 1 || dims[1] < 1 || dims[2] < 1)
+  {
+    vtkErrorMacro("Invalid sampling dimensions.");
+    return 0;
+  }
+
+  if (!this->SampleCache || !this->SampleCache->IsValid(grid, dims))
+  {
+    vtkVLogScopeF(PARAVIEW_LOG_RENDERING_VERBOSITY(),
+      "locate %dx%dx%d resampling points in %lld cells", dims[0], dims[1], dims[2],
+      static_cast<long long>(grid->GetNumberOfCells()));
+    this->SampleCache.reset(new vtkSampleCache());
+    this->SampleCache->Build(grid, dims);
+  }
+  const auto& cache = *this->SampleCache;
+  const auto& samples = cache.Samples;
+
+  output->SetExtent(0, dims[0] - 1, 0, dims[1] - 1, 0, dims[2] - 1);
+  output->SetOrigin(cache.Origin);
+  output->SetSpacing(cache.Spacing);
+  const vtkIdType numSamples = output->GetNumberOfPoints();
+  vtkPointData* outPD = output->GetPointData();
+  vtkCellArray* cells = grid->GetCells();
+
+  // point arrays are interpolated in the cell containing each sample, cell
+  // arrays are passed from that cell, as point arrays.
+  ::InterpolateWorker worker;
+  using Dispatcher = vtkArrayDispatch::Dispatch2SameValueType;
+  for (bool fromCells : { false, true })
+  {
+    vtkDataSetAttributes* inData = fromCells
+      ? static_cast<vtkDataSetAttributes*>(grid->GetCellData())
+      : static_cast<vtkDataSetAttributes*>(grid->GetPointData());
+    for (int arrayIdx = 0; arrayIdx < inData->GetNumberOfArrays(); ++arrayIdx)
+    {
+      vtkDataArray* inArray = inData->GetArray(arrayIdx);
+      if (!inArray || !inArray->GetName() || outPD->HasArray(inArray->GetName()) ||
+        strcmp(inArray->GetName(), vtkDataSetAttributes::GhostArrayName()) == 0)
+      {
+        continue;
+      }
+      vtkSmartPointer<vtkDataArray> outArray = vtk::TakeSmartPointer(inArray->NewInstance());
+      outArray->SetName(inArray->GetName());
+      outArray->SetNumberOfComponents(inArray->GetNumberOfComponents());
+      outArray->SetNumberOfTuples(numSamples);
+      if (!Dispatcher::Execute(inArray, outArray.Get(), worker, cells, samples, fromCells))
+      {
+        worker(inArray, outArray.Get(), cells, samples, fromCells);
+      }
+      outPD->AddArray(outArray);
+    }
+  }
+  if (vtkDataArray* scalars = grid->GetPointData()->GetScalars())
+  {
+    outPD->SetActiveScalars(scalars->GetName());
+  }
+  output->GetFieldData()->PassData(grid->GetFieldData());
+
+  // blank the samples outside of the grid and the cells using them, like
+  // vtkResampleToImage.
+  vtkNew<vtkCharArray> mask;
+  mask->SetName("vtkValidPointMask");
+  mask->SetNumberOfTuples(numSamples);
+  vtkNew<vtkUnsignedCharArray> pointGhosts;
+  pointGhosts->SetName(vtkDataSetAttributes::GhostArrayName());
+  pointGhosts->SetNumberOfTuples(numSamples);
+  vtkSMPTools::For(0, numSamples, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType idx = begin; idx < end; ++idx)
+    {
+      const bool valid = samples.CellIds[idx] >= 0;
+      mask->SetValue(idx, valid ? 1 : 0);
+      pointGhosts->SetValue(idx, valid ? 0 : vtkDataSetAttributes::HIDDENPOINT);
+    }
+  });
+  outPD->AddArray(mask);
+  outPD->AddArray(pointGhosts);
+
+  const vtkIdType numCells = output->GetNumberOfCells();
+  vtkNew<vtkUnsignedCharArray> cellGhosts;
+  cellGhosts->SetName(vtkDataSetAttributes::GhostArrayName());
+  cellGhosts->SetNumberOfTuples(numCells);
+  vtkSMPThreadLocalObject<vtkIdList> tlCellPoints;
+  vtkSMPTools::For(0, numCells, [&](vtkIdType begin, vtkIdType end) {
+    vtkIdList* ptIds = tlCellPoints.Local();
+    for (vtkIdType cellId = begin; cellId < end; ++cellId)
+    {
+      output->GetCellPoints(cellId, ptIds);
+      unsigned char ghost = 0;
+      for (vtkIdType pt = 0; pt < ptIds->GetNumberOfIds(); ++pt)
+      {
+        if (samples.CellIds[ptIds->GetId(pt)] < 0)
+        {
+          ghost = vtkDataSetAttributes::HIDDENCELL;
+          break;
+        }
+      }
+      cellGhosts->SetValue(cellId, ghost);
+    }
+  });
+  output->GetCellData()->AddArray(cellGhosts);
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+void vtkStaticMeshResampleToImage::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "SamplingDimensions: " << this->SamplingDimensions[0] << " "
+     << this->SamplingDimensions[1] << " " << this->SamplingDimensions[2] << endl;
+}
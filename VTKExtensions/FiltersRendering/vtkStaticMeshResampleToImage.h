@@ -0,0 +1,74 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+/**
+ * @class   vtkStaticMeshResampleToImage
+ * @brief   resamples an unstructured grid to an image, caching the sample locations
+ *
+ * vtkStaticMeshResampleToImage resamples an unstructured grid on an image
+ * covering its bounds, producing the same output as vtkResampleToImage with
+ * UseInputBounds on: point arrays are interpolated, cell arrays are passed
+ * as point arrays, and the samples outside of the grid are flagged in the
+ * "vtkValidPointMask" array and blanked using the ghost arrays.
+ *
+ * The cell containing each sample and the interpolation weights of its points
+ * are kept as long as the points, connectivity, offsets and cell types of the
+ * input are unchanged, even when they are new arrays holding the same values
+ * as a reader loading the mesh of each time step produces. Resampling another
+ * time step of a static mesh then only interpolates the new values.
+ *
+ * Unlike vtkResampleToImage, this filter does not partition the image across
+ * processes and only supports a single vtkUnstructuredGrid as input.
+ *
+ * @sa
+ * vtkResampleToImage
+ */
+
+#ifndef vtkStaticMeshResampleToImage_h
+#define vtkStaticMeshResampleToImage_h
+
+#include "vtkImageAlgorithm.h"
+#include "vtkPVVTKExtensionsFiltersRenderingModule.h" // needed for export macro
+
+#include <memory> // for std::unique_ptr
+
+class VTKPVVTKEXTENSIONSFILTERSRENDERING_EXPORT vtkStaticMeshResampleToImage
+  : public vtkImageAlgorithm
+{
+public:
+  static vtkStaticMeshResampleToImage* New();
+  vtkTypeMacro(vtkStaticMeshResampleToImage, vtkImageAlgorithm);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  ///@{
+  /**
+   * Set/Get the number of samples along each axis. Default is 10x10x10.
+   */
+  vtkSetVector3Macro(SamplingDimensions, int);
+  vtkGetVector3Macro(SamplingDimensions, int);
+  ///@}
+
+  /**
+   * Releases the cached sample locations. They are located again on the next
+   * execution.
+   */
+  void ReleaseCache();
+
+protected:
+  vtkStaticMeshResampleToImage();
+  ~vtkStaticMeshResampleToImage() override;
+
+  int RequestInformation(vtkInformation*, vtkInformationVector**, vtkInformationVector*) override;
+  int RequestData(vtkInformation*, vtkInformationVector**, vtkInformationVector*) override;
+  int FillInputPortInformation(int port, vtkInformation* info) override;
+
+  int SamplingDimensions[3] = { 10, 10, 10 };
+
+private:
+  vtkStaticMeshResampleToImage(const vtkStaticMeshResampleToImage&) = delete;
+  void operator=(const vtkStaticMeshResampleToImage&) = delete;
+
+  struct vtkSampleCache;
+  std::unique_ptr<vtkSampleCache> SampleCache;
+};
+
+#endif
@@ -0,0 +1,174 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "vtkDataObjectTreeIterator.h"
+#include "vtkDoubleArray.h"
+#include "vtkIntArray.h"
+#include "vtkLogger.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkNew.h"
+#include "vtkPSciVizContingencyStats.h"
+#include "vtkPSciVizDescriptiveStats.h"
+#include "vtkStringArray.h"
+#include "vtkTable.h"
+
+#include <cmath>
+#include <string>
+
+namespace
+{
+const vtkIdType NumberOfRows = 3000;
+
+// Returns the first table of the model that has all the given columns.
+vtkTable* FindModelTable(vtkMultiBlockDataSet* model, const char* column0, const char* column1)
+{
+  vtkSmartPointer<vtkDataObjectTreeIterator> iter;
+  iter.TakeReference(model->NewTreeIterator());
+  for (iter->InitTraversal(); !iter->IsDoneWithTraversal(); iter->GoToNextItem())
+  {
+    vtkTable* table = vtkTable::SafeDownCast(iter->GetCurrentDataObject());
+    if (table && table->GetColumnByName(column0) && table->GetColumnByName(column1))
+    {
+      return table;
+    }
+  }
+  return nullptr;
+}
+
+// Returns the row of the descriptive statistics of the given variable.
+vtkIdType FindVariable(vtkTable* stats, const std::string& name)
+{
+  vtkStringArray* variables = vtkStringArray::SafeDownCast(stats->GetColumnByName("Variable"));
+  for (vtkIdType row = 0; variables && row < variables->GetNumberOfValues(); ++row)
+  {
+    if (variables->GetValue(row) == name)
+    {
+      return row;
+    }
+  }
+  return -1;
+}
+
+// Checks the descriptive statistics of the 3 components of "vectors" whose
+// tuples are (i, 2i, -i) for a few i's. `cardinality` is the expected number
+// of rows used, which are not known when training on a subset, but the
+// components of the same rows must have been used.
+bool CheckDescriptiveStats(vtkTable* input, int task, double fraction, vtkIdType cardinality)
+{
+  vtkNew<vtkPSciVizDescriptiveStats> stats;
+  stats->SetInputData(input);
+  stats->SetAttributeMode(vtkDataObject::ROW);
+  stats->EnableAttributeArray("vectors");
+  stats->SetTask(task);
+  stats->SetTrainingFraction(fraction);
+  stats->Update();
+
+  vtkTable* primary = FindModelTable(
+    vtkMultiBlockDataSet::SafeDownCast(stats->GetOutputDataObject(0)), "Variable", "Mean");
+  if (!primary)
+  {
+    vtkLog(ERROR, "Missing descriptive statistics.");
+    return false;
+  }
+
+  double means[3];
+  for (int comp = 0; comp < 3; ++comp)
+  {
+    const vtkIdType row = FindVariable(primary, "vectors_" + std::to_string(comp));
+    if (row < 0)
+    {
+      vtkLogF(ERROR, "Missing statistics of component %d.", comp);
+      return false;
+    }
+    if (primary->GetValueByName(row, "Cardinality").ToLongLong() != cardinality)
+    {
+      vtkLogF(ERROR, "Wrong cardinality for component %d.", comp);
+      return false;
+    }
+    means[comp] = primary->GetValueByName(row, "Mean").ToDouble();
+  }
+  if (std::abs(means[1] - 2 * means[0]) > 1e-6 || std::abs(means[2] + means[0]) > 1e-6)
+  {
+    vtkLogF(ERROR, "Components do not come from the same rows: means are %g, %g and %g.",
+      means[0], means[1], means[2]);
+    return false;
+  }
+  return true;
+}
+
+// Checks that the components of "labels", whose tuples are ("a<k>", "b<k>"),
+// are paired correctly in the contingency table.
+bool CheckContingencyStats(vtkTable* input)
+{
+  vtkNew<vtkPSciVizContingencyStats> stats;
+  stats->SetInputData(input);
+  stats->SetAttributeMode(vtkDataObject::ROW);
+  stats->EnableAttributeArray("labels");
+  stats->SetTask(vtkSciVizStatistics::MODEL_INPUT);
+  stats->Update();
+
+  vtkTable* contingency =
+    FindModelTable(vtkMultiBlockDataSet::SafeDownCast(stats->GetOutputDataObject(0)), "x", "y");
+  if (!contingency)
+  {
+    vtkLog(ERROR, "Missing contingency table.");
+    return false;
+  }
+  int pairs = 0;
+  for (vtkIdType row = 0; row < contingency->GetNumberOfRows(); ++row)
+  {
+    const std::string x = contingency->GetValueByName(row, "x").ToString();
+    const std::string y = contingency->GetValueByName(row, "y").ToString();
+    if (x.size() == 2 && y.size() == 2 && x[0] == 'a' && y[0] == 'b')
+    {
+      if (x[1] != y[1])
+      {
+        vtkLogF(ERROR, "Wrong pair (%s, %s).", x.c_str(), y.c_str());
+        return false;
+      }
+      ++pairs;
+    }
+  }
+  if (pairs != 3)
+  {
+    vtkLogF(ERROR, "Expected 3 pairs, got %d.", pairs);
+    return false;
+  }
+  return true;
+}
+}
+
+// Tests how vtkSciVizStatistics splits multi-component numeric and string
+// arrays into columns, with and without a training subset.
+int TestSciVizStatisticsComponents(int, char*[])
+{
+  vtkNew<vtkDoubleArray> vectors;
+  vectors->SetName("vectors");
+  vectors->SetNumberOfComponents(3);
+  vectors->SetNumberOfTuples(NumberOfRows);
+  vtkNew<vtkStringArray> labels;
+  labels->SetName("labels");
+  labels->SetNumberOfComponents(2);
+  labels->SetNumberOfTuples(NumberOfRows);
+  for (vtkIdType i = 0; i < NumberOfRows; ++i)
+  {
+    const double value = static_cast<double>(i % 101);
+    vectors->SetTypedComponent(i, 0, value);
+    vectors->SetTypedComponent(i, 1, 2 * value);
+    vectors->SetTypedComponent(i, 2, -value);
+    const std::string index = std::to_string(i % 3);
+    labels->SetValue(2 * i, "a" + index);
+    labels->SetValue(2 * i + 1, "b" + index);
+  }
+  vtkNew<vtkTable> input;
+  input->AddColumn(vectors);
+  input->AddColumn(labels);
+
+  if (!CheckDescriptiveStats(input, vtkSciVizStatistics::MODEL_INPUT, 1.0, NumberOfRows) ||
+    !CheckDescriptiveStats(input, vtkSciVizStatistics::CREATE_MODEL, 0.5, NumberOfRows / 2) ||
+    !CheckContingencyStats(input))
+  {
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,177 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "vtkDataObjectTreeIterator.h"
+#include "vtkDataSetAttributes.h"
+#include "vtkDescriptiveStatistics.h"
+#include "vtkDoubleArray.h"
+#include "vtkIntArray.h"
+#include "vtkLogger.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkMultiCorrelativeStatistics.h"
+#include "vtkNew.h"
+#include "vtkPCAStatistics.h"
+#include "vtkPSciVizDescriptiveStats.h"
+#include "vtkPSciVizMultiCorrelativeStats.h"
+#include "vtkPSciVizPCAStats.h"
+#include "vtkTable.h"
+#include "vtkUnsignedCharArray.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+const vtkIdType NumberOfRows = 5000;
+const char* const ColumnNames[] = { "scalars", "vectors_0", "vectors_1" };
+
+// Compares every value of the tables of two models.
+bool CompareModels(vtkMultiBlockDataSet* model, vtkMultiBlockDataSet* reference)
+{
+  vtkSmartPointer<vtkDataObjectTreeIterator> iter;
+  iter.TakeReference(model->NewTreeIterator());
+  vtkSmartPointer<vtkDataObjectTreeIterator> refIter;
+  refIter.TakeReference(reference->NewTreeIterator());
+  int numberOfTables = 0;
+  for (iter->InitTraversal(), refIter->InitTraversal();
+       !iter->IsDoneWithTraversal() && !refIter->IsDoneWithTraversal();
+       iter->GoToNextItem(), refIter->GoToNextItem(), ++numberOfTables)
+  {
+    vtkTable* table = vtkTable::SafeDownCast(iter->GetCurrentDataObject());
+    vtkTable* refTable = vtkTable::SafeDownCast(refIter->GetCurrentDataObject());
+    if (!table || !refTable || table->GetNumberOfRows() != refTable->GetNumberOfRows() ||
+      table->GetNumberOfColumns() != refTable->GetNumberOfColumns())
+    {
+      vtkLogF(ERROR, "Table %d does not have the expected size.", numberOfTables);
+      return false;
+    }
+    for (vtkIdType col = 0; col < table->GetNumberOfColumns(); ++col)
+    {
+      for (vtkIdType row = 0; row < table->GetNumberOfRows(); ++row)
+      {
+        const vtkVariant value = table->GetValue(row, col);
+        const vtkVariant refValue = refTable->GetValue(row, col);
+        if (refValue.IsNumeric())
+        {
+          const double expected = refValue.ToDouble();
+          if (std::abs(value.ToDouble() - expected) > 1e-8 * std::max(1., std::abs(expected)))
+          {
+            vtkLogF(ERROR, "Table %d, column %s, row %lld: got %.17g instead of %.17g.",
+              numberOfTables, refTable->GetColumnName(col), static_cast<long long>(row),
+              value.ToDouble(), expected);
+            return false;
+          }
+        }
+        else if (value.ToString() != refValue.ToString())
+        {
+          vtkLogF(ERROR, "Table %d, column %s, row %lld: got \"%s\" instead of \"%s\".",
+            numberOfTables, refTable->GetColumnName(col), static_cast<long long>(row),
+            value.ToString().c_str(), refValue.ToString().c_str());
+          return false;
+        }
+      }
+    }
+  }
+  if (!iter->IsDoneWithTraversal() || !refIter->IsDoneWithTraversal() || numberOfTables == 0)
+  {
+    vtkLog(ERROR, "Models do not have the same tables.");
+    return false;
+  }
+  return true;
+}
+
+// Runs a statistics filter on `input` and compares its model to the one of
+// `reference` learned from `observations`, the rows of `input` that are not ghosts.
+bool CheckModel(vtkSciVizStatistics* stats, vtkTable* input, vtkStatisticsAlgorithm* reference,
+  vtkTable* observations)
+{
+  stats->SetInputData(input);
+  stats->SetAttributeMode(vtkDataObject::ROW);
+  stats->EnableAttributeArray("scalars");
+  stats->EnableAttributeArray("vectors");
+  stats->SetTask(vtkSciVizStatistics::MODEL_INPUT);
+  stats->Update();
+
+  reference->SetInputData(vtkStatisticsAlgorithm::INPUT_DATA, observations);
+  reference->SetLearnOption(true);
+  reference->SetDeriveOption(true);
+  reference->SetAssessOption(false);
+  reference->Update();
+
+  if (!CompareModels(vtkMultiBlockDataSet::SafeDownCast(stats->GetOutputDataObject(0)),
+        vtkMultiBlockDataSet::SafeDownCast(
+          reference->GetOutputDataObject(vtkStatisticsAlgorithm::OUTPUT_MODEL))))
+  {
+    vtkLogF(ERROR, "Wrong model for %s.", stats->GetClassName());
+    return false;
+  }
+  return true;
+}
+}
+
+// Tests that the models vtkSciVizStatistics subclasses build from moments
+// computed over the arrays match the ones learned from a table.
+int TestSciVizStatisticsMoments(int, char*[])
+{
+  vtkNew<vtkIntArray> scalars;
+  scalars->SetName("scalars");
+  scalars->SetNumberOfTuples(NumberOfRows);
+  vtkNew<vtkDoubleArray> vectors;
+  vectors->SetName("vectors");
+  vectors->SetNumberOfComponents(2);
+  vectors->SetNumberOfTuples(NumberOfRows);
+  vtkNew<vtkUnsignedCharArray> ghosts;
+  ghosts->SetName(vtkDataSetAttributes::GhostArrayName());
+  ghosts->SetNumberOfTuples(NumberOfRows);
+
+  vtkNew<vtkTable> observations;
+  vtkNew<vtkDoubleArray> columns[3];
+  for (int col = 0; col < 3; ++col)
+  {
+    columns[col]->SetName(ColumnNames[col]);
+    observations->AddColumn(columns[col]);
+  }
+  for (vtkIdType i = 0; i < NumberOfRows; ++i)
+  {
+    // Ghosts have outlying values which must not be part of the statistics.
+    const bool ghost = i % 7 == 3;
+    const double values[3] = { static_cast<double>(i % 23),
+      ghost ? 1e6 : 100. + 10. * std::sin(0.01 * i), ghost ? -1e6 : std::cos(0.3 * i) + i % 5 };
+    scalars->SetValue(i, static_cast<int>(values[0]));
+    vectors->SetTypedComponent(i, 0, values[1]);
+    vectors->SetTypedComponent(i, 1, values[2]);
+    ghosts->SetValue(i, ghost ? vtkDataSetAttributes::DUPLICATEPOINT : 0);
+    if (!ghost)
+    {
+      for (int col = 0; col < 3; ++col)
+      {
+        columns[col]->InsertNextValue(values[col]);
+      }
+    }
+  }
+  vtkNew<vtkTable> input;
+  input->AddColumn(scalars);
+  input->AddColumn(vectors);
+  input->GetRowData()->AddArray(ghosts);
+
+  vtkNew<vtkPSciVizDescriptiveStats> descriptive;
+  vtkNew<vtkDescriptiveStatistics> descriptiveReference;
+  vtkNew<vtkPSciVizMultiCorrelativeStats> multiCorrelative;
+  vtkNew<vtkMultiCorrelativeStatistics> multiCorrelativeReference;
+  vtkNew<vtkPSciVizPCAStats> pca;
+  vtkNew<vtkPCAStatistics> pcaReference;
+  for (const char* name : ColumnNames)
+  {
+    descriptiveReference->AddColumn(name);
+    multiCorrelativeReference->SetColumnStatus(name, 1);
+    pcaReference->SetColumnStatus(name, 1);
+  }
+
+  if (!CheckModel(descriptive, input, descriptiveReference, observations) ||
+    !CheckModel(multiCorrelative, input, multiCorrelativeReference, observations) ||
+    !CheckModel(pca, input, pcaReference, observations))
+  {
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
@@ -4,9 +4,11 @@
 #include "vtkSciVizStatisticsPrivate.h"
 
 #include "vtkDataSetAttributes.h"
+#include "vtkDescriptiveStatistics.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkMultiBlockDataSet.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPDescriptiveStatistics.h"
 #include "vtkTable.h"
@@ -59,6 +61,23 @@ int vtkPSciVizDescriptiveStats::LearnAndDerive(vtkMultiBlockDataSet* modelDO, vt
   return 1;
 }
 
+int vtkPSciVizDescriptiveStats::GetRequiredMoments()
+{
+  return UNIVARIATE_MOMENTS;
+}
+
+int vtkPSciVizDescriptiveStats::LearnAndDeriveFromMoments(
+  vtkMultiBlockDataSet* modelDO, const vtkSciVizStatisticsMoments& moments)
+{
+  // The moments are already reduced across processes.
+  vtkNew<vtkDescriptiveStatistics> stats;
+  for (const std::string& name : moments.Names)
+  {
+    stats->AddColumn(name.c_str());
+  }
+  return this->BuildModelFromMoments(stats, modelDO, moments);
+}
+
 int vtkPSciVizDescriptiveStats::AssessData(
   vtkTable* observations, vtkDataObject* assessedOut, vtkMultiBlockDataSet* modelOut)
 {
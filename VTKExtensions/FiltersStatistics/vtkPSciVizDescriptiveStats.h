@@ -35,6 +35,9 @@ protected:
   ~vtkPSciVizDescriptiveStats() override;
 
   int LearnAndDerive(vtkMultiBlockDataSet* model, vtkTable* inData) override;
+  int GetRequiredMoments() override;
+  int LearnAndDeriveFromMoments(
+    vtkMultiBlockDataSet* model, const vtkSciVizStatisticsMoments& moments) override;
   int AssessData(
     vtkTable* observations, vtkDataObject* dataset, vtkMultiBlockDataSet* model) override;
 
@@ -7,6 +7,8 @@
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkMultiBlockDataSet.h"
+#include "vtkMultiCorrelativeStatistics.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPMultiCorrelativeStatistics.h"
 #include "vtkStringArray.h"
@@ -48,6 +50,23 @@ int vtkPSciVizMultiCorrelativeStats::LearnAndDerive(vtkMultiBlockDataSet* modelD
   return 1;
 }
 
+int vtkPSciVizMultiCorrelativeStats::GetRequiredMoments()
+{
+  return COVARIANCE_MOMENTS;
+}
+
+int vtkPSciVizMultiCorrelativeStats::LearnAndDeriveFromMoments(
+  vtkMultiBlockDataSet* modelDO, const vtkSciVizStatisticsMoments& moments)
+{
+  // The moments are already reduced across processes.
+  vtkNew<vtkMultiCorrelativeStatistics> stats;
+  for (const std::string& name : moments.Names)
+  {
+    stats->SetColumnStatus(name.c_str(), 1);
+  }
+  return this->BuildModelFromMoments(stats, modelDO, moments);
+}
+
 int vtkPSciVizMultiCorrelativeStats::AssessData(
   vtkTable* observations, vtkDataObject* assessedOut, vtkMultiBlockDataSet* modelOut)
 {
@@ -7,6 +7,8 @@
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkMultiBlockDataSet.h"
+#include "vtkNew.h"
+#include "vtkPCAStatistics.h"
 #include "vtkObjectFactory.h"
 #include "vtkPPCAStatistics.h"
 #include "vtkStringArray.h"
@@ -62,6 +64,25 @@ int vtkPSciVizPCAStats::LearnAndDerive(vtkMultiBlockDataSet* modelDO, vtkTable*
   return 1;
 }
 
+int vtkPSciVizPCAStats::GetRequiredMoments()
+{
+  // The median absolute deviation of robust PCA needs all the observations.
+  return this->RobustPCA ? NO_MOMENTS : COVARIANCE_MOMENTS;
+}
+
+int vtkPSciVizPCAStats::LearnAndDeriveFromMoments(
+  vtkMultiBlockDataSet* modelDO, const vtkSciVizStatisticsMoments& moments)
+{
+  // The moments are already reduced across processes.
+  vtkNew<vtkPCAStatistics> stats;
+  for (const std::string& name : moments.Names)
+  {
+    stats->SetColumnStatus(name.c_str(), 1);
+  }
+  stats->SetNormalizationScheme(this->NormalizationScheme);
+  return this->BuildModelFromMoments(stats, modelDO, moments);
+}
+
 int vtkPSciVizPCAStats::AssessData(
   vtkTable* observations, vtkDataObject* assessedOut, vtkMultiBlockDataSet* modelOut)
 {
@@ -65,6 +65,9 @@ protected:
   ~vtkPSciVizPCAStats() override;
 
   int LearnAndDerive(vtkMultiBlockDataSet* model, vtkTable* inData) override;
+  int GetRequiredMoments() override;
+  int LearnAndDeriveFromMoments(
+    vtkMultiBlockDataSet* model, const vtkSciVizStatisticsMoments& moments) override;
   int AssessData(
     vtkTable* observations, vtkDataObject* dataset, vtkMultiBlockDataSet* model) override;
 
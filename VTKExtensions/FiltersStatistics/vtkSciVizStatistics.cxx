@@ -3,14 +3,20 @@
 #include "vtkSciVizStatistics.h"
 #include "vtkSciVizStatisticsPrivate.h"
 
+#include "vtkAOSDataArrayTemplate.h"
 #include "vtkAlgorithm.h"
+#include "vtkArrayDispatch.h"
 #include "vtkCellData.h"
+#include "vtkCommunicator.h"
 #include "vtkCompositeDataSet.h"
 #include "vtkDataArray.h"
+#include "vtkDataArrayRange.h"
 #include "vtkDataObject.h"
 #include "vtkDataObjectTreeIterator.h"
 #include "vtkDataSetAttributes.h"
 #include "vtkDemandDrivenPipeline.h"
+#include "vtkDoubleArray.h"
+#include "vtkIdList.h"
 #include "vtkInformation.h"
 #include "vtkInformationIntegerKey.h"
 #include "vtkInformationVector.h"
@@ -21,14 +27,136 @@
 #include "vtkObjectFactory.h"
 #include "vtkPartitionedDataSet.h"
 #include "vtkPointData.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
 #include "vtkStatisticsAlgorithm.h"
 #include "vtkStringArray.h"
 #include "vtkTable.h"
 #include "vtkUnsignedCharArray.h"
-#include "vtkVariantArray.h"
 
+#include <algorithm>
+#include <limits>
+#include <map>
 #include <set>
 #include <sstream>
+#include <vector>
+
+namespace
+{
+// Splits a multi-component array into single-component columns in a single
+// multithreaded pass over the source array.
+struct SplitComponentsWorker
+{
+  template <typename ArrayT>
+  void operator()(ArrayT* source, const std::vector<vtkAbstractArray*>& columns)
+  {
+    using ValueType = vtk::GetAPIType<ArrayT>;
+    using ColumnT = vtkAOSDataArrayTemplate<ValueType>;
+
+    const int numComp = source->GetNumberOfComponents();
+    std::vector<ValueType*> outputs(numComp, nullptr);
+    for (int comp = 0; comp < numComp; ++comp)
+    {
+      ColumnT* column = ColumnT::FastDownCast(columns[comp]);
+      if (!column)
+      {
+        // columns are created with vtkAbstractArray::CreateArray, which should
+        // always give AOS arrays of the same value type, fall back otherwise.
+        (*this)(static_cast<vtkDataArray*>(source), columns);
+        return;
+      }
+      outputs[comp] = column->GetPointer(0);
+    }
+
+    vtkSMPTools::For(0, source->GetNumberOfTuples(), [&](vtkIdType begin, vtkIdType end) {
+      const auto tuples = vtk::DataArrayTupleRange(source, begin, end);
+      vtkIdType tupleIdx = begin;
+      for (const auto tuple : tuples)
+      {
+        for (int comp = 0; comp < numComp; ++comp)
+        {
+          outputs[comp][tupleIdx] = tuple[comp];
+        }
+        ++tupleIdx;
+      }
+    });
+  }
+
+  void operator()(vtkDataArray* source, const std::vector<vtkAbstractArray*>& columns)
+  {
+    for (int comp = 0; comp < source->GetNumberOfComponents(); ++comp)
+    {
+      vtkDataArray::SafeDownCast(columns[comp])->CopyComponent(0, source, comp);
+    }
+  }
+};
+
+// Names of the table columns the components of an array are split into.
+std::vector<std::string> GetColumnNames(vtkAbstractArray* arr)
+{
+  const int ncomp = arr->GetNumberOfComponents();
+  if (ncomp == 1)
+  {
+    return { arr->GetName() };
+  }
+
+  // Check component names can be used
+  std::set<std::string> compCheckSet;
+  bool useCompNames = true;
+  for (int i = 0; i < ncomp; ++i)
+  {
+    const char* compName = arr->GetComponentName(i);
+    if (!compName || compCheckSet.count(compName) > 0)
+    {
+      useCompNames = false;
+      break;
+    }
+    compCheckSet.emplace(compName);
+  }
+
+  std::vector<std::string> names;
+  for (int i = 0; i < ncomp; ++i)
+  {
+    std::ostringstream os;
+    os << arr->GetName() << "_";
+    useCompNames ? os << arr->GetComponentName(i) : os << i;
+    names.push_back(os.str());
+  }
+  return names;
+}
+
+// Number of rows whose values are gathered at once when computing moments,
+// small enough for the values of all variables to stay in cache.
+const vtkIdType MomentsBlockSize = 512;
+
+// Copies a component of a range of rows (or of the rows listed in `ids`
+// from `first` on) of an array to `out`.
+struct GatherComponentWorker
+{
+  template <typename ArrayT>
+  void operator()(ArrayT* array, int comp, const vtkIdType* ids, vtkIdType first,
+    vtkIdType count, double* out)
+  {
+    const auto tuples = vtk::DataArrayTupleRange(array);
+    for (vtkIdType k = 0; k < count; ++k)
+    {
+      out[k] = static_cast<double>(tuples[ids ? ids[first + k] : first + k][comp]);
+    }
+  }
+};
+
+// Returns the number of entries flagged in the ghost array.
+vtkIdType CountGhosts(vtkUnsignedCharArray* ghosts)
+{
+  if (!ghosts)
+  {
+    return 0;
+  }
+  const auto values = vtk::DataArrayValueRange<1>(ghosts);
+  return static_cast<vtkIdType>(
+    std::count_if(values.cbegin(), values.cend(), [](unsigned char ghost) { return ghost != 0; }));
+}
+}
 
 vtkCxxSetObjectMacro(vtkSciVizStatistics, Controller, vtkMultiProcessController);
 
@@ -324,7 +452,7 @@ int vtkSciVizStatistics::RequestData(
     stat = this->RequestData(dataObjOu, modelObjOu, dataObjIn, modelObjIn);
   }
 
-  if (this->Controller->GetLocalProcessId() != 0)
+  if (this->Controller && this->Controller->GetLocalProcessId() != 0)
   {
     modelObjOu->Initialize();
   }
@@ -454,12 +582,39 @@ int vtkSciVizStatistics::RequestData(
     return 1;
   }
 
+  // Models that only depend on moments of the observations are learned
+  // directly from the arrays, the table is then only built for assessment.
+  const bool assess = this->Task != CREATE_MODEL && this->Task != MODEL_INPUT;
+  const int momentsType = this->Task != ASSESS_INPUT ? this->GetRequiredMoments() : NO_MOMENTS;
+  vtkSciVizStatisticsMoments moments;
+  bool haveMoments = false;
+  vtkIdType N = 0;
+  vtkIdType M = 0;
+  if (momentsType != NO_MOMENTS)
+  {
+    vtkUnsignedCharArray* ghosts = dataAttrIn->GetGhostArray();
+    const vtkIdType numberOfRows = dataAttrIn->GetNumberOfTuples();
+    N = numberOfRows - ::CountGhosts(ghosts);
+    M = this->Task == MODEL_INPUT ? N : this->GetNumberOfObservationsForTraining(N);
+    vtkNew<vtkIdList> rowIds;
+    if (M != N)
+    {
+      this->SelectTrainingRows(ghosts, numberOfRows, M, rowIds);
+    }
+    haveMoments = this->ComputeMoments(
+      dataAttrIn, M != N ? rowIds.GetPointer() : nullptr, momentsType, moments);
+  }
+
   // Create a table with all the data
   vtkNew<vtkTable> inTable;
-  int stat = this->PrepareFullDataTable(inTable, dataAttrIn);
-  if (stat < 1)
-  { // return an error (stat=0) or success (stat=-1)
-    return -stat;
+  int stat = 1;
+  if (!haveMoments || assess)
+  {
+    stat = this->PrepareFullDataTable(inTable, dataAttrIn);
+    if (stat < 1)
+    { // return an error (stat=0) or success (stat=-1)
+      return -stat;
+    }
   }
 
   // Either create or retrieve the model, depending on the task at hand
@@ -468,21 +623,11 @@ int vtkSciVizStatistics::RequestData(
     // We are creating a model by executing Learn and Derive operations on the input data
     // Create a table to hold the input data (unless the TrainingFraction is exactly 1.0)
     vtkSmartPointer<vtkTable> train = nullptr;
-    vtkIdType N = inTable->GetNumberOfRows();
-
-    vtkUnsignedCharArray* ghosts = inTable->GetRowData()->GetGhostArray();
-    if (ghosts)
+    if (!haveMoments)
     {
-      for (vtkIdType id = 0; id < ghosts->GetNumberOfValues(); ++id)
-      {
-        if (ghosts->GetValue(id))
-        {
-          --N;
-        }
-      }
+      N = inTable->GetNumberOfRows() - ::CountGhosts(inTable->GetRowData()->GetGhostArray());
+      M = this->Task == MODEL_INPUT ? N : this->GetNumberOfObservationsForTraining(N);
     }
-
-    vtkIdType M = this->Task == MODEL_INPUT ? N : this->GetNumberOfObservationsForTraining(N);
     if (M == N)
     {
       train = inTable;
@@ -495,7 +640,7 @@ int vtkSciVizStatistics::RequestData(
                         << " Any assessment will not be able to detect overfitting.");
       }
     }
-    else
+    else if (!haveMoments)
     {
       train = vtkSmartPointer<vtkTable>::New();
       this->PrepareTrainingTable(train, inTable, M);
@@ -511,7 +656,8 @@ int vtkSciVizStatistics::RequestData(
     else
     {
       outModel->Initialize();
-      stat = this->LearnAndDerive(outModelDS, train);
+      stat = haveMoments ? this->LearnAndDeriveFromMoments(outModelDS, moments)
+                         : this->LearnAndDerive(outModelDS, train);
     }
   }
   else
@@ -541,7 +687,7 @@ int vtkSciVizStatistics::RequestData(
     vtkErrorMacro("No model output dataset or incorrect type");
     return 0;
   }
-  if (this->Task != CREATE_MODEL && this->Task != MODEL_INPUT)
+  if (assess)
   {
     // Assess the data using the input or the just-created model
     stat = this->AssessData(inTable, outData, outModelDS);
@@ -568,31 +714,11 @@ int vtkSciVizStatistics::PrepareFullDataTable(vtkTable* inTable, vtkFieldData* d
         // Create a column in the table for each component of non-scalar arrays requested.
         // FIXME: Should we add a "norm" column when arr is a vtkDataArray? It would make sense.
         std::vector<vtkAbstractArray*> comps;
-        const char* compName;
-
-        // Check component names can be used
-        std::set<std::string> compCheckSet;
-        bool useCompNames = true;
-        for (int i = 0; i < ncomp; ++i)
-        {
-          compName = arr->GetComponentName(i);
-          if (!compName || compCheckSet.count(compName) > 0)
-          {
-            useCompNames = false;
-            break;
-          }
-          compCheckSet.emplace(compName);
-        }
-
+        const std::vector<std::string> names = ::GetColumnNames(arr);
         for (int i = 0; i < ncomp; ++i)
         {
-          std::ostringstream os;
-          compName = arr->GetComponentName(i);
-          os << arr->GetName() << "_";
-          useCompNames ? os << compName : os << i;
-
           vtkAbstractArray* arrCol = vtkAbstractArray::CreateArray(arr->GetDataType());
-          arrCol->SetName(os.str().c_str());
+          arrCol->SetName(names[i].c_str());
           arrCol->SetNumberOfComponents(1);
           arrCol->SetNumberOfTuples(ntup);
           comps.push_back(arrCol);
@@ -604,15 +730,16 @@ int vtkSciVizStatistics::PrepareFullDataTable(vtkTable* inTable, vtkFieldData* d
         vtkStringArray* sarr = vtkStringArray::SafeDownCast(arr);
         if (darr)
         {
-          for (int i = 0; i < ncomp; ++i)
+          SplitComponentsWorker worker;
+          if (!vtkArrayDispatch::Dispatch::Execute(darr, worker, comps))
           {
-            vtkDataArray::SafeDownCast(comps[i])->CopyComponent(0, darr, i);
+            worker(darr, comps);
           }
         }
         else if (sarr)
         {
-          std::vector<vtkStringArray*> scomps;
-          for (int i = 0; i < ncomp; ++i, ++vidx)
+          std::vector<vtkStringArray*> scomps(ncomp);
+          for (int i = 0; i < ncomp; ++i)
           {
             scomps[i] = vtkStringArray::SafeDownCast(comps[i]);
           }
@@ -665,10 +792,32 @@ int vtkSciVizStatistics::PrepareTrainingTable(
   // FIXME: this should eventually eliminate duplicate points as well as subsample...
   //        but will require the original ugrid/polydata/graph.
 
-  vtkUnsignedCharArray* ghosts = fullDataTable->GetRowData()->GetGhostArray();
+  vtkNew<vtkIdList> rowIds;
+  this->SelectTrainingRows(fullDataTable->GetRowData()->GetGhostArray(),
+    fullDataTable->GetNumberOfRows(), M, rowIds);
 
+  // Copy the subset into the training table, one column at a time using
+  // typed tuple copies rather than going through a variant per value.
+  trainingTable->Initialize();
+  for (int i = 0; i < fullDataTable->GetNumberOfColumns(); ++i)
+  {
+    vtkAbstractArray* srcCol = fullDataTable->GetColumn(i);
+    vtkAbstractArray* dstCol = srcCol->NewInstance();
+    dstCol->SetName(srcCol->GetName());
+    dstCol->SetNumberOfComponents(srcCol->GetNumberOfComponents());
+    dstCol->SetNumberOfTuples(rowIds->GetNumberOfIds());
+    srcCol->GetTuples(rowIds, dstCol);
+    trainingTable->AddColumn(dstCol);
+    dstCol->FastDelete();
+  }
+  return 1;
+}
+
+void vtkSciVizStatistics::SelectTrainingRows(
+  vtkUnsignedCharArray* ghosts, vtkIdType numberOfRows, vtkIdType M, vtkIdList* rowIds)
+{
   std::set<vtkIdType> trainRows;
-  vtkIdType N = fullDataTable->GetNumberOfRows();
+  vtkIdType N = numberOfRows;
   double frac = static_cast<double>(M) / static_cast<double>(N);
   vtkNew<vtkMinimalStandardRandomSequence> rand;
   for (vtkIdType i = 0; i < N; ++i)
@@ -700,25 +849,12 @@ int vtkSciVizStatistics::PrepareTrainingTable(
       trainRows.insert(rec);
     }
   }
-  // Finally, copy the subset into the training table
-  trainingTable->Initialize();
-  for (int i = 0; i < fullDataTable->GetNumberOfColumns(); ++i)
+  rowIds->Initialize();
+  rowIds->Allocate(static_cast<vtkIdType>(trainRows.size()));
+  for (vtkIdType rowId : trainRows)
   {
-    vtkAbstractArray* srcCol = fullDataTable->GetColumn(i);
-    vtkAbstractArray* dstCol = vtkAbstractArray::CreateArray(srcCol->GetDataType());
-    dstCol->SetName(srcCol->GetName());
-    trainingTable->AddColumn(dstCol);
-    dstCol->FastDelete();
+    rowIds->InsertNextId(rowId);
   }
-  trainingTable->SetNumberOfRows(M);
-  vtkNew<vtkVariantArray> row;
-  vtkIdType dstRow = 0;
-  for (std::set<vtkIdType>::iterator it = trainRows.begin(); it != trainRows.end(); ++it, ++dstRow)
-  {
-    fullDataTable->GetRow(*it, row);
-    trainingTable->SetRow(dstRow, row);
-  }
-  return 1;
 }
 
 vtkIdType vtkSciVizStatistics::GetNumberOfObservationsForTraining(vtkIdType N)
@@ -727,6 +863,408 @@ vtkIdType vtkSciVizStatistics::GetNumberOfObservationsForTraining(vtkIdType N)
   return M < 100 ? (N < 100 ? N : 100) : M;
 }
 
+int vtkSciVizStatistics::LearnAndDeriveFromMoments(
+  vtkMultiBlockDataSet* vtkNotUsed(model), const vtkSciVizStatisticsMoments& vtkNotUsed(moments))
+{
+  vtkErrorMacro("Subclasses requiring moments must build their model from them.");
+  return 0;
+}
+
+bool vtkSciVizStatistics::ComputeMoments(
+  vtkFieldData* dataAttrIn, vtkIdList* rowIds, int type, vtkSciVizStatisticsMoments& moments)
+{
+  // Gather the variables the table would have, one per array component.
+  std::vector<std::pair<vtkDataArray*, int>> variables;
+  std::vector<std::string> names;
+  bool numeric = true;
+  for (const auto& arrName : this->P->Buffer)
+  {
+    vtkAbstractArray* arr = dataAttrIn->GetAbstractArray(arrName.c_str());
+    if (!arr)
+    {
+      continue;
+    }
+    vtkDataArray* darr = vtkDataArray::SafeDownCast(arr);
+    if (!darr)
+    {
+      numeric = false;
+      break;
+    }
+    const std::vector<std::string> colNames = ::GetColumnNames(arr);
+    for (int comp = 0; comp < darr->GetNumberOfComponents(); ++comp)
+    {
+      variables.emplace_back(darr, comp);
+      names.push_back(colNames[comp]);
+    }
+  }
+  numeric = numeric && !variables.empty();
+
+  // The moments are reduced across processes, so they must all agree on using them.
+  const int numProcs = this->Controller ? this->Controller->GetNumberOfProcesses() : 1;
+  if (numProcs > 1)
+  {
+    const vtkIdType numVariables = static_cast<vtkIdType>(variables.size());
+    vtkIdType local[3] = { numeric ? 1 : 0, numVariables, -numVariables };
+    vtkIdType global[3];
+    this->Controller->AllReduce(local, global, 3, vtkCommunicator::MIN_OP);
+    numeric = global[0] == 1 && global[1] == -global[2];
+  }
+  if (!numeric)
+  {
+    return false;
+  }
+
+  const size_t numVariables = variables.size();
+  const vtkIdType numRows =
+    rowIds ? rowIds->GetNumberOfIds() : variables[0].first->GetNumberOfTuples();
+  const vtkIdType* ids = rowIds ? rowIds->GetPointer(0) : nullptr;
+  vtkUnsignedCharArray* ghosts = dataAttrIn->GetGhostArray();
+
+  vtkSMPThreadLocal<vtkSciVizStatisticsMoments> localMoments;
+  vtkSMPTools::For(0, numRows, [&](vtkIdType begin, vtkIdType end) {
+    vtkSciVizStatisticsMoments& threadMoments = localMoments.Local();
+    if (threadMoments.Mean.empty())
+    {
+      threadMoments.Initialize(numVariables, type);
+    }
+    // Gather a block of rows of every variable, then accumulate them row by row.
+    std::vector<double> values(numVariables * ::MomentsBlockSize);
+    std::vector<double> observation(numVariables);
+    GatherComponentWorker worker;
+    for (vtkIdType first = begin; first < end; first += ::MomentsBlockSize)
+    {
+      const vtkIdType count = std::min(::MomentsBlockSize, end - first);
+      for (size_t var = 0; var < numVariables; ++var)
+      {
+        vtkDataArray* array = variables[var].first;
+        const int comp = variables[var].second;
+        double* out = values.data() + var * ::MomentsBlockSize;
+        if (!vtkArrayDispatch::Dispatch::Execute(array, worker, comp, ids, first, count, out))
+        {
+          worker(array, comp, ids, first, count, out);
+        }
+      }
+      for (vtkIdType k = 0; k < count; ++k)
+      {
+        const vtkIdType row = ids ? ids[first + k] : first + k;
+        if (ghosts && ghosts->GetValue(row))
+        {
+          continue;
+        }
+        for (size_t var = 0; var < numVariables; ++var)
+        {
+          observation[var] = values[var * ::MomentsBlockSize + k];
+        }
+        threadMoments.AddObservation(observation.data());
+      }
+    }
+  });
+
+  moments.Initialize(numVariables, type);
+  for (const auto& threadMoments : localMoments)
+  {
+    if (!threadMoments.Mean.empty())
+    {
+      moments.Merge(threadMoments);
+    }
+  }
+
+  if (numProcs > 1)
+  {
+    // Merge the moments of all processes in the same order everywhere.
+    std::vector<double> buffer;
+    moments.Serialize(buffer);
+    const vtkIdType length = static_cast<vtkIdType>(buffer.size());
+    std::vector<double> allBuffers(length * numProcs);
+    this->Controller->AllGather(buffer.data(), allBuffers.data(), length);
+    moments.Initialize(numVariables, type);
+    vtkSciVizStatisticsMoments processMoments;
+    processMoments.Initialize(numVariables, type);
+    for (int proc = 0; proc < numProcs; ++proc)
+    {
+      processMoments.Deserialize(allBuffers.data() + proc * length);
+      moments.Merge(processMoments);
+    }
+  }
+  moments.Names = names;
+  return true;
+}
+
+int vtkSciVizStatistics::BuildModelFromMoments(vtkStatisticsAlgorithm* stats,
+  vtkMultiBlockDataSet* model, const vtkSciVizStatisticsMoments& moments)
+{
+  if (!model)
+  {
+    vtkErrorMacro("No place to store output tables.");
+    return 0;
+  }
+
+  vtkSmartPointer<vtkTable> observation = moments.NewObservationTable();
+  stats->SetInputData(vtkStatisticsAlgorithm::INPUT_DATA, observation);
+  stats->SetLearnOption(true);
+  stats->SetDeriveOption(false);
+  stats->SetAssessOption(false);
+  stats->Update();
+
+  // Copy the primary model so that it can be fed back to the algorithm.
+  vtkNew<vtkMultiBlockDataSet> primaryModel;
+  primaryModel->DeepCopy(stats->GetOutputDataObject(vtkStatisticsAlgorithm::OUTPUT_MODEL));
+  vtkTable* primary = primaryModel->GetNumberOfBlocks() > 0
+    ? vtkTable::SafeDownCast(primaryModel->GetBlock(0))
+    : nullptr;
+  if (!primary || !moments.FillModel(primary))
+  {
+    vtkErrorMacro("Unexpected primary model from " << stats->GetClassName() << ".");
+    return 0;
+  }
+
+  stats->SetInputData(vtkStatisticsAlgorithm::INPUT_MODEL, primaryModel);
+  stats->SetLearnOption(false);
+  stats->SetDeriveOption(true);
+  stats->Update();
+
+  // Copy the output of the statistics filter to our output
+  model->CompositeShallowCopy(vtkMultiBlockDataSet::SafeDownCast(
+    stats->GetOutputDataObject(vtkStatisticsAlgorithm::OUTPUT_MODEL)));
+  return 1;
+}
+
+void vtkSciVizStatisticsMoments::Initialize(size_t numberOfVariables, int type)
+{
+  this->Type = type;
+  this->Cardinality = 0;
+  this->Minimum.assign(numberOfVariables, std::numeric_limits<double>::max());
+  this->Maximum.assign(numberOfVariables, std::numeric_limits<double>::lowest());
+  this->Mean.assign(numberOfVariables, 0.);
+  const bool univariate = type == vtkSciVizStatistics::UNIVARIATE_MOMENTS;
+  this->M2.assign(univariate ? numberOfVariables : 0, 0.);
+  this->M3.assign(univariate ? numberOfVariables : 0, 0.);
+  this->M4.assign(univariate ? numberOfVariables : 0, 0.);
+  this->CoMoments.assign(univariate ? 0 : numberOfVariables * (numberOfVariables + 1) / 2, 0.);
+  this->Delta.assign(numberOfVariables, 0.);
+}
+
+size_t vtkSciVizStatisticsMoments::GetCoMomentIndex(size_t i, size_t j) const
+{
+  if (i > j)
+  {
+    std::swap(i, j);
+  }
+  return i * (2 * this->Mean.size() - i + 1) / 2 + j - i;
+}
+
+double vtkSciVizStatisticsMoments::GetCoMoment(size_t i, size_t j) const
+{
+  return this->CoMoments.empty() ? (i == j ? this->M2[i] : 0.)
+                                 : this->CoMoments[this->GetCoMomentIndex(i, j)];
+}
+
+void vtkSciVizStatisticsMoments::AddObservation(const double* values)
+{
+  const size_t numVariables = this->Mean.size();
+  const double n1 = static_cast<double>(this->Cardinality);
+  const double n = static_cast<double>(++this->Cardinality);
+  for (size_t i = 0; i < numVariables; ++i)
+  {
+    const double x = values[i];
+    this->Minimum[i] = std::min(this->Minimum[i], x);
+    this->Maximum[i] = std::max(this->Maximum[i], x);
+    const double delta = x - this->Mean[i];
+    const double deltaN = delta / n;
+    this->Mean[i] += deltaN;
+    this->Delta[i] = delta;
+    if (!this->M2.empty())
+    {
+      const double deltaN2 = deltaN * deltaN;
+      const double term = delta * deltaN * n1;
+      this->M4[i] += term * deltaN2 * (n * n - 3. * n + 3.) + 6. * deltaN2 * this->M2[i] -
+        4. * deltaN * this->M3[i];
+      this->M3[i] += term * deltaN * (n - 2.) - 3. * deltaN * this->M2[i];
+      this->M2[i] += term;
+    }
+  }
+  if (!this->CoMoments.empty())
+  {
+    const double factor = n1 / n;
+    size_t index = 0;
+    for (size_t i = 0; i < numVariables; ++i)
+    {
+      const double deltaI = this->Delta[i] * factor;
+      for (size_t j = i; j < numVariables; ++j, ++index)
+      {
+        this->CoMoments[index] += deltaI * this->Delta[j];
+      }
+    }
+  }
+}
+
+void vtkSciVizStatisticsMoments::Merge(const vtkSciVizStatisticsMoments& other)
+{
+  if (other.Cardinality == 0)
+  {
+    return;
+  }
+  if (this->Cardinality == 0)
+  {
+    this->Cardinality = other.Cardinality;
+    this->Minimum = other.Minimum;
+    this->Maximum = other.Maximum;
+    this->Mean = other.Mean;
+    this->M2 = other.M2;
+    this->M3 = other.M3;
+    this->M4 = other.M4;
+    this->CoMoments = other.CoMoments;
+    return;
+  }
+
+  const size_t numVariables = this->Mean.size();
+  const double nA = static_cast<double>(this->Cardinality);
+  const double nB = static_cast<double>(other.Cardinality);
+  const double n = nA + nB;
+  for (size_t i = 0; i < numVariables; ++i)
+  {
+    this->Minimum[i] = std::min(this->Minimum[i], other.Minimum[i]);
+    this->Maximum[i] = std::max(this->Maximum[i], other.Maximum[i]);
+    const double delta = other.Mean[i] - this->Mean[i];
+    this->Delta[i] = delta;
+    this->Mean[i] += delta * nB / n;
+    if (!this->M2.empty())
+    {
+      const double delta2 = delta * delta;
+      this->M4[i] += other.M4[i] +
+        delta2 * delta2 * nA * nB * (nA * nA - nA * nB + nB * nB) / (n * n * n) +
+        6. * delta2 * (nA * nA * other.M2[i] + nB * nB * this->M2[i]) / (n * n) +
+        4. * delta * (nA * other.M3[i] - nB * this->M3[i]) / n;
+      this->M3[i] += other.M3[i] + delta * delta2 * nA * nB * (nA - nB) / (n * n) +
+        3. * delta * (nA * other.M2[i] - nB * this->M2[i]) / n;
+      this->M2[i] += other.M2[i] + delta2 * nA * nB / n;
+    }
+  }
+  if (!this->CoMoments.empty())
+  {
+    const double factor = nA * nB / n;
+    size_t index = 0;
+    for (size_t i = 0; i < numVariables; ++i)
+    {
+      for (size_t j = i; j < numVariables; ++j, ++index)
+      {
+        this->CoMoments[index] +=
+          other.CoMoments[index] + this->Delta[i] * this->Delta[j] * factor;
+      }
+    }
+  }
+  this->Cardinality += other.Cardinality;
+}
+
+void vtkSciVizStatisticsMoments::Serialize(std::vector<double>& buffer) const
+{
+  buffer.clear();
+  buffer.push_back(static_cast<double>(this->Cardinality));
+  for (const auto* values : { &this->Minimum, &this->Maximum, &this->Mean, &this->M2, &this->M3,
+         &this->M4, &this->CoMoments })
+  {
+    buffer.insert(buffer.end(), values->begin(), values->end());
+  }
+}
+
+void vtkSciVizStatisticsMoments::Deserialize(const double* buffer)
+{
+  this->Cardinality = static_cast<vtkIdType>(*buffer++);
+  for (auto* values : { &this->Minimum, &this->Maximum, &this->Mean, &this->M2, &this->M3,
+         &this->M4, &this->CoMoments })
+  {
+    std::copy(buffer, buffer + values->size(), values->begin());
+    buffer += values->size();
+  }
+}
+
+vtkSmartPointer<vtkTable> vtkSciVizStatisticsMoments::NewObservationTable() const
+{
+  auto observation = vtkSmartPointer<vtkTable>::New();
+  for (size_t i = 0; i < this->Names.size(); ++i)
+  {
+    vtkNew<vtkDoubleArray> column;
+    column->SetName(this->Names[i].c_str());
+    column->InsertNextValue(this->Mean[i]);
+    observation->AddColumn(column);
+  }
+  return observation;
+}
+
+bool vtkSciVizStatisticsMoments::FillModel(vtkTable* primary) const
+{
+  std::map<std::string, size_t> indices;
+  for (size_t i = 0; i < this->Names.size(); ++i)
+  {
+    indices[this->Names[i]] = i;
+  }
+
+  if (this->Type == vtkSciVizStatistics::UNIVARIATE_MOMENTS)
+  {
+    // One row per variable, see vtkDescriptiveStatistics::Learn.
+    vtkStringArray* variables =
+      vtkArrayDownCast<vtkStringArray>(primary->GetColumnByName("Variable"));
+    const char* columnNames[] = { "Cardinality", "Minimum", "Maximum", "Mean", "M2", "M3", "M4" };
+    const std::vector<double>* columnValues[] = { nullptr, &this->Minimum, &this->Maximum,
+      &this->Mean, &this->M2, &this->M3, &this->M4 };
+    vtkDataArray* columns[7];
+    for (int col = 0; col < 7; ++col)
+    {
+      columns[col] = vtkArrayDownCast<vtkDataArray>(primary->GetColumnByName(columnNames[col]));
+      if (!columns[col])
+      {
+        return false;
+      }
+    }
+    for (vtkIdType row = 0; variables && row < variables->GetNumberOfValues(); ++row)
+    {
+      const auto index = indices.find(variables->GetValue(row));
+      if (index == indices.end())
+      {
+        return false;
+      }
+      columns[0]->SetComponent(row, 0, static_cast<double>(this->Cardinality));
+      for (int col = 1; col < 7; ++col)
+      {
+        columns[col]->SetComponent(row, 0, (*columnValues[col])[index->second]);
+      }
+    }
+    return variables != nullptr;
+  }
+
+  // The cardinality, then the mean of each variable and the co-moment of each
+  // pair of variables, see vtkMultiCorrelativeStatistics::Learn.
+  vtkStringArray* column1 = vtkArrayDownCast<vtkStringArray>(primary->GetColumnByName("Column1"));
+  vtkStringArray* column2 = vtkArrayDownCast<vtkStringArray>(primary->GetColumnByName("Column2"));
+  vtkDataArray* entries = vtkArrayDownCast<vtkDataArray>(primary->GetColumnByName("Entries"));
+  if (!column1 || !column2 || !entries || entries->GetNumberOfTuples() < 1)
+  {
+    return false;
+  }
+  entries->SetComponent(0, 0, static_cast<double>(this->Cardinality));
+  for (vtkIdType row = 1; row < entries->GetNumberOfTuples(); ++row)
+  {
+    const auto index1 = indices.find(column1->GetValue(row));
+    if (index1 == indices.end())
+    {
+      return false;
+    }
+    const std::string& name2 = column2->GetValue(row);
+    if (name2.empty())
+    {
+      entries->SetComponent(row, 0, this->Mean[index1->second]);
+      continue;
+    }
+    const auto index2 = indices.find(name2);
+    if (index2 == indices.end())
+    {
+      return false;
+    }
+    entries->SetComponent(row, 0, this->GetCoMoment(index1->second, index2->second));
+  }
+  return true;
+}
+
 void vtkSciVizStatistics::ShallowCopy(vtkDataObject* out, vtkDataObject* in)
 {
   out->ShallowCopy(in);
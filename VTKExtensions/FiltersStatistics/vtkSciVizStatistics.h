@@ -27,11 +27,14 @@
 class vtkCompositeDataSet;
 class vtkDataObjectToTable;
 class vtkFieldData;
+class vtkIdList;
 class vtkInformationIntegerKey;
 class vtkMultiBlockDataSet;
 class vtkMultiProcessController;
+class vtkSciVizStatisticsMoments;
 class vtkSciVizStatisticsP;
 class vtkStatisticsAlgorithm;
+class vtkUnsignedCharArray;
 
 class VTKPVVTKEXTENSIONSFILTERSSTATISTICS_EXPORT vtkSciVizStatistics : public vtkTableAlgorithm
 {
@@ -162,6 +165,59 @@ protected:
    */
   virtual int LearnAndDerive(vtkMultiBlockDataSet* model, vtkTable* inData) = 0;
 
+  /**
+   * Moments of the observations a model can be built from, see GetRequiredMoments().
+   */
+  enum MomentsType
+  {
+    NO_MOMENTS = 0,     //!< The model needs the table of observations.
+    UNIVARIATE_MOMENTS, //!< Extrema, mean and centered moments up to order 4 of each variable.
+    COVARIANCE_MOMENTS  //!< Extrema and mean of each variable and co-moments of each pair.
+  };
+
+  /**
+   * Subclasses whose model only depends on moments of the training observations
+   * <b>may</b> override this to return the MomentsType they need.
+   * These moments are then computed in a single multithreaded pass over the
+   * selected arrays, without converting them to a table, reduced across
+   * processes and passed to LearnAndDeriveFromMoments() instead of calling
+   * LearnAndDerive(). The table is then only built to assess the observations.
+   * Returns NO_MOMENTS by default.
+   */
+  virtual int GetRequiredMoments() { return NO_MOMENTS; }
+
+  /**
+   * Method subclasses overriding GetRequiredMoments() <b>must</b> override to
+   * calculate a full model from the moments of the training observations.
+   */
+  virtual int LearnAndDeriveFromMoments(
+    vtkMultiBlockDataSet* model, const vtkSciVizStatisticsMoments& moments);
+
+  /**
+   * Computes the moments of the given type of the selected arrays, split into
+   * one variable per component as in PrepareFullDataTable(), over the rows in
+   * \a rowIds (or all rows when null), skipping ghosts.
+   * Returns false on every process when a selected array is not numeric
+   * or the processes do not have the same variables.
+   */
+  bool ComputeMoments(
+    vtkFieldData* dataAttrIn, vtkIdList* rowIds, int type, vtkSciVizStatisticsMoments& moments);
+
+  /**
+   * Runs \a stats, whose columns of interest must have been set, on a single
+   * observation to create the structure of its model, replaces the entries of
+   * the primary model table with \a moments and derives the full \a model from it.
+   */
+  int BuildModelFromMoments(vtkStatisticsAlgorithm* stats, vtkMultiBlockDataSet* model,
+    const vtkSciVizStatisticsMoments& moments);
+
+  /**
+   * Picks \a numObservations random rows that are not ghosts among the first
+   * \a numberOfRows ones, in increasing order, to train the model with.
+   */
+  void SelectTrainingRows(vtkUnsignedCharArray* ghosts, vtkIdType numberOfRows,
+    vtkIdType numObservations, vtkIdList* rowIds);
+
   /**
    * Method subclasses <b>must</b> override to assess an input table given a model of the proper
    type.
@@ -10,7 +10,14 @@
 #ifndef vtkSciVizStatisticsPrivate_h
 #define vtkSciVizStatisticsPrivate_h
 
+#include "vtkSmartPointer.h"
 #include "vtkStatisticsAlgorithmPrivate.h"
+#include "vtkType.h"
+
+#include <string>
+#include <vector>
+
+class vtkTable;
 
 class vtkSciVizStatisticsP : public vtkStatisticsAlgorithmPrivate
 {
@@ -18,6 +25,67 @@ public:
   bool Has(std::string arrName) { return this->Buffer.find(arrName) != this->Buffer.end(); }
 };
 
+/**
+ * Moments of a set of observations of several variables, accumulated one
+ * observation at a time and merged pairwise with the update formulas of
+ * Pebay (2008), so that partial moments of threads and processes combine
+ * exactly. Which moments are kept depends on Type, one of
+ * vtkSciVizStatistics::UNIVARIATE_MOMENTS or COVARIANCE_MOMENTS.
+ */
+class vtkSciVizStatisticsMoments
+{
+public:
+  void Initialize(size_t numberOfVariables, int type);
+  void AddObservation(const double* values);
+  void Merge(const vtkSciVizStatisticsMoments& other);
+
+  ///@{
+  /**
+   * Flatten the moments to (and restore them from) doubles, to exchange
+   * them between processes.
+   */
+  void Serialize(std::vector<double>& buffer) const;
+  void Deserialize(const double* buffer);
+  ///@}
+
+  /**
+   * Sum of the products of the deviations of variables i and j from their
+   * means, which is M2 of i when i == j.
+   */
+  double GetCoMoment(size_t i, size_t j) const;
+
+  /**
+   * Returns a table with a single observation, the means, of every variable,
+   * from which statistics algorithms can create the structure of their model.
+   */
+  vtkSmartPointer<vtkTable> NewObservationTable() const;
+
+  /**
+   * Replaces the entries of the primary model table created by
+   * vtkDescriptiveStatistics (UNIVARIATE_MOMENTS) or by
+   * vtkMultiCorrelativeStatistics (COVARIANCE_MOMENTS) with these moments.
+   * Returns false if the table does not have the expected layout.
+   */
+  bool FillModel(vtkTable* primary) const;
+
+  std::vector<std::string> Names;
+  int Type = 0;
+  vtkIdType Cardinality = 0;
+  std::vector<double> Minimum;
+  std::vector<double> Maximum;
+  std::vector<double> Mean;
+  std::vector<double> M2;
+  std::vector<double> M3;
+  std::vector<double> M4;
+  // Upper triangle of the co-moments, row by row.
+  std::vector<double> CoMoments;
+
+private:
+  size_t GetCoMomentIndex(size_t i, size_t j) const;
+
+  std::vector<double> Delta;
+};
+
 #endif // vtkSciVizStatisticsPrivate_h
 
 // VTK-HeaderTest-Exclude: vtkSciVizStatisticsPrivate.h
@@ -0,0 +1,120 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "vtkDataSetAttributes.h"
+#include "vtkDoubleArray.h"
+#include "vtkIntArray.h"
+#include "vtkLogger.h"
+#include "vtkMinMax.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPolyData.h"
+#include "vtkUnsignedCharArray.h"
+
+namespace
+{
+// Creates a polydata with `numPoints` point values (i + offset) for a scalar
+// array and (i, -i) for a 2-component array. Every 10th point is a ghost
+// holding a huge value that must be ignored.
+vtkSmartPointer<vtkPolyData> CreateData(vtkIdType numPoints, int offset)
+{
+  vtkNew<vtkDoubleArray> scalars;
+  scalars->SetName("scalars");
+  scalars->SetNumberOfTuples(numPoints);
+  vtkNew<vtkIntArray> vectors;
+  vectors->SetName("vectors");
+  vectors->SetNumberOfComponents(2);
+  vectors->SetNumberOfTuples(numPoints);
+  vtkNew<vtkUnsignedCharArray> ghosts;
+  ghosts->SetName(vtkDataSetAttributes::GhostArrayName());
+  ghosts->SetNumberOfTuples(numPoints);
+  for (vtkIdType i = 0; i < numPoints; ++i)
+  {
+    const bool isGhost = (i % 10) == 9;
+    ghosts->SetValue(i, isGhost ? vtkDataSetAttributes::DUPLICATEPOINT : 0);
+    scalars->SetValue(i, isGhost ? 1e10 : static_cast<double>(i + offset));
+    vectors->SetTypedComponent(i, 0, isGhost ? 1000000 : static_cast<int>(i));
+    vectors->SetTypedComponent(i, 1, isGhost ? -1000000 : -static_cast<int>(i));
+  }
+
+  auto pd = vtkSmartPointer<vtkPolyData>::New();
+  pd->GetPointData()->AddArray(scalars);
+  pd->GetPointData()->AddArray(vectors);
+  pd->GetPointData()->AddArray(ghosts);
+  return pd;
+}
+}
+
+int TestMinMax(int, char*[])
+{
+  const vtkIdType numPoints = 100000;
+  vtkNew<vtkMultiBlockDataSet> mb;
+  mb->SetBlock(0, CreateData(numPoints, 10));
+  mb->SetBlock(1, CreateData(numPoints, -5));
+
+  vtkNew<vtkMinMax> minmax;
+  minmax->SetInputDataObject(mb);
+
+  minmax->SetOperation(vtkMinMax::MIN);
+  minmax->Update();
+  vtkPointData* pd = minmax->GetOutput()->GetPointData();
+  if (pd->GetArray("scalars")->GetComponent(0, 0) != -5)
+  {
+    vtkLogF(ERROR, "incorrect minimum");
+    return EXIT_FAILURE;
+  }
+  if (pd->GetArray("vectors")->GetComponent(0, 0) != 0)
+  {
+    vtkLogF(ERROR, "incorrect minimum");
+    return EXIT_FAILURE;
+  }
+  if (pd->GetArray("vectors")->GetComponent(0, 1) != -(numPoints - 2))
+  {
+    vtkLogF(ERROR, "incorrect minimum");
+    return EXIT_FAILURE;
+  }
+
+  minmax->SetOperation(vtkMinMax::MAX);
+  minmax->Update();
+  pd = minmax->GetOutput()->GetPointData();
+  if (pd->GetArray("scalars")->GetComponent(0, 0) != numPoints - 2 + 10)
+  {
+    vtkLogF(ERROR, "incorrect maximum");
+    return EXIT_FAILURE;
+  }
+  if (pd->GetArray("vectors")->GetComponent(0, 0) != numPoints - 2)
+  {
+    vtkLogF(ERROR, "incorrect maximum");
+    return EXIT_FAILURE;
+  }
+  if (pd->GetArray("vectors")->GetComponent(0, 1) != 0)
+  {
+    vtkLogF(ERROR, "incorrect maximum");
+    return EXIT_FAILURE;
+  }
+
+  minmax->SetOperation(vtkMinMax::SUM);
+  minmax->Update();
+  pd = minmax->GetOutput()->GetPointData();
+  double expected = 0;
+  for (vtkIdType i = 0; i < numPoints; ++i)
+  {
+    if (i % 10 != 9)
+    {
+      expected += (i + 10) + (i - 5);
+    }
+  }
+  if (pd->GetArray("scalars")->GetComponent(0, 0) != expected)
+  {
+    vtkLogF(ERROR, "incorrect sum");
+    return EXIT_FAILURE;
+  }
+  if (minmax->GetMismatchOccurred() != 0)
+  {
+    vtkLogF(ERROR, "unexpected mismatch");
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,128 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "vtkDataArray.h"
+#include "vtkDoubleArray.h"
+#include "vtkExtractHistogram.h"
+#include "vtkFieldData.h"
+#include "vtkFloatArray.h"
+#include "vtkLogger.h"
+#include "vtkMinimalStandardRandomSequence.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkNew.h"
+#include "vtkPExtractHistogram.h"
+#include "vtkPointData.h"
+#include "vtkPolyData.h"
+#include "vtkTable.h"
+#include "vtkUnsignedCharArray.h"
+
+#include <cmath>
+
+namespace
+{
+// Creates a polydata with random values in a scalar and a 3-component array.
+vtkSmartPointer<vtkPolyData> CreateData(vtkIdType numPoints, int seed)
+{
+  vtkNew<vtkMinimalStandardRandomSequence> random;
+  random->SetSeed(seed);
+  vtkNew<vtkDoubleArray> scalars;
+  scalars->SetName("scalars");
+  scalars->SetNumberOfTuples(numPoints);
+  vtkNew<vtkFloatArray> vectors;
+  vectors->SetName("vectors");
+  vectors->SetNumberOfComponents(3);
+  vectors->SetNumberOfTuples(numPoints);
+  for (vtkIdType i = 0; i < numPoints; ++i)
+  {
+    scalars->SetValue(i, random->GetNextRangeValue(-10, 50));
+    for (int comp = 0; comp < 3; ++comp)
+    {
+      vectors->SetTypedComponent(i, comp, random->GetNextRangeValue(-1, 1));
+    }
+  }
+  // the first points are hidden, the field data array is not affected by it.
+  vtkNew<vtkUnsignedCharArray> ghosts;
+  ghosts->SetName(vtkDataSetAttributes::GhostArrayName());
+  ghosts->SetNumberOfTuples(numPoints);
+  ghosts->Fill(0);
+  vtkNew<vtkDoubleArray> fieldValues;
+  fieldValues->SetName("fieldValues");
+  fieldValues->SetNumberOfTuples(20);
+  for (vtkIdType i = 0; i < 20; ++i)
+  {
+    ghosts->SetValue(i, vtkDataSetAttributes::HIDDENPOINT);
+    fieldValues->SetValue(i, random->GetNextRangeValue(0, 1));
+  }
+  auto pd = vtkSmartPointer<vtkPolyData>::New();
+  pd->GetPointData()->AddArray(scalars);
+  pd->GetPointData()->AddArray(vectors);
+  pd->GetPointData()->AddArray(ghosts);
+  pd->GetFieldData()->AddArray(fieldValues);
+  return pd;
+}
+
+// Returns true if both filters produce the same bins for the given array and
+// component.
+bool CompareHistograms(vtkDataObject* input, const char* arrayName, int component,
+  int association = vtkDataObject::FIELD_ASSOCIATION_POINTS)
+{
+  vtkNew<vtkExtractHistogram> reference;
+  vtkNew<vtkPExtractHistogram> histogram;
+  vtkExtractHistogram* filters[2] = { reference, histogram };
+  for (vtkExtractHistogram* filter : filters)
+  {
+    filter->SetInputData(input);
+    filter->SetInputArrayToProcess(0, 0, 0, association, arrayName);
+    filter->SetComponent(component);
+    filter->SetBinCount(17);
+    filter->Update();
+  }
+
+  vtkTable* expected = reference->GetOutput();
+  vtkTable* result = histogram->GetOutput();
+  for (const char* name :
+    { reference->GetBinExtentsArrayName(), reference->GetBinValuesArrayName() })
+  {
+    vtkDataArray* expectedArray = vtkDataArray::SafeDownCast(expected->GetColumnByName(name));
+    vtkDataArray* resultArray = vtkDataArray::SafeDownCast(result->GetColumnByName(name));
+    if (!expectedArray || !resultArray ||
+      expectedArray->GetNumberOfTuples() != resultArray->GetNumberOfTuples())
+    {
+      vtkLogF(ERROR, "Missing or mismatched '%s' for '%s' (%d).", name, arrayName, component);
+      return false;
+    }
+    for (vtkIdType cc = 0; cc < expectedArray->GetNumberOfTuples(); ++cc)
+    {
+      if (std::abs(expectedArray->GetTuple1(cc) - resultArray->GetTuple1(cc)) > 1e-9)
+      {
+        vtkLogF(ERROR, "Wrong '%s' %lld for '%s' (%d): %g instead of %g.", name,
+          static_cast<long long>(cc), arrayName, component, resultArray->GetTuple1(cc),
+          expectedArray->GetTuple1(cc));
+        return false;
+      }
+    }
+  }
+  return true;
+}
+}
+
+// Compares the bins computed with vtkSMPTools by vtkPExtractHistogram with
+// the ones of vtkExtractHistogram.
+int TestPExtractHistogram(int, char*[])
+{
+  vtkNew<vtkMultiBlockDataSet> mb;
+  mb->SetBlock(0, CreateData(100000, 1));
+  mb->SetBlock(1, CreateData(50000, 2));
+
+  vtkDataObject* inputs[2] = { mb->GetBlock(0), mb };
+  for (vtkDataObject* input : inputs)
+  {
+    if (!CompareHistograms(input, "scalars", 0) || !CompareHistograms(input, "vectors", 1) ||
+      !CompareHistograms(input, "vectors", 3) ||
+      !CompareHistograms(input, "fieldValues", 0, vtkDataObject::FIELD_ASSOCIATION_NONE))
+    {
+      return EXIT_FAILURE;
+    }
+  }
+  return EXIT_SUCCESS;
+}
@@ -5,25 +5,185 @@
 #include "vtkObjectFactory.h"
 
 #include "vtkAbstractArray.h"
+#include "vtkArrayDispatch.h"
 #include "vtkCellArray.h"
 #include "vtkCellData.h"
 #include "vtkCompositeDataIterator.h"
 #include "vtkCompositeDataSet.h"
 #include "vtkDataArray.h"
+#include "vtkDataArrayRange.h"
 #include "vtkDataSet.h"
 #include "vtkFieldData.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkPointData.h"
 #include "vtkPoints.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
 #include "vtkUnsignedCharArray.h"
 
 #include "vtkMultiProcessController.h"
 
+#include <vector>
+
 vtkStandardNewMacro(vtkMinMax);
 
-template <class T>
-void vtkMinMaxExecute(vtkMinMax* self, int numComp, int compIdx, T* idata, T* odata);
+namespace
+{
+//-----------------------------------------------------------------------------
+template <typename T>
+void Combine(int operation, T& accumulated, const T& value)
+{
+  switch (operation)
+  {
+    case vtkMinMax::MIN:
+      if (value < accumulated)
+      {
+        accumulated = value;
+      }
+      break;
+    case vtkMinMax::MAX:
+      if (value > accumulated)
+      {
+        accumulated = value;
+      }
+      break;
+    case vtkMinMax::SUM:
+      accumulated += value;
+      break;
+    default:
+      accumulated = value;
+      break;
+  }
+}
+
+//-----------------------------------------------------------------------------
+// Computes the operation over all non-ghost tuples of an array. Each thread
+// accumulates into its own per-component values which are combined in Reduce.
+template <typename ArrayT>
+struct MinMaxFunctor
+{
+  using ValueType = vtk::GetAPIType<ArrayT>;
+
+  struct LocalResult
+  {
+    std::vector<ValueType> Values;
+    bool Initialized = false;
+  };
+
+  ArrayT* Input;
+  const unsigned char* Ghosts;
+  int Operation;
+  int NumberOfComponents;
+  vtkSMPThreadLocal<LocalResult> TLResult;
+
+  std::vector<ValueType> Result;
+  bool Initialized = false;
+
+  MinMaxFunctor(ArrayT* input, const unsigned char* ghosts, int operation)
+    : Input(input)
+    , Ghosts(ghosts)
+    , Operation(operation)
+    , NumberOfComponents(input->GetNumberOfComponents())
+  {
+  }
+
+  void Initialize()
+  {
+    LocalResult& local = this->TLResult.Local();
+    local.Values.assign(this->NumberOfComponents, ValueType());
+    local.Initialized = false;
+  }
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    LocalResult& local = this->TLResult.Local();
+    const int numComp = this->NumberOfComponents;
+    const auto tuples = vtk::DataArrayTupleRange(this->Input, begin, end);
+    const unsigned char* ghosts = this->Ghosts ? this->Ghosts + begin : nullptr;
+    vtkIdType localIdx = 0;
+    for (const auto tuple : tuples)
+    {
+      if (ghosts && (ghosts[localIdx++] & vtkDataSetAttributes::DUPLICATECELL))
+      {
+        // skip cell and point attributes that don't belong to me
+        continue;
+      }
+      if (!local.Initialized)
+      {
+        for (int comp = 0; comp < numComp; ++comp)
+        {
+          local.Values[comp] = tuple[comp];
+        }
+        local.Initialized = true;
+        continue;
+      }
+      for (int comp = 0; comp < numComp; ++comp)
+      {
+        ::Combine<ValueType>(this->Operation, local.Values[comp], tuple[comp]);
+      }
+    }
+  }
+
+  void Reduce()
+  {
+    for (const LocalResult& local : this->TLResult)
+    {
+      if (!local.Initialized)
+      {
+        continue;
+      }
+      if (!this->Initialized)
+      {
+        this->Result = local.Values;
+        this->Initialized = true;
+        continue;
+      }
+      for (int comp = 0; comp < this->NumberOfComponents; ++comp)
+      {
+        ::Combine<ValueType>(this->Operation, this->Result[comp], local.Values[comp]);
+      }
+    }
+  }
+};
+
+//-----------------------------------------------------------------------------
+struct MinMaxWorker
+{
+  template <typename InArrayT, typename OutArrayT>
+  void operator()(InArrayT* input, OutArrayT* output, vtkMinMax* self,
+    const unsigned char* ghosts, int compIdx)
+  {
+    using ValueType = vtk::GetAPIType<OutArrayT>;
+
+    MinMaxFunctor<InArrayT> functor(input, ghosts, self->GetOperation());
+    vtkSMPTools::For(0, input->GetNumberOfTuples(), functor);
+    if (!functor.Initialized)
+    {
+      return;
+    }
+
+    // accumulate the result of this array into the output
+    char* firstPasses = self->GetFirstPasses();
+    auto outValues = vtk::DataArrayValueRange(output, 0, functor.NumberOfComponents);
+    for (int comp = 0; comp < functor.NumberOfComponents; ++comp)
+    {
+      const ValueType value = static_cast<ValueType>(functor.Result[comp]);
+      if (firstPasses[compIdx + comp])
+      {
+        firstPasses[compIdx + comp] = 0;
+        outValues[comp] = value;
+      }
+      else
+      {
+        ValueType accumulated = outValues[comp];
+        ::Combine<ValueType>(self->GetOperation(), accumulated, value);
+        outValues[comp] = accumulated;
+      }
+    }
+  }
+};
+}
 
 //-----------------------------------------------------------------------------
 vtkMinMax::vtkMinMax()
@@ -266,91 +426,32 @@ void vtkMinMax::OperateOnField(vtkFieldData* ifd, vtkFieldData* ofd)
 //-----------------------------------------------------------------------------
 void vtkMinMax::OperateOnArray(vtkAbstractArray* ia, vtkAbstractArray* oa)
 {
-  vtkIdType numTuples = ia->GetNumberOfTuples();
-  int numComp = ia->GetNumberOfComponents();
-  int datatype = ia->GetDataType();
-
   this->Name = ia->GetName();
 
-  // go over each tuple
-  for (vtkIdType idx = 0; idx < numTuples; idx++)
+  vtkDataArray* ida = vtkDataArray::SafeDownCast(ia);
+  vtkDataArray* oda = vtkDataArray::SafeDownCast(oa);
+  if (!ida || !oda)
   {
-    this->Idx = idx;
-
-    if ((this->GhostArray != nullptr) &&
-      (this->GhostArray->GetValue(idx) & vtkDataSetAttributes::DUPLICATECELL))
-    {
-      // skip cell and point attributes that don't belong to me
-      continue;
-    }
-
-    // get type agnostic access to the tuple
-    void* idata = ia->GetVoidPointer(idx * numComp);
-    void* odata = oa->GetVoidPointer(0);
-
-    // go over each component in the tuple (jdx)
-    // perform odata[jdx] = operation(idata[jdx],odata[jdx])
-    switch (datatype)
-    {
-      vtkTemplateMacro(vtkMinMaxExecute(this, numComp, this->ComponentIdx,
-        static_cast<VTK_TT*>(idata), static_cast<VTK_TT*>(odata)));
-
-        // if you can make an operator for things like strings etc,
-        // put the cases for those strings here
-
-      default:
-        vtkErrorMacro(<< "Unknown data type refusing to operate on this array");
-        this->MismatchOccurred = 1;
-    }
+    // if you can make an operator for things like strings etc,
+    // handle those arrays here
+    vtkErrorMacro(<< "Unknown data type refusing to operate on this array");
+    this->MismatchOccurred = 1;
+    return;
   }
-}
-
-//-----------------------------------------------------------------------------
-// This templated function performs the operation on any type of data.
-template <class T>
-void vtkMinMaxExecute(vtkMinMax* self, int numComp, int compIdx, T* idata, T* odata)
-{
 
-  // go over each component of the tuple
-  for (int jdx = 0; jdx < numComp; jdx++)
+  const unsigned char* ghosts = nullptr;
+  if (this->GhostArray != nullptr &&
+    this->GhostArray->GetNumberOfTuples() >= ida->GetNumberOfTuples())
   {
+    ghosts = this->GhostArray->GetPointer(0);
+  }
 
-    T* ivalue = idata + jdx;
-    T* ovalue = odata + jdx;
-
-    char* FirstPasses = self->GetFirstPasses();
-    if (FirstPasses[compIdx + jdx])
-    {
-      FirstPasses[compIdx + jdx] = 0;
-      *ovalue = *ivalue;
-      continue;
-    }
-
-    switch (self->GetOperation())
-    {
-      case vtkMinMax::MIN:
-      {
-        if (*ivalue < *ovalue)
-          *ovalue = *ivalue;
-        break;
-      }
-      case vtkMinMax::MAX:
-      {
-        if (*ivalue > *ovalue)
-          *ovalue = *ivalue;
-        break;
-      }
-      case vtkMinMax::SUM:
-      {
-        *ovalue += *ivalue;
-        break;
-      }
-      default:
-      {
-        *ovalue = *ivalue;
-        break;
-      }
-    }
+  // input and output arrays have the same type, see OperateOnField.
+  MinMaxWorker worker;
+  using Dispatcher = vtkArrayDispatch::Dispatch2SameValueType;
+  if (!Dispatcher::Execute(ida, oda, worker, this, ghosts, this->ComponentIdx))
+  {
+    worker(ida, oda, this, ghosts, this->ComponentIdx);
   }
 }
 
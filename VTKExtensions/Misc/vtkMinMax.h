@@ -16,6 +16,9 @@
  * runs this filter REQUIRES ghost arrays to skip redundant
  * information. The output of this filter will always be a single vtkPolyData
  * that contains exactly one point and one cell (a VTK_VERTEX).
+ *
+ * Each array is processed with a typed kernel through vtkArrayDispatch and
+ * vtkSMPTools, accumulating per-thread results that are then reduced.
  */
 
 #ifndef vtkMinMax_h
@@ -71,7 +74,6 @@ public:
 
   // temp for debugging
   const char* Name;
-  vtkIdType Idx;
 
 protected:
   vtkMinMax();
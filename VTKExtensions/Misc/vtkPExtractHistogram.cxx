@@ -3,24 +3,113 @@
 // SPDX-License-Identifier: BSD-3-Clause
 #include "vtkPExtractHistogram.h"
 
+#include "vtkArrayDispatch.h"
 #include "vtkAttributeDataReductionFilter.h"
 #include "vtkCellData.h"
 #include "vtkCommunicator.h"
+#include "vtkCompositeDataSet.h"
 #include "vtkDataArrayRange.h"
 #include "vtkDataSet.h"
+#include "vtkDataSetAttributes.h"
 #include "vtkDoubleArray.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkIntArray.h"
 #include "vtkMultiProcessController.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkReductionFilter.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
 #include "vtkTable.h"
+#include "vtkUnsignedCharArray.h"
 
+#include <algorithm>
+#include <cmath>
 #include <string>
+#include <vector>
 #include <vtksys/RegularExpression.hxx>
 
+namespace
+{
+// Counts the values of an array in each bin, skipping hidden and duplicate
+// tuples. A component equal to the number of components of the array selects
+// the magnitude.
+struct BinWorker
+{
+  const unsigned char* Ghosts;
+  unsigned char HiddenMask;
+  int Component;
+  double Min;
+  double BinDelta;
+  std::vector<vtkIdType>& Counts;
+
+  BinWorker(const unsigned char* ghosts, unsigned char hiddenMask, int component, double min,
+    double binDelta, std::vector<vtkIdType>& counts)
+    : Ghosts(ghosts)
+    , HiddenMask(hiddenMask)
+    , Component(component)
+    , Min(min)
+    , BinDelta(binDelta)
+    , Counts(counts)
+  {
+  }
+
+  template <typename ArrayT>
+  void operator()(ArrayT* array)
+  {
+    const auto tuples = vtk::DataArrayTupleRange(array);
+    const int numComps = tuples.GetTupleSize();
+    if (this->Component < 0 || this->Component > numComps)
+    {
+      return;
+    }
+
+    const int binCount = static_cast<int>(this->Counts.size());
+    vtkSMPThreadLocal<std::vector<vtkIdType>> localCounts;
+    vtkSMPTools::For(0, tuples.size(), [&](vtkIdType begin, vtkIdType end) {
+      std::vector<vtkIdType>& counts = localCounts.Local();
+      counts.resize(binCount, 0);
+      for (vtkIdType tuple = begin; tuple < end; ++tuple)
+      {
+        if (this->Ghosts && (this->Ghosts[tuple] & this->HiddenMask))
+        {
+          continue;
+        }
+        double value = 0.0;
+        if (this->Component < numComps)
+        {
+          value = static_cast<double>(tuples[tuple][this->Component]);
+        }
+        else
+        {
+          for (const auto comp : tuples[tuple])
+          {
+            value += static_cast<double>(comp) * static_cast<double>(comp);
+          }
+          value = std::sqrt(value);
+        }
+        if (std::isnan(value))
+        {
+          continue;
+        }
+        const int bin = static_cast<int>((value - this->Min) / this->BinDelta);
+        ++counts[std::max(0, std::min(bin, binCount - 1))];
+      }
+    });
+
+    for (const auto& counts : localCounts)
+    {
+      for (int cc = 0; cc < binCount; ++cc)
+      {
+        this->Counts[cc] += counts[cc];
+      }
+    }
+  }
+};
+}
+
 vtkStandardNewMacro(vtkPExtractHistogram);
 vtkCxxSetObjectMacro(vtkPExtractHistogram, Controller, vtkMultiProcessController);
 //-----------------------------------------------------------------------------
@@ -50,13 +139,17 @@ bool vtkPExtractHistogram::GetInputArrayRange(vtkInformationVector** inputVector
   // return value in this call.
   this->Superclass::GetInputArrayRange(inputVector, local_range);
 
-  if (!this->Controller->AllReduce(&local_range[0], &range[0], 1, vtkCommunicator::MIN_OP) ||
-    !this->Controller->AllReduce(&local_range[1], &range[1], 1, vtkCommunicator::MAX_OP))
+  // reduce both bounds in a single collective: min(a) == -max(-a).
+  double local_bounds[2] = { -local_range[0], local_range[1] };
+  double bounds[2];
+  if (!this->Controller->AllReduce(local_bounds, bounds, 2, vtkCommunicator::MAX_OP))
   {
     vtkErrorMacro("Parallel communication error. Could not reduce ranges.");
     return false;
   }
 
+  range[0] = -bounds[0];
+  range[1] = bounds[1];
   return true;
 }
 
@@ -72,7 +165,20 @@ int vtkPExtractHistogram::RequestData(
   bool tempAccumulation = this->Accumulation;
   this->Accumulation = false;
 
-  int superRequestData = this->Superclass::RequestData(request, inputVector, outputVector);
+  // the bins of datasets are computed here, with vtkSMPTools, unless the
+  // superclass is needed for the options that affect them.
+  vtkDataObject* input = vtkDataObject::GetData(inputVector[0], 0);
+  int superRequestData;
+  if ((vtkDataSet::SafeDownCast(input) || vtkCompositeDataSet::SafeDownCast(input)) &&
+    !this->CalculateAverages && !this->UseCustomBinRanges && !this->CenterBinsAroundMinAndMax)
+  {
+    superRequestData =
+      this->BinInputArray(inputVector, vtkTable::GetData(outputVector, 0)) ? 1 : 0;
+  }
+  else
+  {
+    superRequestData = this->Superclass::RequestData(request, inputVector, outputVector);
+  }
 
   this->Normalize = tempNormalize;
   this->Accumulation = tempAccumulation;
@@ -95,37 +201,46 @@ int vtkPExtractHistogram::RequestData(
       // Nothing to do if there is no data
       return 1;
     }
-    // Now we need to collect and reduce data from all nodes on the root.
-    vtkSmartPointer<vtkReductionFilter> reduceFilter = vtkSmartPointer<vtkReductionFilter>::New();
-    reduceFilter->SetController(this->Controller);
-
-    if (isRoot)
+    if (!this->CalculateAverages)
     {
-      // PostGatherHelper needs to be set only on the root node.
-      vtkSmartPointer<vtkAttributeDataReductionFilter> rf =
-        vtkSmartPointer<vtkAttributeDataReductionFilter>::New();
-      rf->SetAttributeType(vtkAttributeDataReductionFilter::ROW_DATA);
-      rf->SetReductionType(vtkAttributeDataReductionFilter::ADD);
-      reduceFilter->SetPostGatherHelper(rf);
+      // Only the bin values need to be summed up, all ranks share the same
+      // bin extents. Reduce them directly instead of gathering the tables.
+      if (!this->ReduceBinValues(output))
+      {
+        return 0;
+      }
     }
-
-    vtkSmartPointer<vtkTable> copy = vtkSmartPointer<vtkTable>::New();
-    copy->ShallowCopy(output);
-    reduceFilter->SetInputData(copy);
-    reduceFilter->Update();
-    if (isRoot)
+    else
     {
-      // We save the old bin extents and then revert to be restored later since
-      // the reduction reduces the bin extents as well.
-      output->ShallowCopy(reduceFilter->GetOutput());
-      if (output->GetRowData()->GetNumberOfArrays() == 0)
+      // Now we need to collect and reduce data from all nodes on the root.
+      vtkSmartPointer<vtkReductionFilter> reduceFilter = vtkSmartPointer<vtkReductionFilter>::New();
+      reduceFilter->SetController(this->Controller);
+
+      if (isRoot)
       {
-        vtkErrorMacro(<< "Reduced data has 0 arrays");
-        return 0;
+        // PostGatherHelper needs to be set only on the root node.
+        vtkSmartPointer<vtkAttributeDataReductionFilter> rf =
+          vtkSmartPointer<vtkAttributeDataReductionFilter>::New();
+        rf->SetAttributeType(vtkAttributeDataReductionFilter::ROW_DATA);
+        rf->SetReductionType(vtkAttributeDataReductionFilter::ADD);
+        reduceFilter->SetPostGatherHelper(rf);
       }
-      output->GetRowData()->GetArray(this->BinExtentsArrayName)->DeepCopy(oldExtents);
-      if (this->CalculateAverages)
+
+      vtkSmartPointer<vtkTable> copy = vtkSmartPointer<vtkTable>::New();
+      copy->ShallowCopy(output);
+      reduceFilter->SetInputData(copy);
+      reduceFilter->Update();
+      if (isRoot)
       {
+        // We save the old bin extents and then revert to be restored later since
+        // the reduction reduces the bin extents as well.
+        output->ShallowCopy(reduceFilter->GetOutput());
+        if (output->GetRowData()->GetNumberOfArrays() == 0)
+        {
+          vtkErrorMacro(<< "Reduced data has 0 arrays");
+          return 0;
+        }
+        output->GetRowData()->GetArray(this->BinExtentsArrayName)->DeepCopy(oldExtents);
         vtkDataArray* bin_values = output->GetRowData()->GetArray(this->BinValuesArrayName);
         vtksys::RegularExpression reg_ex("^(.*)_average$");
         int numArrays = output->GetRowData()->GetNumberOfArrays();
@@ -148,10 +263,10 @@ int vtkPExtractHistogram::RequestData(
           }
         }
       }
-    }
-    else
-    {
-      output->Initialize();
+      else
+      {
+        output->Initialize();
+      }
     }
   }
 
@@ -170,6 +285,109 @@ int vtkPExtractHistogram::RequestData(
   return 1;
 }
 
+//-----------------------------------------------------------------------------
+bool vtkPExtractHistogram::BinInputArray(vtkInformationVector** inputVector, vtkTable* output)
+{
+  output->Initialize();
+
+  double range[2] = { VTK_DOUBLE_MAX, VTK_DOUBLE_MIN };
+  if (!this->GetInputArrayRange(inputVector, range) || range[0] > range[1])
+  {
+    // no values to bin.
+    return true;
+  }
+  if (range[0] == range[1])
+  {
+    // give the bins some width.
+    range[1] = range[0] + 1;
+  }
+
+  const int binCount = this->BinCount;
+  const double binDelta = (range[1] - range[0]) / binCount;
+  vtkNew<vtkDoubleArray> binExtents;
+  binExtents->SetName(this->BinExtentsArrayName);
+  binExtents->SetNumberOfTuples(binCount);
+  for (int cc = 0; cc < binCount; ++cc)
+  {
+    binExtents->SetValue(cc, range[0] + (cc + 0.5) * binDelta);
+  }
+
+  std::vector<vtkIdType> counts(binCount, 0);
+  vtkDataObject* input = vtkDataObject::GetData(inputVector[0], 0);
+  for (vtkDataSet* ds : vtkCompositeDataSet::GetDataSets<vtkDataSet>(input))
+  {
+    int association = vtkDataObject::FIELD_ASSOCIATION_POINTS;
+    vtkDataArray* array = this->GetInputArrayToProcess(0, ds, association);
+    if (!array || array->GetNumberOfTuples() == 0)
+    {
+      continue;
+    }
+
+    // the ghost arrays only apply to point and cell arrays, not to field data.
+    const bool cells = association == vtkDataObject::FIELD_ASSOCIATION_CELLS;
+    vtkUnsignedCharArray* ghostArray = nullptr;
+    if (association == vtkDataObject::FIELD_ASSOCIATION_POINTS)
+    {
+      ghostArray = ds->GetPointGhostArray();
+    }
+    else if (cells)
+    {
+      ghostArray = ds->GetCellGhostArray();
+    }
+    const unsigned char hiddenMask = cells
+      ? vtkDataSetAttributes::DUPLICATECELL | vtkDataSetAttributes::HIDDENCELL
+      : vtkDataSetAttributes::DUPLICATEPOINT | vtkDataSetAttributes::HIDDENPOINT;
+    ::BinWorker worker(ghostArray ? ghostArray->GetPointer(0) : nullptr, hiddenMask,
+      this->Component, range[0], binDelta, counts);
+    if (!vtkArrayDispatch::Dispatch::Execute(array, worker))
+    {
+      worker(array);
+    }
+  }
+
+  vtkNew<vtkIntArray> binValues;
+  binValues->SetName(this->BinValuesArrayName);
+  binValues->SetNumberOfTuples(binCount);
+  for (int cc = 0; cc < binCount; ++cc)
+  {
+    binValues->SetValue(cc, static_cast<int>(counts[cc]));
+  }
+
+  output->GetRowData()->AddArray(binExtents);
+  output->GetRowData()->AddArray(binValues);
+  return true;
+}
+
+//-----------------------------------------------------------------------------
+bool vtkPExtractHistogram::ReduceBinValues(vtkTable* output)
+{
+  vtkDataArray* binValues = output->GetRowData()->GetArray(this->BinValuesArrayName);
+  if (!binValues)
+  {
+    vtkErrorMacro("Missing bin values array.");
+    return false;
+  }
+
+  vtkSmartPointer<vtkDataArray> reduced = vtk::TakeSmartPointer(binValues->NewInstance());
+  reduced->SetNumberOfComponents(binValues->GetNumberOfComponents());
+  reduced->SetNumberOfTuples(binValues->GetNumberOfTuples());
+  if (!this->Controller->Reduce(binValues, reduced, vtkCommunicator::SUM_OP, 0))
+  {
+    vtkErrorMacro("Parallel communication error. Could not reduce bin values.");
+    return false;
+  }
+
+  if (this->Controller->GetLocalProcessId() == 0)
+  {
+    binValues->DeepCopy(reduced);
+  }
+  else
+  {
+    output->Initialize();
+  }
+  return true;
+}
+
 //-----------------------------------------------------------------------------
 void vtkPExtractHistogram::PrintSelf(ostream& os, vtkIndent indent)
 {
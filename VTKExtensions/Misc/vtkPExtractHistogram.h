@@ -7,6 +7,10 @@
  *
  * vtkPExtractHistogram is vtkExtractHistogram subclass for parallel datasets.
  * It gathers the histogram data on the root node.
+ *
+ * Unless averages, custom bin ranges or centered bins are requested, the
+ * values are binned with vtkSMPTools, each thread filling its own bins that
+ * are summed afterwards.
  */
 
 #ifndef vtkPExtractHistogram_h
@@ -16,6 +20,7 @@
 #include "vtkPVVTKExtensionsMiscModule.h" //needed for exports
 
 class vtkMultiProcessController;
+class vtkTable;
 
 class VTKPVVTKEXTENSIONSMISC_EXPORT vtkPExtractHistogram : public vtkExtractHistogram
 {
@@ -46,6 +51,21 @@ protected:
   int RequestData(vtkInformation* request, vtkInformationVector** inputVector,
     vtkInformationVector* outputVector) override;
 
+  /**
+   * Computes the bin extents and bin values of the input array in `output`,
+   * binning the values of each dataset concurrently. The bins are the same as
+   * the ones of vtkExtractHistogram without custom ranges nor centered bins.
+   * Returns false on error.
+   */
+  bool BinInputArray(vtkInformationVector** inputVector, vtkTable* output);
+
+  /**
+   * Sums the bin values of all ranks on the root using a single reduction.
+   * Used when no other array needs to be reduced. The output of
+   * non-root ranks is cleared.
+   */
+  bool ReduceBinValues(vtkTable* output);
+
   vtkMultiProcessController* Controller;
 
 private:
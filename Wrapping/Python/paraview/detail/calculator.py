@@ -16,6 +16,7 @@ from vtkmodules.numpy_interface.algorithms import *
 from paraview.vtk import vtkDataObject, vtkDoubleArray, vtkSelectionNode, vtkSelection, vtkStreamingDemandDrivenPipeline
 from paraview.modules import vtkPVVTKExtensionsFiltersPython
 from paraview.vtk.util.numpy_support import get_numpy_array_type
+import ast
 import sys
 import textwrap
 
@@ -171,6 +172,130 @@ def compute(inputs, expression, ns=None, multiline=False):
                 finalRet = dsa.VTKArray([a & b for a, b in zip(finalRet, retVal)])
         return finalRet
 
+# Element-wise functions that numexpr understands and that have the same
+# semantics as their `vtkmodules.numpy_interface.algorithms` counterparts.
+_NUMEXPR_FUNCTIONS = frozenset([
+    "abs", "arccos", "arccosh", "arcsin", "arcsinh", "arctan", "arctan2",
+    "arctanh", "cos", "cosh", "exp", "expm1", "log", "log10", "log1p", "sin",
+    "sinh", "sqrt", "tan", "tanh", "where"])
+
+_NUMEXPR_NODES = (ast.Expression, ast.BinOp, ast.UnaryOp, ast.Compare, ast.Call,
+                  ast.Name, ast.Load, ast.Constant, ast.operator, ast.unaryop,
+                  ast.cmpop)
+
+
+def _get_numexpr_names(expression):
+    """Returns the set of variable names referenced by `expression` if it only
+    uses element-wise operations supported by numexpr, otherwise None.
+
+    Reductions (`sum`, `max`, ...), attribute access and subscripts are
+    rejected so that such expressions keep their composite-aware semantics.
+    """
+    try:
+        tree = ast.parse(expression.strip(), mode="eval")
+    except SyntaxError:
+        return None
+    names = set()
+    for node in ast.walk(tree):
+        if not isinstance(node, _NUMEXPR_NODES):
+            return None
+        if isinstance(node, ast.Call):
+            if not isinstance(node.func, ast.Name) or node.func.id not in _NUMEXPR_FUNCTIONS \
+                    or node.keywords:
+                return None
+        elif isinstance(node, ast.Name) and node.id not in _NUMEXPR_FUNCTIONS:
+            names.add(node.id)
+    return names
+
+
+def _wrap_result(result, source):
+    """Wraps the ndarray `result` as a VTKArray tied to the same dataset and
+    association as the `source` VTKArray. This does not copy `result`."""
+    array = dsa.VTKArray(result, dataset=source.DataSet)
+    array.Association = source.Association
+    return array
+
+
+def compute_numexpr(expression, ns):
+    """Evaluates the single-line `expression` using numexpr's multithreaded
+    virtual machine. Returns None when numexpr is not available or when the
+    expression (or its operands) cannot be handled, in which case the caller
+    is expected to fall back to `compute`.
+
+    For composite datasets, arrays from all blocks are gathered into a single
+    buffer so that the expression is evaluated in one call rather than once
+    per block. The per-block results are views into the result buffer, so no
+    additional copy is made when they are appended to the output.
+    """
+    try:
+        import numexpr
+    except ImportError:
+        return None
+
+    names = _get_numexpr_names(expression)
+    if not names or not ns:
+        return None
+
+    arrays = {}
+    scalars = {}
+    for name in names:
+        value = ns.get(name)
+        if isinstance(value, (dsa.VTKArray, dsa.VTKCompositeDataArray)):
+            arrays[name] = value
+        elif isinstance(value, (int, float)) and not isinstance(value, bool):
+            scalars[name] = value
+        else:
+            # unknown name, NoneArray or unsupported type.
+            return None
+    if not arrays:
+        return None
+
+    reference = next(iter(arrays.values()))
+    try:
+        if isinstance(reference, dsa.VTKCompositeDataArray):
+            if any(not isinstance(a, dsa.VTKCompositeDataArray) for a in arrays.values()):
+                return None
+            blocks = [a.Arrays for a in arrays.values()]
+            nblocks = len(reference.Arrays)
+            if any(len(b) != nblocks for b in blocks):
+                return None
+            shapes = []
+            for i in range(nblocks):
+                items = [b[i] for b in blocks]
+                if any(item is dsa.NoneArray for item in items) or \
+                        any(item.shape != items[0].shape for item in items):
+                    return None
+                shapes.append(items[0].shape)
+            if nblocks == 0:
+                return None
+
+            local_dict = dict(scalars)
+            for name, value in arrays.items():
+                local_dict[name] = value.Arrays[0] if nblocks == 1 else \
+                    np.concatenate([np.asarray(a) for a in value.Arrays])
+            result = numexpr.evaluate(expression, local_dict=local_dict, global_dict={})
+            if result.shape[:1] != (sum(s[0] for s in shapes),):
+                return None
+
+            offsets = np.cumsum([s[0] for s in shapes])[:-1]
+            pieces = [_wrap_result(piece, source) for piece, source in
+                      zip(np.split(result, offsets), reference.Arrays)]
+            return dsa.VTKCompositeDataArray(pieces, dataset=reference.DataSet,
+                                             association=reference.Association)
+        else:
+            if any(not isinstance(a, dsa.VTKArray) or a.shape != reference.shape
+                   for a in arrays.values()):
+                return None
+            local_dict = dict(scalars)
+            local_dict.update(arrays)
+            result = numexpr.evaluate(expression, local_dict=local_dict, global_dict={})
+            if result.shape != reference.shape:
+                return None
+            return _wrap_result(result, reference)
+    except (KeyError, NotImplementedError, SyntaxError, TypeError, ValueError):
+        return None
+
+
 def get_data_time(self, do, ininfo):
     dinfo = do.GetInformation()
     if dinfo and dinfo.Has(do.DATA_TIME_STEP()):
@@ -230,14 +355,21 @@ def execute(self, expression, multiline=False):
                       "t_value": inputs[0].t_value,
                       "time_index": inputs[0].time_index,
                       "t_index": inputs[0].t_index})
-    retVal = compute(inputs, expression, ns=variables, multiline=multiline)
+    retVal = None
+    if self.GetUseNumExpr() and not multiline:
+        retVal = compute_numexpr(expression, variables)
+    if retVal is None:
+        retVal = compute(inputs, expression, ns=variables, multiline=multiline)
 
     if retVal is not None:
         vtkRet = retVal
         # Convert the result array type if requested.
         if self.GetResultArrayType() != -1:
             # handles VTKArray and VTKCompositeDataArray
-            if hasattr(retVal, "astype"):
+            if isinstance(retVal, np.ndarray):
+                # avoid a deep copy when the result already has the requested type.
+                vtkRet = retVal.astype(get_numpy_array_type(self.GetResultArrayType()), copy=False)
+            elif hasattr(retVal, "astype"):
                 vtkRet = retVal.astype(get_numpy_array_type(self.GetResultArrayType()))
             else:
                 # we can also get a scalar, convert to single element array of correct type